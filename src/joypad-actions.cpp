@@ -17,14 +17,14 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 */
 
 #include "joypad-actions.h"
+#include "joypad-flight-recorder.h"
+#include "joypad-stats.h"
+#include "joypad-trace.h"
+#include "joypad-watchdog.h"
 
-#include <obs-frontend-api.h>
-#include <obs-module.h>
-#include <obs-properties.h>
 #include <algorithm>
 #include <cmath>
-#include <QMetaObject>
-#include <QCoreApplication>
+#include <iterator>
 
 namespace {
 constexpr float kMinDb = -60.0f;
@@ -32,6 +32,38 @@ constexpr float kMaxDb = 50.0f;
 constexpr float kVolumeEpsilon = 0.0005f;
 constexpr uint32_t kAlignCenter = 0;
 
+// Trace span names, indexed by JoypadActionType.
+constexpr const char *kExecuteSpanNames[] = {
+	"Execute SwitchScene",
+	"Execute ToggleSourceVisibility",
+	"Execute SetSourceVisibility",
+	"Execute ToggleSourceMute",
+	"Execute SetSourceMute",
+	"Execute SetSourceVolume",
+	"Execute MediaPlayPause",
+	"Execute MediaRestart",
+	"Execute MediaStop",
+	"Execute ToggleFilterEnabled",
+	"Execute SetFilterEnabled",
+	"Execute AdjustSourceVolume",
+	"Execute SetSourceVolumePercent",
+	"Execute NextScene",
+	"Execute PreviousScene",
+	"Execute ToggleStreaming",
+	"Execute ToggleRecording",
+	"Execute ToggleVirtualCam",
+	"Execute ToggleStudioMode",
+	"Execute TransitionToProgram",
+	"Execute SetFilterProperty",
+	"Execute AdjustFilterProperty",
+	"Execute SourceTransform",
+	"Execute Screenshot",
+	"Execute StartReplayBuffer",
+	"Execute StopReplayBuffer",
+	"Execute ToggleReplayBuffer",
+	"Execute SaveReplayBuffer",
+};
+
 static float db_to_mul(float db)
 {
 	return std::pow(10.0f, db / 20.0f);
@@ -45,181 +77,183 @@ static float mul_to_db(float mul)
 	return 20.0f * std::log10(mul);
 }
 
-obs_source_t *get_scene_source(const JoypadBinding &binding)
-{
-	if (binding.use_current_scene) {
-		return obs_frontend_get_current_scene();
+// Hands a source or scene item reference back to the facade when it goes out of scope.
+template<typename T> class ObsRef {
+public:
+	ObsRef(JoypadObsApi &obs, T *ref) : obs_(obs), ref_(ref) {}
+	~ObsRef()
+	{
+		if (ref_) {
+			obs_.Release(ref_);
+		}
 	}
+	ObsRef(const ObsRef &) = delete;
+	ObsRef &operator=(const ObsRef &) = delete;
 
-	if (!binding.scene_name.empty()) {
-		return obs_get_source_by_name(binding.scene_name.c_str());
-	}
+	T *get() const { return ref_; }
+	explicit operator bool() const { return ref_ != nullptr; }
 
-	return nullptr;
-}
-
-void release_scene_source(obs_source_t *scene_source, const JoypadBinding &binding)
-{
-	if (!scene_source) {
-		return;
-	}
-	obs_source_release(scene_source);
-	(void)binding;
-}
+private:
+	JoypadObsApi &obs_;
+	T *ref_;
+};
 
-obs_sceneitem_t *get_scene_item_from_binding(const JoypadBinding &binding, obs_source_t **scene_source_out)
+JoypadObsItem *get_scene_item_from_params(JoypadObsApi &obs, const JoypadActionParams &params)
 {
-	obs_source_t *scene_source = get_scene_source(binding);
-	if (!scene_source) {
-		return nullptr;
+	if (params.use_current_scene) {
+		return obs.GetSceneItem(nullptr, params.source_name);
 	}
-
-	obs_scene_t *scene = obs_scene_from_source(scene_source);
-	if (!scene) {
-		release_scene_source(scene_source, binding);
-		return nullptr;
-	}
-
-	obs_sceneitem_t *item = obs_scene_find_source(scene, binding.source_name.c_str());
-	if (!item) {
-		release_scene_source(scene_source, binding);
-		return nullptr;
+	if (*params.scene_name) {
+		return obs.GetSceneItem(params.scene_name, params.source_name);
 	}
-
-	if (scene_source_out) {
-		*scene_source_out = scene_source;
-	} else {
-		release_scene_source(scene_source, binding);
-	}
-
-	return item;
+	return nullptr;
 }
 
-void apply_sceneitem_alignment(obs_sceneitem_t *item, JoypadSourceTransformOp op)
+void apply_sceneitem_alignment(JoypadObsApi &obs, JoypadObsItem *item, JoypadSourceTransformOp op)
 {
-	obs_video_info ovi = {};
-	if (!obs_get_video_info(&ovi) || ovi.base_width == 0 || ovi.base_height == 0) {
+	uint32_t base_width = 0;
+	uint32_t base_height = 0;
+	if (!obs.CanvasSize(base_width, base_height) || base_width == 0 || base_height == 0) {
 		return;
 	}
 
-	struct vec2 box = {};
-	obs_sceneitem_get_box_scale(item, &box);
+	const JoypadObsVec2 box = obs.ItemBoxSize(item);
 	const float width = std::fabs(box.x);
 	const float height = std::fabs(box.y);
 
-	struct vec2 pos = {};
-	obs_sceneitem_get_pos(item, &pos);
-	obs_sceneitem_set_alignment(item, kAlignCenter);
+	JoypadObsVec2 pos = obs.ItemPosition(item);
+	obs.SetItemAlignment(item, kAlignCenter);
 
 	switch (op) {
 	case JoypadSourceTransformOp::AlignLeft:
 		pos.x = width * 0.5f;
 		break;
 	case JoypadSourceTransformOp::AlignRight:
-		pos.x = (float)ovi.base_width - width * 0.5f;
+		pos.x = (float)base_width - width * 0.5f;
 		break;
 	case JoypadSourceTransformOp::AlignTop:
 		pos.y = height * 0.5f;
 		break;
 	case JoypadSourceTransformOp::AlignBottom:
-		pos.y = (float)ovi.base_height - height * 0.5f;
+		pos.y = (float)base_height - height * 0.5f;
 		break;
 	case JoypadSourceTransformOp::AlignTopLeft:
 		pos.x = width * 0.5f;
 		pos.y = height * 0.5f;
 		break;
 	case JoypadSourceTransformOp::AlignTopRight:
-		pos.x = (float)ovi.base_width - width * 0.5f;
+		pos.x = (float)base_width - width * 0.5f;
 		pos.y = height * 0.5f;
 		break;
 	case JoypadSourceTransformOp::AlignBottomLeft:
 		pos.x = width * 0.5f;
-		pos.y = (float)ovi.base_height - height * 0.5f;
+		pos.y = (float)base_height - height * 0.5f;
 		break;
 	case JoypadSourceTransformOp::AlignBottomRight:
-		pos.x = (float)ovi.base_width - width * 0.5f;
-		pos.y = (float)ovi.base_height - height * 0.5f;
+		pos.x = (float)base_width - width * 0.5f;
+		pos.y = (float)base_height - height * 0.5f;
 		break;
 	case JoypadSourceTransformOp::AlignCenterLeft:
 		pos.x = width * 0.5f;
-		pos.y = (float)ovi.base_height * 0.5f;
+		pos.y = (float)base_height * 0.5f;
 		break;
 	case JoypadSourceTransformOp::AlignCenterRight:
-		pos.x = (float)ovi.base_width - width * 0.5f;
-		pos.y = (float)ovi.base_height * 0.5f;
+		pos.x = (float)base_width - width * 0.5f;
+		pos.y = (float)base_height * 0.5f;
 		break;
 	case JoypadSourceTransformOp::CenterToScreen:
-		pos.x = (float)ovi.base_width * 0.5f;
-		pos.y = (float)ovi.base_height * 0.5f;
+		pos.x = (float)base_width * 0.5f;
+		pos.y = (float)base_height * 0.5f;
 		break;
 	default:
 		break;
 	}
 
-	obs_sceneitem_set_pos(item, &pos);
+	obs.SetItemPosition(item, pos);
+}
+
+void fit_sceneitem_to_screen(JoypadObsApi &obs, JoypadObsItem *item, int bounds_type)
+{
+	uint32_t base_width = 0;
+	uint32_t base_height = 0;
+	if (!obs.CanvasSize(base_width, base_height) || base_width == 0 || base_height == 0) {
+		return;
+	}
+	obs.SetItemAlignment(item, kAlignCenter);
+	obs.SetItemPosition(item, {(float)base_width * 0.5f, (float)base_height * 0.5f});
+	obs.SetItemBounds(item, bounds_type, kAlignCenter, {(float)base_width, (float)base_height});
 }
 
 } // namespace
 
-void JoypadActionEngine::Execute(const JoypadBinding &binding)
+void JoypadActionEngine::Execute(const JoypadActionParams &params, int64_t binding_uid)
+{
+	const size_t span = (size_t)params.action;
+	JoypadTraceScope trace_span(span < std::size(kExecuteSpanNames) ? kExecuteSpanNames[span] : "Execute");
+	const int64_t started = JoypadFlightNow();
+	if (watchdog_) {
+		watchdog_->BeginAction(params, binding_uid, started);
+	}
+	Run(params);
+	const int64_t finished = JoypadFlightNow();
+	if (watchdog_) {
+		watchdog_->EndAction(params, binding_uid, started, finished);
+	}
+	JoypadFlightRecordAction(params.action, started, finished);
+	JoypadStatsRecordAction(params.action, finished - started);
+}
+
+void JoypadActionEngine::Run(const JoypadActionParams &params)
 {
-	switch (binding.action) {
+	switch (params.action) {
 	case JoypadActionType::SwitchScene: {
-		if (binding.scene_name.empty()) {
-			return;
-		}
-		obs_source_t *scene = obs_get_source_by_name(binding.scene_name.c_str());
-		if (!scene) {
+		if (!*params.scene_name) {
 			return;
 		}
-		obs_frontend_set_current_scene(scene);
-		obs_source_release(scene);
+		obs_.SetProgramScene(params.scene_name);
 		break;
 	}
 	case JoypadActionType::ToggleSourceVisibility:
 	case JoypadActionType::SetSourceVisibility: {
-		if (binding.source_name.empty()) {
+		if (!*params.source_name) {
 			return;
 		}
 
-		obs_source_t *scene_source = nullptr;
-		obs_sceneitem_t *item = get_scene_item_from_binding(binding, &scene_source);
+		ObsRef<JoypadObsItem> item(obs_, get_scene_item_from_params(obs_, params));
 		if (!item) {
 			return;
 		}
 
-		bool visible = obs_sceneitem_visible(item);
-		bool new_visible = (binding.action == JoypadActionType::ToggleSourceVisibility) ? !visible
-												: binding.bool_value;
-		obs_sceneitem_set_visible(item, new_visible);
-		release_scene_source(scene_source, binding);
+		bool visible = obs_.ItemVisible(item.get());
+		bool new_visible = (params.action == JoypadActionType::ToggleSourceVisibility) ? !visible
+											       : params.bool_value;
+		obs_.SetItemVisible(item.get(), new_visible);
 		break;
 	}
 	case JoypadActionType::ToggleSourceMute:
 	case JoypadActionType::SetSourceMute: {
-		if (binding.source_name.empty()) {
+		if (!*params.source_name) {
 			return;
 		}
-		obs_source_t *source = obs_get_source_by_name(binding.source_name.c_str());
+		ObsRef<JoypadObsSource> source(obs_, obs_.GetSource(params.source_name));
 		if (!source) {
 			return;
 		}
-		bool muted = obs_source_muted(source);
-		bool new_muted = (binding.action == JoypadActionType::ToggleSourceMute) ? !muted : binding.bool_value;
-		obs_source_set_muted(source, new_muted);
-		obs_source_release(source);
+		bool muted = obs_.Muted(source.get());
+		bool new_muted = (params.action == JoypadActionType::ToggleSourceMute) ? !muted : params.bool_value;
+		obs_.SetMuted(source.get(), new_muted);
 		break;
 	}
 	case JoypadActionType::SetSourceVolume: {
-		if (binding.source_name.empty()) {
+		if (!*params.source_name) {
 			return;
 		}
-		obs_source_t *source = obs_get_source_by_name(binding.source_name.c_str());
+		ObsRef<JoypadObsSource> source(obs_, obs_.GetSource(params.source_name));
 		if (!source) {
 			return;
 		}
-		float target_db = (float)binding.volume_value;
-		if (!binding.allow_above_unity && target_db > 0.0f) {
+		float target_db = (float)params.volume_value;
+		if (!params.allow_above_unity && target_db > 0.0f) {
 			target_db = 0.0f;
 		}
 		if (target_db < kMinDb) {
@@ -229,22 +263,21 @@ void JoypadActionEngine::Execute(const JoypadBinding &binding)
 			target_db = kMaxDb;
 		}
 		const float target_mul = db_to_mul(target_db);
-		const float current_mul = obs_source_get_volume(source);
+		const float current_mul = obs_.Volume(source.get());
 		if (std::fabs(current_mul - target_mul) > kVolumeEpsilon) {
-			obs_source_set_volume(source, target_mul);
+			obs_.SetVolume(source.get(), target_mul);
 		}
-		obs_source_release(source);
 		break;
 	}
 	case JoypadActionType::SetSourceVolumePercent: {
-		if (binding.source_name.empty()) {
+		if (!*params.source_name) {
 			return;
 		}
-		obs_source_t *source = obs_get_source_by_name(binding.source_name.c_str());
+		ObsRef<JoypadObsSource> source(obs_, obs_.GetSource(params.source_name));
 		if (!source) {
 			return;
 		}
-		float percent = (float)binding.volume_value;
+		float percent = (float)params.volume_value;
 		if (percent < 0.0f) {
 			percent = 0.0f;
 		}
@@ -259,28 +292,27 @@ void JoypadActionEngine::Execute(const JoypadBinding &binding)
 			target_db = 0.0f;
 		}
 		const float target_mul = db_to_mul(target_db);
-		const float current_mul = obs_source_get_volume(source);
+		const float current_mul = obs_.Volume(source.get());
 		if (std::fabs(current_mul - target_mul) > kVolumeEpsilon) {
-			obs_source_set_volume(source, target_mul);
+			obs_.SetVolume(source.get(), target_mul);
 		}
-		obs_source_release(source);
 		break;
 	}
 	case JoypadActionType::AdjustSourceVolume: {
-		if (binding.source_name.empty()) {
+		if (!*params.source_name) {
 			return;
 		}
-		obs_source_t *source = obs_get_source_by_name(binding.source_name.c_str());
+		ObsRef<JoypadObsSource> source(obs_, obs_.GetSource(params.source_name));
 		if (!source) {
 			return;
 		}
-		const float current_mul = obs_source_get_volume(source);
+		const float current_mul = obs_.Volume(source.get());
 		float current_db = mul_to_db(current_mul);
 		if (current_db < kMinDb) {
 			current_db = kMinDb;
 		}
-		float next_db = current_db + (float)binding.volume_value;
-		if (!binding.allow_above_unity && next_db > 0.0f) {
+		float next_db = current_db + (float)params.volume_value;
+		if (!params.allow_above_unity && next_db > 0.0f) {
 			next_db = 0.0f;
 		}
 		if (next_db < kMinDb) {
@@ -291,265 +323,171 @@ void JoypadActionEngine::Execute(const JoypadBinding &binding)
 		}
 		const float next_mul = db_to_mul(next_db);
 		if (std::fabs(current_mul - next_mul) > kVolumeEpsilon) {
-			obs_source_set_volume(source, next_mul);
+			obs_.SetVolume(source.get(), next_mul);
 		}
-		obs_source_release(source);
 		break;
 	}
 	case JoypadActionType::MediaPlayPause:
 	case JoypadActionType::MediaRestart:
 	case JoypadActionType::MediaStop: {
-		if (binding.source_name.empty()) {
+		if (!*params.source_name) {
 			return;
 		}
-		obs_source_t *source = obs_get_source_by_name(binding.source_name.c_str());
+		ObsRef<JoypadObsSource> source(obs_, obs_.GetSource(params.source_name));
 		if (!source) {
 			return;
 		}
 
-		switch (binding.action) {
-		case JoypadActionType::MediaPlayPause: {
-			enum obs_media_state state = obs_source_media_get_state(source);
-			bool pause = (state == OBS_MEDIA_STATE_PLAYING);
-			obs_source_media_play_pause(source, pause);
+		switch (params.action) {
+		case JoypadActionType::MediaPlayPause:
+			obs_.MediaPlayPause(source.get(), obs_.MediaPlaying(source.get()));
 			break;
-		} break;
 		case JoypadActionType::MediaRestart:
-			obs_source_media_restart(source);
+			obs_.MediaRestart(source.get());
 			break;
 		case JoypadActionType::MediaStop:
-			obs_source_media_stop(source);
+			obs_.MediaStop(source.get());
 			break;
 		default:
 			break;
 		}
-
-		obs_source_release(source);
 		break;
 	}
 	case JoypadActionType::ToggleFilterEnabled:
 	case JoypadActionType::SetFilterEnabled: {
-		if (binding.source_name.empty() || binding.filter_name.empty()) {
+		if (!*params.source_name || !*params.filter_name) {
 			return;
 		}
-		obs_source_t *source = obs_get_source_by_name(binding.source_name.c_str());
+		ObsRef<JoypadObsSource> source(obs_, obs_.GetSource(params.source_name));
 		if (!source) {
 			return;
 		}
-		obs_source_t *filter = obs_source_get_filter_by_name(source, binding.filter_name.c_str());
+		ObsRef<JoypadObsSource> filter(obs_, obs_.GetFilter(source.get(), params.filter_name));
 		if (!filter) {
-			obs_source_release(source);
 			return;
 		}
-		bool enabled = obs_source_enabled(filter);
-		bool new_enabled = (binding.action == JoypadActionType::ToggleFilterEnabled) ? !enabled
-											     : binding.bool_value;
-		obs_source_set_enabled(filter, new_enabled);
-		obs_source_release(filter);
-		obs_source_release(source);
+		bool enabled = obs_.Enabled(filter.get());
+		bool new_enabled = (params.action == JoypadActionType::ToggleFilterEnabled) ? !enabled
+											    : params.bool_value;
+		obs_.SetEnabled(filter.get(), new_enabled);
 		break;
 	}
 	case JoypadActionType::SetFilterProperty: {
-		if (binding.source_name.empty() || binding.filter_name.empty() ||
-		    binding.filter_property_name.empty()) {
+		if (!*params.source_name || !*params.filter_name || !*params.filter_property_name) {
 			return;
 		}
-		obs_source_t *source = obs_get_source_by_name(binding.source_name.c_str());
+		ObsRef<JoypadObsSource> source(obs_, obs_.GetSource(params.source_name));
 		if (!source) {
 			return;
 		}
-		obs_source_t *filter = obs_source_get_filter_by_name(source, binding.filter_name.c_str());
+		ObsRef<JoypadObsSource> filter(obs_, obs_.GetFilter(source.get(), params.filter_name));
 		if (!filter) {
-			obs_source_release(source);
-			return;
-		}
-
-		obs_properties_t *props = obs_source_properties(filter);
-		if (!props) {
-			obs_source_release(filter);
-			obs_source_release(source);
-			return;
-		}
-		obs_property_t *prop = obs_properties_get(props, binding.filter_property_name.c_str());
-		if (!prop) {
-			obs_properties_destroy(props);
-			obs_source_release(filter);
-			obs_source_release(source);
 			return;
 		}
-		obs_data_t *settings = obs_source_get_settings(filter);
-		if (!settings) {
-			obs_properties_destroy(props);
-			obs_source_release(filter);
-			obs_source_release(source);
+		JoypadObsProperty prop;
+		if (!obs_.GetProperty(filter.get(), params.filter_property_name, prop)) {
 			return;
 		}
 
-		const enum obs_property_type prop_type = obs_property_get_type(prop);
-		switch (prop_type) {
-		case OBS_PROPERTY_BOOL:
-			obs_data_set_bool(settings, binding.filter_property_name.c_str(), binding.bool_value);
+		switch (prop.type) {
+		case kJoypadPropertyBool:
+			obs_.SetBoolSetting(filter.get(), params.filter_property_name, params.bool_value);
 			break;
-		case OBS_PROPERTY_INT: {
-			const int minv = obs_property_int_min(prop);
-			const int maxv = obs_property_int_max(prop);
-			long long value = (long long)std::llround(binding.filter_property_value);
-			value = std::clamp(value, (long long)minv, (long long)maxv);
-			obs_data_set_int(settings, binding.filter_property_name.c_str(), value);
+		case kJoypadPropertyInt: {
+			long long value = (long long)std::llround(params.filter_property_value);
+			value = std::clamp(value, (long long)prop.min, (long long)prop.max);
+			obs_.SetIntSetting(filter.get(), params.filter_property_name, value);
 		} break;
-		case OBS_PROPERTY_FLOAT: {
-			const double minv = obs_property_float_min(prop);
-			const double maxv = obs_property_float_max(prop);
-			double value = std::clamp(binding.filter_property_value, minv, maxv);
-			obs_data_set_double(settings, binding.filter_property_name.c_str(), value);
+		case kJoypadPropertyFloat: {
+			double value = std::clamp(params.filter_property_value, prop.min, prop.max);
+			obs_.SetDoubleSetting(filter.get(), params.filter_property_name, value);
 		} break;
-		case OBS_PROPERTY_LIST: {
-			const enum obs_combo_format format = obs_property_list_format(prop);
-			if (format == OBS_COMBO_FORMAT_INT) {
-				obs_data_set_int(settings, binding.filter_property_name.c_str(),
-						 binding.filter_property_list_int);
-			} else if (format == OBS_COMBO_FORMAT_FLOAT) {
-				obs_data_set_double(settings, binding.filter_property_name.c_str(),
-						    binding.filter_property_list_float);
+		case kJoypadPropertyList: {
+			if (prop.list_format == kJoypadComboFormatInt) {
+				obs_.SetIntSetting(filter.get(), params.filter_property_name,
+						   params.filter_property_list_int);
+			} else if (prop.list_format == kJoypadComboFormatFloat) {
+				obs_.SetDoubleSetting(filter.get(), params.filter_property_name,
+						      params.filter_property_list_float);
 			} else {
-				obs_data_set_string(settings, binding.filter_property_name.c_str(),
-						    binding.filter_property_list_string.c_str());
+				obs_.SetStringSetting(filter.get(), params.filter_property_name,
+						      params.filter_property_list_string);
 			}
 		} break;
 		default:
 			break;
 		}
-
-		obs_source_update(filter, settings);
-		obs_data_release(settings);
-		obs_properties_destroy(props);
-		obs_source_release(filter);
-		obs_source_release(source);
 		break;
 	}
 	case JoypadActionType::AdjustFilterProperty: {
-		if (binding.source_name.empty() || binding.filter_name.empty() ||
-		    binding.filter_property_name.empty()) {
+		if (!*params.source_name || !*params.filter_name || !*params.filter_property_name) {
 			return;
 		}
-		obs_source_t *source = obs_get_source_by_name(binding.source_name.c_str());
+		ObsRef<JoypadObsSource> source(obs_, obs_.GetSource(params.source_name));
 		if (!source) {
 			return;
 		}
-		obs_source_t *filter = obs_source_get_filter_by_name(source, binding.filter_name.c_str());
+		ObsRef<JoypadObsSource> filter(obs_, obs_.GetFilter(source.get(), params.filter_name));
 		if (!filter) {
-			obs_source_release(source);
-			return;
-		}
-
-		obs_properties_t *props = obs_source_properties(filter);
-		if (!props) {
-			obs_source_release(filter);
-			obs_source_release(source);
 			return;
 		}
-		obs_property_t *prop = obs_properties_get(props, binding.filter_property_name.c_str());
-		if (!prop) {
-			obs_properties_destroy(props);
-			obs_source_release(filter);
-			obs_source_release(source);
-			return;
-		}
-		obs_data_t *settings = obs_source_get_settings(filter);
-		if (!settings) {
-			obs_properties_destroy(props);
-			obs_source_release(filter);
-			obs_source_release(source);
+		JoypadObsProperty prop;
+		if (!obs_.GetProperty(filter.get(), params.filter_property_name, prop)) {
 			return;
 		}
 
-		const enum obs_property_type prop_type = obs_property_get_type(prop);
-		if (prop_type == OBS_PROPERTY_INT) {
-			const int minv = obs_property_int_min(prop);
-			const int maxv = obs_property_int_max(prop);
-			const long long current = obs_data_get_int(settings, binding.filter_property_name.c_str());
-			const long long delta = (long long)std::llround(binding.volume_value);
+		if (prop.type == kJoypadPropertyInt) {
+			const long long current = obs_.IntSetting(filter.get(), params.filter_property_name);
+			const long long delta = (long long)std::llround(params.volume_value);
 			long long next = current + delta;
-			next = std::clamp(next, (long long)minv, (long long)maxv);
-			obs_data_set_int(settings, binding.filter_property_name.c_str(), next);
-			obs_source_update(filter, settings);
-		} else if (prop_type == OBS_PROPERTY_FLOAT) {
-			const double minv = obs_property_float_min(prop);
-			const double maxv = obs_property_float_max(prop);
-			const double current = obs_data_get_double(settings, binding.filter_property_name.c_str());
-			double next = current + binding.volume_value;
-			next = std::clamp(next, minv, maxv);
-			obs_data_set_double(settings, binding.filter_property_name.c_str(), next);
-			obs_source_update(filter, settings);
+			next = std::clamp(next, (long long)prop.min, (long long)prop.max);
+			obs_.SetIntSetting(filter.get(), params.filter_property_name, next);
+		} else if (prop.type == kJoypadPropertyFloat) {
+			const double current = obs_.DoubleSetting(filter.get(), params.filter_property_name);
+			double next = current + params.volume_value;
+			next = std::clamp(next, prop.min, prop.max);
+			obs_.SetDoubleSetting(filter.get(), params.filter_property_name, next);
 		}
-
-		obs_data_release(settings);
-		obs_properties_destroy(props);
-		obs_source_release(filter);
-		obs_source_release(source);
 		break;
 	}
 	case JoypadActionType::SourceTransform: {
-		if (binding.source_name.empty()) {
+		if (!*params.source_name) {
 			return;
 		}
 
-		obs_source_t *scene_source = nullptr;
-		obs_sceneitem_t *item = get_scene_item_from_binding(binding, &scene_source);
+		ObsRef<JoypadObsItem> item(obs_, get_scene_item_from_params(obs_, params));
 		if (!item) {
 			return;
 		}
 
-		switch (binding.source_transform_op) {
+		switch (params.source_transform_op) {
 		case JoypadSourceTransformOp::FlipHorizontal: {
-			struct vec2 scale = {};
-			obs_sceneitem_get_scale(item, &scale);
+			JoypadObsVec2 scale = obs_.ItemScale(item.get());
 			scale.x = -scale.x;
-			obs_sceneitem_set_scale(item, &scale);
+			obs_.SetItemScale(item.get(), scale);
 			break;
 		}
 		case JoypadSourceTransformOp::FlipVertical: {
-			struct vec2 scale = {};
-			obs_sceneitem_get_scale(item, &scale);
+			JoypadObsVec2 scale = obs_.ItemScale(item.get());
 			scale.y = -scale.y;
-			obs_sceneitem_set_scale(item, &scale);
+			obs_.SetItemScale(item.get(), scale);
 			break;
 		}
 		case JoypadSourceTransformOp::Rotate90CW:
-			obs_sceneitem_set_rot(item, obs_sceneitem_get_rot(item) + 90.0f);
+			obs_.SetItemRotation(item.get(), obs_.ItemRotation(item.get()) + 90.0f);
 			break;
 		case JoypadSourceTransformOp::Rotate90CCW:
-			obs_sceneitem_set_rot(item, obs_sceneitem_get_rot(item) - 90.0f);
+			obs_.SetItemRotation(item.get(), obs_.ItemRotation(item.get()) - 90.0f);
 			break;
 		case JoypadSourceTransformOp::Rotate180:
-			obs_sceneitem_set_rot(item, obs_sceneitem_get_rot(item) + 180.0f);
+			obs_.SetItemRotation(item.get(), obs_.ItemRotation(item.get()) + 180.0f);
 			break;
-		case JoypadSourceTransformOp::FitToScreen: {
-			obs_video_info ovi = {};
-			if (obs_get_video_info(&ovi) && ovi.base_width > 0 && ovi.base_height > 0) {
-				struct vec2 pos = {(float)ovi.base_width * 0.5f, (float)ovi.base_height * 0.5f};
-				struct vec2 bounds = {(float)ovi.base_width, (float)ovi.base_height};
-				obs_sceneitem_set_alignment(item, kAlignCenter);
-				obs_sceneitem_set_pos(item, &pos);
-				obs_sceneitem_set_bounds_type(item, OBS_BOUNDS_SCALE_INNER);
-				obs_sceneitem_set_bounds_alignment(item, kAlignCenter);
-				obs_sceneitem_set_bounds(item, &bounds);
-			}
+		case JoypadSourceTransformOp::FitToScreen:
+			fit_sceneitem_to_screen(obs_, item.get(), kJoypadBoundsScaleInner);
 			break;
-		}
-		case JoypadSourceTransformOp::StretchToScreen: {
-			obs_video_info ovi = {};
-			if (obs_get_video_info(&ovi) && ovi.base_width > 0 && ovi.base_height > 0) {
-				struct vec2 pos = {(float)ovi.base_width * 0.5f, (float)ovi.base_height * 0.5f};
-				struct vec2 bounds = {(float)ovi.base_width, (float)ovi.base_height};
-				obs_sceneitem_set_alignment(item, kAlignCenter);
-				obs_sceneitem_set_pos(item, &pos);
-				obs_sceneitem_set_bounds_type(item, OBS_BOUNDS_STRETCH);
-				obs_sceneitem_set_bounds_alignment(item, kAlignCenter);
-				obs_sceneitem_set_bounds(item, &bounds);
-			}
+		case JoypadSourceTransformOp::StretchToScreen:
+			fit_sceneitem_to_screen(obs_, item.get(), kJoypadBoundsStretch);
 			break;
-		}
 		case JoypadSourceTransformOp::AlignLeft:
 		case JoypadSourceTransformOp::AlignRight:
 		case JoypadSourceTransformOp::AlignTop:
@@ -561,138 +499,95 @@ void JoypadActionEngine::Execute(const JoypadBinding &binding)
 		case JoypadSourceTransformOp::AlignCenterLeft:
 		case JoypadSourceTransformOp::AlignCenterRight:
 		case JoypadSourceTransformOp::CenterToScreen:
-			apply_sceneitem_alignment(item, binding.source_transform_op);
+			apply_sceneitem_alignment(obs_, item.get(), params.source_transform_op);
 			break;
 		default:
 			break;
 		}
-
-		release_scene_source(scene_source, binding);
 		break;
 	}
 	case JoypadActionType::NextScene:
 	case JoypadActionType::PreviousScene: {
-		obs_source_t *current_scene = nullptr;
-		if (obs_frontend_preview_program_mode_active()) {
-			current_scene = obs_frontend_get_current_preview_scene();
-		} else {
-			current_scene = obs_frontend_get_current_scene();
-		}
-
-		if (!current_scene) {
+		const bool studio_mode = obs_.StudioModeActive();
+		const std::string current_scene = studio_mode ? obs_.PreviewScene() : obs_.ProgramScene();
+		if (current_scene.empty()) {
 			return;
 		}
 
-		obs_frontend_source_list scenes = {};
-		obs_frontend_get_scenes(&scenes);
+		std::vector<std::string> scenes;
+		obs_.GetSceneNames(scenes);
 
-		size_t current_index = (size_t)-1;
-		for (size_t i = 0; i < scenes.sources.num; ++i) {
-			if (scenes.sources.array[i] == current_scene) {
-				current_index = i;
-				break;
-			}
+		const auto it = std::find(scenes.begin(), scenes.end(), current_scene);
+		if (it == scenes.end()) {
+			return;
 		}
-
-		if (current_index != (size_t)-1) {
-			size_t new_index = current_index;
-			if (binding.action == JoypadActionType::NextScene) {
-				new_index++;
-				if (new_index >= scenes.sources.num) {
-					new_index = 0;
-				}
-			} else {
-				if (new_index == 0) {
-					new_index = scenes.sources.num - 1;
-				} else {
-					new_index--;
-				}
+		size_t new_index = (size_t)(it - scenes.begin());
+		if (params.action == JoypadActionType::NextScene) {
+			new_index++;
+			if (new_index >= scenes.size()) {
+				new_index = 0;
 			}
-			if (new_index < scenes.sources.num) {
-				if (obs_frontend_preview_program_mode_active()) {
-					obs_frontend_set_current_preview_scene(scenes.sources.array[new_index]);
-				} else {
-					obs_frontend_set_current_scene(scenes.sources.array[new_index]);
-				}
+		} else {
+			if (new_index == 0) {
+				new_index = scenes.size() - 1;
+			} else {
+				new_index--;
 			}
 		}
-
-		obs_frontend_source_list_free(&scenes);
-		obs_source_release(current_scene);
+		if (studio_mode) {
+			obs_.SetPreviewScene(scenes[new_index].c_str());
+		} else {
+			obs_.SetProgramScene(scenes[new_index].c_str());
+		}
 		break;
 	}
 	case JoypadActionType::ToggleStreaming:
-		if (obs_frontend_streaming_active()) {
-			obs_frontend_streaming_stop();
-		} else {
-			obs_frontend_streaming_start();
-		}
+		obs_.SetOutputActive(JoypadObsOutput::Streaming, !obs_.OutputActive(JoypadObsOutput::Streaming));
 		break;
 	case JoypadActionType::ToggleRecording:
-		if (obs_frontend_recording_active()) {
-			obs_frontend_recording_stop();
-		} else {
-			obs_frontend_recording_start();
-		}
+		obs_.SetOutputActive(JoypadObsOutput::Recording, !obs_.OutputActive(JoypadObsOutput::Recording));
 		break;
 	case JoypadActionType::ToggleVirtualCam:
-		if (obs_frontend_virtualcam_active()) {
-			obs_frontend_stop_virtualcam();
-		} else {
-			obs_frontend_start_virtualcam();
-		}
+		obs_.SetOutputActive(JoypadObsOutput::VirtualCam, !obs_.OutputActive(JoypadObsOutput::VirtualCam));
 		break;
 	case JoypadActionType::ToggleStudioMode:
-		if (QCoreApplication *app = QCoreApplication::instance()) {
-			QMetaObject::invokeMethod(app, []() {
-				obs_frontend_set_preview_program_mode(!obs_frontend_preview_program_mode_active());
-			});
-		}
+		obs_.ToggleStudioMode();
 		break;
 	case JoypadActionType::TransitionToProgram:
-		if (QCoreApplication *app = QCoreApplication::instance()) {
-			QMetaObject::invokeMethod(app, []() {
-				if (obs_frontend_preview_program_mode_active()) {
-					obs_frontend_preview_program_trigger_transition();
-				}
-			});
-		}
+		obs_.TransitionToProgram();
 		break;
 	case JoypadActionType::StartReplayBuffer:
-		if (!obs_frontend_replay_buffer_active()) {
-			obs_frontend_replay_buffer_start();
+		if (!obs_.OutputActive(JoypadObsOutput::ReplayBuffer)) {
+			obs_.SetOutputActive(JoypadObsOutput::ReplayBuffer, true);
 		}
 		break;
 	case JoypadActionType::StopReplayBuffer:
-		if (obs_frontend_replay_buffer_active()) {
-			obs_frontend_replay_buffer_stop();
+		if (obs_.OutputActive(JoypadObsOutput::ReplayBuffer)) {
+			obs_.SetOutputActive(JoypadObsOutput::ReplayBuffer, false);
 		}
 		break;
 	case JoypadActionType::ToggleReplayBuffer:
-		if (obs_frontend_replay_buffer_active()) {
-			obs_frontend_replay_buffer_stop();
-		} else {
-			obs_frontend_replay_buffer_start();
-		}
+		obs_.SetOutputActive(JoypadObsOutput::ReplayBuffer, !obs_.OutputActive(JoypadObsOutput::ReplayBuffer));
 		break;
 	case JoypadActionType::SaveReplayBuffer:
-		if (obs_frontend_replay_buffer_active()) {
-			obs_frontend_replay_buffer_save();
+		if (obs_.OutputActive(JoypadObsOutput::ReplayBuffer)) {
+			obs_.SaveReplayBuffer();
 		}
 		break;
-	case JoypadActionType::Screenshot:
-		if (binding.screenshot_target == JoypadScreenshotTarget::Program) {
-			obs_frontend_take_screenshot();
+	case JoypadActionType::Screenshot: {
+		if (params.screenshot_target == JoypadScreenshotTarget::Program) {
+			obs_.TakeScreenshot(nullptr);
 			break;
 		}
-		if (binding.source_name.empty()) {
+		if (!*params.source_name) {
 			return;
 		}
-		if (obs_source_t *source = obs_get_source_by_name(binding.source_name.c_str())) {
-			obs_frontend_take_source_screenshot(source);
-			obs_source_release(source);
+		ObsRef<JoypadObsSource> source(obs_, obs_.GetSource(params.source_name));
+		if (source) {
+			obs_.TakeScreenshot(source.get());
 		}
 		break;
+	}
 	default:
 		break;
 	}
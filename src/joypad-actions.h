@@ -18,9 +18,25 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 
 #pragma once
 
-#include "joypad-config.h"
+#include "joypad-core.h"
+#include "joypad-obs-api.h"
 
+class JoypadWatchdog;
+
+// Runs binding actions against OBS through a JoypadObsApi: JoypadLibObsApi() in the plugin,
+// a JoypadFakeObsApi in tools.
 class JoypadActionEngine {
 public:
-	void Execute(const JoypadBinding &binding);
+	explicit JoypadActionEngine(JoypadObsApi &obs) : obs_(obs) {}
+
+	// binding_uid only labels the action in watchdog reports.
+	void Execute(const JoypadActionParams &params, int64_t binding_uid = 0);
+	void Execute(const JoypadBinding &binding) { Execute(JoypadActionParams::FromBinding(binding), binding.uid); }
+	void SetWatchdog(JoypadWatchdog *watchdog) { watchdog_ = watchdog; }
+
+private:
+	void Run(const JoypadActionParams &params);
+
+	JoypadObsApi &obs_;
+	JoypadWatchdog *watchdog_ = nullptr;
 };
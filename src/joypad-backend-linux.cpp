@@ -0,0 +1,381 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "joypad-backend.h"
+
+#if defined(__linux__)
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <linux/joystick.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+namespace {
+constexpr const char *kInputDir = "/dev/input";
+constexpr auto kRescanInterval = std::chrono::seconds(4);
+
+// Open descriptors by handle, /dev/input hotplug through inotify and a poll()-based Wait
+// shared by the joydev and evdev backends.
+class LinuxBackend : public JoypadInputBackend {
+public:
+	explicit LinuxBackend(const char *prefix) : prefix_(prefix)
+	{
+		inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		// IN_ATTRIB: udev fixes node permissions after creating it.
+		const uint32_t mask = IN_CREATE | IN_DELETE | IN_ATTRIB;
+		if (inotify_fd_ >= 0 && inotify_add_watch(inotify_fd_, kInputDir, mask) < 0) {
+			close(inotify_fd_);
+			inotify_fd_ = -1;
+		}
+		last_rescan_ = std::chrono::steady_clock::now();
+	}
+
+	~LinuxBackend() override
+	{
+		for (int fd : fds_) {
+			if (fd >= 0) {
+				close(fd);
+			}
+		}
+		if (inotify_fd_ >= 0) {
+			close(inotify_fd_);
+		}
+	}
+
+	void Enumerate(std::vector<JoypadBackendDevice> &devices) override
+	{
+		DIR *dir = opendir(kInputDir);
+		if (!dir) {
+			return;
+		}
+		const size_t prefix_length = strlen(prefix_);
+		struct dirent *ent = nullptr;
+		while ((ent = readdir(dir)) != nullptr) {
+			if (strncmp(ent->d_name, prefix_, prefix_length) != 0) {
+				continue;
+			}
+			const std::string path = std::string(kInputDir) + "/" + ent->d_name;
+			const int fd = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+			if (fd < 0) {
+				continue;
+			}
+			JoypadBackendDevice device;
+			if (Describe(fd, ent->d_name, device)) {
+				devices.push_back(std::move(device));
+			}
+			close(fd);
+		}
+		closedir(dir);
+	}
+
+	int Open(const JoypadBackendDevice &device) override
+	{
+		const std::string path = std::string(kInputDir) + "/" + device.id.substr(device.id.find(':') + 1);
+		const int fd = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+		if (fd < 0) {
+			return -1;
+		}
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = std::find(fds_.begin(), fds_.end(), -1);
+		if (it == fds_.end()) {
+			it = fds_.insert(fds_.end(), -1);
+		}
+		*it = fd;
+		const int handle = (int)(it - fds_.begin());
+		Opened(handle, fd);
+		return handle;
+	}
+
+	void Close(int handle) override
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (handle >= 0 && handle < (int)fds_.size() && fds_[(size_t)handle] >= 0) {
+			close(fds_[(size_t)handle]);
+			fds_[(size_t)handle] = -1;
+		}
+	}
+
+	bool PollHotplug() override
+	{
+		if (inotify_fd_ < 0) {
+			// No inotify: rescan on a timer like the poll loop used to.
+			const auto now = std::chrono::steady_clock::now();
+			if (now - last_rescan_ < kRescanInterval) {
+				return false;
+			}
+			last_rescan_ = now;
+			return true;
+		}
+		bool changed = false;
+		alignas(inotify_event) char buffer[4096];
+		ssize_t length = 0;
+		while ((length = read(inotify_fd_, buffer, sizeof(buffer))) > 0) {
+			for (ssize_t offset = 0; offset < length;) {
+				const auto *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+				if (event->len > 0 && strncmp(event->name, prefix_, strlen(prefix_)) == 0) {
+					changed = true;
+				}
+				offset += (ssize_t)sizeof(inotify_event) + event->len;
+			}
+		}
+		return changed;
+	}
+
+	void Wait(std::chrono::milliseconds timeout) override
+	{
+		std::vector<pollfd> fds;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			fds.reserve(fds_.size() + 1);
+			for (int fd : fds_) {
+				if (fd >= 0) {
+					fds.push_back({fd, POLLIN, 0});
+				}
+			}
+		}
+		if (inotify_fd_ >= 0) {
+			fds.push_back({inotify_fd_, POLLIN, 0});
+		}
+		if (fds.empty()) {
+			JoypadInputBackend::Wait(timeout);
+			return;
+		}
+		poll(fds.data(), (nfds_t)fds.size(), (int)timeout.count());
+	}
+
+protected:
+	// Fills device from an open node; false if the node isn't a game controller.
+	virtual bool Describe(int fd, const char *node, JoypadBackendDevice &device) = 0;
+	virtual void Opened(int handle, int fd)
+	{
+		(void)handle;
+		(void)fd;
+	}
+
+	int Fd(int handle)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return handle >= 0 && handle < (int)fds_.size() ? fds_[(size_t)handle] : -1;
+	}
+
+	static bool Gone(ssize_t bytes_read) { return bytes_read < 0 && errno != EAGAIN && errno != EWOULDBLOCK; }
+
+	std::mutex mutex_;
+	std::vector<int> fds_;
+
+private:
+	const char *prefix_;
+	int inotify_fd_ = -1;
+	std::chrono::steady_clock::time_point last_rescan_;
+};
+
+// Legacy joystick interface. Ids are "js:jsN" for every field, as earlier releases stored
+// them, so existing bindings keep matching.
+class JoydevBackend : public LinuxBackend {
+public:
+	JoydevBackend() : LinuxBackend("js") {}
+
+	const char *Name() const override { return "joydev"; }
+
+	bool ReadBatch(int handle, std::vector<JoypadBackendEvent> &events) override
+	{
+		const int fd = Fd(handle);
+		if (fd < 0) {
+			return false;
+		}
+		js_event e = {};
+		ssize_t bytes_read = 0;
+		while ((bytes_read = read(fd, &e, sizeof(e))) == (ssize_t)sizeof(e)) {
+			if (e.type & JS_EVENT_INIT) {
+				continue;
+			}
+			JoypadBackendEvent event;
+			event.index = (int)e.number;
+			if ((e.type & JS_EVENT_BUTTON) != 0) {
+				event.type = JoypadBackendEvent::Type::Button;
+				event.pressed = e.value != 0;
+			} else if ((e.type & JS_EVENT_AXIS) != 0) {
+				event.type = JoypadBackendEvent::Type::Axis;
+				event.value = std::clamp((double)e.value / 32767.0, -1.0, 1.0);
+				event.raw = (double)e.value;
+			} else {
+				continue;
+			}
+			events.push_back(event);
+		}
+		return !Gone(bytes_read);
+	}
+
+protected:
+	bool Describe(int fd, const char *node, JoypadBackendDevice &device) override
+	{
+		char name[128] = {};
+		if (ioctl(fd, JSIOCGNAME(sizeof(name)), name) < 0 || name[0] == '\0') {
+			snprintf(name, sizeof(name), "Joystick %s", node);
+		}
+		device.id = std::string("js:") + node;
+		device.stable_id = device.id;
+		device.type_id = device.id;
+		device.name = name;
+		return true;
+	}
+};
+
+bool test_bit(const unsigned long *bits, int bit)
+{
+	constexpr int kBitsPerLong = (int)(sizeof(unsigned long) * 8);
+	return (bits[bit / kBitsPerLong] >> (bit % kBitsPerLong)) & 1ul;
+}
+
+// Event interface, for controllers joydev doesn't expose. Buttons and axes are numbered in
+// the same order joydev would use; type ids follow the VID_xxxx&PID_xxxx form of the other
+// platforms.
+class EvdevBackend : public LinuxBackend {
+public:
+	EvdevBackend() : LinuxBackend("event") {}
+
+	const char *Name() const override { return "evdev"; }
+
+	bool ReadBatch(int handle, std::vector<JoypadBackendEvent> &events) override
+	{
+		const int fd = Fd(handle);
+		if (fd < 0) {
+			return false;
+		}
+		std::lock_guard<std::mutex> lock(layouts_mutex_);
+		const Layout &layout = layouts_[(size_t)handle];
+		input_event e = {};
+		ssize_t bytes_read = 0;
+		while ((bytes_read = read(fd, &e, sizeof(e))) == (ssize_t)sizeof(e)) {
+			JoypadBackendEvent event;
+			if (e.type == EV_KEY && e.code < KEY_CNT && layout.buttons[e.code] >= 0 && e.value != 2) {
+				event.type = JoypadBackendEvent::Type::Button;
+				event.index = layout.buttons[e.code];
+				event.pressed = e.value != 0;
+			} else if (e.type == EV_ABS && e.code < ABS_CNT && layout.axes[e.code] >= 0) {
+				const input_absinfo &info = layout.ranges[e.code];
+				const double span = (double)info.maximum - (double)info.minimum;
+				event.type = JoypadBackendEvent::Type::Axis;
+				event.index = layout.axes[e.code];
+				const double position = span > 0.0 ? ((double)e.value - info.minimum) / span : 0.5;
+				event.value = std::clamp(2.0 * position - 1.0, -1.0, 1.0);
+				event.raw = (double)e.value;
+			} else if (e.type == EV_SYN && e.code == SYN_DROPPED) {
+				event.type = JoypadBackendEvent::Type::Dropped;
+			} else {
+				continue;
+			}
+			events.push_back(event);
+		}
+		return !Gone(bytes_read);
+	}
+
+protected:
+	bool Describe(int fd, const char *node, JoypadBackendDevice &device) override
+	{
+		unsigned long keys[KEY_CNT / (sizeof(unsigned long) * 8) + 1] = {};
+		if (ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keys)), keys) < 0 ||
+		    !(test_bit(keys, BTN_GAMEPAD) || test_bit(keys, BTN_JOYSTICK) || test_bit(keys, BTN_TRIGGER))) {
+			return false;
+		}
+		char name[128] = {};
+		if (ioctl(fd, EVIOCGNAME(sizeof(name)), name) < 0 || name[0] == '\0') {
+			snprintf(name, sizeof(name), "Gamepad %s", node);
+		}
+		char phys[128] = {};
+		ioctl(fd, EVIOCGPHYS(sizeof(phys)), phys);
+		input_id id = {};
+		ioctl(fd, EVIOCGID, &id);
+		char type_id[32];
+		snprintf(type_id, sizeof(type_id), "VID_%04X&PID_%04X", id.vendor, id.product);
+
+		device.id = std::string("evdev:") + node;
+		device.stable_id = phys[0] != '\0' ? std::string(phys) : device.id;
+		device.type_id = type_id;
+		device.name = name;
+		return true;
+	}
+
+	void Opened(int handle, int fd) override
+	{
+		Layout layout;
+		unsigned long keys[KEY_CNT / (sizeof(unsigned long) * 8) + 1] = {};
+		unsigned long abs[ABS_CNT / (sizeof(unsigned long) * 8) + 1] = {};
+		ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keys)), keys);
+		ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(abs)), abs);
+		int next = 0;
+		for (int code = BTN_JOYSTICK; code < KEY_CNT; ++code) {
+			if (test_bit(keys, code)) {
+				layout.buttons[code] = next++;
+			}
+		}
+		for (int code = BTN_MISC; code < BTN_JOYSTICK; ++code) {
+			if (test_bit(keys, code)) {
+				layout.buttons[code] = next++;
+			}
+		}
+		next = 0;
+		for (int code = 0; code < ABS_CNT; ++code) {
+			if (test_bit(abs, code) && ioctl(fd, EVIOCGABS(code), &layout.ranges[code]) >= 0) {
+				layout.axes[code] = next++;
+			}
+		}
+		std::lock_guard<std::mutex> lock(layouts_mutex_);
+		if ((size_t)handle >= layouts_.size()) {
+			layouts_.resize((size_t)handle + 1);
+		}
+		layouts_[(size_t)handle] = layout;
+	}
+
+private:
+	// Key / axis code -> button / axis number, -1 when the device lacks it.
+	struct Layout {
+		Layout()
+		{
+			std::fill(std::begin(buttons), std::end(buttons), (int16_t)-1);
+			std::fill(std::begin(axes), std::end(axes), (int16_t)-1);
+		}
+		int16_t buttons[KEY_CNT];
+		int16_t axes[ABS_CNT];
+		input_absinfo ranges[ABS_CNT] = {};
+	};
+
+	std::mutex layouts_mutex_;
+	std::vector<Layout> layouts_;
+};
+} // namespace
+
+std::unique_ptr<JoypadInputBackend> JoypadCreateJoydevBackend()
+{
+	return std::make_unique<JoydevBackend>();
+}
+
+std::unique_ptr<JoypadInputBackend> JoypadCreateEvdevBackend()
+{
+	return std::make_unique<EvdevBackend>();
+}
+#endif
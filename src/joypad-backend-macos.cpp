@@ -0,0 +1,289 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "joypad-backend.h"
+
+#if defined(__APPLE__)
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+
+#include <CoreFoundation/CoreFoundation.h>
+#include <IOKit/hid/IOHIDManager.h>
+
+namespace {
+int hid_int_property(IOHIDDeviceRef device, CFStringRef key)
+{
+	int value = 0;
+	CFTypeRef ref = IOHIDDeviceGetProperty(device, key);
+	if (ref && CFGetTypeID(ref) == CFNumberGetTypeID()) {
+		CFNumberGetValue((CFNumberRef)ref, kCFNumberIntType, &value);
+	}
+	return value;
+}
+
+// Axis number for a GenericDesktop usage, -1 for usages that aren't axes.
+int hid_axis_index(uint32_t usage)
+{
+	switch (usage) {
+	case kHIDUsage_GD_X:
+		return 0;
+	case kHIDUsage_GD_Y:
+		return 1;
+	case kHIDUsage_GD_Z:
+		return 2;
+	case kHIDUsage_GD_Rx:
+		return 3;
+	case kHIDUsage_GD_Ry:
+		return 4;
+	case kHIDUsage_GD_Rz:
+		return 5;
+	case kHIDUsage_GD_Slider:
+		return 6;
+	case kHIDUsage_GD_Dial:
+		return 7;
+	case kHIDUsage_GD_Wheel:
+		return 0;
+	default:
+		return -1;
+	}
+}
+
+// IOHIDManager reports devices and input through callbacks on the run loop that Wait() runs on
+// the poll thread; input is queued per open device until the next ReadBatch().
+class IOHIDBackend : public JoypadInputBackend {
+public:
+	~IOHIDBackend() override { Stop(); }
+
+	const char *Name() const override { return "iohid"; }
+
+	void Stop() override
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (manager_) {
+			IOHIDManagerClose(manager_, kIOHIDOptionsTypeNone);
+			CFRelease(manager_);
+			manager_ = nullptr;
+		}
+		devices_.clear();
+	}
+
+	void Enumerate(std::vector<JoypadBackendDevice> &devices) override
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (const auto &device : devices_) {
+			if (device.ref) {
+				devices.push_back(device.info);
+			}
+		}
+	}
+
+	int Open(const JoypadBackendDevice &device) override
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (size_t i = 0; i < devices_.size(); ++i) {
+			if (devices_[i].ref && !devices_[i].open && devices_[i].info.id == device.id) {
+				devices_[i].open = true;
+				return (int)i;
+			}
+		}
+		return -1;
+	}
+
+	void Close(int handle) override
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (handle >= 0 && handle < (int)devices_.size()) {
+			devices_[(size_t)handle].open = false;
+			devices_[(size_t)handle].queue.clear();
+		}
+	}
+
+	bool ReadBatch(int handle, std::vector<JoypadBackendEvent> &events) override
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (handle < 0 || handle >= (int)devices_.size() || !devices_[(size_t)handle].open) {
+			return false;
+		}
+		Device &device = devices_[(size_t)handle];
+		events.insert(events.end(), device.queue.begin(), device.queue.end());
+		device.queue.clear();
+		return device.ref != nullptr;
+	}
+
+	bool PollHotplug() override { return hotplug_.exchange(false); }
+
+	void Wait(std::chrono::milliseconds timeout) override
+	{
+		// Created here so it is scheduled on the poll thread's run loop.
+		if (!manager_ && !CreateManager()) {
+			JoypadInputBackend::Wait(timeout);
+			return;
+		}
+		CFRunLoopRunInMode(kCFRunLoopDefaultMode, (double)timeout.count() / 1000.0, true);
+	}
+
+private:
+	struct Device {
+		// nullptr once removed; the entry is reused after its handle is closed.
+		IOHIDDeviceRef ref = nullptr;
+		JoypadBackendDevice info;
+		bool open = false;
+		std::vector<JoypadBackendEvent> queue;
+	};
+
+	bool CreateManager()
+	{
+		IOHIDManagerRef manager = IOHIDManagerCreate(kCFAllocatorDefault, kIOHIDOptionsTypeNone);
+		if (!manager) {
+			return false;
+		}
+		IOHIDManagerSetDeviceMatching(manager, nullptr);
+		IOHIDManagerRegisterDeviceMatchingCallback(manager, &IOHIDBackend::DeviceMatched, this);
+		IOHIDManagerRegisterDeviceRemovalCallback(manager, &IOHIDBackend::DeviceRemoved, this);
+		IOHIDManagerRegisterInputValueCallback(manager, &IOHIDBackend::InputValue, this);
+		IOHIDManagerScheduleWithRunLoop(manager, CFRunLoopGetCurrent(), kCFRunLoopDefaultMode);
+		IOHIDManagerOpen(manager, kIOHIDOptionsTypeNone);
+		std::lock_guard<std::mutex> lock(mutex_);
+		manager_ = manager;
+		return true;
+	}
+
+	Device *FindLocked(IOHIDDeviceRef ref)
+	{
+		for (auto &device : devices_) {
+			if (device.ref == ref) {
+				return &device;
+			}
+		}
+		return nullptr;
+	}
+
+	static void DeviceMatched(void *context, IOReturn, void *, IOHIDDeviceRef ref)
+	{
+		auto *self = static_cast<IOHIDBackend *>(context);
+		if (!self || !ref) {
+			return;
+		}
+		char name[256] = "Gamepad";
+		CFStringRef name_ref = (CFStringRef)IOHIDDeviceGetProperty(ref, CFSTR(kIOHIDProductKey));
+		if (name_ref) {
+			CFStringGetCString(name_ref, name, sizeof(name), kCFStringEncodingUTF8);
+		}
+		const int vid = hid_int_property(ref, CFSTR(kIOHIDVendorIDKey));
+		const int pid = hid_int_property(ref, CFSTR(kIOHIDProductIDKey));
+		char type_id[32] = {};
+		snprintf(type_id, sizeof(type_id), "VID_%04X&PID_%04X", vid & 0xFFFF, pid & 0xFFFF);
+
+		JoypadBackendDevice info;
+		info.stable_id = "hid:" + std::to_string(vid) + ":" + std::to_string(pid);
+		info.type_id = type_id;
+		info.name = name;
+
+		std::lock_guard<std::mutex> lock(self->mutex_);
+		if (self->FindLocked(ref)) {
+			return;
+		}
+		// Identical devices share vendor and product; the second and later get "#n" ids so
+		// each keeps its own state.
+		info.id = info.stable_id;
+		for (int n = 2; std::any_of(self->devices_.begin(), self->devices_.end(),
+					    [&info](const Device &d) { return d.ref && d.info.id == info.id; });
+		     ++n) {
+			info.id = info.stable_id + "#" + std::to_string(n);
+		}
+		auto it = std::find_if(self->devices_.begin(), self->devices_.end(),
+				       [](const Device &d) { return !d.ref && !d.open; });
+		if (it == self->devices_.end()) {
+			it = self->devices_.insert(self->devices_.end(), Device{});
+		}
+		it->ref = ref;
+		it->info = std::move(info);
+		it->open = false;
+		it->queue.clear();
+		self->hotplug_.store(true);
+	}
+
+	static void DeviceRemoved(void *context, IOReturn, void *, IOHIDDeviceRef ref)
+	{
+		auto *self = static_cast<IOHIDBackend *>(context);
+		if (!self || !ref) {
+			return;
+		}
+		std::lock_guard<std::mutex> lock(self->mutex_);
+		if (Device *device = self->FindLocked(ref)) {
+			device->ref = nullptr;
+			self->hotplug_.store(true);
+		}
+	}
+
+	static void InputValue(void *context, IOReturn, void *, IOHIDValueRef value)
+	{
+		auto *self = static_cast<IOHIDBackend *>(context);
+		IOHIDElementRef element = value ? IOHIDValueGetElement(value) : nullptr;
+		if (!self || !element) {
+			return;
+		}
+		const uint32_t usage_page = IOHIDElementGetUsagePage(element);
+		const uint32_t usage = IOHIDElementGetUsage(element);
+		JoypadBackendEvent event;
+		if (usage_page == kHIDPage_Button) {
+			event.type = JoypadBackendEvent::Type::Button;
+			event.index = (int)usage - 1;
+			event.pressed = IOHIDValueGetIntegerValue(value) != 0;
+		} else if (usage_page == kHIDPage_GenericDesktop && hid_axis_index(usage) >= 0) {
+			const double scaled = IOHIDValueGetScaledValue(value, kIOHIDValueScaleTypeCalibrated);
+			const CFIndex min = IOHIDElementGetLogicalMin(element);
+			const CFIndex max = IOHIDElementGetLogicalMax(element);
+			double norm = 0.0;
+			if (max > min) {
+				norm = (scaled - min) / (double)(max - min) * 2.0 - 1.0;
+			}
+			event.type = JoypadBackendEvent::Type::Axis;
+			event.index = hid_axis_index(usage);
+			event.value = std::clamp(norm, -1.0, 1.0);
+			event.raw = (double)IOHIDValueGetIntegerValue(value);
+		} else {
+			return;
+		}
+
+		IOHIDDeviceRef ref = IOHIDElementGetDevice(element);
+		if (!ref) {
+			return;
+		}
+		std::lock_guard<std::mutex> lock(self->mutex_);
+		Device *device = self->FindLocked(ref);
+		if (device && device->open) {
+			device->queue.push_back(event);
+		}
+	}
+
+	std::mutex mutex_;
+	// Touched by Wait() on the poll thread, and by Stop() once that thread has exited.
+	IOHIDManagerRef manager_ = nullptr;
+	std::atomic<bool> hotplug_{false};
+	std::vector<Device> devices_;
+};
+} // namespace
+
+std::unique_ptr<JoypadInputBackend> JoypadCreateIOHIDBackend()
+{
+	return std::make_unique<IOHIDBackend>();
+}
+#endif
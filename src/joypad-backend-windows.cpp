@@ -0,0 +1,892 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "joypad-backend.h"
+
+#if defined(_WIN32)
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <windows.h>
+#include <dbt.h>
+#include <xinput.h>
+#define DIRECTINPUT_VERSION 0x0800
+#include <dinput.h>
+#include <wbemidl.h>
+
+namespace {
+constexpr int kAxes = 8;
+constexpr double kAxisCenterRawValue = 512.0;
+constexpr double kAxisCenterRawTolerance = 2.0;
+constexpr double kAxisCenterNormalizedTolerance = 0.01;
+constexpr double kAxisCenterSnapMinDelta = 100.0;
+constexpr int kAxisCenterSnapSuppressionThreshold = 2;
+
+struct DiControllerInfo {
+	IDirectInputDevice8W *device = nullptr;
+	std::string id;
+	std::string stable_id;
+	std::string type_id;
+	std::string name;
+};
+
+struct XInputApi {
+	HMODULE module = nullptr;
+	DWORD(WINAPI *get_state)(DWORD, XINPUT_STATE *) = nullptr;
+	DWORD(WINAPI *get_capabilities)(DWORD, DWORD, XINPUT_CAPABILITIES *) = nullptr;
+};
+
+struct XInputControllerInfo {
+	DWORD slot = 0;
+	std::string id;
+	std::string stable_id;
+	std::string type_id;
+	std::string name;
+};
+
+std::string wide_to_utf8(const wchar_t *wstr);
+
+XInputApi g_xinput_api;
+
+bool xinput_ready()
+{
+	return g_xinput_api.module != nullptr && g_xinput_api.get_state != nullptr;
+}
+
+void load_xinput_api()
+{
+	if (xinput_ready()) {
+		return;
+	}
+	const char *dlls[] = {"xinput1_4.dll", "xinput1_3.dll", "xinput9_1_0.dll"};
+	for (const char *dll_name : dlls) {
+		HMODULE mod = LoadLibraryA(dll_name);
+		if (!mod) {
+			continue;
+		}
+		auto fn_get_state = (DWORD(WINAPI *)(DWORD, XINPUT_STATE *))GetProcAddress(mod, "XInputGetState");
+		if (!fn_get_state) {
+			FreeLibrary(mod);
+			continue;
+		}
+		auto fn_get_caps = (DWORD(WINAPI *)(DWORD, DWORD,
+						    XINPUT_CAPABILITIES *))GetProcAddress(mod, "XInputGetCapabilities");
+		g_xinput_api.module = mod;
+		g_xinput_api.get_state = fn_get_state;
+		g_xinput_api.get_capabilities = fn_get_caps;
+		return;
+	}
+}
+
+void unload_xinput_api()
+{
+	if (g_xinput_api.module) {
+		FreeLibrary(g_xinput_api.module);
+	}
+	g_xinput_api = {};
+}
+
+std::string xinput_type_id(DWORD slot)
+{
+	if (!xinput_ready() || !g_xinput_api.get_capabilities) {
+		return "VID_045E&PID_XINPUT";
+	}
+	XINPUT_CAPABILITIES caps = {};
+	if (g_xinput_api.get_capabilities(slot, XINPUT_FLAG_GAMEPAD, &caps) != ERROR_SUCCESS) {
+		return "VID_045E&PID_XINPUT";
+	}
+	if (caps.SubType == XINPUT_DEVSUBTYPE_GAMEPAD) {
+		return "VID_045E&PID_XINPUT";
+	}
+	return "XINPUT_GAMEPAD";
+}
+
+std::vector<XInputControllerInfo> enumerate_xinput_controllers()
+{
+	std::vector<XInputControllerInfo> out;
+	if (!xinput_ready()) {
+		return out;
+	}
+	for (DWORD slot = 0; slot < XUSER_MAX_COUNT; ++slot) {
+		XINPUT_STATE state = {};
+		if (g_xinput_api.get_state(slot, &state) != ERROR_SUCCESS) {
+			continue;
+		}
+		XInputControllerInfo info;
+		info.slot = slot;
+		info.id = "xinput:" + std::to_string((unsigned long long)slot);
+		info.stable_id = info.id;
+		info.type_id = xinput_type_id(slot);
+		info.name = "Xbox Controller " + std::to_string((unsigned long long)(slot + 1));
+		out.push_back(std::move(info));
+	}
+	return out;
+}
+
+std::string to_upper_ascii(std::string text)
+{
+	std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return (char)std::toupper(c); });
+	return text;
+}
+
+bool extract_vid_pid(const std::string &text, uint16_t &vid_out, uint16_t &pid_out)
+{
+	std::string upper = to_upper_ascii(text);
+	size_t vid_pos = upper.find("VID_");
+	size_t pid_pos = upper.find("PID_");
+	if (vid_pos == std::string::npos || pid_pos == std::string::npos || vid_pos + 8 > upper.size() ||
+	    pid_pos + 8 > upper.size()) {
+		return false;
+	}
+	char *endp = nullptr;
+	unsigned long vid = strtoul(upper.substr(vid_pos + 4, 4).c_str(), &endp, 16);
+	if (!endp || *endp != '\0' || vid > 0xFFFF) {
+		return false;
+	}
+	unsigned long pid = strtoul(upper.substr(pid_pos + 4, 4).c_str(), &endp, 16);
+	if (!endp || *endp != '\0' || pid > 0xFFFF) {
+		return false;
+	}
+	vid_out = (uint16_t)vid;
+	pid_out = (uint16_t)pid;
+	return true;
+}
+
+std::unordered_set<uint32_t> query_xinput_vidpid_from_wmi()
+{
+	std::unordered_set<uint32_t> out;
+
+	HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+	const bool should_uninit = SUCCEEDED(hr);
+	if (FAILED(hr) && hr != RPC_E_CHANGED_MODE) {
+		return out;
+	}
+
+	hr = CoInitializeSecurity(nullptr, -1, nullptr, nullptr, RPC_C_AUTHN_LEVEL_DEFAULT, RPC_C_IMP_LEVEL_IMPERSONATE,
+				  nullptr, EOAC_NONE, nullptr);
+	if (FAILED(hr) && hr != RPC_E_TOO_LATE) {
+		if (should_uninit) {
+			CoUninitialize();
+		}
+		return out;
+	}
+
+	IWbemLocator *locator = nullptr;
+	hr = CoCreateInstance(CLSID_WbemLocator, nullptr, CLSCTX_INPROC_SERVER, IID_IWbemLocator,
+			      reinterpret_cast<void **>(&locator));
+	if (FAILED(hr) || !locator) {
+		if (should_uninit) {
+			CoUninitialize();
+		}
+		return out;
+	}
+
+	IWbemServices *services = nullptr;
+	BSTR ns = SysAllocString(L"ROOT\\CIMV2");
+	hr = locator->ConnectServer(ns, nullptr, nullptr, nullptr, 0, nullptr, nullptr, &services);
+	SysFreeString(ns);
+	if (FAILED(hr) || !services) {
+		locator->Release();
+		if (should_uninit) {
+			CoUninitialize();
+		}
+		return out;
+	}
+
+	hr = CoSetProxyBlanket(services, RPC_C_AUTHN_WINNT, RPC_C_AUTHZ_NONE, nullptr, RPC_C_AUTHN_LEVEL_CALL,
+			       RPC_C_IMP_LEVEL_IMPERSONATE, nullptr, EOAC_NONE);
+	if (FAILED(hr)) {
+		services->Release();
+		locator->Release();
+		if (should_uninit) {
+			CoUninitialize();
+		}
+		return out;
+	}
+
+	IEnumWbemClassObject *enumerator = nullptr;
+	BSTR lang = SysAllocString(L"WQL");
+	BSTR query = SysAllocString(L"SELECT DeviceID FROM Win32_PNPEntity WHERE DeviceID LIKE '%IG_%'");
+	hr = services->ExecQuery(lang, query, WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY, nullptr,
+				 &enumerator);
+	SysFreeString(query);
+	SysFreeString(lang);
+	if (SUCCEEDED(hr) && enumerator) {
+		while (true) {
+			IWbemClassObject *obj = nullptr;
+			ULONG ret = 0;
+			hr = enumerator->Next(200, 1, &obj, &ret);
+			if (FAILED(hr) || ret == 0 || !obj) {
+				break;
+			}
+
+			VARIANT var;
+			VariantInit(&var);
+			HRESULT get_hr = obj->Get(L"DeviceID", 0, &var, nullptr, nullptr);
+			if (SUCCEEDED(get_hr) && var.vt == VT_BSTR && var.bstrVal) {
+				std::string device_id = wide_to_utf8(var.bstrVal);
+				uint16_t vid = 0;
+				uint16_t pid = 0;
+				if (extract_vid_pid(device_id, vid, pid)) {
+					out.insert((uint32_t)MAKELONG(vid, pid));
+				}
+			}
+			VariantClear(&var);
+			obj->Release();
+		}
+		enumerator->Release();
+	}
+
+	services->Release();
+	locator->Release();
+	if (should_uninit) {
+		CoUninitialize();
+	}
+	return out;
+}
+
+bool is_xinput_vidpid(uint16_t vid, uint16_t pid)
+{
+	static std::once_flag once;
+	static std::unordered_set<uint32_t> xinput_vidpid;
+	std::call_once(once, []() { xinput_vidpid = query_xinput_vidpid_from_wmi(); });
+	return xinput_vidpid.find((uint32_t)MAKELONG(vid, pid)) != xinput_vidpid.end();
+}
+
+bool is_xinput_shadow_device(const DiControllerInfo &di_info, const std::vector<XInputControllerInfo> &xinput_infos)
+{
+	if (xinput_infos.empty()) {
+		return false;
+	}
+
+	uint16_t vid = 0;
+	uint16_t pid = 0;
+	if (extract_vid_pid(di_info.type_id, vid, pid) && is_xinput_vidpid(vid, pid)) {
+		return true;
+	}
+
+	std::string name_up = to_upper_ascii(di_info.name);
+	if (name_up.find("XBOX") != std::string::npos || name_up.find("XINPUT") != std::string::npos) {
+		return true;
+	}
+	return false;
+}
+
+double xinput_normalize_thumb(short v)
+{
+	if (v >= 0) {
+		return std::clamp((double)v / 32767.0, 0.0, 1.0);
+	}
+	return std::clamp((double)v / 32768.0, -1.0, 0.0);
+}
+
+void xinput_read_buttons_axes(const XINPUT_STATE &state, uint32_t &buttons_out,
+			      std::array<double, kAxes> &axes_out)
+{
+	buttons_out = 0;
+	const WORD b = state.Gamepad.wButtons;
+	if (b & XINPUT_GAMEPAD_A)
+		buttons_out |= (1u << 0);
+	if (b & XINPUT_GAMEPAD_B)
+		buttons_out |= (1u << 1);
+	if (b & XINPUT_GAMEPAD_X)
+		buttons_out |= (1u << 2);
+	if (b & XINPUT_GAMEPAD_Y)
+		buttons_out |= (1u << 3);
+	if (b & XINPUT_GAMEPAD_LEFT_SHOULDER)
+		buttons_out |= (1u << 4);
+	if (b & XINPUT_GAMEPAD_RIGHT_SHOULDER)
+		buttons_out |= (1u << 5);
+	if (b & XINPUT_GAMEPAD_BACK)
+		buttons_out |= (1u << 6);
+	if (b & XINPUT_GAMEPAD_START)
+		buttons_out |= (1u << 7);
+	if (b & XINPUT_GAMEPAD_LEFT_THUMB)
+		buttons_out |= (1u << 8);
+	if (b & XINPUT_GAMEPAD_RIGHT_THUMB)
+		buttons_out |= (1u << 9);
+	if (b & XINPUT_GAMEPAD_DPAD_UP)
+		buttons_out |= (1u << 10);
+	if (b & XINPUT_GAMEPAD_DPAD_DOWN)
+		buttons_out |= (1u << 11);
+	if (b & XINPUT_GAMEPAD_DPAD_LEFT)
+		buttons_out |= (1u << 12);
+	if (b & XINPUT_GAMEPAD_DPAD_RIGHT)
+		buttons_out |= (1u << 13);
+
+	axes_out[0] = xinput_normalize_thumb(state.Gamepad.sThumbLX);
+	axes_out[1] = xinput_normalize_thumb(state.Gamepad.sThumbLY);
+	axes_out[2] = xinput_normalize_thumb(state.Gamepad.sThumbRX);
+	axes_out[3] = xinput_normalize_thumb(state.Gamepad.sThumbRY);
+	axes_out[4] = std::clamp((double)state.Gamepad.bLeftTrigger / 255.0, 0.0, 1.0);
+	axes_out[5] = std::clamp((double)state.Gamepad.bRightTrigger / 255.0, 0.0, 1.0);
+	axes_out[6] = 0.0;
+	axes_out[7] = 0.0;
+}
+
+std::string wide_to_utf8(const wchar_t *wstr)
+{
+	if (!wstr || !*wstr) {
+		return {};
+	}
+	int len = WideCharToMultiByte(CP_UTF8, 0, wstr, -1, nullptr, 0, nullptr, nullptr);
+	if (len <= 0) {
+		return {};
+	}
+	std::vector<char> out((size_t)len);
+	WideCharToMultiByte(CP_UTF8, 0, wstr, -1, out.data(), len, nullptr, nullptr);
+	return std::string(out.data());
+}
+
+std::string guid_to_string(const GUID &guid)
+{
+	char buf[64] = {};
+	snprintf(buf, sizeof(buf), "%08lX-%04hX-%04hX-%02hhX%02hhX-%02hhX%02hhX%02hhX%02hhX%02hhX%02hhX",
+		 (unsigned long)guid.Data1, guid.Data2, guid.Data3, guid.Data4[0], guid.Data4[1], guid.Data4[2],
+		 guid.Data4[3], guid.Data4[4], guid.Data4[5], guid.Data4[6], guid.Data4[7]);
+	return std::string(buf);
+}
+
+std::string dinput_type_id(const GUID &product_guid)
+{
+	uint16_t vid = LOWORD(product_guid.Data1);
+	uint16_t pid = HIWORD(product_guid.Data1);
+	if (vid != 0 || pid != 0) {
+		char buf[32] = {};
+		snprintf(buf, sizeof(buf), "VID_%04X&PID_%04X", vid, pid);
+		return std::string(buf);
+	}
+	return "DINPUT_" + guid_to_string(product_guid);
+}
+
+BOOL CALLBACK enum_axis_callback(const DIDEVICEOBJECTINSTANCEW *instance, void *context)
+{
+	(void)instance;
+	auto *device = static_cast<IDirectInputDevice8W *>(context);
+	if (!device) {
+		return DIENUM_CONTINUE;
+	}
+	DIPROPRANGE range = {};
+	range.diph.dwSize = sizeof(DIPROPRANGE);
+	range.diph.dwHeaderSize = sizeof(DIPROPHEADER);
+	range.diph.dwObj = instance->dwType;
+	range.diph.dwHow = DIPH_BYID;
+	range.lMin = -1000;
+	range.lMax = 1000;
+	device->SetProperty(DIPROP_RANGE, &range.diph);
+	return DIENUM_CONTINUE;
+}
+
+struct EnumContext {
+	IDirectInput8W *dinput = nullptr;
+	HWND hwnd = nullptr;
+	std::vector<DiControllerInfo> *out = nullptr;
+};
+
+BOOL CALLBACK enum_device_callback(const DIDEVICEINSTANCEW *instance, void *context_ptr)
+{
+	auto *context = static_cast<EnumContext *>(context_ptr);
+	if (!context || !context->dinput || !context->out) {
+		return DIENUM_STOP;
+	}
+
+	IDirectInputDevice8W *device = nullptr;
+	if (FAILED(context->dinput->CreateDevice(instance->guidInstance, &device, nullptr)) || !device) {
+		return DIENUM_CONTINUE;
+	}
+
+	if (FAILED(device->SetDataFormat(&c_dfDIJoystick2))) {
+		device->Release();
+		return DIENUM_CONTINUE;
+	}
+
+	if (FAILED(device->SetCooperativeLevel(context->hwnd, DISCL_BACKGROUND | DISCL_NONEXCLUSIVE))) {
+		device->Release();
+		return DIENUM_CONTINUE;
+	}
+
+	device->EnumObjects(enum_axis_callback, device, DIDFT_AXIS);
+	device->Acquire();
+
+	DiControllerInfo info;
+	info.device = device;
+	info.id = "dinput:" + guid_to_string(instance->guidInstance);
+	info.stable_id = info.id;
+	info.type_id = dinput_type_id(instance->guidProduct);
+	info.name = wide_to_utf8(instance->tszProductName);
+	if (info.name.empty()) {
+		info.name = wide_to_utf8(instance->tszInstanceName);
+	}
+	if (info.name.empty()) {
+		info.name = "Controller";
+	}
+	context->out->push_back(std::move(info));
+
+	return DIENUM_CONTINUE;
+}
+
+HWND create_input_window()
+{
+	static const wchar_t *kClassName = L"JoypadToOBSDeviceNotifyWindow";
+	static bool class_registered = false;
+	HINSTANCE hinst = GetModuleHandleW(nullptr);
+
+	if (!class_registered) {
+		WNDCLASSW wc = {};
+		wc.lpfnWndProc = [](HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam) -> LRESULT {
+			switch (msg) {
+			case WM_NCCREATE: {
+				CREATESTRUCTW *cs = reinterpret_cast<CREATESTRUCTW *>(lparam);
+				SetWindowLongPtrW(hwnd, GWLP_USERDATA, (LONG_PTR)cs->lpCreateParams);
+				return TRUE;
+			}
+			case WM_DEVICECHANGE: {
+				if (wparam == DBT_DEVICEARRIVAL || wparam == DBT_DEVICEREMOVECOMPLETE ||
+				    wparam == DBT_DEVNODES_CHANGED) {
+					auto *flag = reinterpret_cast<std::atomic<bool> *>(
+						GetWindowLongPtrW(hwnd, GWLP_USERDATA));
+					if (flag) {
+						flag->store(true);
+					}
+				}
+				return 0;
+			}
+			default:
+				break;
+			}
+			return DefWindowProcW(hwnd, msg, wparam, lparam);
+		};
+		wc.hInstance = hinst;
+		wc.lpszClassName = kClassName;
+		class_registered = (RegisterClassW(&wc) != 0);
+	}
+
+	if (!class_registered) {
+		return nullptr;
+	}
+
+	HWND hwnd = CreateWindowExW(0, kClassName, L"joypad-to-obs-device-notify", WS_POPUP, 0, 0, 1, 1, nullptr,
+				    nullptr, hinst, nullptr);
+	return hwnd;
+}
+
+std::vector<DiControllerInfo> enumerate_dinput_controllers(IDirectInput8W *dinput, HWND hwnd)
+{
+	std::vector<DiControllerInfo> out;
+	if (!dinput || !hwnd) {
+		return out;
+	}
+	EnumContext context;
+	context.dinput = dinput;
+	context.hwnd = hwnd;
+	context.out = &out;
+	dinput->EnumDevices(DI8DEVCLASS_GAMECTRL, enum_device_callback, &context, DIEDFL_ATTACHEDONLY);
+	std::sort(out.begin(), out.end(),
+		  [](const DiControllerInfo &a, const DiControllerInfo &b) { return a.id < b.id; });
+	return out;
+}
+
+double axis_raw(double normalized)
+{
+	return ((normalized + 1.0) * 0.5) * 1024.0;
+}
+
+// XInput pads plus every other DirectInput game controller. Both APIs report state rather than
+// events, so each read is diffed against the previous one; WM_DEVICECHANGE drives hotplug.
+class DirectInputBackend : public JoypadInputBackend {
+public:
+	~DirectInputBackend() override { Stop(); }
+
+	const char *Name() const override { return "dinput"; }
+
+	void Start(void *native_window) override
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		device_change_pending_.store(false);
+		load_xinput_api();
+		notify_hwnd_ = create_input_window();
+		if (notify_hwnd_) {
+			SetWindowLongPtrW(notify_hwnd_, GWLP_USERDATA, (LONG_PTR)&device_change_pending_);
+
+			DEV_BROADCAST_DEVICEINTERFACE_W filter = {};
+			filter.dbcc_size = sizeof(filter);
+			filter.dbcc_devicetype = DBT_DEVTYP_DEVICEINTERFACE;
+			filter.dbcc_classguid = {0x4D1E55B2, 0xF16F, 0x11CF,
+						 {0x88, 0xCB, 0x00, 0x11, 0x11, 0x00, 0x00, 0x30}};
+			devnotify_ = RegisterDeviceNotificationW(notify_hwnd_, &filter, DEVICE_NOTIFY_WINDOW_HANDLE);
+		}
+
+		HWND coop_hwnd = native_window ? static_cast<HWND>(native_window) : notify_hwnd_;
+		if (coop_hwnd) {
+			IDirectInput8W *dinput = nullptr;
+			HINSTANCE hinst = GetModuleHandleW(nullptr);
+			if (SUCCEEDED(DirectInput8Create(hinst, DIRECTINPUT_VERSION, IID_IDirectInput8W,
+							 reinterpret_cast<void **>(&dinput), nullptr)) &&
+			    dinput) {
+				dinput_ = dinput;
+				coop_hwnd_ = coop_hwnd;
+			}
+		}
+	}
+
+	void Stop() override
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (auto &device : devices_) {
+			ReleaseDevice(device.di_device);
+		}
+		devices_.clear();
+		ReleasePendingLocked();
+		if (dinput_) {
+			dinput_->Release();
+			dinput_ = nullptr;
+		}
+		unload_xinput_api();
+		if (devnotify_) {
+			UnregisterDeviceNotification(devnotify_);
+			devnotify_ = nullptr;
+		}
+		if (notify_hwnd_) {
+			DestroyWindow(notify_hwnd_);
+			notify_hwnd_ = nullptr;
+		}
+		coop_hwnd_ = nullptr;
+	}
+
+	void Enumerate(std::vector<JoypadBackendDevice> &devices) override
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		ReleasePendingLocked();
+		if (!dinput_ || !coop_hwnd_) {
+			return;
+		}
+		const auto xinput_controllers = enumerate_xinput_controllers();
+		for (const auto &xinfo : xinput_controllers) {
+			devices.push_back(Describe(xinfo.id, xinfo.stable_id, xinfo.type_id, xinfo.name));
+		}
+		for (auto &controller : enumerate_dinput_controllers(dinput_, coop_hwnd_)) {
+			if (is_xinput_shadow_device(controller, xinput_controllers)) {
+				ReleaseDevice(controller.device);
+				continue;
+			}
+			devices.push_back(Describe(controller.id, controller.stable_id, controller.type_id,
+						   controller.name));
+			// An open device keeps the object it was opened with; the fresh one is only
+			// needed if Open() follows.
+			if (FindOpenLocked(controller.id)) {
+				ReleaseDevice(controller.device);
+			} else {
+				pending_[controller.id] = controller.device;
+			}
+		}
+	}
+
+	int Open(const JoypadBackendDevice &device) override
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		Device opened;
+		opened.open = true;
+		opened.id = device.id;
+		if (device.id.rfind("xinput:", 0) == 0) {
+			opened.xinput = true;
+			opened.xinput_slot = (DWORD)strtoul(device.id.c_str() + strlen("xinput:"), nullptr, 10);
+		} else {
+			auto it = pending_.find(device.id);
+			if (it == pending_.end()) {
+				return -1;
+			}
+			opened.di_device = it->second;
+			pending_.erase(it);
+		}
+		auto it = std::find_if(devices_.begin(), devices_.end(), [](const Device &d) { return !d.open; });
+		if (it == devices_.end()) {
+			it = devices_.insert(devices_.end(), Device{});
+		}
+		*it = opened;
+		return (int)(it - devices_.begin());
+	}
+
+	void Close(int handle) override
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (handle >= 0 && handle < (int)devices_.size() && devices_[(size_t)handle].open) {
+			ReleaseDevice(devices_[(size_t)handle].di_device);
+			devices_[(size_t)handle] = Device{};
+		}
+	}
+
+	bool ReadBatch(int handle, std::vector<JoypadBackendEvent> &events) override
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (handle < 0 || handle >= (int)devices_.size() || !devices_[(size_t)handle].open) {
+			return false;
+		}
+		Device &device = devices_[(size_t)handle];
+		uint32_t buttons = 0;
+		std::array<double, kAxes> axes = {};
+		int axis_count = kAxes;
+		uint32_t button_count = 20;
+		// Removal is reported through WM_DEVICECHANGE, so failed reads keep the device open.
+		if (device.xinput) {
+			XINPUT_STATE xstate = {};
+			if (!xinput_ready() || g_xinput_api.get_state(device.xinput_slot, &xstate) != ERROR_SUCCESS) {
+				return true;
+			}
+			axis_count = 6;
+			button_count = 14;
+			xinput_read_buttons_axes(xstate, buttons, axes);
+		} else if (!ReadDirectInput(device, buttons, axes, events)) {
+			return true;
+		}
+
+		if (device.lost) {
+			// Back after input loss: take the current state as the baseline.
+			device.lost = false;
+			device.buttons = buttons;
+			for (uint32_t bit = 0; bit < button_count; ++bit) {
+				if (buttons & (1u << bit)) {
+					JoypadBackendEvent event;
+					event.type = JoypadBackendEvent::Type::Button;
+					event.index = (int)bit;
+					event.pressed = true;
+					event.sync = true;
+					events.push_back(event);
+				}
+			}
+			for (int i = 0; i < axis_count; ++i) {
+				device.raw[(size_t)i] = axis_raw(axes[(size_t)i]);
+				events.push_back(AxisEvent(i, axes[(size_t)i], device.raw[(size_t)i], true));
+			}
+			device.axes_seen = true;
+			return true;
+		}
+
+		// Releases, then presses, one bit at a time so every event carries the pressed set as
+		// it was right after that edge.
+		const uint32_t released = device.buttons & ~buttons;
+		const uint32_t pressed = buttons & ~device.buttons;
+		for (int pass = 0; pass < 2 && (released | pressed) != 0; ++pass) {
+			const uint32_t edges = pass == 0 ? released : pressed;
+			for (uint32_t bit = 0; bit < button_count && edges; ++bit) {
+				if ((edges & (1u << bit)) == 0) {
+					continue;
+				}
+				JoypadBackendEvent event;
+				event.type = JoypadBackendEvent::Type::Button;
+				event.index = (int)bit;
+				event.pressed = pass == 1;
+				events.push_back(event);
+			}
+		}
+		device.buttons = buttons;
+
+		if (!device.xinput && device.axes_seen && CenterSnapLocked(device, axes, axis_count)) {
+			return true;
+		}
+		// Every axis every read: the manager drops unchanged ones and repeats held ones.
+		for (int i = 0; i < axis_count; ++i) {
+			device.raw[(size_t)i] = axis_raw(axes[(size_t)i]);
+			events.push_back(AxisEvent(i, axes[(size_t)i], device.raw[(size_t)i], false));
+		}
+		device.axes_seen = true;
+		return true;
+	}
+
+	bool PollHotplug() override
+	{
+		HWND hwnd = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			hwnd = notify_hwnd_;
+		}
+		if (hwnd) {
+			MSG msg;
+			while (PeekMessageW(&msg, hwnd, 0, 0, PM_REMOVE)) {
+				TranslateMessage(&msg);
+				DispatchMessageW(&msg);
+			}
+		}
+		return device_change_pending_.exchange(false);
+	}
+
+private:
+	struct Device {
+		bool open = false;
+		std::string id;
+		bool xinput = false;
+		DWORD xinput_slot = 0;
+		IDirectInputDevice8W *di_device = nullptr;
+		// Input was lost; the next good read is reported as a sync.
+		bool lost = false;
+		bool axes_seen = false;
+		uint32_t buttons = 0;
+		std::array<double, kAxes> raw = {};
+	};
+
+	static JoypadBackendDevice Describe(const std::string &id, const std::string &stable_id,
+					    const std::string &type_id, const std::string &name)
+	{
+		JoypadBackendDevice device;
+		device.id = id;
+		device.stable_id = stable_id;
+		device.type_id = type_id;
+		device.name = name;
+		return device;
+	}
+
+	static JoypadBackendEvent AxisEvent(int index, double value, double raw, bool sync)
+	{
+		JoypadBackendEvent event;
+		event.type = JoypadBackendEvent::Type::Axis;
+		event.index = index;
+		event.value = value;
+		event.raw = raw;
+		event.sync = sync;
+		return event;
+	}
+
+	static void ReleaseDevice(IDirectInputDevice8W *device)
+	{
+		if (device) {
+			device->Unacquire();
+			device->Release();
+		}
+	}
+
+	void MarkLost(Device &device, std::vector<JoypadBackendEvent> &events)
+	{
+		if (!device.lost) {
+			device.lost = true;
+			JoypadBackendEvent event;
+			event.type = JoypadBackendEvent::Type::Lost;
+			events.push_back(event);
+		}
+	}
+
+	bool ReadDirectInput(Device &device, uint32_t &buttons, std::array<double, kAxes> &axes,
+			     std::vector<JoypadBackendEvent> &events)
+	{
+		IDirectInputDevice8W *dev = device.di_device;
+		HRESULT hr = dev->Poll();
+		if (FAILED(hr)) {
+			MarkLost(device, events);
+			hr = dev->Acquire();
+			// Avoid infinite loops when device is unplugged/lost.
+			for (int tries = 0; hr == DIERR_INPUTLOST && tries < 8; ++tries) {
+				hr = dev->Acquire();
+			}
+			hr = dev->Poll();
+		}
+		if (FAILED(hr)) {
+			return false;
+		}
+
+		DIJOYSTATE2 js = {};
+		if (FAILED(dev->GetDeviceState(sizeof(js), &js))) {
+			MarkLost(device, events);
+			return false;
+		}
+
+		for (uint32_t i = 0; i < 16; ++i) {
+			if (js.rgbButtons[i] & 0x80) {
+				buttons |= (1u << i);
+			}
+		}
+
+		DWORD pov = js.rgdwPOV[0];
+		if (LOWORD(pov) != 0xFFFF) {
+			if (pov <= 4500 || pov >= 31500)
+				buttons |= (1u << 16); // up
+			if (pov >= 4500 && pov <= 13500)
+				buttons |= (1u << 17); // right
+			if (pov >= 13500 && pov <= 22500)
+				buttons |= (1u << 18); // down
+			if (pov >= 22500 && pov <= 31500)
+				buttons |= (1u << 19); // left
+		}
+
+		axes[0] = std::clamp((double)js.lX / 1000.0, -1.0, 1.0);
+		axes[1] = std::clamp((double)js.lY / 1000.0, -1.0, 1.0);
+		axes[2] = std::clamp((double)js.lZ / 1000.0, -1.0, 1.0);
+		axes[3] = std::clamp((double)js.lRx / 1000.0, -1.0, 1.0);
+		axes[4] = std::clamp((double)js.lRy / 1000.0, -1.0, 1.0);
+		axes[5] = std::clamp((double)js.lRz / 1000.0, -1.0, 1.0);
+		axes[6] = std::clamp((double)js.rglSlider[0] / 1000.0, -1.0, 1.0);
+		axes[7] = std::clamp((double)js.rglSlider[1] / 1000.0, -1.0, 1.0);
+		return true;
+	}
+
+	// Some DirectInput drivers briefly report every axis centered; several axes jumping to
+	// the center at once is treated as a glitch and the reading is skipped.
+	static bool CenterSnapLocked(const Device &device, const std::array<double, kAxes> &axes, int axis_count)
+	{
+		int centered_snap_count = 0;
+		for (int i = 0; i < axis_count; ++i) {
+			const double normalized = axes[(size_t)i];
+			const double raw = axis_raw(normalized);
+			const bool near_center = std::fabs(raw - kAxisCenterRawValue) <= kAxisCenterRawTolerance &&
+						 std::fabs(normalized) <= kAxisCenterNormalizedTolerance;
+			const bool snapped_from_far = std::fabs(device.raw[(size_t)i] - kAxisCenterRawValue) >=
+						      kAxisCenterSnapMinDelta;
+			if (near_center && snapped_from_far) {
+				++centered_snap_count;
+			}
+		}
+		return centered_snap_count >= kAxisCenterSnapSuppressionThreshold;
+	}
+
+	bool FindOpenLocked(const std::string &id) const
+	{
+		return std::any_of(devices_.begin(), devices_.end(),
+				   [&id](const Device &device) { return device.open && device.id == id; });
+	}
+
+	void ReleasePendingLocked()
+	{
+		for (auto &entry : pending_) {
+			ReleaseDevice(entry.second);
+		}
+		pending_.clear();
+	}
+
+	std::mutex mutex_;
+	IDirectInput8W *dinput_ = nullptr;
+	HWND coop_hwnd_ = nullptr;
+	HWND notify_hwnd_ = nullptr;
+	HDEVNOTIFY devnotify_ = nullptr;
+	std::atomic<bool> device_change_pending_{false};
+	// Devices created by the last Enumerate() and not yet opened, by id.
+	std::unordered_map<std::string, IDirectInputDevice8W *> pending_;
+	std::vector<Device> devices_;
+};
+} // namespace
+
+std::unique_ptr<JoypadInputBackend> JoypadCreateDirectInputBackend()
+{
+	return std::make_unique<DirectInputBackend>();
+}
+#endif
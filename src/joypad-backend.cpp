@@ -0,0 +1,199 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "joypad-backend.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#if defined(__linux__)
+std::unique_ptr<JoypadInputBackend> JoypadCreateJoydevBackend();
+std::unique_ptr<JoypadInputBackend> JoypadCreateEvdevBackend();
+#elif defined(_WIN32)
+std::unique_ptr<JoypadInputBackend> JoypadCreateDirectInputBackend();
+#elif defined(__APPLE__)
+std::unique_ptr<JoypadInputBackend> JoypadCreateIOHIDBackend();
+#endif
+
+namespace {
+constexpr int kSyntheticButtons = 16;
+constexpr int kSyntheticAxes = 6;
+
+// Devices that press buttons and sweep axes at a fixed average rate, for load tests. Three
+// events in four are button edges; the rest move one axis along a sine.
+class SyntheticBackend : public JoypadInputBackend {
+public:
+	SyntheticBackend(int devices, double events_per_second, uint32_t seed)
+		: rate_(std::max(events_per_second, 0.0)),
+		  rng_(seed)
+	{
+		slots_.resize((size_t)std::max(devices, 0));
+	}
+
+	const char *Name() const override { return "synthetic"; }
+
+	void Enumerate(std::vector<JoypadBackendDevice> &devices) override
+	{
+		for (size_t i = 0; i < slots_.size(); ++i) {
+			char type_id[32];
+			snprintf(type_id, sizeof(type_id), "VID_FFFF&PID_%04X", (unsigned)i);
+			JoypadBackendDevice device;
+			device.id = "synthetic:" + std::to_string(i);
+			device.stable_id = "synthetic-" + std::to_string(i);
+			device.type_id = type_id;
+			device.name = "Synthetic Pad " + std::to_string(i + 1);
+			devices.push_back(std::move(device));
+		}
+	}
+
+	int Open(const JoypadBackendDevice &device) override
+	{
+		const int index = atoi(device.id.c_str() + device.id.find(':') + 1);
+		if (index < 0 || index >= (int)slots_.size()) {
+			return -1;
+		}
+		std::lock_guard<std::mutex> lock(mutex_);
+		Slot &slot = slots_[(size_t)index];
+		slot = Slot{};
+		slot.open = true;
+		slot.last_read = Clock::now();
+		return index;
+	}
+
+	void Close(int handle) override
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (handle >= 0 && handle < (int)slots_.size()) {
+			slots_[(size_t)handle].open = false;
+		}
+	}
+
+	bool ReadBatch(int handle, std::vector<JoypadBackendEvent> &events) override
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (handle < 0 || handle >= (int)slots_.size() || !slots_[(size_t)handle].open) {
+			return false;
+		}
+		Slot &slot = slots_[(size_t)handle];
+		const auto now = Clock::now();
+		// Owed events are capped at one second's worth, so a stalled reader doesn't get a burst.
+		const double elapsed = std::chrono::duration<double>(now - slot.last_read).count();
+		slot.last_read = now;
+		slot.owed = std::min(slot.owed + elapsed * rate_, std::max(rate_, 1.0));
+		std::uniform_int_distribution<int> percent(0, 99);
+		std::uniform_int_distribution<int> button(0, kSyntheticButtons - 1);
+		std::uniform_int_distribution<int> axis(0, kSyntheticAxes - 1);
+		for (; slot.owed >= 1.0; slot.owed -= 1.0) {
+			JoypadBackendEvent event;
+			if (percent(rng_) < 75) {
+				event.type = JoypadBackendEvent::Type::Button;
+				event.index = button(rng_);
+				slot.buttons ^= 1u << event.index;
+				event.pressed = (slot.buttons & (1u << event.index)) != 0;
+			} else {
+				event.type = JoypadBackendEvent::Type::Axis;
+				event.index = axis(rng_);
+				slot.phase[event.index] += 0.05;
+				event.value = std::sin(slot.phase[event.index]);
+				event.raw = event.value * 32767.0;
+			}
+			events.push_back(event);
+		}
+		return true;
+	}
+
+	bool PollHotplug() override { return false; }
+
+	void Wait(std::chrono::milliseconds timeout) override
+	{
+		std::this_thread::sleep_for(std::min(timeout, std::chrono::milliseconds(1)));
+	}
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Slot {
+		bool open = false;
+		Clock::time_point last_read = {};
+		double owed = 0.0;
+		uint32_t buttons = 0;
+		double phase[kSyntheticAxes] = {};
+	};
+
+	std::mutex mutex_;
+	double rate_ = 0.0;
+	std::mt19937 rng_;
+	std::vector<Slot> slots_;
+};
+} // namespace
+
+void JoypadInputBackend::Wait(std::chrono::milliseconds timeout)
+{
+	std::this_thread::sleep_for(timeout);
+}
+
+std::unique_ptr<JoypadInputBackend> JoypadCreateSyntheticBackend(int devices, double events_per_second, uint32_t seed)
+{
+	return std::make_unique<SyntheticBackend>(devices, events_per_second, seed);
+}
+
+std::unique_ptr<JoypadInputBackend> JoypadCreateInputBackend(const std::string &spec)
+{
+	const std::string kind = spec.substr(0, spec.find(':'));
+	if (kind == "synthetic") {
+		int devices = 4;
+		double rate = 100.0;
+		sscanf(spec.c_str(), "synthetic:%d:%lf", &devices, &rate);
+		return JoypadCreateSyntheticBackend(devices, rate);
+	}
+#if defined(__linux__)
+	if (kind == "joydev") {
+		return JoypadCreateJoydevBackend();
+	}
+	if (kind == "evdev") {
+		return JoypadCreateEvdevBackend();
+	}
+#elif defined(_WIN32)
+	if (kind == "dinput") {
+		return JoypadCreateDirectInputBackend();
+	}
+#elif defined(__APPLE__)
+	if (kind == "iohid") {
+		return JoypadCreateIOHIDBackend();
+	}
+#endif
+	return nullptr;
+}
+
+std::unique_ptr<JoypadInputBackend> JoypadCreateDefaultInputBackend()
+{
+#if defined(__linux__)
+	return JoypadCreateJoydevBackend();
+#elif defined(_WIN32)
+	return JoypadCreateDirectInputBackend();
+#elif defined(__APPLE__)
+	return JoypadCreateIOHIDBackend();
+#else
+	return nullptr;
+#endif
+}
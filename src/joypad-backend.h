@@ -0,0 +1,93 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct JoypadBackendDevice {
+	std::string id;
+	std::string stable_id;
+	std::string type_id;
+	std::string name;
+};
+
+struct JoypadBackendEvent {
+	enum class Type : uint8_t {
+		Button = 0,
+		Axis = 1,
+		// The device lost input before this point (evdev SYN_DROPPED); no other fields.
+		Dropped = 2,
+		// The device stopped answering but is still attached (DirectInput input loss). It reads
+		// as disconnected until the backend reports its state again; no other fields.
+		Lost = 3,
+	};
+	Type type = Type::Button;
+	// Zero-based button or axis number.
+	int index = 0;
+	bool pressed = false;
+	// Axes: value normalized to [-1, 1], and the backend's own reading.
+	double value = 0.0;
+	double raw = 0.0;
+	// Buttons and axes: state found when input resumed after Lost, recorded without dispatching.
+	bool sync = false;
+};
+
+// Source of devices and their input for JoypadInputManager. The manager enumerates on start
+// and whenever PollHotplug() reports a change, opens what it finds, and drains every open
+// device with ReadBatch() once per poll cycle. Calls come from the poll thread or, for
+// Enumerate/Open/Close, from RefreshDevices(); backends serialize them internally.
+class JoypadInputBackend {
+public:
+	virtual ~JoypadInputBackend() = default;
+
+	virtual const char *Name() const = 0;
+	// Bracket a run of the manager: Start() comes before the first Enumerate() and Stop() after
+	// the last Close(). native_window is the host window given to SetNativeWindowHandle(), or
+	// nullptr; backends that need OS resources (notification windows, HID managers) take them here.
+	virtual void Start(void *native_window) { (void)native_window; }
+	virtual void Stop() {}
+	virtual void Enumerate(std::vector<JoypadBackendDevice> &devices) = 0;
+	// Returns a handle for ReadBatch/Close, or -1 if the device can't be opened.
+	virtual int Open(const JoypadBackendDevice &device) = 0;
+	virtual void Close(int handle) = 0;
+	// Appends the events pending on handle. Returns false once the device is gone.
+	virtual bool ReadBatch(int handle, std::vector<JoypadBackendEvent> &events) = 0;
+	// True when devices may have been added or removed since the last call.
+	virtual bool PollHotplug() = 0;
+	// Blocks until input or a hotplug event may be pending, or timeout elapses.
+	virtual void Wait(std::chrono::milliseconds timeout);
+};
+
+// Creates a backend from a spec:
+//   joydev                          Linux /dev/input/js*
+//   evdev                           Linux /dev/input/event* gamepads and joysticks
+//   dinput                          Windows XInput pads plus other DirectInput game controllers
+//   iohid                           macOS IOHIDManager devices
+//   synthetic[:devices[:rate_hz]]   generated input, no hardware (default 4 devices at 100 Hz)
+// Returns nullptr for unknown specs and backends this platform lacks.
+std::unique_ptr<JoypadInputBackend> JoypadCreateInputBackend(const std::string &spec);
+// joydev, dinput or iohid for this platform; nullptr where there is none.
+std::unique_ptr<JoypadInputBackend> JoypadCreateDefaultInputBackend();
+
+std::unique_ptr<JoypadInputBackend> JoypadCreateSyntheticBackend(int devices, double events_per_second,
+								 uint32_t seed = 1);
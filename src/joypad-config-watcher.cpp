@@ -0,0 +1,179 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "joypad-config-watcher.h"
+#include <util/base.h>
+#include <plugin-support.h>
+
+#include <chrono>
+#include <cstring>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#else
+#include <filesystem>
+#endif
+
+namespace {
+// Editors and scripts often write in several steps (truncate, write, rename).
+constexpr int kSettleMs = 250;
+#if !defined(__linux__)
+constexpr int kPollIntervalMs = 1000;
+#endif
+} // namespace
+
+JoypadConfigWatcher::~JoypadConfigWatcher()
+{
+	Stop();
+}
+
+bool JoypadConfigWatcher::Start(const std::string &path, ChangeCallback on_change)
+{
+	Stop();
+
+	path_ = path;
+	const size_t slash = path.find_last_of("/\\");
+	dir_ = slash == std::string::npos ? "." : path.substr(0, slash);
+	file_name_ = slash == std::string::npos ? path : path.substr(slash + 1);
+	on_change_ = std::move(on_change);
+
+#if defined(__linux__)
+	inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotify_fd_ < 0) {
+		obs_log(LOG_WARNING, "Config watcher: inotify_init1 failed (%s)", strerror(errno));
+		return false;
+	}
+	// Watch the directory so files replaced through rename are still seen.
+	if (inotify_add_watch(inotify_fd_, dir_.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+		obs_log(LOG_WARNING, "Config watcher: cannot watch %s (%s)", dir_.c_str(), strerror(errno));
+		close(inotify_fd_);
+		inotify_fd_ = -1;
+		return false;
+	}
+	if (pipe2(wake_pipe_, O_NONBLOCK | O_CLOEXEC) != 0) {
+		close(inotify_fd_);
+		inotify_fd_ = -1;
+		return false;
+	}
+#endif
+
+	running_ = true;
+	thread_ = std::thread([this]() { Run(); });
+	obs_log(LOG_INFO, "Watching %s for changes", path_.c_str());
+	return true;
+}
+
+void JoypadConfigWatcher::Stop()
+{
+	if (!running_.exchange(false)) {
+		return;
+	}
+#if defined(__linux__)
+	// If the write fails the poll timeout still ends the loop.
+	const char wake = 1;
+	const ssize_t written = write(wake_pipe_[1], &wake, 1);
+	(void)written;
+#else
+	{
+		std::lock_guard<std::mutex> lock(wait_mutex_);
+	}
+	wait_cv_.notify_all();
+#endif
+	if (thread_.joinable()) {
+		thread_.join();
+	}
+#if defined(__linux__)
+	close(inotify_fd_);
+	close(wake_pipe_[0]);
+	close(wake_pipe_[1]);
+	inotify_fd_ = -1;
+	wake_pipe_[0] = wake_pipe_[1] = -1;
+#endif
+}
+
+bool JoypadConfigWatcher::IsRunning() const
+{
+	return running_.load();
+}
+
+void JoypadConfigWatcher::Run()
+{
+#if defined(__linux__)
+	alignas(struct inotify_event) char buffer[4096];
+	bool pending = false;
+	while (running_.load()) {
+		pollfd fds[2] = {{inotify_fd_, POLLIN, 0}, {wake_pipe_[0], POLLIN, 0}};
+		const int rc = poll(fds, 2, pending ? kSettleMs : 1000);
+		if (!running_.load()) {
+			break;
+		}
+		if (rc == 0) {
+			if (pending) {
+				pending = false;
+				on_change_();
+			}
+			continue;
+		}
+		if (rc < 0 || !(fds[0].revents & POLLIN)) {
+			continue;
+		}
+
+		ssize_t len = 0;
+		while ((len = read(inotify_fd_, buffer, sizeof(buffer))) > 0) {
+			for (char *ptr = buffer; ptr < buffer + len;) {
+				const auto *event = reinterpret_cast<const struct inotify_event *>(ptr);
+				if (event->len > 0 && file_name_ == event->name) {
+					// Every write re-arms the settle timeout.
+					pending = true;
+				}
+				ptr += sizeof(struct inotify_event) + event->len;
+			}
+		}
+	}
+#else
+	namespace fs = std::filesystem;
+	std::error_code ec;
+	auto last_seen = fs::last_write_time(path_, ec);
+	bool pending = false;
+	while (running_.load()) {
+		{
+			std::unique_lock<std::mutex> lock(wait_mutex_);
+			wait_cv_.wait_for(lock, std::chrono::milliseconds(pending ? kSettleMs : kPollIntervalMs),
+					  [this]() { return !running_.load(); });
+		}
+		if (!running_.load()) {
+			break;
+		}
+		const auto stamp = fs::last_write_time(path_, ec);
+		if (ec) {
+			continue;
+		}
+		if (stamp != last_seen) {
+			last_seen = stamp;
+			pending = true;
+		} else if (pending) {
+			pending = false;
+			on_change_();
+		}
+	}
+#endif
+}
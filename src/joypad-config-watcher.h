@@ -0,0 +1,56 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Watches a single file and calls back on its own thread once writes to it have settled.
+// Uses inotify on Linux and a modification time poll elsewhere.
+class JoypadConfigWatcher {
+public:
+	using ChangeCallback = std::function<void()>;
+
+	~JoypadConfigWatcher();
+
+	bool Start(const std::string &path, ChangeCallback on_change);
+	void Stop();
+	bool IsRunning() const;
+
+private:
+	void Run();
+
+	std::thread thread_;
+	std::atomic<bool> running_{false};
+	std::string path_;
+	std::string dir_;
+	std::string file_name_;
+	ChangeCallback on_change_;
+#if defined(__linux__)
+	int inotify_fd_ = -1;
+	int wake_pipe_[2] = {-1, -1};
+#else
+	std::mutex wait_mutex_;
+	std::condition_variable wait_cv_;
+#endif
+};
@@ -17,7 +17,11 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 */
 
 #include "joypad-config.h"
+#include "joypad-flight-recorder.h"
 #include "joypad-input.h"
+#include "joypad-matcher.h"
+#include "joypad-stats.h"
+#include "joypad-trace.h"
 
 #include <obs-module.h>
 #include <obs-properties.h>
@@ -32,143 +36,79 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 #include <util/dstr.h>
 #include <cstring>
 #include <chrono>
+#include <unordered_set>
 
 namespace {
 const char *kConfigFileName = "joypad-to-obs.json";
+const char *kBundleFormat = "joypad-to-obs-bundle";
+constexpr int kBundleVersion = 1;
+constexpr size_t kStringPoolSlack = 256;
 constexpr int kOsdPositionMin = (int)JoypadOsdPosition::TopLeft;
 constexpr int kOsdPositionMax = (int)JoypadOsdPosition::BottomRight;
 
-std::string to_upper_copy(const std::string &s)
+bool validate_binding(const JoypadBinding &binding, std::string &error)
 {
-	std::string out = s;
-	std::transform(out.begin(), out.end(), out.begin(), [](unsigned char c) { return (char)std::toupper(c); });
-	return out;
-}
-
-bool contains_upper(const std::string &haystack_upper, const char *needle_upper)
-{
-	return haystack_upper.find(needle_upper) != std::string::npos;
-}
-
-bool is_xbox_like(const std::string &device_id, const std::string &device_type_id, const std::string &device_name)
-{
-	(void)device_id;
-	const std::string type_up = to_upper_copy(device_type_id);
-	const std::string name_up = to_upper_copy(device_name);
-	if (contains_upper(type_up, "VID_045E")) {
-		return true;
-	}
-	if (contains_upper(name_up, "XBOX")) {
-		return true;
-	}
-	return false;
-}
-
-bool device_matches_input(const std::string &binding_device_id, const std::string &binding_device_stable_id,
-			  const std::string &binding_device_type_id, const std::string &binding_device_name,
-			  const std::string &event_device_id, const std::string &event_device_stable_id,
-			  const std::string &event_device_type_id, const std::string &event_device_name)
-{
-	bool device_match = binding_device_id.empty() || binding_device_id == event_device_id;
-	if (!device_match && !binding_device_stable_id.empty() && binding_device_stable_id == event_device_stable_id) {
-		device_match = true;
+	const int action = (int)binding.action;
+	if (action < (int)JoypadActionType::SwitchScene || action > (int)JoypadActionType::SaveReplayBuffer) {
+		error = "unknown action " + std::to_string(action);
+		return false;
 	}
-	if (!device_match && !binding_device_type_id.empty() && binding_device_type_id == event_device_type_id) {
-		device_match = true;
+	if (binding.layer < 0) {
+		error = "negative layer " + std::to_string(binding.layer);
+		return false;
 	}
-	if (!device_match) {
-		const bool binding_xbox = is_xbox_like(binding_device_id, binding_device_type_id, binding_device_name);
-		const bool event_xbox = is_xbox_like(event_device_id, event_device_type_id, event_device_name);
-		if (binding_xbox && event_xbox) {
-			device_match = true;
-		}
+	if ((binding.require_state & binding.forbid_state) != 0) {
+		error = "state both required and forbidden";
+		return false;
 	}
-	return device_match;
-}
-
-bool button_combo_contains_event(const std::vector<JoypadButtonComboEntry> &combo, const JoypadEvent &event)
-{
-	for (const auto &entry : combo) {
-		if (entry.button != event.button) {
-			continue;
+	if (binding.input_type == JoypadInputType::Axis) {
+		if (binding.axis_index < 0) {
+			error = "axis binding without an axis";
+			return false;
 		}
-		if (device_matches_input(entry.device_id, entry.device_stable_id, entry.device_type_id,
-					 entry.device_name, event.device_id, event.device_stable_id,
-					 event.device_type_id, event.device_name)) {
-			return true;
+	} else if (binding.input_type == JoypadInputType::Button) {
+		if (binding.button <= 0 && binding.button_combo.empty()) {
+			error = "button binding without a button";
+			return false;
 		}
-	}
-	return false;
-}
-
-bool button_combo_is_active(const JoypadBinding &binding, const JoypadInputManager *input)
-{
-	if (!input) {
-		return binding.button > 0;
-	}
-	if (binding.button_combo.empty()) {
-		return input->IsButtonPressed(binding.device_id, binding.device_stable_id, binding.device_type_id,
-					      binding.button);
-	}
-	for (const auto &entry : binding.button_combo) {
-		if (!input->IsButtonPressed(entry.device_id, entry.device_stable_id, entry.device_type_id,
-					    entry.button)) {
+		if (binding.action == JoypadActionType::SetSourceVolumePercent) {
+			error = "slider volume requires an axis";
 			return false;
 		}
+	} else {
+		error = "unknown input type " + std::to_string((int)binding.input_type);
+		return false;
 	}
 	return true;
 }
 
-std::string button_combo_state_key(const JoypadBinding &binding)
+bool reject_transaction(const std::string &profile_name, const std::string &reason, std::string *error)
 {
-	if (binding.uid > 0) {
-		return "combo:" + std::to_string((long long)binding.uid);
-	}
-
-	std::string key = "combo:";
-	for (const auto &entry : binding.button_combo) {
-		key += entry.device_id;
-		key += "|";
-		key += entry.device_stable_id;
-		key += "|";
-		key += entry.device_type_id;
-		key += "|";
-		key += std::to_string(entry.button);
-		key += ";";
+	obs_log(LOG_WARNING, "Binding changes for profile '%s' rejected: %s", profile_name.c_str(), reason.c_str());
+	if (error) {
+		*error = reason;
 	}
-	key += std::to_string((int)binding.action);
-	key += ":";
-	key += binding.source_name;
-	key += ":";
-	key += binding.filter_name;
-	return key;
+	return false;
 }
 
-void sync_legacy_button_from_combo(JoypadBinding &binding)
+void index_profile_bindings(JoypadProfile &profile, size_t first = 0)
 {
-	if (binding.input_type != JoypadInputType::Button) {
-		binding.button = -1;
-		binding.button_combo.clear();
-		return;
-	}
-
-	if (binding.button_combo.empty() && binding.button > 0) {
-		JoypadButtonComboEntry entry;
-		entry.device_id = binding.device_id;
-		entry.device_stable_id = binding.device_stable_id;
-		entry.device_type_id = binding.device_type_id;
-		entry.device_name = binding.device_name;
-		entry.button = binding.button;
-		binding.button_combo.push_back(std::move(entry));
+	if (first == 0) {
+		profile.uid_slots.clear();
+		profile.uid_slots.reserve(profile.bindings.size());
+		for (const auto &binding : profile.bindings) {
+			if (binding.uid >= profile.next_uid) {
+				profile.next_uid = binding.uid + 1;
+			}
+		}
 	}
-
-	if (!binding.button_combo.empty()) {
-		const auto &primary = binding.button_combo.front();
-		binding.button = primary.button;
-		binding.device_id = primary.device_id;
-		binding.device_stable_id = primary.device_stable_id;
-		binding.device_type_id = primary.device_type_id;
-		binding.device_name = primary.device_name;
+	for (size_t i = first; i < profile.bindings.size(); ++i) {
+		auto &binding = profile.bindings[i];
+		// Missing or duplicated uids (hand edited files) get a fresh one.
+		if (binding.uid <= 0 || (first == 0 && profile.uid_slots.count(binding.uid) != 0)) {
+			binding.uid = profile.next_uid++;
+		}
+		profile.uid_slots[binding.uid] = i;
 	}
 }
 
@@ -181,6 +121,14 @@ void profile_hotkey_callback(void *data, obs_hotkey_id id, obs_hotkey_t *hotkey,
 	(void)hotkey;
 }
 
+void hotkey_bindings_changed(void *data, calldata_t *cd)
+{
+	auto *hotkey = static_cast<obs_hotkey_t *>(calldata_ptr(cd, "key"));
+	if (hotkey) {
+		static_cast<JoypadConfigStore *>(data)->ForgetHotkeyString(obs_hotkey_get_id(hotkey));
+	}
+}
+
 void register_profile_hotkey(JoypadConfigStore *store, JoypadProfile &profile)
 {
 	if (profile.hotkey_id != OBS_INVALID_HOTKEY_ID)
@@ -250,6 +198,20 @@ static void load_binding_from_data(JoypadBinding &binding, obs_data_t *data)
 		}
 		obs_data_array_release(combo_array);
 	}
+	binding.combo_mode = (JoypadComboMode)std::clamp((int)obs_data_get_int(data, "combo_mode"),
+							 (int)JoypadComboMode::Chord, (int)JoypadComboMode::Sequence);
+	binding.combo_trigger = obs_data_get_int(data, "combo_trigger") == (int)JoypadComboTrigger::Release
+					? JoypadComboTrigger::Release
+					: JoypadComboTrigger::Press;
+	binding.combo_window_ms = 500;
+	if (obs_data_has_user_value(data, "combo_window_ms")) {
+		binding.combo_window_ms = std::clamp((int)obs_data_get_int(data, "combo_window_ms"), 50, 5000);
+	}
+	binding.layer = std::max(0, (int)obs_data_get_int(data, "layer"));
+	binding.require_state = (uint32_t)obs_data_get_int(data, "require_state") & kJoypadStateAll;
+	binding.forbid_state = (uint32_t)obs_data_get_int(data, "forbid_state") & kJoypadStateAll;
+	binding.forbid_state &= ~binding.require_state;
+	binding.condition_scene = obs_data_get_string(data, "condition_scene");
 	binding.input_type = (JoypadInputType)obs_data_get_int(data, "input_type");
 	binding.axis_index = (int)obs_data_get_int(data, "axis_index");
 	binding.axis_direction = (JoypadAxisDirection)obs_data_get_int(data, "axis_direction");
@@ -335,7 +297,7 @@ static void load_binding_from_data(JoypadBinding &binding, obs_data_t *data)
 	if (obs_data_has_user_value(data, "enabled")) {
 		binding.enabled = obs_data_get_bool(data, "enabled");
 	}
-	sync_legacy_button_from_combo(binding);
+	JoypadSyncButtonCombo(binding);
 }
 
 static void save_binding_to_data(const JoypadBinding &binding, obs_data_t *data)
@@ -361,6 +323,25 @@ static void save_binding_to_data(const JoypadBinding &binding, obs_data_t *data)
 		obs_data_set_array(data, "button_combo", combo_array);
 		obs_data_array_release(combo_array);
 	}
+	if (binding.input_type == JoypadInputType::Button) {
+		obs_data_set_int(data, "combo_mode", (int)binding.combo_mode);
+		obs_data_set_int(data, "combo_trigger", (int)binding.combo_trigger);
+		if (binding.combo_mode != JoypadComboMode::Chord) {
+			obs_data_set_int(data, "combo_window_ms", binding.combo_window_ms);
+		}
+	}
+	if (binding.layer > 0) {
+		obs_data_set_int(data, "layer", binding.layer);
+	}
+	if (binding.require_state != 0) {
+		obs_data_set_int(data, "require_state", binding.require_state);
+	}
+	if (binding.forbid_state != 0) {
+		obs_data_set_int(data, "forbid_state", binding.forbid_state);
+	}
+	if (!binding.condition_scene.empty()) {
+		obs_data_set_string(data, "condition_scene", binding.condition_scene.c_str());
+	}
 	obs_data_set_int(data, "input_type", (int)binding.input_type);
 	if (binding.input_type == JoypadInputType::Axis) {
 		obs_data_set_int(data, "axis_index", binding.axis_index);
@@ -464,8 +445,257 @@ static void save_binding_to_data(const JoypadBinding &binding, obs_data_t *data)
 	}
 }
 
+static void load_layers_from_data(std::vector<JoypadLayer> &layers, obs_data_t *data)
+{
+	layers.clear();
+	obs_data_array_t *layers_array = obs_data_get_array(data, "layers");
+	if (!layers_array) {
+		return;
+	}
+	const size_t count = obs_data_array_count(layers_array);
+	for (size_t i = 0; i < count; ++i) {
+		if (obs_data_t *item = obs_data_array_item(layers_array, i)) {
+			// Kept even without a modifier, so layer numbers of bindings stay valid.
+			JoypadLayer layer;
+			layer.name = obs_data_get_string(item, "name");
+			layer.modifier.device_id = obs_data_get_string(item, "device_id");
+			layer.modifier.device_stable_id = obs_data_get_string(item, "device_stable_id");
+			layer.modifier.device_type_id = obs_data_get_string(item, "device_type_id");
+			layer.modifier.device_name = obs_data_get_string(item, "device_name");
+			layer.modifier.button = (int)obs_data_get_int(item, "button");
+			layers.push_back(std::move(layer));
+			obs_data_release(item);
+		}
+	}
+	obs_data_array_release(layers_array);
+}
+
+static void save_layers_to_data(const std::vector<JoypadLayer> &layers, obs_data_t *data, bool portable)
+{
+	if (layers.empty()) {
+		return;
+	}
+	obs_data_array_t *layers_array = obs_data_array_create();
+	for (const auto &layer : layers) {
+		obs_data_t *item = obs_data_create();
+		obs_data_set_string(item, "name", layer.name.c_str());
+		obs_data_set_string(item, "device_id", layer.modifier.device_id.c_str());
+		if (!portable) {
+			obs_data_set_string(item, "device_stable_id", layer.modifier.device_stable_id.c_str());
+		}
+		obs_data_set_string(item, "device_type_id", layer.modifier.device_type_id.c_str());
+		obs_data_set_string(item, "device_name", layer.modifier.device_name.c_str());
+		obs_data_set_int(item, "button", layer.modifier.button);
+		obs_data_array_push_back(layers_array, item);
+		obs_data_release(item);
+	}
+	obs_data_set_array(data, "layers", layers_array);
+	obs_data_array_release(layers_array);
+}
+
+struct ParsedProfile {
+	JoypadProfile profile;
+	obs_data_array_t *hotkey_data = nullptr;
+};
+
+// Reads one entry of the "profiles" array. Returns false for entries without a name.
+static bool parse_profile_item(obs_data_t *p_item, ParsedProfile &item)
+{
+	item.profile.name = obs_data_get_string(p_item, "name");
+	item.profile.comment = obs_data_get_string(p_item, "comment");
+	if (item.profile.name.empty()) {
+		return false;
+	}
+	load_layers_from_data(item.profile.layers, p_item);
+
+	obs_data_array_t *bindings_array = obs_data_get_array(p_item, "bindings");
+	if (bindings_array) {
+		size_t b_count = obs_data_array_count(bindings_array);
+		item.profile.bindings.reserve(b_count);
+		for (size_t j = 0; j < b_count; ++j) {
+			obs_data_t *b_item = obs_data_array_item(bindings_array, j);
+			JoypadBinding binding;
+			load_binding_from_data(binding, b_item);
+			item.profile.bindings.push_back(std::move(binding));
+			obs_data_release(b_item);
+		}
+		obs_data_array_release(bindings_array);
+	}
+	index_profile_bindings(item.profile);
+	item.hotkey_data = obs_data_get_array(p_item, "hotkey_data");
+	return true;
+}
+
+// Reads the profile list (or the legacy flat binding list) without touching OBS hotkeys.
+static std::vector<ParsedProfile> parse_profiles(obs_data_t *data)
+{
+	std::vector<ParsedProfile> parsed;
+	obs_data_array_t *profiles_array = obs_data_get_array(data, "profiles");
+	if (profiles_array) {
+		size_t count = obs_data_array_count(profiles_array);
+		for (size_t i = 0; i < count; ++i) {
+			obs_data_t *p_item = obs_data_array_item(profiles_array, i);
+			ParsedProfile item;
+			if (parse_profile_item(p_item, item)) {
+				parsed.push_back(std::move(item));
+			}
+			obs_data_release(p_item);
+		}
+		obs_data_array_release(profiles_array);
+	} else {
+		// Legacy migration or new file
+		ParsedProfile item;
+		item.profile.name = "Default";
+		obs_data_array_t *bindings_array = obs_data_get_array(data, "bindings");
+		if (bindings_array) {
+			size_t count = obs_data_array_count(bindings_array);
+			for (size_t i = 0; i < count; ++i) {
+				obs_data_t *b_item = obs_data_array_item(bindings_array, i);
+				JoypadBinding binding;
+				load_binding_from_data(binding, b_item);
+				item.profile.bindings.push_back(std::move(binding));
+				obs_data_release(b_item);
+			}
+			obs_data_array_release(bindings_array);
+		}
+		index_profile_bindings(item.profile);
+		parsed.push_back(std::move(item));
+	}
+	return parsed;
+}
+
+// Exported profiles stay portable: bindings resolve through device_id/device_type_id instead.
+static void strip_stable_device_ids(obs_data_t *item)
+{
+	obs_data_erase(item, "device_stable_id");
+	if (obs_data_array_t *combo_array = obs_data_get_array(item, "button_combo")) {
+		const size_t combo_count = obs_data_array_count(combo_array);
+		for (size_t i = 0; i < combo_count; ++i) {
+			if (obs_data_t *combo_item = obs_data_array_item(combo_array, i)) {
+				obs_data_erase(combo_item, "device_stable_id");
+				obs_data_release(combo_item);
+			}
+		}
+		obs_data_array_release(combo_array);
+	}
+}
+
+static obs_data_array_t *portable_bindings_array(const std::vector<JoypadBinding> &bindings)
+{
+	obs_data_array_t *arr = obs_data_array_create();
+	for (const auto &b : bindings) {
+		obs_data_t *item = obs_data_create();
+		save_binding_to_data(b, item);
+		strip_stable_device_ids(item);
+		obs_data_array_push_back(arr, item);
+		obs_data_release(item);
+	}
+	return arr;
+}
+
+static std::string unique_profile_name(const std::vector<JoypadProfile> &profiles, const std::string &name)
+{
+	std::string candidate = name;
+	int counter = 1;
+	bool collision = true;
+	while (collision) {
+		collision = false;
+		for (const auto &p : profiles) {
+			if (p.name.size() == candidate.size() &&
+			    std::equal(p.name.begin(), p.name.end(), candidate.begin(), [](char a, char b) {
+				    return std::tolower((unsigned char)a) == std::tolower((unsigned char)b);
+			    })) {
+				collision = true;
+				break;
+			}
+		}
+		if (collision) {
+			candidate = name + " (" + std::to_string(counter++) + ")";
+		}
+	}
+	return candidate;
+}
+
+static bool bundle_failure(const char *what, const std::string &path, const std::string &reason, std::string *error)
+{
+	obs_log(LOG_WARNING, "Profile bundle %s '%s' failed: %s", what, path.c_str(), reason.c_str());
+	if (error) {
+		*error = reason;
+	}
+	return false;
+}
+
+static bool read_text_file(const std::string &path, std::string &out)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+	out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	return true;
+}
+
+static size_t hash_config_file(const std::string &path)
+{
+	std::string text;
+	if (!read_text_file(path, text)) {
+		return 0;
+	}
+	return std::hash<std::string>{}(text);
+}
+
+// Counts bindings added, changed or removed between two versions of a profile and appends
+// their uids to stale_uids: uids come from the file, so an added one may be a uid the
+// matcher still holds state for.
+static size_t diff_profile_bindings(const JoypadProfile &current, const JoypadProfile &incoming, bool &reordered,
+				    std::vector<int64_t> &stale_uids)
+{
+	size_t changes = 0;
+	reordered = current.bindings.size() != incoming.bindings.size();
+	for (size_t i = 0; i < incoming.bindings.size(); ++i) {
+		const JoypadBinding &binding = incoming.bindings[i];
+		auto it = current.uid_slots.find(binding.uid);
+		if (it == current.uid_slots.end()) {
+			++changes;
+			stale_uids.push_back(binding.uid);
+			continue;
+		}
+		if (it->second != i) {
+			reordered = true;
+		}
+		if (!JoypadBindingsEqual(current.bindings[it->second], binding)) {
+			++changes;
+			stale_uids.push_back(binding.uid);
+		}
+	}
+	for (const auto &binding : current.bindings) {
+		if (incoming.uid_slots.count(binding.uid) == 0) {
+			++changes;
+			stale_uids.push_back(binding.uid);
+		}
+	}
+	return changes;
+}
+
+JoypadConfigStore::JoypadConfigStore() : matcher_(std::make_unique<JoypadMatcher>()) {}
+
+JoypadConfigStore::~JoypadConfigStore() = default;
+
 void JoypadConfigStore::Load()
 {
+	if (!hotkey_signal_connected_) {
+		signal_handler_connect(obs_get_signal_handler(), "hotkey_bindings_changed", hotkey_bindings_changed,
+				       this);
+		hotkey_signal_connected_ = true;
+	}
+	LoadFromDisk();
+	UpdateConfigWatcher();
+	NotifyChanged(kJoypadConfigAllChanged);
+}
+
+void JoypadConfigStore::LoadFromDisk()
+{
+	std::lock_guard<std::mutex> restructure(restructure_mutex_);
 	std::lock_guard<std::mutex> lock(mutex_);
 	for (auto &profile : profiles_) {
 		unregister_profile_hotkey(profile);
@@ -473,18 +703,19 @@ void JoypadConfigStore::Load()
 
 	profiles_.clear();
 	current_profile_index_ = 0;
-	axis_active_.clear();
-	button_combo_last_dispatch_.clear();
+	matcher_->Reset();
 	dirty_ = false;
 
 	ensure_config_dir();
 
 	char *config_path = obs_module_config_path(kConfigFileName);
 	if (!config_path) {
+		PublishBindingsLocked();
 		return;
 	}
 
 	obs_data_t *data = obs_data_create_from_json_file_safe(config_path, "backup");
+	disk_hash_ = hash_config_file(config_path);
 	bfree(config_path);
 
 	if (!data) {
@@ -556,6 +787,7 @@ void JoypadConfigStore::Load()
 		b4.enabled = true;
 		xbox_profile.bindings.push_back(b4);
 
+		index_profile_bindings(xbox_profile);
 		register_profile_hotkey(this, xbox_profile);
 
 		if (xbox_profile.hotkey_id != OBS_INVALID_HOTKEY_ID) {
@@ -574,72 +806,41 @@ void JoypadConfigStore::Load()
 
 		profiles_.push_back(xbox_profile);
 #endif
+		PublishBindingsLocked();
 		return;
 	}
 
-	obs_data_array_t *profiles_array = obs_data_get_array(data, "profiles");
-	if (profiles_array) {
-		size_t count = obs_data_array_count(profiles_array);
-		for (size_t i = 0; i < count; ++i) {
-			obs_data_t *p_item = obs_data_array_item(profiles_array, i);
-			JoypadProfile profile;
-			profile.name = obs_data_get_string(p_item, "name");
-			profile.comment = obs_data_get_string(p_item, "comment");
-			if (profile.name.empty()) {
-				obs_data_release(p_item);
-				continue;
-			}
-
-			obs_data_array_t *bindings_array = obs_data_get_array(p_item, "bindings");
-			if (bindings_array) {
-				size_t b_count = obs_data_array_count(bindings_array);
-				for (size_t j = 0; j < b_count; ++j) {
-					obs_data_t *b_item = obs_data_array_item(bindings_array, j);
-					JoypadBinding binding;
-					load_binding_from_data(binding, b_item);
-					profile.bindings.push_back(binding);
-					obs_data_release(b_item);
-				}
-				obs_data_array_release(bindings_array);
+	for (auto &item : parse_profiles(data)) {
+		register_profile_hotkey(this, item.profile);
+		if (item.hotkey_data) {
+			size_t count = obs_data_array_count(item.hotkey_data);
+			if (item.profile.hotkey_id != OBS_INVALID_HOTKEY_ID) {
+				obs_hotkey_load(item.profile.hotkey_id, item.hotkey_data);
+				obs_log(LOG_INFO, "Loaded %d hotkey bindings for profile '%s'", (int)count,
+					item.profile.name.c_str());
 			}
+			obs_data_array_release(item.hotkey_data);
+		}
+		profiles_.push_back(std::move(item.profile));
+	}
+	current_profile_index_ = (int)obs_data_get_int(data, "current_profile_index");
+	ReadSettingsLocked(data);
+	watch_config_file_ = obs_data_get_bool(data, "watch_config_file");
 
-			register_profile_hotkey(this, profile);
-			obs_data_array_t *hotkey_data = obs_data_get_array(p_item, "hotkey_data");
-			if (hotkey_data) {
-				size_t count = obs_data_array_count(hotkey_data);
-				if (profile.hotkey_id != OBS_INVALID_HOTKEY_ID) {
-					obs_hotkey_load(profile.hotkey_id, hotkey_data);
-					obs_log(LOG_INFO, "Loaded %d hotkey bindings for profile '%s'", (int)count,
-						profile.name.c_str());
-				}
-				obs_data_array_release(hotkey_data);
-			}
+	if (profiles_.empty()) {
+		profiles_.push_back({"Default", {}});
+	}
 
-			profiles_.push_back(profile);
-			obs_data_release(p_item);
-		}
-		obs_data_array_release(profiles_array);
-		current_profile_index_ = (int)obs_data_get_int(data, "current_profile_index");
-	} else {
-		// Legacy migration or new file
-		JoypadProfile default_profile;
-		default_profile.name = "Default";
-		obs_data_array_t *bindings_array = obs_data_get_array(data, "bindings");
-		if (bindings_array) {
-			size_t count = obs_data_array_count(bindings_array);
-			for (size_t i = 0; i < count; ++i) {
-				obs_data_t *item = obs_data_array_item(bindings_array, i);
-				JoypadBinding binding;
-				load_binding_from_data(binding, item);
-				default_profile.bindings.push_back(binding);
-				obs_data_release(item);
-			}
-			obs_data_array_release(bindings_array);
-		}
-		profiles_.push_back(default_profile);
-		current_profile_index_ = 0;
+	for (auto &profile : profiles_) {
+		register_profile_hotkey(this, profile);
 	}
+	PublishBindingsLocked();
+
+	obs_data_release(data);
+}
 
+void JoypadConfigStore::ReadSettingsLocked(obs_data_t *data)
+{
 	osd_enabled_ = true;
 	if (obs_data_has_user_value(data, "osd_enabled")) {
 		osd_enabled_ = obs_data_get_bool(data, "osd_enabled");
@@ -656,54 +857,340 @@ void JoypadConfigStore::Load()
 	osd_position_ = (JoypadOsdPosition)osd_position;
 	const char *bg_color = obs_data_get_string(data, "osd_background_color");
 	osd_background_color_ = (bg_color && *bg_color) ? bg_color : "rgba(0, 0, 0, 230)";
+}
 
-	for (auto &profile : profiles_) {
-		int64_t max_uid = 0;
-		for (const auto &b : profile.bindings) {
-			if (b.uid > max_uid)
-				max_uid = b.uid;
+bool JoypadConfigStore::ReloadFromDisk()
+{
+	std::lock_guard<std::mutex> restructure(restructure_mutex_);
+	char *config_path = obs_module_config_path(kConfigFileName);
+	if (!config_path) {
+		return false;
+	}
+	const std::string path = config_path;
+	bfree(config_path);
+
+	std::string text;
+	if (!read_text_file(path, text)) {
+		return false;
+	}
+	const size_t hash = std::hash<std::string>{}(text);
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (hash == disk_hash_) {
+			// Our own save, or a write that did not change anything.
+			return false;
 		}
-		int64_t local_gen = max_uid + 1;
-		for (auto &binding : profile.bindings) {
-			if (binding.uid == 0) {
-				binding.uid = local_gen++;
-			}
+		if (dirty_) {
+			obs_log(LOG_WARNING, "%s changed on disk, but there are unsaved changes in OBS; not reloading",
+				path.c_str());
+			return false;
 		}
 	}
 
-	if (profiles_.empty()) {
-		profiles_.push_back({"Default", {}});
+	obs_data_t *data = obs_data_create_from_json(text.c_str());
+	if (!data) {
+		obs_log(LOG_WARNING, "%s changed on disk, but it is not valid JSON; not reloading", path.c_str());
+		return false;
 	}
 
-	for (auto &profile : profiles_) {
-		register_profile_hotkey(this, profile);
+	std::vector<ParsedProfile> parsed;
+	for (auto &item : parse_profiles(data)) {
+		const bool duplicate = std::any_of(parsed.begin(), parsed.end(), [&item](const ParsedProfile &p) {
+			return p.profile.name == item.profile.name;
+		});
+		if (duplicate) {
+			obs_log(LOG_WARNING, "Ignoring duplicated profile '%s' in %s", item.profile.name.c_str(),
+				path.c_str());
+			if (item.hotkey_data) {
+				obs_data_array_release(item.hotkey_data);
+			}
+			continue;
+		}
+		parsed.push_back(std::move(item));
 	}
-
-	obs_data_release(data);
-}
-
-bool JoypadConfigStore::HasUnsavedChanges() const
-{
-	std::lock_guard<std::mutex> lock(mutex_);
-	return dirty_;
-}
-
-void JoypadConfigStore::DiscardChanges()
-{
-	Load();
-}
-
-void JoypadConfigStore::Unload()
-{
-	std::lock_guard<std::mutex> lock(mutex_);
-	for (auto &profile : profiles_) {
-		unregister_profile_hotkey(profile);
+	if (parsed.empty()) {
+		obs_log(LOG_WARNING, "%s changed on disk, but it has no profiles; not reloading", path.c_str());
+		obs_data_release(data);
+		return false;
 	}
-	profiles_.clear();
-}
 
-void JoypadConfigStore::Save()
-{
+	// Hotkey registration happens without mutex_, as in SortAndRegisterHotkeys; restructure_mutex_
+	// keeps that from interleaving with another profile list rebuild.
+	std::unordered_map<std::string, obs_hotkey_id> existing_hotkeys;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (const auto &profile : profiles_) {
+			existing_hotkeys[profile.name] = profile.hotkey_id;
+		}
+	}
+	for (auto &item : parsed) {
+		auto it = existing_hotkeys.find(item.profile.name);
+		if (it == existing_hotkeys.end()) {
+			register_profile_hotkey(this, item.profile);
+		}
+		const obs_hotkey_id id = it != existing_hotkeys.end() ? it->second : item.profile.hotkey_id;
+		if (item.hotkey_data) {
+			if (id != OBS_INVALID_HOTKEY_ID) {
+				obs_hotkey_load(id, item.hotkey_data);
+			}
+			obs_data_array_release(item.hotkey_data);
+			item.hotkey_data = nullptr;
+		}
+	}
+
+	std::vector<obs_hotkey_id> stale_hotkeys;
+	bool applied = false;
+	size_t profiles_added = 0;
+	size_t profiles_removed = 0;
+	size_t bindings_changed = 0;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (dirty_) {
+			// Edited in OBS while the file was being read; the in-memory state wins.
+			for (const auto &item : parsed) {
+				if (existing_hotkeys.count(item.profile.name) == 0) {
+					stale_hotkeys.push_back(item.profile.hotkey_id);
+				}
+			}
+		} else {
+			const JoypadProfile *current = CurrentProfile();
+			const std::string current_name = current ? current->name : std::string();
+			bool current_changed = false;
+			std::vector<int64_t> stale_uids;
+			std::vector<bool> kept(profiles_.size(), false);
+			std::vector<JoypadProfile> next;
+			next.reserve(parsed.size());
+
+			for (auto &item : parsed) {
+				size_t old_index = profiles_.size();
+				for (size_t i = 0; i < profiles_.size(); ++i) {
+					if (!kept[i] && profiles_[i].name == item.profile.name) {
+						old_index = i;
+						break;
+					}
+				}
+				if (old_index == profiles_.size()) {
+					++profiles_added;
+					bindings_changed += item.profile.bindings.size();
+					next.push_back(std::move(item.profile));
+					continue;
+				}
+
+				kept[old_index] = true;
+				JoypadProfile merged = std::move(profiles_[old_index]);
+				merged.comment = std::move(item.profile.comment);
+				const bool is_current = merged.name == current_name;
+				if (!JoypadLayersEqual(merged.layers, item.profile.layers)) {
+					merged.layers = std::move(item.profile.layers);
+					current_changed = current_changed || is_current;
+				}
+				bool reordered = false;
+				const size_t changes =
+					diff_profile_bindings(merged, item.profile, reordered, stale_uids);
+				if (changes > 0 || reordered) {
+					const int64_t next_uid = std::max(merged.next_uid, item.profile.next_uid);
+					merged.bindings = std::move(item.profile.bindings);
+					merged.uid_slots = std::move(item.profile.uid_slots);
+					merged.next_uid = next_uid;
+					bindings_changed += changes;
+					current_changed = current_changed || is_current;
+				}
+				next.push_back(std::move(merged));
+			}
+			for (size_t i = 0; i < profiles_.size(); ++i) {
+				if (!kept[i]) {
+					++profiles_removed;
+					stale_hotkeys.push_back(profiles_[i].hotkey_id);
+				}
+			}
+			profiles_ = std::move(next);
+
+			current_profile_index_ = -1;
+			for (size_t i = 0; i < profiles_.size(); ++i) {
+				if (profiles_[i].name == current_name) {
+					current_profile_index_ = (int)i;
+					break;
+				}
+			}
+			const bool current_replaced = current_profile_index_ < 0;
+			if (current_replaced) {
+				current_profile_index_ = (int)obs_data_get_int(data, "current_profile_index");
+				if (current_profile_index_ < 0 || current_profile_index_ >= (int)profiles_.size()) {
+					current_profile_index_ = 0;
+				}
+				current_changed = true;
+			}
+
+			// The watcher setting itself is only changed from OBS.
+			ReadSettingsLocked(data);
+			disk_hash_ = hash;
+			// Uids are per profile, so state of another profile's uid may belong to the
+			// current one; forgetting it only drops hysteresis a little early.
+			if (current_replaced) {
+				matcher_->Reset();
+			} else {
+				matcher_->Forget(stale_uids);
+			}
+			if (current_changed) {
+				PublishBindingsLocked();
+			}
+			applied = true;
+		}
+	}
+	obs_data_release(data);
+
+	for (obs_hotkey_id id : stale_hotkeys) {
+		if (id != OBS_INVALID_HOTKEY_ID) {
+			obs_hotkey_unregister(id);
+		}
+	}
+
+	if (applied) {
+		obs_log(LOG_INFO, "Reloaded %s: %d profiles added, %d removed, %d bindings changed", path.c_str(),
+			(int)profiles_added, (int)profiles_removed, (int)bindings_changed);
+		NotifyChanged(kJoypadConfigProfilesChanged | kJoypadConfigCurrentProfileChanged |
+			      kJoypadConfigBindingsChanged | kJoypadConfigOsdChanged);
+	}
+	return applied;
+}
+
+void JoypadConfigStore::QueueReload()
+{
+	// Several settled writes before the UI thread gets to it reload once.
+	if (reload_queued_.exchange(true)) {
+		return;
+	}
+	obs_queue_task(
+		OBS_TASK_UI,
+		[](void *param) {
+			auto *store = static_cast<JoypadConfigStore *>(param);
+			store->reload_queued_ = false;
+			// Unload() stops the watcher first; a reload queued before that must not run.
+			if (store->watcher_.IsRunning()) {
+				store->ReloadFromDisk();
+			}
+		},
+		this, false);
+}
+
+bool JoypadConfigStore::GetWatchConfigFile() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return watch_config_file_;
+}
+
+void JoypadConfigStore::SetWatchConfigFile(bool enabled)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		watch_config_file_ = enabled;
+	}
+	MarkDirty(0);
+	UpdateConfigWatcher();
+}
+
+void JoypadConfigStore::UpdateConfigWatcher()
+{
+	bool enabled = false;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		enabled = watch_config_file_;
+	}
+	if (!enabled) {
+		watcher_.Stop();
+		return;
+	}
+	if (watcher_.IsRunning()) {
+		return;
+	}
+
+	char *config_path = obs_module_config_path(kConfigFileName);
+	if (!config_path) {
+		return;
+	}
+	watcher_.Start(config_path, [this]() { QueueReload(); });
+	bfree(config_path);
+}
+
+uint64_t JoypadConfigStore::GetVersion() const
+{
+	return version_.load(std::memory_order_acquire);
+}
+
+int JoypadConfigStore::Subscribe(ChangeCallback callback)
+{
+	std::lock_guard<std::mutex> lock(subscribers_mutex_);
+	const int id = next_subscriber_id_++;
+	subscribers_.emplace_back(id, std::move(callback));
+	return id;
+}
+
+void JoypadConfigStore::Unsubscribe(int id)
+{
+	std::lock_guard<std::mutex> lock(subscribers_mutex_);
+	subscribers_.erase(std::remove_if(subscribers_.begin(), subscribers_.end(),
+					  [id](const auto &subscriber) { return subscriber.first == id; }),
+			   subscribers_.end());
+}
+
+void JoypadConfigStore::MarkDirty(uint32_t changes)
+{
+	if (!dirty_.exchange(true)) {
+		changes |= kJoypadConfigDirtyChanged;
+	}
+	NotifyChanged(changes);
+}
+
+void JoypadConfigStore::NotifyChanged(uint32_t changes)
+{
+	if (changes == 0) {
+		return;
+	}
+	version_.fetch_add(1, std::memory_order_acq_rel);
+	// Held while calling so that Unsubscribe() returns only once the callback is done.
+	std::lock_guard<std::mutex> lock(subscribers_mutex_);
+	for (const auto &subscriber : subscribers_) {
+		subscriber.second(changes);
+	}
+}
+
+bool JoypadConfigStore::HasUnsavedChanges() const
+{
+	return dirty_;
+}
+
+void JoypadConfigStore::DiscardChanges()
+{
+	Load();
+}
+
+void JoypadConfigStore::Unload()
+{
+	watcher_.Stop();
+	if (hotkey_signal_connected_) {
+		signal_handler_disconnect(obs_get_signal_handler(), "hotkey_bindings_changed", hotkey_bindings_changed,
+					  this);
+		hotkey_signal_connected_ = false;
+	}
+	std::lock_guard<std::mutex> lock(mutex_);
+	for (auto &profile : profiles_) {
+		unregister_profile_hotkey(profile);
+	}
+	profiles_.clear();
+	compiled_.reset();
+}
+
+void JoypadConfigStore::Save()
+{
+	const bool was_dirty = dirty_;
+	SaveToDisk();
+	if (was_dirty) {
+		NotifyChanged(kJoypadConfigDirtyChanged);
+	}
+}
+
+void JoypadConfigStore::SaveToDisk()
+{
 	std::lock_guard<std::mutex> lock(mutex_);
 
 	ensure_config_dir();
@@ -720,6 +1207,7 @@ void JoypadConfigStore::Save()
 		obs_data_t *p_item = obs_data_create();
 		obs_data_set_string(p_item, "name", profile.name.c_str());
 		obs_data_set_string(p_item, "comment", profile.comment.c_str());
+		save_layers_to_data(profile.layers, p_item, false);
 
 		obs_data_array_t *bindings_array = obs_data_array_create();
 		for (const auto &binding : profile.bindings) {
@@ -752,10 +1240,13 @@ void JoypadConfigStore::Save()
 	obs_data_set_string(data, "osd_background_color", osd_background_color_.c_str());
 	obs_data_set_int(data, "osd_font_size", osd_font_size_);
 	obs_data_set_int(data, "osd_position", (int)osd_position_);
+	obs_data_set_bool(data, "watch_config_file", watch_config_file_);
 
 	if (!obs_data_save_json(data, config_path)) {
 		obs_log(LOG_WARNING, "Nao foi possivel salvar %s", config_path);
 	}
+	// Lets the file watcher recognize our own write.
+	disk_hash_ = hash_config_file(config_path);
 	dirty_ = false;
 
 	obs_data_release(data);
@@ -782,7 +1273,7 @@ void JoypadConfigStore::SwitchProfileByHotkey(obs_hotkey_id id)
 					current_profile_index_ = (int)i;
 					name = profiles_[i].name;
 					changed = true;
-					dirty_ = true;
+					PublishBindingsLocked();
 				}
 				break;
 			}
@@ -792,6 +1283,7 @@ void JoypadConfigStore::SwitchProfileByHotkey(obs_hotkey_id id)
 		}
 	}
 	if (changed) {
+		MarkDirty(kJoypadConfigCurrentProfileChanged | kJoypadConfigBindingsChanged);
 		if (callback) {
 			callback(name);
 		}
@@ -868,22 +1360,37 @@ void JoypadConfigStore::SortAndRegisterHotkeys(std::unique_lock<std::mutex> &loc
 	}
 }
 
-void JoypadConfigStore::AddBinding(const JoypadBinding &binding)
+JoypadProfile *JoypadConfigStore::CurrentProfile()
+{
+	if (current_profile_index_ >= 0 && current_profile_index_ < (int)profiles_.size()) {
+		return &profiles_[current_profile_index_];
+	}
+	return nullptr;
+}
+
+const JoypadProfile *JoypadConfigStore::CurrentProfile() const
 {
+	if (current_profile_index_ >= 0 && current_profile_index_ < (int)profiles_.size()) {
+		return &profiles_[current_profile_index_];
+	}
+	return nullptr;
+}
+
+int64_t JoypadConfigStore::AddBinding(const JoypadBinding &binding)
+{
+	int64_t uid = 0;
 	{
 		std::lock_guard<std::mutex> lock(mutex_);
-		if (current_profile_index_ >= 0 && current_profile_index_ < (int)profiles_.size()) {
-			int64_t max_uid = 0;
-			for (const auto &b : profiles_[current_profile_index_].bindings) {
-				if (b.uid > max_uid)
-					max_uid = b.uid;
-			}
-			JoypadBinding b = binding;
-			b.uid = max_uid + 1;
-			profiles_[current_profile_index_].bindings.push_back(b);
+		if (JoypadProfile *profile = CurrentProfile()) {
+			uid = profile->next_uid++;
+			profile->bindings.push_back(binding);
+			profile->bindings.back().uid = uid;
+			profile->uid_slots[uid] = profile->bindings.size() - 1;
+			PublishBindingsLocked();
 		}
 	}
-	dirty_ = true;
+	MarkDirty(kJoypadConfigBindingsChanged);
+	return uid;
 }
 
 JoypadOsdPosition JoypadConfigStore::GetOsdPosition() const
@@ -898,7 +1405,19 @@ void JoypadConfigStore::SetOsdPosition(JoypadOsdPosition position)
 		std::lock_guard<std::mutex> lock(mutex_);
 		osd_position_ = position;
 	}
-	dirty_ = true;
+	MarkDirty(kJoypadConfigOsdChanged);
+}
+
+JoypadOsdSettings JoypadConfigStore::GetOsdSettings() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	JoypadOsdSettings settings;
+	settings.enabled = osd_enabled_;
+	settings.color = osd_color_;
+	settings.background_color = osd_background_color_;
+	settings.font_size = osd_font_size_;
+	settings.position = osd_position_;
+	return settings;
 }
 
 bool JoypadConfigStore::GetOsdEnabled() const
@@ -913,7 +1432,7 @@ void JoypadConfigStore::SetOsdEnabled(bool enabled)
 		std::lock_guard<std::mutex> lock(mutex_);
 		osd_enabled_ = enabled;
 	}
-	dirty_ = true;
+	MarkDirty(kJoypadConfigOsdChanged);
 }
 
 std::string JoypadConfigStore::GetOsdColor() const
@@ -928,7 +1447,7 @@ void JoypadConfigStore::SetOsdColor(const std::string &color)
 		std::lock_guard<std::mutex> lock(mutex_);
 		osd_color_ = color.empty() ? "#ffffff" : color;
 	}
-	dirty_ = true;
+	MarkDirty(kJoypadConfigOsdChanged);
 }
 
 std::string JoypadConfigStore::GetOsdBackgroundColor() const
@@ -943,7 +1462,7 @@ void JoypadConfigStore::SetOsdBackgroundColor(const std::string &color)
 		std::lock_guard<std::mutex> lock(mutex_);
 		osd_background_color_ = color.empty() ? "rgba(0, 0, 0, 230)" : color;
 	}
-	dirty_ = true;
+	MarkDirty(kJoypadConfigOsdChanged);
 }
 
 int JoypadConfigStore::GetOsdFontSize() const
@@ -958,44 +1477,135 @@ void JoypadConfigStore::SetOsdFontSize(int size)
 		std::lock_guard<std::mutex> lock(mutex_);
 		osd_font_size_ = size;
 	}
-	dirty_ = true;
+	MarkDirty(kJoypadConfigOsdChanged);
 }
 
 void JoypadConfigStore::RemoveBinding(size_t index)
 {
 	{
 		std::lock_guard<std::mutex> lock(mutex_);
-		if (current_profile_index_ >= 0 && current_profile_index_ < (int)profiles_.size()) {
-			auto &bindings = profiles_[current_profile_index_].bindings;
-			if (index < bindings.size())
+		if (JoypadProfile *profile = CurrentProfile()) {
+			auto &bindings = profile->bindings;
+			if (index < bindings.size()) {
+				profile->uid_slots.erase(bindings[index].uid);
 				bindings.erase(bindings.begin() + (ptrdiff_t)index);
+				index_profile_bindings(*profile, index);
+				PublishBindingsLocked();
+			}
 		}
 	}
-	dirty_ = true;
+	MarkDirty(kJoypadConfigBindingsChanged);
 }
 
 void JoypadConfigStore::UpdateBinding(size_t index, const JoypadBinding &binding)
 {
 	{
 		std::lock_guard<std::mutex> lock(mutex_);
-		if (current_profile_index_ >= 0 && current_profile_index_ < (int)profiles_.size()) {
-			auto &bindings = profiles_[current_profile_index_].bindings;
-			if (index < bindings.size())
+		if (JoypadProfile *profile = CurrentProfile()) {
+			auto &bindings = profile->bindings;
+			if (index < bindings.size()) {
+				const int64_t uid = bindings[index].uid;
 				bindings[index] = binding;
+				bindings[index].uid = uid;
+				PublishBindingsLocked();
+			}
 		}
 	}
-	dirty_ = true;
+	MarkDirty(kJoypadConfigBindingsChanged);
 }
 
 void JoypadConfigStore::ClearCurrentProfileBindings()
 {
 	{
 		std::lock_guard<std::mutex> lock(mutex_);
-		if (current_profile_index_ >= 0 && current_profile_index_ < (int)profiles_.size()) {
-			profiles_[current_profile_index_].bindings.clear();
+		if (JoypadProfile *profile = CurrentProfile()) {
+			profile->bindings.clear();
+			profile->uid_slots.clear();
+			PublishBindingsLocked();
 		}
 	}
-	dirty_ = true;
+	MarkDirty(kJoypadConfigBindingsChanged);
+}
+
+bool JoypadConfigStore::GetBindingByUid(int64_t uid, JoypadBinding &out) const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	const JoypadProfile *profile = CurrentProfile();
+	if (!profile) {
+		return false;
+	}
+	auto it = profile->uid_slots.find(uid);
+	if (it == profile->uid_slots.end()) {
+		return false;
+	}
+	out = profile->bindings[it->second];
+	return true;
+}
+
+bool JoypadConfigStore::UpdateBindingByUid(int64_t uid, const JoypadBinding &binding)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		JoypadProfile *profile = CurrentProfile();
+		if (!profile) {
+			return false;
+		}
+		auto it = profile->uid_slots.find(uid);
+		if (it == profile->uid_slots.end()) {
+			return false;
+		}
+		JoypadBinding &slot = profile->bindings[it->second];
+		slot = binding;
+		slot.uid = uid;
+		PublishBindingsLocked();
+	}
+	MarkDirty(kJoypadConfigBindingsChanged);
+	return true;
+}
+
+bool JoypadConfigStore::SetBindingEnabledByUid(int64_t uid, bool enabled)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		JoypadProfile *profile = CurrentProfile();
+		if (!profile) {
+			return false;
+		}
+		auto it = profile->uid_slots.find(uid);
+		if (it == profile->uid_slots.end()) {
+			return false;
+		}
+		JoypadBinding &slot = profile->bindings[it->second];
+		if (slot.enabled == enabled) {
+			return true;
+		}
+		slot.enabled = enabled;
+		PublishBindingsLocked();
+	}
+	MarkDirty(kJoypadConfigBindingsChanged);
+	return true;
+}
+
+bool JoypadConfigStore::RemoveBindingByUid(int64_t uid)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		JoypadProfile *profile = CurrentProfile();
+		if (!profile) {
+			return false;
+		}
+		auto it = profile->uid_slots.find(uid);
+		if (it == profile->uid_slots.end()) {
+			return false;
+		}
+		const size_t index = it->second;
+		profile->uid_slots.erase(it);
+		profile->bindings.erase(profile->bindings.begin() + (ptrdiff_t)index);
+		index_profile_bindings(*profile, index);
+		PublishBindingsLocked();
+	}
+	MarkDirty(kJoypadConfigBindingsChanged);
+	return true;
 }
 
 std::vector<JoypadBinding> JoypadConfigStore::GetBindingsSnapshot() const
@@ -1007,179 +1617,189 @@ std::vector<JoypadBinding> JoypadConfigStore::GetBindingsSnapshot() const
 	return {};
 }
 
-std::vector<JoypadBinding> JoypadConfigStore::FindMatchingBindings(const JoypadEvent &event,
-								   const JoypadInputManager *input) const
+JoypadMatchList JoypadConfigStore::FindMatchingBindings(const JoypadEvent &event, const JoypadInputManager *input,
+							const JoypadFrontendState *state) const
+{
+	JoypadTraceScope trace_span("FindMatchingBindings");
+	JoypadMatchList result;
+	{
+		JoypadTraceScope lock_span("Config lock");
+		std::lock_guard<std::mutex> lock(mutex_);
+		result.profile = compiled_;
+	}
+	if (result.profile) {
+		const int64_t started = JoypadFlightNow();
+		matcher_->Match(*result.profile, event, input, state, result.matches);
+		const int64_t finished = JoypadFlightNow();
+		JoypadFlightRecordMatch(event, result.matches.size(), started, finished);
+		JoypadStatsRecordMatch(finished - started);
+	}
+	return result;
+}
+
+void JoypadConfigStore::PublishBindingsLocked()
+{
+	const JoypadProfile *profile = CurrentProfile();
+	const size_t live_strings = compiled_ ? compiled_->strings.size() : 0;
+	if (!string_pool_ || string_pool_->Size() > kStringPoolSlack + 4 * live_strings) {
+		// Strings are never removed from a pool; start over once most of it is garbage.
+		// Published profiles keep their old pool alive until they are released.
+		string_pool_ = std::make_shared<JoypadStringPool>();
+	}
+	static const std::vector<JoypadLayer> no_layers;
+	const std::string name = profile ? profile->name : std::string();
+	const std::vector<JoypadLayer> &layers = profile ? profile->layers : no_layers;
+	if (layer_revision_ == 0 || name != published_profile_name_ || !JoypadLayersEqual(layers, published_layers_)) {
+		++layer_revision_;
+		published_profile_name_ = name;
+		published_layers_ = layers;
+	}
+	compiled_ = JoypadCompileProfile(profile ? profile->bindings : std::vector<JoypadBinding>{}, layers,
+					 ++bindings_revision_, string_pool_, layer_revision_);
+}
+
+void JoypadBindingTransaction::Add(const JoypadBinding &binding)
+{
+	Op op;
+	op.type = OpType::Add;
+	op.binding = binding;
+	ops_.push_back(std::move(op));
+}
+
+void JoypadBindingTransaction::Update(int64_t uid, const JoypadBinding &binding)
 {
-	std::vector<JoypadBinding> matches;
-	const auto now = std::chrono::steady_clock::now();
+	Op op;
+	op.type = OpType::Update;
+	op.uid = uid;
+	op.binding = binding;
+	ops_.push_back(std::move(op));
+}
+
+void JoypadBindingTransaction::SetEnabled(int64_t uid, bool enabled)
+{
+	Op op;
+	op.type = OpType::SetEnabled;
+	op.uid = uid;
+	op.enabled = enabled;
+	ops_.push_back(std::move(op));
+}
+
+void JoypadBindingTransaction::Remove(int64_t uid)
+{
+	Op op;
+	op.type = OpType::Remove;
+	op.uid = uid;
+	ops_.push_back(std::move(op));
+}
+
+void JoypadBindingTransaction::Clear()
+{
+	Op op;
+	op.type = OpType::Clear;
+	ops_.push_back(std::move(op));
+}
+
+JoypadBindingTransaction JoypadConfigStore::BeginBindingTransaction() const
+{
+	JoypadBindingTransaction transaction;
 	std::lock_guard<std::mutex> lock(mutex_);
-	if (current_profile_index_ < 0 || current_profile_index_ >= (int)profiles_.size()) {
-		return matches;
-	}
-	const auto &current_bindings = profiles_[current_profile_index_].bindings;
-	for (const auto &binding_ref : current_bindings) {
-		JoypadBinding binding = binding_ref;
-		sync_legacy_button_from_combo(binding);
-		if (!binding.enabled) {
-			continue;
+	if (const JoypadProfile *profile = CurrentProfile()) {
+		transaction.profile_name_ = profile->name;
+	}
+	return transaction;
+}
+
+bool JoypadConfigStore::CommitBindingTransaction(const JoypadBindingTransaction &transaction, std::string *error)
+{
+	using OpType = JoypadBindingTransaction::OpType;
+
+	std::string reason;
+	for (const auto &op : transaction.ops_) {
+		if ((op.type == OpType::Add || op.type == OpType::Update) && !validate_binding(op.binding, reason)) {
+			return reject_transaction(transaction.profile_name_, reason, error);
 		}
-		if (binding.input_type == JoypadInputType::Axis) {
-			if (!event.is_axis || binding.axis_index != event.axis_index) {
-				continue;
+	}
+	if (transaction.ops_.empty()) {
+		return true;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		int profile_index = -1;
+		for (size_t i = 0; i < profiles_.size(); ++i) {
+			if (profiles_[i].name == transaction.profile_name_) {
+				profile_index = (int)i;
+				break;
 			}
-			const bool is_percent_axis = (binding.action == JoypadActionType::SetSourceVolumePercent);
-			const bool is_filter_numeric_axis = (binding.action == JoypadActionType::SetFilterProperty) &&
-							    (binding.filter_property_type == OBS_PROPERTY_INT ||
-							     binding.filter_property_type == OBS_PROPERTY_FLOAT);
-			if (binding.action == JoypadActionType::SetSourceVolumePercent) {
-				// Map axis min..max to 0..100%
-				double minv = binding.axis_min_value;
-				double maxv = binding.axis_max_value;
-				if (maxv <= minv) {
-					minv = 0.0;
-					maxv = 1024.0;
-				}
-				const double raw = event.axis_raw_value;
-				double percent = ((raw - minv) / (maxv - minv)) * 100.0;
-				if (binding.axis_inverted || binding.axis_direction == JoypadAxisDirection::Negative) {
-					percent = 100.0 - percent;
-				}
-				if (percent < 0.0) {
-					percent = 0.0;
-				}
-				if (percent > 100.0) {
-					percent = 100.0;
-				}
-				double base = percent / 100.0;
-				base = std::clamp(base, 0.0, 1.0);
-				double gamma = binding.slider_gamma > 0.0 ? binding.slider_gamma : 0.6;
-				gamma = std::clamp(gamma, 0.1, 50.0);
-				double curved = std::pow(base, gamma);
-				binding.volume_value = std::clamp(curved * 100.0, 0.0, 100.0);
-			} else if (is_filter_numeric_axis) {
-				double minv = binding.axis_min_value;
-				double maxv = binding.axis_max_value;
-				if (maxv <= minv) {
-					minv = 0.0;
-					maxv = 1024.0;
-				}
-				double normalized = (event.axis_raw_value - minv) / (maxv - minv);
-				normalized = std::clamp(normalized, 0.0, 1.0);
-				if (binding.axis_inverted || binding.axis_direction == JoypadAxisDirection::Negative) {
-					normalized = 1.0 - normalized;
-				}
-				double target_min = binding.filter_property_min;
-				double target_max = binding.filter_property_max;
-				if (target_max <= target_min) {
-					target_min = 0.0;
-					target_max = 1.0;
+		}
+		if (profile_index < 0) {
+			return reject_transaction(transaction.profile_name_, "profile no longer exists", error);
+		}
+		JoypadProfile &profile = profiles_[profile_index];
+
+		// Check every uid reference against the state it would see before touching anything.
+		std::unordered_set<int64_t> removed;
+		bool cleared = false;
+		for (const auto &op : transaction.ops_) {
+			if (op.type == OpType::Clear) {
+				cleared = true;
+			} else if (op.type != OpType::Add) {
+				if (cleared || removed.count(op.uid) != 0 || profile.uid_slots.count(op.uid) == 0) {
+					reason = "binding " + std::to_string((long long)op.uid) + " not found";
+					return reject_transaction(transaction.profile_name_, reason, error);
 				}
-				binding.filter_property_value = target_min + normalized * (target_max - target_min);
-			}
-			double value = event.axis_value;
-			if (binding.axis_inverted) {
-				value = -value;
-			}
-			const double abs_value = std::fabs(value);
-			if (!is_percent_axis && !is_filter_numeric_axis &&
-			    binding.axis_direction != JoypadAxisDirection::Both) {
-				int dir = value >= 0.0 ? 1 : -1;
-				if (dir != (int)binding.axis_direction) {
-					continue;
+				if (op.type == OpType::Remove) {
+					removed.insert(op.uid);
 				}
 			}
+		}
 
-			const double threshold_on = std::clamp(binding.axis_threshold, 0.0, 0.95);
-			const double threshold_off = threshold_on * 0.4;
-			std::string axis_key = event.device_id + ":" + std::to_string(binding.axis_index) + ":" +
-					       std::to_string((int)binding.axis_direction) + ":" +
-					       (binding.axis_inverted ? "1" : "0");
-			if (!is_percent_axis && !is_filter_numeric_axis) {
-				bool active = axis_active_[axis_key];
-				if (!active) {
-					if (abs_value < threshold_on) {
-						continue;
-					}
-					axis_active_[axis_key] = true;
-				} else {
-					if (abs_value < threshold_off) {
-						axis_active_[axis_key] = false;
-						continue;
-					}
-				}
-			}
-			if (binding.action == JoypadActionType::AdjustSourceVolume ||
-			    binding.action == JoypadActionType::AdjustFilterProperty) {
-				double sign = value >= 0.0 ? 1.0 : -1.0;
-				binding.volume_value = std::fabs(binding.volume_value) * sign;
-			}
-			const bool is_continuous_axis_action =
-				(binding.action == JoypadActionType::SetSourceVolumePercent) || is_filter_numeric_axis;
-			if (!is_continuous_axis_action) {
-				const double min_rate = std::clamp(binding.axis_min_per_second, 1.0, 60.0);
-				const double max_rate = std::clamp(binding.axis_max_per_second, min_rate, 60.0);
-				double intensity =
-					std::clamp((abs_value - threshold_on) / (1.0 - threshold_on), 0.0, 1.0);
-				double rate = min_rate + (max_rate - min_rate) * intensity;
-				int dynamic_interval_ms = (int)std::round(1000.0 / std::max(rate, 0.001));
-				dynamic_interval_ms = std::max(dynamic_interval_ms, 1);
-				std::string interval_key;
-				if (binding.uid > 0) {
-					interval_key = std::to_string((long long)binding.uid);
-				} else {
-					interval_key = event.device_id + ":" + std::to_string(binding.axis_index) +
-						       ":" + std::to_string((int)binding.action) + ":" +
-						       binding.source_name + ":" + binding.filter_name;
-				}
-				auto it_last = axis_last_dispatch_.find(interval_key);
-				if (it_last != axis_last_dispatch_.end()) {
-					const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-								     now - it_last->second)
-								     .count();
-					if (elapsed < dynamic_interval_ms) {
-						continue;
-					}
-				}
-				axis_last_dispatch_[interval_key] = now;
+		bool compact = false;
+		for (const auto &op : transaction.ops_) {
+			switch (op.type) {
+			case OpType::Add: {
+				const int64_t uid = profile.next_uid++;
+				profile.bindings.push_back(op.binding);
+				profile.bindings.back().uid = uid;
+				profile.uid_slots[uid] = profile.bindings.size() - 1;
+				break;
 			}
-		} else {
-			if (event.is_axis) {
-				continue;
+			case OpType::Update: {
+				JoypadBinding &slot = profile.bindings[profile.uid_slots[op.uid]];
+				slot = op.binding;
+				slot.uid = op.uid;
+				break;
 			}
-			if (!binding.button_combo.empty()) {
-				const std::string combo_key = button_combo_state_key(binding);
-				if (!button_combo_contains_event(binding.button_combo, event)) {
-					continue;
-				}
-				const bool combo_active_now = button_combo_is_active(binding, input);
-				if (!combo_active_now) {
-					continue;
-				}
-				const auto it_last = button_combo_last_dispatch_.find(combo_key);
-				if (it_last != button_combo_last_dispatch_.end()) {
-					const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-								     now - it_last->second)
-								     .count();
-					if (elapsed < 75) {
-						continue;
-					}
-				}
-				button_combo_last_dispatch_[combo_key] = now;
-				matches.push_back(binding);
-				continue;
+			case OpType::SetEnabled:
+				profile.bindings[profile.uid_slots[op.uid]].enabled = op.enabled;
+				break;
+			case OpType::Remove: {
+				// Marked here and dropped in a single pass below.
+				auto it = profile.uid_slots.find(op.uid);
+				profile.bindings[it->second].uid = 0;
+				profile.uid_slots.erase(it);
+				compact = true;
+				break;
 			}
-			if (binding.button != event.button) {
-				continue;
+			case OpType::Clear:
+				profile.bindings.clear();
+				profile.uid_slots.clear();
+				break;
 			}
 		}
-		if (!device_matches_input(binding.device_id, binding.device_stable_id, binding.device_type_id,
-					  binding.device_name, event.device_id, event.device_stable_id,
-					  event.device_type_id, event.device_name)) {
-			continue;
+		if (compact) {
+			auto &bindings = profile.bindings;
+			bindings.erase(std::remove_if(bindings.begin(), bindings.end(),
+						      [](const JoypadBinding &b) { return b.uid == 0; }),
+				       bindings.end());
+			index_profile_bindings(profile);
+		}
+		if (profile_index == current_profile_index_) {
+			PublishBindingsLocked();
 		}
-		matches.push_back(binding);
 	}
-	return matches;
+	MarkDirty(kJoypadConfigBindingsChanged);
+	return true;
 }
 
 std::vector<std::string> JoypadConfigStore::GetProfileNames() const
@@ -1204,25 +1824,29 @@ void JoypadConfigStore::SetCurrentProfile(int index)
 		std::lock_guard<std::mutex> lock(mutex_);
 		if (index >= 0 && index < (int)profiles_.size()) {
 			current_profile_index_ = index;
+			PublishBindingsLocked();
 		}
 	}
-	dirty_ = true;
+	MarkDirty(kJoypadConfigCurrentProfileChanged | kJoypadConfigBindingsChanged);
 }
 
 void JoypadConfigStore::AddProfile(const std::string &name)
 {
+	std::lock_guard<std::mutex> restructure(restructure_mutex_);
 	{
 		std::unique_lock<std::mutex> lock(mutex_);
 		JoypadProfile new_profile = {name, {}};
 		profiles_.push_back(new_profile);
 		current_profile_index_ = (int)profiles_.size() - 1;
 		SortAndRegisterHotkeys(lock);
+		PublishBindingsLocked();
 	}
-	dirty_ = true;
+	MarkDirty(kJoypadConfigProfilesChanged | kJoypadConfigCurrentProfileChanged | kJoypadConfigBindingsChanged);
 }
 
 void JoypadConfigStore::RenameProfile(int index, const std::string &new_name)
 {
+	std::lock_guard<std::mutex> restructure(restructure_mutex_);
 	{
 		std::unique_lock<std::mutex> lock(mutex_);
 		if (index >= 0 && index < (int)profiles_.size()) {
@@ -1230,7 +1854,7 @@ void JoypadConfigStore::RenameProfile(int index, const std::string &new_name)
 			SortAndRegisterHotkeys(lock);
 		}
 	}
-	dirty_ = true;
+	MarkDirty(kJoypadConfigProfilesChanged | kJoypadConfigCurrentProfileChanged);
 }
 
 void JoypadConfigStore::SetProfileComment(int index, const std::string &comment)
@@ -1241,7 +1865,70 @@ void JoypadConfigStore::SetProfileComment(int index, const std::string &comment)
 			profiles_[index].comment = comment;
 		}
 	}
-	dirty_ = true;
+	MarkDirty(0);
+}
+
+std::vector<JoypadLayer> JoypadConfigStore::GetProfileLayers(int index) const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (index >= 0 && index < (int)profiles_.size()) {
+		return profiles_[index].layers;
+	}
+	return {};
+}
+
+void JoypadConfigStore::SetProfileLayers(int index, const std::vector<JoypadLayer> &layers,
+					 const std::vector<int> &origins)
+{
+	uint32_t changes = 0;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (index < 0 || index >= (int)profiles_.size()) {
+			return;
+		}
+		JoypadProfile &profile = profiles_[index];
+		std::vector<int> renumber(profile.layers.size() + 1, -1);
+		renumber[0] = 0;
+		for (size_t i = 0; i < origins.size() && i < layers.size(); ++i) {
+			if (origins[i] > 0 && origins[i] < (int)renumber.size()) {
+				renumber[origins[i]] = (int)i + 1;
+			}
+		}
+		bool moved = false;
+		for (size_t i = 1; i < renumber.size(); ++i) {
+			moved = moved || renumber[i] != (int)i;
+		}
+		if (!moved && JoypadLayersEqual(profile.layers, layers)) {
+			return;
+		}
+
+		std::vector<int64_t> removed;
+		for (auto &binding : profile.bindings) {
+			if (binding.layer <= 0 || binding.layer >= (int)renumber.size()) {
+				continue;
+			}
+			if (renumber[binding.layer] < 0) {
+				removed.push_back(binding.uid);
+				binding.uid = 0;
+			} else {
+				binding.layer = renumber[binding.layer];
+			}
+		}
+		if (!removed.empty()) {
+			auto &bindings = profile.bindings;
+			bindings.erase(std::remove_if(bindings.begin(), bindings.end(),
+						      [](const JoypadBinding &b) { return b.uid == 0; }),
+				       bindings.end());
+			index_profile_bindings(profile);
+		}
+		profile.layers = layers;
+		if (index == current_profile_index_) {
+			matcher_->Forget(removed);
+			PublishBindingsLocked();
+			changes = kJoypadConfigBindingsChanged;
+		}
+	}
+	MarkDirty(changes);
 }
 
 std::string JoypadConfigStore::GetProfileComment(int index) const
@@ -1255,6 +1942,7 @@ std::string JoypadConfigStore::GetProfileComment(int index) const
 
 void JoypadConfigStore::RemoveProfile(int index)
 {
+	std::lock_guard<std::mutex> restructure(restructure_mutex_);
 	{
 		std::unique_lock<std::mutex> lock(mutex_);
 		if (profiles_.size() <= 1) {
@@ -1278,14 +1966,16 @@ void JoypadConfigStore::RemoveProfile(int index)
 				if (current_profile_index_ >= (int)profiles_.size()) {
 					current_profile_index_ = (int)profiles_.size() - 1;
 				}
+				PublishBindingsLocked();
 			}
 		}
 	}
-	dirty_ = true;
+	MarkDirty(kJoypadConfigProfilesChanged | kJoypadConfigCurrentProfileChanged | kJoypadConfigBindingsChanged);
 }
 
 void JoypadConfigStore::DuplicateProfile(int index, const std::string &new_name)
 {
+	std::lock_guard<std::mutex> restructure(restructure_mutex_);
 	{
 		std::unique_lock<std::mutex> lock(mutex_);
 		if (index >= 0 && index < (int)profiles_.size()) {
@@ -1296,9 +1986,10 @@ void JoypadConfigStore::DuplicateProfile(int index, const std::string &new_name)
 			profiles_.push_back(new_profile);
 			current_profile_index_ = (int)profiles_.size() - 1;
 			SortAndRegisterHotkeys(lock);
+			PublishBindingsLocked();
 		}
 	}
-	dirty_ = true;
+	MarkDirty(kJoypadConfigProfilesChanged | kJoypadConfigCurrentProfileChanged | kJoypadConfigBindingsChanged);
 }
 
 bool JoypadConfigStore::ExportProfile(int index, const std::string &filepath)
@@ -1312,26 +2003,8 @@ bool JoypadConfigStore::ExportProfile(int index, const std::string &filepath)
 	obs_data_t *root = obs_data_create();
 	obs_data_set_string(root, "profile_name", profile.name.c_str());
 	obs_data_set_string(root, "profile_comment", profile.comment.c_str());
-	obs_data_array_t *arr = obs_data_array_create();
-	for (const auto &b : profile.bindings) {
-		obs_data_t *item = obs_data_create();
-		save_binding_to_data(b, item);
-		// Keep exported profiles portable and less device-specific.
-		// Resolution will still work via device_id/device_type_id matching.
-		obs_data_erase(item, "device_stable_id");
-		if (obs_data_array_t *combo_array = obs_data_get_array(item, "button_combo")) {
-			const size_t combo_count = obs_data_array_count(combo_array);
-			for (size_t i = 0; i < combo_count; ++i) {
-				if (obs_data_t *combo_item = obs_data_array_item(combo_array, i)) {
-					obs_data_erase(combo_item, "device_stable_id");
-					obs_data_release(combo_item);
-				}
-			}
-			obs_data_array_release(combo_array);
-		}
-		obs_data_array_push_back(arr, item);
-		obs_data_release(item);
-	}
+	save_layers_to_data(profile.layers, root, true);
+	obs_data_array_t *arr = portable_bindings_array(profile.bindings);
 	obs_data_set_array(root, "bindings", arr);
 	obs_data_array_release(arr);
 
@@ -1361,6 +2034,7 @@ bool JoypadConfigStore::ImportProfile(const std::string &filepath)
 		profile.name = "Imported";
 	}
 	profile.comment = obs_data_get_string(root, "profile_comment");
+	load_layers_from_data(profile.layers, root);
 
 	obs_data_array_t *hotkey_data = obs_data_get_array(root, "hotkey_data");
 
@@ -1378,41 +2052,17 @@ bool JoypadConfigStore::ImportProfile(const std::string &filepath)
 	}
 	obs_data_release(root);
 
+	std::lock_guard<std::mutex> restructure(restructure_mutex_);
 	{
 		std::unique_lock<std::mutex> lock(mutex_);
-		std::string base_name = profile.name;
-		int counter = 1;
-		bool collision = true;
-		while (collision) {
-			collision = false;
-			for (const auto &p : profiles_) {
-				if (p.name.size() == profile.name.size() &&
-				    std::equal(p.name.begin(), p.name.end(), profile.name.begin(), [](char a, char b) {
-					    return std::tolower((unsigned char)a) == std::tolower((unsigned char)b);
-				    })) {
-					collision = true;
-					break;
-				}
-			}
-			if (collision) {
-				profile.name = base_name + " (" + std::to_string(counter++) + ")";
-			}
-		}
+		profile.name = unique_profile_name(profiles_, profile.name);
 
-		int64_t max_uid = 0;
-		for (const auto &b : profile.bindings) {
-			if (b.uid > max_uid)
-				max_uid = b.uid;
-		}
-		int64_t local_gen = max_uid + 1;
-		for (auto &b : profile.bindings) {
-			if (b.uid == 0)
-				b.uid = local_gen++;
-		}
+		index_profile_bindings(profile);
 		profile.hotkey_id = OBS_INVALID_HOTKEY_ID;
 		profiles_.push_back(profile);
 		current_profile_index_ = (int)profiles_.size() - 1;
 		SortAndRegisterHotkeys(lock);
+		PublishBindingsLocked();
 
 		if (hotkey_data) {
 			obs_hotkey_id id = OBS_INVALID_HOTKEY_ID;
@@ -1426,10 +2076,250 @@ bool JoypadConfigStore::ImportProfile(const std::string &filepath)
 			obs_data_array_release(hotkey_data);
 		}
 	}
-	dirty_ = true;
+	MarkDirty(kJoypadConfigProfilesChanged | kJoypadConfigCurrentProfileChanged | kJoypadConfigBindingsChanged);
+	return true;
+}
+
+JoypadProfileBundle::~JoypadProfileBundle()
+{
+	Release();
+}
+
+JoypadProfileBundle &JoypadProfileBundle::operator=(JoypadProfileBundle &&other)
+{
+	if (this != &other) {
+		Release();
+		entries_ = std::move(other.entries_);
+		other.entries_.clear();
+	}
+	return *this;
+}
+
+void JoypadProfileBundle::Release()
+{
+	for (auto &entry : entries_) {
+		if (entry.hotkey_data) {
+			obs_data_array_release(entry.hotkey_data);
+			entry.hotkey_data = nullptr;
+		}
+	}
+	entries_.clear();
+}
+
+bool JoypadConfigStore::ExportBundle(const std::string &filepath, const BundleProgressCallback &progress,
+				     const std::atomic<bool> *cancel, std::string *error) const
+{
+	struct ExportItem {
+		std::string name;
+		std::string comment;
+		std::vector<JoypadLayer> layers;
+		std::vector<JoypadBinding> bindings;
+		obs_hotkey_id hotkey_id = OBS_INVALID_HOTKEY_ID;
+	};
+	std::vector<ExportItem> items;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		items.reserve(profiles_.size());
+		for (const auto &profile : profiles_) {
+			items.push_back({profile.name, profile.comment, profile.layers, profile.bindings,
+					 profile.hotkey_id});
+		}
+	}
+
+	// Written next to the target and renamed at the end, so a failed export never
+	// leaves a half-written bundle behind.
+	const std::string tmp_path = filepath + ".tmp";
+	std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+	if (!out) {
+		return bundle_failure("export", filepath, "cannot write " + tmp_path, error);
+	}
+
+	obs_data_t *header = obs_data_create();
+	obs_data_set_string(header, "format", kBundleFormat);
+	obs_data_set_int(header, "version", kBundleVersion);
+	obs_data_set_int(header, "profile_count", (long long)items.size());
+	out << obs_data_get_json(header) << '\n';
+	obs_data_release(header);
+
+	for (size_t i = 0; i < items.size(); ++i) {
+		if (cancel && cancel->load()) {
+			out.close();
+			os_unlink(tmp_path.c_str());
+			return bundle_failure("export", filepath, "cancelled", error);
+		}
+
+		ExportItem &item = items[i];
+		obs_data_t *p_item = obs_data_create();
+		obs_data_set_string(p_item, "name", item.name.c_str());
+		obs_data_set_string(p_item, "comment", item.comment.c_str());
+		save_layers_to_data(item.layers, p_item, true);
+		obs_data_array_t *bindings_array = portable_bindings_array(item.bindings);
+		obs_data_set_array(p_item, "bindings", bindings_array);
+		obs_data_array_release(bindings_array);
+		if (item.hotkey_id != OBS_INVALID_HOTKEY_ID) {
+			if (obs_data_array_t *hotkey_data = obs_hotkey_save(item.hotkey_id)) {
+				obs_data_set_array(p_item, "hotkey_data", hotkey_data);
+				obs_data_array_release(hotkey_data);
+			}
+		}
+		out << obs_data_get_json(p_item) << '\n';
+		obs_data_release(p_item);
+		// Only one profile is held as obs_data at a time.
+		std::vector<JoypadBinding>().swap(item.bindings);
+
+		if (progress) {
+			progress(i + 1, items.size());
+		}
+	}
+
+	out.close();
+	if (out.fail()) {
+		os_unlink(tmp_path.c_str());
+		return bundle_failure("export", filepath, "write error", error);
+	}
+	if (os_rename(tmp_path.c_str(), filepath.c_str()) != 0) {
+		os_unlink(tmp_path.c_str());
+		return bundle_failure("export", filepath, "cannot replace the target file", error);
+	}
+	obs_log(LOG_INFO, "Exported %d profiles to %s", (int)items.size(), filepath.c_str());
 	return true;
 }
 
+bool JoypadConfigStore::ReadBundle(const std::string &filepath, JoypadProfileBundle &bundle,
+				   const BundleProgressCallback &progress, const std::atomic<bool> *cancel,
+				   std::string *error)
+{
+	std::ifstream in(filepath, std::ios::binary);
+	if (!in) {
+		return bundle_failure("import", filepath, "cannot open the file", error);
+	}
+
+	std::string line;
+	if (!std::getline(in, line)) {
+		return bundle_failure("import", filepath, "the file is empty", error);
+	}
+	obs_data_t *header = obs_data_create_from_json(line.c_str());
+	if (!header) {
+		return bundle_failure("import", filepath, "not a profile bundle", error);
+	}
+	const std::string format = obs_data_get_string(header, "format");
+	const int version = (int)obs_data_get_int(header, "version");
+	const size_t total = (size_t)std::max<long long>(obs_data_get_int(header, "profile_count"), 0);
+	obs_data_release(header);
+	if (format != kBundleFormat) {
+		return bundle_failure("import", filepath, "not a profile bundle", error);
+	}
+	if (version < 1 || version > kBundleVersion) {
+		return bundle_failure("import", filepath, "unsupported bundle version " + std::to_string(version),
+				      error);
+	}
+
+	JoypadProfileBundle result;
+	result.entries_.reserve(total);
+	size_t line_number = 1;
+	while (std::getline(in, line)) {
+		++line_number;
+		if (cancel && cancel->load()) {
+			return bundle_failure("import", filepath, "cancelled", error);
+		}
+		if (line.empty() || line == "\r") {
+			continue;
+		}
+
+		obs_data_t *p_item = obs_data_create_from_json(line.c_str());
+		if (!p_item) {
+			return bundle_failure("import", filepath,
+					      "line " + std::to_string(line_number) + " is not valid JSON", error);
+		}
+		ParsedProfile item;
+		const bool named = parse_profile_item(p_item, item);
+		obs_data_release(p_item);
+		JoypadProfileBundle::Entry entry;
+		entry.profile = std::move(item.profile);
+		entry.hotkey_data = item.hotkey_data;
+		result.entries_.push_back(std::move(entry));
+		if (!named) {
+			return bundle_failure("import", filepath,
+					      "profile without a name on line " + std::to_string(line_number), error);
+		}
+
+		const JoypadProfile &profile = result.entries_.back().profile;
+		for (size_t i = 0; i < profile.bindings.size(); ++i) {
+			std::string reason;
+			if (!validate_binding(profile.bindings[i], reason)) {
+				return bundle_failure("import", filepath,
+						      "profile '" + profile.name + "', binding " +
+							      std::to_string(i + 1) + ": " + reason,
+						      error);
+			}
+		}
+
+		if (progress) {
+			progress(result.entries_.size(), std::max(total, result.entries_.size()));
+		}
+	}
+
+	if (result.entries_.size() != total) {
+		return bundle_failure("import", filepath,
+				      "expected " + std::to_string(total) + " profiles, found " +
+					      std::to_string(result.entries_.size()),
+				      error);
+	}
+	bundle = std::move(result);
+	return true;
+}
+
+size_t JoypadConfigStore::CommitBundle(JoypadProfileBundle &bundle)
+{
+	if (bundle.Empty()) {
+		return 0;
+	}
+
+	std::lock_guard<std::mutex> restructure(restructure_mutex_);
+	std::vector<std::pair<std::string, obs_data_array_t *>> hotkey_data;
+	std::vector<std::pair<obs_hotkey_id, obs_data_array_t *>> hotkey_loads;
+	const size_t added = bundle.Size();
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		for (auto &entry : bundle.entries_) {
+			JoypadProfile &profile = entry.profile;
+			profile.name = unique_profile_name(profiles_, profile.name);
+			profile.hotkey_id = OBS_INVALID_HOTKEY_ID;
+			if (entry.hotkey_data) {
+				hotkey_data.emplace_back(profile.name, entry.hotkey_data);
+				entry.hotkey_data = nullptr;
+			}
+			profiles_.push_back(std::move(profile));
+		}
+		current_profile_index_ = (int)(profiles_.size() - added);
+		// One re-registration pass for the whole bundle.
+		SortAndRegisterHotkeys(lock);
+		PublishBindingsLocked();
+
+		for (const auto &item : hotkey_data) {
+			for (const auto &profile : profiles_) {
+				if (profile.name == item.first) {
+					hotkey_loads.emplace_back(profile.hotkey_id, item.second);
+					break;
+				}
+			}
+		}
+	}
+	bundle.Release();
+
+	for (const auto &item : hotkey_loads) {
+		if (item.first != OBS_INVALID_HOTKEY_ID) {
+			obs_hotkey_load(item.first, item.second);
+		}
+	}
+	for (const auto &item : hotkey_data) {
+		obs_data_array_release(item.second);
+	}
+	MarkDirty(kJoypadConfigProfilesChanged | kJoypadConfigCurrentProfileChanged | kJoypadConfigBindingsChanged);
+	obs_log(LOG_INFO, "Imported %d profiles from bundle", (int)added);
+	return added;
+}
+
 std::string JoypadConfigStore::GetProfileHotkeyString(int index) const
 {
 	obs_hotkey_id id = OBS_INVALID_HOTKEY_ID;
@@ -1443,6 +2333,13 @@ std::string JoypadConfigStore::GetProfileHotkeyString(int index) const
 	if (id == OBS_INVALID_HOTKEY_ID) {
 		return "";
 	}
+	{
+		std::lock_guard<std::mutex> lock(hotkey_strings_mutex_);
+		auto it = hotkey_strings_.find(id);
+		if (it != hotkey_strings_.end()) {
+			return it->second;
+		}
+	}
 
 	obs_data_array_t *bindings = obs_hotkey_save(id);
 	if (!bindings) {
@@ -1499,9 +2396,24 @@ std::string JoypadConfigStore::GetProfileHotkeyString(int index) const
 			break;
 	}
 	obs_data_array_release(bindings);
+
+	std::lock_guard<std::mutex> lock(hotkey_strings_mutex_);
+	hotkey_strings_[id] = result;
 	return result;
 }
 
+void JoypadConfigStore::ForgetHotkeyString(obs_hotkey_id id)
+{
+	{
+		// Only ids cached above belong to profiles; other hotkeys are not ours to report.
+		std::lock_guard<std::mutex> lock(hotkey_strings_mutex_);
+		if (hotkey_strings_.erase(id) == 0) {
+			return;
+		}
+	}
+	NotifyChanged(kJoypadConfigProfilesChanged);
+}
+
 std::string JoypadConfigStore::GetLastFilePath() const
 {
 	std::lock_guard<std::mutex> lock(mutex_);
@@ -1514,5 +2426,5 @@ void JoypadConfigStore::SetLastFilePath(const std::string &path)
 		std::lock_guard<std::mutex> lock(mutex_);
 		last_file_path_ = path;
 	}
-	dirty_ = true;
+	MarkDirty(0);
 }
@@ -24,50 +24,12 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <memory>
 #include <obs.h>
 #include <functional>
 
-enum class JoypadActionType {
-	SwitchScene = 0,
-	ToggleSourceVisibility = 1,
-	SetSourceVisibility = 2,
-	ToggleSourceMute = 3,
-	SetSourceMute = 4,
-	SetSourceVolume = 5,
-	MediaPlayPause = 6,
-	MediaRestart = 7,
-	MediaStop = 8,
-	ToggleFilterEnabled = 9,
-	SetFilterEnabled = 10,
-	AdjustSourceVolume = 11,
-	SetSourceVolumePercent = 12,
-	NextScene = 13,
-	PreviousScene = 14,
-	ToggleStreaming = 15,
-	ToggleRecording = 16,
-	ToggleVirtualCam = 17,
-	ToggleStudioMode = 18,
-	TransitionToProgram = 19,
-	SetFilterProperty = 20,
-	AdjustFilterProperty = 21,
-	SourceTransform = 22,
-	Screenshot = 23,
-	StartReplayBuffer = 24,
-	StopReplayBuffer = 25,
-	ToggleReplayBuffer = 26,
-	SaveReplayBuffer = 27,
-};
-
-enum class JoypadInputType {
-	Button = 0,
-	Axis = 1,
-};
-
-enum class JoypadAxisDirection {
-	Both = 0,
-	Negative = -1,
-	Positive = 1,
-};
+#include "joypad-config-watcher.h"
+#include "joypad-core.h"
 
 enum class JoypadOsdPosition {
 	TopLeft = 0,
@@ -81,108 +43,109 @@ enum class JoypadOsdPosition {
 	BottomRight = 8
 };
 
-enum class JoypadSourceTransformOp {
-	FlipHorizontal = 0,
-	FlipVertical = 1,
-	AlignLeft = 2,
-	AlignRight = 3,
-	AlignTop = 4,
-	AlignBottom = 5,
-	AlignTopLeft = 6,
-	AlignTopRight = 7,
-	AlignBottomLeft = 8,
-	AlignBottomRight = 9,
-	AlignCenterLeft = 10,
-	AlignCenterRight = 11,
-	Rotate90CW = 12,
-	Rotate90CCW = 13,
-	Rotate180 = 14,
-	CenterToScreen = 15,
-	FitToScreen = 16,
-	StretchToScreen = 17,
-};
-
-enum class JoypadScreenshotTarget {
-	Program = 0,
-	Source = 1,
-};
-
-struct JoypadButtonComboEntry {
-	std::string device_id;
-	std::string device_stable_id;
-	std::string device_type_id;
-	std::string device_name;
-	int button = -1;
-};
-
-struct JoypadBinding {
-	int64_t uid = 0;
-	std::string device_id;
-	std::string device_stable_id;
-	std::string device_type_id;
-	std::string device_name;
-	int button = -1;
-	std::vector<JoypadButtonComboEntry> button_combo;
-	JoypadInputType input_type = JoypadInputType::Button;
-	int axis_index = -1;
-	JoypadAxisDirection axis_direction = JoypadAxisDirection::Both;
-	bool axis_inverted = false;
-	double axis_threshold = 0.10;
-	double axis_min_per_second = 2.5;
-	double axis_max_per_second = 20.0;
-	int axis_interval_ms = 150;
-	double axis_min_value = 0.0;
-	double axis_max_value = 1024.0;
-
-	JoypadActionType action = JoypadActionType::SwitchScene;
-
-	bool use_current_scene = false;
-	std::string scene_name;
-
-	std::string source_name;
-	std::string filter_name;
-	std::string filter_property_name;
-	int filter_property_type = 0;
-	double filter_property_value = 0.0;
-	double filter_property_min = 0.0;
-	double filter_property_max = 1.0;
-	int filter_property_list_format = 0;
-	std::string filter_property_list_string;
-	long long filter_property_list_int = 0;
-	double filter_property_list_float = 0.0;
-	JoypadSourceTransformOp source_transform_op = JoypadSourceTransformOp::CenterToScreen;
-	JoypadScreenshotTarget screenshot_target = JoypadScreenshotTarget::Program;
-
-	bool bool_value = false;
-	bool allow_above_unity = false;
-	double volume_value = 1.0;
-	double slider_gamma = 0.6;
+struct JoypadOsdSettings {
 	bool enabled = true;
-};
-
-struct JoypadEvent {
-	std::string device_id;
-	std::string device_stable_id;
-	std::string device_type_id;
-	std::string device_name;
-	int button = -1;
-	bool is_axis = false;
-	int axis_index = -1;
-	double axis_value = 0.0;
-	double axis_raw_value = 0.0;
+	std::string color = "#ffffff";
+	std::string background_color = "rgba(0, 0, 0, 230)";
+	int font_size = 24;
+	JoypadOsdPosition position = JoypadOsdPosition::BottomCenter;
 };
 
 class JoypadInputManager;
+class JoypadMatcher;
+class JoypadStringPool;
+struct JoypadCompiledProfile;
+struct JoypadMatchList;
 
 struct JoypadProfile {
 	std::string name;
 	std::string comment;
+	std::vector<JoypadLayer> layers;
 	std::vector<JoypadBinding> bindings;
 	obs_hotkey_id hotkey_id = OBS_INVALID_HOTKEY_ID;
+	// Next uid handed out in this profile and uid -> position in bindings.
+	int64_t next_uid = 1;
+	std::unordered_map<int64_t, size_t> uid_slots;
 };
 
+// Edits staged against one profile and applied by JoypadConfigStore::CommitBindingTransaction
+// as a single step: either every edit is applied or none is.
+class JoypadBindingTransaction {
+public:
+	void Add(const JoypadBinding &binding);
+	void Update(int64_t uid, const JoypadBinding &binding);
+	void SetEnabled(int64_t uid, bool enabled);
+	void Remove(int64_t uid);
+	void Clear();
+
+	bool Empty() const { return ops_.empty(); }
+	size_t Size() const { return ops_.size(); }
+	const std::string &ProfileName() const { return profile_name_; }
+
+private:
+	friend class JoypadConfigStore;
+
+	enum class OpType {
+		Add,
+		Update,
+		SetEnabled,
+		Remove,
+		Clear,
+	};
+
+	struct Op {
+		OpType type = OpType::Add;
+		int64_t uid = 0;
+		bool enabled = true;
+		JoypadBinding binding;
+	};
+
+	std::string profile_name_;
+	std::vector<Op> ops_;
+};
+
+// Profiles read from a bundle file: parsed and validated, but not yet part of the store.
+// Hand it to JoypadConfigStore::CommitBundle to add them.
+class JoypadProfileBundle {
+public:
+	JoypadProfileBundle() = default;
+	~JoypadProfileBundle();
+	JoypadProfileBundle(JoypadProfileBundle &&) = default;
+	JoypadProfileBundle &operator=(JoypadProfileBundle &&other);
+	JoypadProfileBundle(const JoypadProfileBundle &) = delete;
+	JoypadProfileBundle &operator=(const JoypadProfileBundle &) = delete;
+
+	bool Empty() const { return entries_.empty(); }
+	size_t Size() const { return entries_.size(); }
+
+private:
+	friend class JoypadConfigStore;
+
+	struct Entry {
+		JoypadProfile profile;
+		obs_data_array_t *hotkey_data = nullptr;
+	};
+
+	void Release();
+
+	std::vector<Entry> entries_;
+};
+
+// Change bits passed to JoypadConfigStore subscribers.
+constexpr uint32_t kJoypadConfigProfilesChanged = 1u << 0;
+constexpr uint32_t kJoypadConfigCurrentProfileChanged = 1u << 1;
+constexpr uint32_t kJoypadConfigBindingsChanged = 1u << 2;
+constexpr uint32_t kJoypadConfigDirtyChanged = 1u << 3;
+constexpr uint32_t kJoypadConfigOsdChanged = 1u << 4;
+constexpr uint32_t kJoypadConfigAllChanged = kJoypadConfigProfilesChanged | kJoypadConfigCurrentProfileChanged |
+					     kJoypadConfigBindingsChanged | kJoypadConfigDirtyChanged |
+					     kJoypadConfigOsdChanged;
+
 class JoypadConfigStore {
 public:
+	JoypadConfigStore();
+	~JoypadConfigStore();
+
 	using ProfileSwitchCallback = std::function<void(const std::string &)>;
 	void SetProfileSwitchCallback(ProfileSwitchCallback callback);
 
@@ -192,14 +155,40 @@ public:
 	bool HasUnsavedChanges() const;
 	void DiscardChanges();
 
-	void AddBinding(const JoypadBinding &binding);
+	// Applies external edits of the config file, keeping state of untouched bindings.
+	// Skipped while there are unsaved changes made inside OBS. Registers and loads OBS
+	// hotkeys, so it runs on the UI thread; the file watcher queues it there.
+	bool ReloadFromDisk();
+	bool GetWatchConfigFile() const;
+	void SetWatchConfigFile(bool enabled);
+
+	// Change notifications. The version grows with every notified change. Subscribers get
+	// kJoypadConfig*Changed bits on the thread that made the change, after the store lock is
+	// released; they must return quickly and must not edit the store or (un)subscribe.
+	using ChangeCallback = std::function<void(uint32_t changes)>;
+	uint64_t GetVersion() const;
+	int Subscribe(ChangeCallback callback);
+	void Unsubscribe(int id);
+
+	int64_t AddBinding(const JoypadBinding &binding);
 	void RemoveBinding(size_t index);
 	void UpdateBinding(size_t index, const JoypadBinding &binding);
 	void ClearCurrentProfileBindings();
 
+	// Lookups and edits by uid in the current profile, without copying the profile.
+	bool GetBindingByUid(int64_t uid, JoypadBinding &out) const;
+	bool UpdateBindingByUid(int64_t uid, const JoypadBinding &binding);
+	bool SetBindingEnabledByUid(int64_t uid, bool enabled);
+	bool RemoveBindingByUid(int64_t uid);
+
+	// Stages edits against the current profile; nothing changes until the commit.
+	JoypadBindingTransaction BeginBindingTransaction() const;
+	bool CommitBindingTransaction(const JoypadBindingTransaction &transaction, std::string *error = nullptr);
+
 	std::vector<JoypadBinding> GetBindingsSnapshot() const;
-	std::vector<JoypadBinding> FindMatchingBindings(const JoypadEvent &event,
-							const JoypadInputManager *input = nullptr) const;
+	// Without a state, conditions on OBS state are not checked.
+	JoypadMatchList FindMatchingBindings(const JoypadEvent &event, const JoypadInputManager *input = nullptr,
+					     const JoypadFrontendState *state = nullptr) const;
 	void SwitchProfileByHotkey(obs_hotkey_id id);
 
 	// Profile Management
@@ -210,11 +199,28 @@ public:
 	void RenameProfile(int index, const std::string &new_name);
 	void SetProfileComment(int index, const std::string &comment);
 	std::string GetProfileComment(int index) const;
+	std::vector<JoypadLayer> GetProfileLayers(int index) const;
+	// origins[i] is the number layers[i] had before, or 0 for a new layer. The profile's
+	// bindings follow their layer to its new number; bindings on layers left out are removed.
+	void SetProfileLayers(int index, const std::vector<JoypadLayer> &layers, const std::vector<int> &origins);
 	void RemoveProfile(int index);
 	void DuplicateProfile(int index, const std::string &new_name);
 	bool ExportProfile(int index, const std::string &filepath);
 	bool ImportProfile(const std::string &filepath);
+
+	// Bundles hold many profiles, one JSON object per line. ExportBundle and ReadBundle do
+	// their file work outside the store lock and may run on a worker thread; progress is
+	// reported on that thread. CommitBundle adds a whole bundle in one step.
+	using BundleProgressCallback = std::function<void(size_t done, size_t total)>;
+	bool ExportBundle(const std::string &filepath, const BundleProgressCallback &progress = {},
+			  const std::atomic<bool> *cancel = nullptr, std::string *error = nullptr) const;
+	static bool ReadBundle(const std::string &filepath, JoypadProfileBundle &bundle,
+			       const BundleProgressCallback &progress = {}, const std::atomic<bool> *cancel = nullptr,
+			       std::string *error = nullptr);
+	size_t CommitBundle(JoypadProfileBundle &bundle);
+	// Cached per hotkey until OBS reports that its bindings changed.
 	std::string GetProfileHotkeyString(int index) const;
+	void ForgetHotkeyString(obs_hotkey_id id);
 	std::string GetLastFilePath() const;
 	void SetLastFilePath(const std::string &path);
 
@@ -228,15 +234,26 @@ public:
 	void SetOsdFontSize(int size);
 	JoypadOsdPosition GetOsdPosition() const;
 	void SetOsdPosition(JoypadOsdPosition position);
+	// All OSD fields under one lock; re-read after kJoypadConfigOsdChanged.
+	JoypadOsdSettings GetOsdSettings() const;
 
 private:
 	std::vector<JoypadProfile> profiles_;
 	int current_profile_index_ = 0;
 	mutable std::mutex mutex_;
+	// Held, before mutex_, by every operation that rebuilds profiles_ or its hotkeys. They drop
+	// mutex_ around OBS hotkey calls (SortAndRegisterHotkeys empties profiles_ meanwhile) and
+	// only set dirty_ at the end, so a file reload must not run in between.
+	std::mutex restructure_mutex_;
 	std::atomic<bool> dirty_{false};
-	mutable std::unordered_map<std::string, bool> axis_active_;
-	mutable std::unordered_map<std::string, std::chrono::steady_clock::time_point> button_combo_last_dispatch_;
-	mutable std::unordered_map<std::string, std::chrono::steady_clock::time_point> axis_last_dispatch_;
+	std::shared_ptr<const JoypadCompiledProfile> compiled_;
+	uint64_t bindings_revision_ = 0;
+	// Bumped when the published profile or its layers differ from the last publish.
+	uint64_t layer_revision_ = 0;
+	std::string published_profile_name_;
+	std::vector<JoypadLayer> published_layers_;
+	std::shared_ptr<JoypadStringPool> string_pool_;
+	std::unique_ptr<JoypadMatcher> matcher_;
 	std::string last_file_path_;
 	ProfileSwitchCallback on_profile_switch_;
 	bool osd_enabled_ = true;
@@ -244,5 +261,29 @@ private:
 	int osd_font_size_ = 24;
 	JoypadOsdPosition osd_position_ = JoypadOsdPosition::BottomCenter;
 	std::string osd_background_color_ = "rgba(0, 0, 0, 230)";
+	bool watch_config_file_ = false;
+	std::atomic<bool> reload_queued_{false};
+	size_t disk_hash_ = 0;
+	std::atomic<uint64_t> version_{0};
+	// Own lock: OBS reports binding changes while mutex_ may be held by Load().
+	mutable std::mutex hotkey_strings_mutex_;
+	mutable std::unordered_map<obs_hotkey_id, std::string> hotkey_strings_;
+	bool hotkey_signal_connected_ = false;
+	std::mutex subscribers_mutex_;
+	std::vector<std::pair<int, ChangeCallback>> subscribers_;
+	int next_subscriber_id_ = 1;
 	void SortAndRegisterHotkeys(std::unique_lock<std::mutex> &lock);
+	JoypadProfile *CurrentProfile();
+	const JoypadProfile *CurrentProfile() const;
+	void PublishBindingsLocked();
+	void LoadFromDisk();
+	void SaveToDisk();
+	void MarkDirty(uint32_t changes);
+	void NotifyChanged(uint32_t changes);
+	void ReadSettingsLocked(obs_data_t *data);
+	void UpdateConfigWatcher();
+	void QueueReload();
+
+	// Last member: its thread calls back into the store and must stop first.
+	JoypadConfigWatcher watcher_;
 };
@@ -0,0 +1,186 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "joypad-core.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdarg>
+#include <cstdio>
+#include <iterator>
+
+namespace {
+std::atomic<JoypadLogHandler> g_log_handler{nullptr};
+
+bool combo_entries_equal(const JoypadButtonComboEntry &a, const JoypadButtonComboEntry &b)
+{
+	return a.button == b.button && a.device_id == b.device_id && a.device_stable_id == b.device_stable_id &&
+	       a.device_type_id == b.device_type_id && a.device_name == b.device_name;
+}
+} // namespace
+
+void JoypadSetLogHandler(JoypadLogHandler handler)
+{
+	g_log_handler.store(handler, std::memory_order_release);
+}
+
+void JoypadLog(int level, const char *format, ...)
+{
+	char message[1024];
+	va_list args;
+	va_start(args, format);
+	vsnprintf(message, sizeof(message), format, args);
+	va_end(args);
+
+	JoypadLogHandler handler = g_log_handler.load(std::memory_order_acquire);
+	if (handler) {
+		handler(level, message);
+		return;
+	}
+	fprintf(stderr, "[joypad-core] %s\n", message);
+}
+
+uint64_t JoypadHashString(const std::string &value)
+{
+	if (value.empty()) {
+		return 0;
+	}
+	// FNV-1a; zero is reserved for "unset".
+	uint64_t hash = 14695981039346656037ull;
+	for (unsigned char c : value) {
+		hash ^= c;
+		hash *= 1099511628211ull;
+	}
+	return hash ? hash : 1;
+}
+
+const char *JoypadActionTypeName(JoypadActionType action)
+{
+	static constexpr const char *kNames[] = {
+		"SwitchScene",
+		"ToggleSourceVisibility",
+		"SetSourceVisibility",
+		"ToggleSourceMute",
+		"SetSourceMute",
+		"SetSourceVolume",
+		"MediaPlayPause",
+		"MediaRestart",
+		"MediaStop",
+		"ToggleFilterEnabled",
+		"SetFilterEnabled",
+		"AdjustSourceVolume",
+		"SetSourceVolumePercent",
+		"NextScene",
+		"PreviousScene",
+		"ToggleStreaming",
+		"ToggleRecording",
+		"ToggleVirtualCam",
+		"ToggleStudioMode",
+		"TransitionToProgram",
+		"SetFilterProperty",
+		"AdjustFilterProperty",
+		"SourceTransform",
+		"Screenshot",
+		"StartReplayBuffer",
+		"StopReplayBuffer",
+		"ToggleReplayBuffer",
+		"SaveReplayBuffer",
+	};
+	static_assert(std::size(kNames) == kJoypadActionTypeCount, "every action type needs a name");
+	const size_t index = (size_t)action;
+	return index < std::size(kNames) ? kNames[index] : "Unknown";
+}
+
+JoypadDeviceKey JoypadMakeDeviceKey(const std::string &id, const std::string &stable_id, const std::string &type_id)
+{
+	JoypadDeviceKey key;
+	key.id = JoypadHashString(id);
+	key.stable_id = JoypadHashString(stable_id);
+	key.type_id = JoypadHashString(type_id);
+	return key;
+}
+
+bool JoypadIsXboxLikeDevice(const std::string &type_id, const std::string &name)
+{
+	std::string type_up = type_id;
+	std::string name_up = name;
+	std::transform(type_up.begin(), type_up.end(), type_up.begin(),
+		       [](unsigned char c) { return (char)std::toupper(c); });
+	std::transform(name_up.begin(), name_up.end(), name_up.begin(),
+		       [](unsigned char c) { return (char)std::toupper(c); });
+	return type_up.find("VID_045E") != std::string::npos || name_up.find("XBOX") != std::string::npos;
+}
+
+bool JoypadLayersEqual(const std::vector<JoypadLayer> &a, const std::vector<JoypadLayer> &b)
+{
+	return a.size() == b.size() &&
+	       std::equal(a.begin(), a.end(), b.begin(), [](const JoypadLayer &x, const JoypadLayer &y) {
+		       return x.name == y.name && combo_entries_equal(x.modifier, y.modifier);
+	       });
+}
+
+bool JoypadBindingsEqual(const JoypadBinding &a, const JoypadBinding &b)
+{
+	return a.uid == b.uid && a.device_id == b.device_id && a.device_stable_id == b.device_stable_id &&
+	       a.device_type_id == b.device_type_id && a.device_name == b.device_name && a.button == b.button &&
+	       a.button_combo.size() == b.button_combo.size() &&
+	       std::equal(a.button_combo.begin(), a.button_combo.end(), b.button_combo.begin(),
+			  combo_entries_equal) &&
+	       a.layer == b.layer && a.require_state == b.require_state && a.forbid_state == b.forbid_state &&
+	       a.condition_scene == b.condition_scene && a.combo_mode == b.combo_mode &&
+	       a.combo_trigger == b.combo_trigger &&
+	       a.combo_window_ms == b.combo_window_ms && a.input_type == b.input_type && a.axis_index == b.axis_index &&
+	       a.axis_direction == b.axis_direction && a.axis_inverted == b.axis_inverted &&
+	       a.axis_threshold == b.axis_threshold && a.axis_min_per_second == b.axis_min_per_second &&
+	       a.axis_max_per_second == b.axis_max_per_second && a.axis_interval_ms == b.axis_interval_ms &&
+	       a.axis_min_value == b.axis_min_value && a.axis_max_value == b.axis_max_value &&
+	       a.action == b.action && a.use_current_scene == b.use_current_scene && a.scene_name == b.scene_name &&
+	       a.source_name == b.source_name && a.filter_name == b.filter_name &&
+	       a.filter_property_name == b.filter_property_name &&
+	       a.filter_property_type == b.filter_property_type &&
+	       a.filter_property_value == b.filter_property_value &&
+	       a.filter_property_min == b.filter_property_min && a.filter_property_max == b.filter_property_max &&
+	       a.filter_property_list_format == b.filter_property_list_format &&
+	       a.filter_property_list_string == b.filter_property_list_string &&
+	       a.filter_property_list_int == b.filter_property_list_int &&
+	       a.filter_property_list_float == b.filter_property_list_float &&
+	       a.source_transform_op == b.source_transform_op && a.screenshot_target == b.screenshot_target &&
+	       a.bool_value == b.bool_value && a.allow_above_unity == b.allow_above_unity &&
+	       a.volume_value == b.volume_value && a.slider_gamma == b.slider_gamma && a.enabled == b.enabled;
+}
+
+JoypadActionParams JoypadActionParams::FromBinding(const JoypadBinding &binding)
+{
+	JoypadActionParams params;
+	params.action = binding.action;
+	params.use_current_scene = binding.use_current_scene;
+	params.bool_value = binding.bool_value;
+	params.allow_above_unity = binding.allow_above_unity;
+	params.source_transform_op = binding.source_transform_op;
+	params.screenshot_target = binding.screenshot_target;
+	params.scene_name = binding.scene_name.c_str();
+	params.source_name = binding.source_name.c_str();
+	params.filter_name = binding.filter_name.c_str();
+	params.filter_property_name = binding.filter_property_name.c_str();
+	params.filter_property_list_string = binding.filter_property_list_string.c_str();
+	params.volume_value = binding.volume_value;
+	params.filter_property_value = binding.filter_property_value;
+	params.filter_property_list_int = binding.filter_property_list_int;
+	params.filter_property_list_float = binding.filter_property_list_float;
+	return params;
+}
@@ -0,0 +1,296 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+// Binding model, device keys and logging shared by the matcher and the input backends.
+// Nothing here depends on libobs or Qt, so joypad-core links on a machine without OBS.
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class JoypadActionType : uint8_t {
+	SwitchScene = 0,
+	ToggleSourceVisibility = 1,
+	SetSourceVisibility = 2,
+	ToggleSourceMute = 3,
+	SetSourceMute = 4,
+	SetSourceVolume = 5,
+	MediaPlayPause = 6,
+	MediaRestart = 7,
+	MediaStop = 8,
+	ToggleFilterEnabled = 9,
+	SetFilterEnabled = 10,
+	AdjustSourceVolume = 11,
+	SetSourceVolumePercent = 12,
+	NextScene = 13,
+	PreviousScene = 14,
+	ToggleStreaming = 15,
+	ToggleRecording = 16,
+	ToggleVirtualCam = 17,
+	ToggleStudioMode = 18,
+	TransitionToProgram = 19,
+	SetFilterProperty = 20,
+	AdjustFilterProperty = 21,
+	SourceTransform = 22,
+	Screenshot = 23,
+	StartReplayBuffer = 24,
+	StopReplayBuffer = 25,
+	ToggleReplayBuffer = 26,
+	SaveReplayBuffer = 27,
+};
+constexpr size_t kJoypadActionTypeCount = (size_t)JoypadActionType::SaveReplayBuffer + 1;
+
+// Enumerator name, for logs and diagnostics; "Unknown" for out-of-range values.
+const char *JoypadActionTypeName(JoypadActionType action);
+
+enum class JoypadInputType : uint8_t {
+	Button = 0,
+	Axis = 1,
+};
+
+enum class JoypadAxisDirection : int8_t {
+	Both = 0,
+	Negative = -1,
+	Positive = 1,
+};
+
+enum class JoypadComboMode : uint8_t {
+	// Every button held, pressed in any order.
+	Chord = 0,
+	// Every button held, pressed in the listed order within combo_window_ms.
+	Ordered = 1,
+	// Buttons tapped one after another, repeats allowed, all within combo_window_ms.
+	Sequence = 2,
+};
+
+enum class JoypadComboTrigger : uint8_t {
+	// Fires on the press that completes the combo.
+	Press = 0,
+	// Fires on the first release after the combo was complete.
+	Release = 1,
+};
+
+enum class JoypadSourceTransformOp : uint8_t {
+	FlipHorizontal = 0,
+	FlipVertical = 1,
+	AlignLeft = 2,
+	AlignRight = 3,
+	AlignTop = 4,
+	AlignBottom = 5,
+	AlignTopLeft = 6,
+	AlignTopRight = 7,
+	AlignBottomLeft = 8,
+	AlignBottomRight = 9,
+	AlignCenterLeft = 10,
+	AlignCenterRight = 11,
+	Rotate90CW = 12,
+	Rotate90CCW = 13,
+	Rotate180 = 14,
+	CenterToScreen = 15,
+	FitToScreen = 16,
+	StretchToScreen = 17,
+};
+
+enum class JoypadScreenshotTarget : uint8_t {
+	Program = 0,
+	Source = 1,
+};
+
+struct JoypadButtonComboEntry {
+	std::string device_id;
+	std::string device_stable_id;
+	std::string device_type_id;
+	std::string device_name;
+	int button = -1;
+};
+
+struct JoypadBinding {
+	int64_t uid = 0;
+	std::string device_id;
+	std::string device_stable_id;
+	std::string device_type_id;
+	std::string device_name;
+	int button = -1;
+	std::vector<JoypadButtonComboEntry> button_combo;
+	// 0 is the base layer; n is JoypadProfile::layers[n - 1].
+	int layer = 0;
+	// kJoypadState* bits that must be set / clear, and the program scene required, for the
+	// binding to fire. Checked against JoypadFrontendState after the input matched.
+	uint32_t require_state = 0;
+	uint32_t forbid_state = 0;
+	std::string condition_scene;
+	JoypadComboMode combo_mode = JoypadComboMode::Chord;
+	JoypadComboTrigger combo_trigger = JoypadComboTrigger::Press;
+	int combo_window_ms = 500;
+	JoypadInputType input_type = JoypadInputType::Button;
+	int axis_index = -1;
+	JoypadAxisDirection axis_direction = JoypadAxisDirection::Both;
+	bool axis_inverted = false;
+	double axis_threshold = 0.10;
+	double axis_min_per_second = 2.5;
+	double axis_max_per_second = 20.0;
+	int axis_interval_ms = 150;
+	double axis_min_value = 0.0;
+	double axis_max_value = 1024.0;
+
+	JoypadActionType action = JoypadActionType::SwitchScene;
+
+	bool use_current_scene = false;
+	std::string scene_name;
+
+	std::string source_name;
+	std::string filter_name;
+	std::string filter_property_name;
+	int filter_property_type = 0;
+	double filter_property_value = 0.0;
+	double filter_property_min = 0.0;
+	double filter_property_max = 1.0;
+	int filter_property_list_format = 0;
+	std::string filter_property_list_string;
+	long long filter_property_list_int = 0;
+	double filter_property_list_float = 0.0;
+	JoypadSourceTransformOp source_transform_op = JoypadSourceTransformOp::CenterToScreen;
+	JoypadScreenshotTarget screenshot_target = JoypadScreenshotTarget::Program;
+
+	bool bool_value = false;
+	bool allow_above_unity = false;
+	double volume_value = 1.0;
+	double slider_gamma = 0.6;
+	bool enabled = true;
+};
+
+// Field-by-field comparison, uid included.
+bool JoypadBindingsEqual(const JoypadBinding &a, const JoypadBinding &b);
+
+// Hashed device identifiers, so state lookups on the input path compare integers instead
+// of strings. A zero field is unset and matches any device.
+struct JoypadDeviceKey {
+	uint64_t id = 0;
+	uint64_t stable_id = 0;
+	uint64_t type_id = 0;
+};
+
+// FNV-1a of value; 0 only for the empty string.
+uint64_t JoypadHashString(const std::string &value);
+JoypadDeviceKey JoypadMakeDeviceKey(const std::string &id, const std::string &stable_id, const std::string &type_id);
+// Xbox pads match Xbox-like bindings regardless of their id.
+bool JoypadIsXboxLikeDevice(const std::string &type_id, const std::string &name);
+
+struct JoypadEvent {
+	std::string device_id;
+	std::string device_stable_id;
+	std::string device_type_id;
+	std::string device_name;
+	// Filled by the input manager; events without a key fall back to string matching.
+	JoypadDeviceKey device_key;
+	bool device_xbox_like = false;
+	int button = -1;
+	// Button events only: set for releases, and the device's pressed buttons right after
+	// this event (bit N is button N + 1).
+	bool released = false;
+	uint32_t buttons = 0;
+	bool is_axis = false;
+	int axis_index = -1;
+	double axis_value = 0.0;
+	double axis_raw_value = 0.0;
+	// Set when the event is read while tracing is on; see joypad-trace.h.
+	uint64_t trace_id = 0;
+	int64_t trace_read_ns = 0;
+};
+
+constexpr uint32_t kJoypadStateStreaming = 1u << 0;
+constexpr uint32_t kJoypadStateRecording = 1u << 1;
+constexpr uint32_t kJoypadStateStudioMode = 1u << 2;
+constexpr uint32_t kJoypadStateReplayBuffer = 1u << 3;
+constexpr uint32_t kJoypadStateVirtualCam = 1u << 4;
+constexpr uint32_t kJoypadStateAll = kJoypadStateStreaming | kJoypadStateRecording | kJoypadStateStudioMode |
+				     kJoypadStateReplayBuffer | kJoypadStateVirtualCam;
+
+// Snapshot of the OBS state bindings can be conditioned on. Written by the plugin from
+// frontend events only, so the input thread never calls into the frontend API to read it.
+class JoypadFrontendState {
+public:
+	uint32_t Flags() const { return flags_.load(std::memory_order_relaxed); }
+	uint64_t SceneHash() const { return scene_hash_.load(std::memory_order_relaxed); }
+
+	void SetFlag(uint32_t flag, bool on)
+	{
+		if (on) {
+			flags_.fetch_or(flag, std::memory_order_relaxed);
+		} else {
+			flags_.fetch_and(~flag, std::memory_order_relaxed);
+		}
+	}
+	void SetFlags(uint32_t flags) { flags_.store(flags, std::memory_order_relaxed); }
+	void SetScene(const std::string &name) { scene_hash_.store(JoypadHashString(name), std::memory_order_relaxed); }
+
+private:
+	std::atomic<uint32_t> flags_{0};
+	std::atomic<uint64_t> scene_hash_{0};
+};
+
+// While its modifier button is held, only bindings of this layer are matched.
+struct JoypadLayer {
+	std::string name;
+	JoypadButtonComboEntry modifier;
+};
+
+bool JoypadLayersEqual(const std::vector<JoypadLayer> &a, const std::vector<JoypadLayer> &b);
+
+// What an action needs to run. Strings are borrowed from a binding or a compiled
+// profile and must outlive the Execute call; they are never null.
+struct JoypadActionParams {
+	JoypadActionType action = JoypadActionType::SwitchScene;
+	bool use_current_scene = false;
+	bool bool_value = false;
+	bool allow_above_unity = false;
+	JoypadSourceTransformOp source_transform_op = JoypadSourceTransformOp::CenterToScreen;
+	JoypadScreenshotTarget screenshot_target = JoypadScreenshotTarget::Program;
+	const char *scene_name = "";
+	const char *source_name = "";
+	const char *filter_name = "";
+	const char *filter_property_name = "";
+	const char *filter_property_list_string = "";
+	double volume_value = 1.0;
+	double filter_property_value = 0.0;
+	long long filter_property_list_int = 0;
+	double filter_property_list_float = 0.0;
+
+	static JoypadActionParams FromBinding(const JoypadBinding &binding);
+};
+
+// obs_property_type values the matcher and action engine need; joypad-obs-libobs.cpp checks
+// them against libobs.
+constexpr int kJoypadPropertyBool = 1;
+constexpr int kJoypadPropertyInt = 2;
+constexpr int kJoypadPropertyFloat = 3;
+constexpr int kJoypadPropertyList = 6;
+
+// Same values as the libobs LOG_* levels, so the plugin can forward them to obs_log unchanged.
+constexpr int kJoypadLogError = 100;
+constexpr int kJoypadLogWarning = 200;
+constexpr int kJoypadLogInfo = 300;
+constexpr int kJoypadLogDebug = 400;
+
+// Receives every core log line. Without a handler lines go to stderr.
+using JoypadLogHandler = void (*)(int level, const char *message);
+void JoypadSetLogHandler(JoypadLogHandler handler);
+void JoypadLog(int level, const char *format, ...);
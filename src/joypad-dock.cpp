@@ -17,6 +17,8 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 */
 
 #include "joypad-dock.h"
+#include "joypad-stats-panel.h"
+#include "joypad-trace.h"
 #include "joypad-ui.h"
 
 #include <obs-module.h>
@@ -27,7 +29,7 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 #include <QSignalBlocker>
 #include <QSizePolicy>
 #include <QStyle>
-#include <QTimer>
+#include <QToolButton>
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QWidget>
@@ -40,8 +42,12 @@ inline QString L(const char *key)
 } // namespace
 
 void JoypadPluginOpenToolsDialog();
+void JoypadPluginToggleTrace();
 
-JoypadControlDock::JoypadControlDock(QWidget *parent, JoypadConfigStore *config) : QDockWidget(parent), config_(config)
+JoypadControlDock::JoypadControlDock(QWidget *parent, JoypadConfigStore *config, JoypadInputManager *input,
+				     JoypadWatchdog *watchdog)
+	: QDockWidget(parent),
+	  config_(config)
 {
 	setObjectName(QStringLiteral("joypad_to_obs_dock"));
 	setWindowTitle(L("JoypadToOBS.Dock.Title"));
@@ -78,7 +84,26 @@ JoypadControlDock::JoypadControlDock(QWidget *parent, JoypadConfigStore *config)
 	input_toggle_button_->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Preferred);
 	profile_row->addWidget(input_toggle_button_, 0);
 
+	trace_button_ = new QPushButton(content);
+	trace_button_->setCheckable(true);
+	trace_button_->setText(QString());
+	trace_button_->setFixedWidth(34);
+	trace_button_->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Preferred);
+	profile_row->addWidget(trace_button_, 0);
+
 	layout->addLayout(profile_row);
+
+	stats_toggle_ = new QToolButton(content);
+	stats_toggle_->setCheckable(true);
+	stats_toggle_->setAutoRaise(true);
+	stats_toggle_->setToolButtonStyle(Qt::ToolButtonTextBesideIcon);
+	stats_toggle_->setArrowType(Qt::RightArrow);
+	stats_toggle_->setText(L("JoypadToOBS.Dock.Stats"));
+	layout->addWidget(stats_toggle_);
+
+	stats_panel_ = new JoypadStatsPanel(content, input, watchdog);
+	stats_panel_->setVisible(false);
+	layout->addWidget(stats_panel_);
 	setWidget(content);
 
 	connect(profile_combo_, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index) {
@@ -91,10 +116,11 @@ JoypadControlDock::JoypadControlDock(QWidget *parent, JoypadConfigStore *config)
 	connect(input_toggle_button_, &QPushButton::toggled, this,
 		[](bool enabled) { JoypadUiSetInputListeningEnabled(enabled); });
 	connect(open_config_button_, &QPushButton::clicked, this, []() { JoypadPluginOpenToolsDialog(); });
-
-	update_timer_ = new QTimer(this);
-	connect(update_timer_, &QTimer::timeout, this, [this]() { RefreshState(); });
-	update_timer_->start(200);
+	connect(trace_button_, &QPushButton::clicked, this, []() { JoypadPluginToggleTrace(); });
+	connect(stats_toggle_, &QToolButton::toggled, this, [this](bool expanded) {
+		stats_toggle_->setArrowType(expanded ? Qt::DownArrow : Qt::RightArrow);
+		stats_panel_->setVisible(expanded);
+	});
 
 	RefreshState();
 }
@@ -115,6 +141,22 @@ void JoypadControlDock::RefreshState()
 	const QStyle::StandardPixmap icon_type = enabled ? QStyle::SP_DialogApplyButton : QStyle::SP_DialogCancelButton;
 	input_toggle_button_->setIcon(style()->standardIcon(icon_type));
 	input_toggle_button_->setToolTip(L("JoypadToOBS.Dock.ListeningButton").arg(status));
+
+	// The plugin writes the trace file and refreshes the dock when tracing stops.
+	const bool tracing = JoypadTraceEnabled();
+	if (trace_button_->isChecked() != tracing) {
+		const QSignalBlocker blocker(trace_button_);
+		trace_button_->setChecked(tracing);
+	}
+	trace_button_->setIcon(style()->standardIcon(tracing ? QStyle::SP_MediaStop : QStyle::SP_MediaPlay));
+	trace_button_->setToolTip(L(tracing ? "JoypadToOBS.Dock.TraceStop" : "JoypadToOBS.Dock.TraceStart"));
+}
+
+void JoypadControlDock::OnConfigChanged(uint32_t changes)
+{
+	if (changes & (kJoypadConfigProfilesChanged | kJoypadConfigCurrentProfileChanged)) {
+		RefreshProfiles();
+	}
 }
 
 void JoypadControlDock::RefreshProfiles()
@@ -24,12 +24,18 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 
 class QComboBox;
 class QPushButton;
-class QTimer;
+class QToolButton;
+class JoypadInputManager;
+class JoypadStatsPanel;
+class JoypadWatchdog;
 
 class JoypadControlDock : public QDockWidget {
 public:
-	JoypadControlDock(QWidget *parent, JoypadConfigStore *config);
+	JoypadControlDock(QWidget *parent, JoypadConfigStore *config, JoypadInputManager *input,
+			  JoypadWatchdog *watchdog);
 	void RefreshState();
+	// Called on the UI thread with kJoypadConfig*Changed bits from the config store.
+	void OnConfigChanged(uint32_t changes);
 
 private:
 	void RefreshProfiles();
@@ -38,5 +44,7 @@ private:
 	QComboBox *profile_combo_ = nullptr;
 	QPushButton *open_config_button_ = nullptr;
 	QPushButton *input_toggle_button_ = nullptr;
-	QTimer *update_timer_ = nullptr;
+	QPushButton *trace_button_ = nullptr;
+	QToolButton *stats_toggle_ = nullptr;
+	JoypadStatsPanel *stats_panel_ = nullptr;
 };
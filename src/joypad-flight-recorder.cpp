@@ -0,0 +1,329 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "joypad-flight-recorder.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+constexpr int64_t kSlowDumpIntervalNs = 30000000000LL;
+
+// Entry fields live in relaxed atomics so a reader racing a writer sees stale or torn
+// words instead of undefined behaviour; the sequence check then discards the entry.
+struct FlightSlot {
+	// Ring position + 1 once published, 0 while a writer fills the slot.
+	std::atomic<uint64_t> sequence{0};
+	std::atomic<int64_t> time_ns{0};
+	std::atomic<int64_t> duration_ns{0};
+	std::atomic<uint64_t> device{0};
+	std::atomic<double> value{0.0};
+	std::atomic<uint32_t> count{0};
+	std::atomic<int32_t> index{-1};
+	std::atomic<uint8_t> kind{0};
+};
+
+FlightSlot g_slots[kJoypadFlightEntries];
+std::atomic<uint64_t> g_head{0};
+std::atomic<int64_t> g_last_slow_dump_ns{0};
+// Slow action waiting for JoypadFlightDumpPending(); the flag is published last.
+std::atomic<bool> g_slow_dump_pending{false};
+std::atomic<uint8_t> g_slow_action{0};
+std::atomic<int64_t> g_slow_duration_ns{0};
+
+// Device names and the dump directory change rarely and are only read by dumps.
+std::mutex g_names_mutex;
+std::unordered_map<uint64_t, std::string> g_device_names;
+std::string g_dump_directory;
+std::mutex g_dump_mutex;
+
+void record(const JoypadFlightEntry &entry)
+{
+	const uint64_t position = g_head.fetch_add(1, std::memory_order_relaxed);
+	FlightSlot &slot = g_slots[position % kJoypadFlightEntries];
+	slot.sequence.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.time_ns.store(entry.time_ns, std::memory_order_relaxed);
+	slot.duration_ns.store(entry.duration_ns, std::memory_order_relaxed);
+	slot.device.store(entry.device, std::memory_order_relaxed);
+	slot.value.store(entry.value, std::memory_order_relaxed);
+	slot.count.store(entry.count, std::memory_order_relaxed);
+	slot.index.store(entry.index, std::memory_order_relaxed);
+	slot.kind.store((uint8_t)entry.kind, std::memory_order_relaxed);
+	slot.sequence.store(position + 1, std::memory_order_release);
+}
+
+void write_json_string(FILE *file, const std::string &text)
+{
+	fputc('"', file);
+	for (unsigned char c : text) {
+		if (c == '"' || c == '\\') {
+			fputc('\\', file);
+			fputc(c, file);
+		} else if (c < 0x20) {
+			fprintf(file, "\\u%04x", (unsigned)c);
+		} else {
+			fputc(c, file);
+		}
+	}
+	fputc('"', file);
+}
+
+void write_device(FILE *file, uint64_t device, const std::unordered_map<uint64_t, std::string> &names)
+{
+	fputs(",\"device\":", file);
+	const auto it = names.find(device);
+	if (it != names.end()) {
+		write_json_string(file, it->second);
+	} else {
+		fprintf(file, "\"%016llx\"", (unsigned long long)device);
+	}
+}
+
+std::string format_local_time(const char *format)
+{
+	const std::time_t now = std::time(nullptr);
+	char text[64] = {};
+	// Callers hold g_dump_mutex, which also covers localtime's shared buffer.
+	const std::tm *local = std::localtime(&now);
+	if (!local || std::strftime(text, sizeof(text), format, local) == 0) {
+		return std::string();
+	}
+	return text;
+}
+
+bool write_locked(const std::string &path, const char *reason, std::string *error)
+{
+	std::vector<JoypadFlightEntry> entries;
+	JoypadFlightSnapshot(entries);
+	std::unordered_map<uint64_t, std::string> names;
+	{
+		std::lock_guard<std::mutex> lock(g_names_mutex);
+		names = g_device_names;
+	}
+
+	FILE *file = fopen(path.c_str(), "wb");
+	if (!file) {
+		if (error) {
+			*error = "cannot create " + path;
+		}
+		return false;
+	}
+	const int64_t now = JoypadFlightNow();
+	fputs("{\"flight_recorder\":\"joypad-to-obs\",\"reason\":", file);
+	write_json_string(file, reason);
+	fputs(",\"time\":", file);
+	write_json_string(file, format_local_time("%Y-%m-%d %H:%M:%S"));
+	fprintf(file, ",\"entries\":%zu}\n", entries.size());
+
+	for (const auto &entry : entries) {
+		fprintf(file, "{\"ago_ms\":%.3f", (double)(now - entry.time_ns) / 1000000.0);
+		switch (entry.kind) {
+		case JoypadFlightKind::Button:
+			fputs(",\"kind\":\"button\"", file);
+			write_device(file, entry.device, names);
+			fprintf(file, ",\"button\":%d,\"pressed\":%s", entry.index,
+				entry.value != 0.0 ? "true" : "false");
+			break;
+		case JoypadFlightKind::Axis:
+			fputs(",\"kind\":\"axis\"", file);
+			write_device(file, entry.device, names);
+			fprintf(file, ",\"axis\":%d,\"value\":%.4f", entry.index, entry.value);
+			break;
+		case JoypadFlightKind::Match:
+			fputs(",\"kind\":\"match\"", file);
+			write_device(file, entry.device, names);
+			fprintf(file, ",\"bindings\":%u,\"us\":%.1f", entry.count, (double)entry.duration_ns / 1000.0);
+			break;
+		case JoypadFlightKind::Action:
+			fputs(",\"kind\":\"action\",\"action\":", file);
+			write_json_string(file, JoypadActionTypeName((JoypadActionType)entry.index));
+			fprintf(file, ",\"us\":%.1f", (double)entry.duration_ns / 1000.0);
+			break;
+		case JoypadFlightKind::DeviceConnected:
+		case JoypadFlightKind::DeviceDisconnected:
+			fputs(entry.kind == JoypadFlightKind::DeviceConnected ? ",\"kind\":\"connected\""
+									     : ",\"kind\":\"disconnected\"",
+			      file);
+			write_device(file, entry.device, names);
+			break;
+		}
+		fputs("}\n", file);
+	}
+
+	const bool ok = !ferror(file);
+	if (fclose(file) != 0 || !ok) {
+		if (error) {
+			*error = "cannot write " + path;
+		}
+		return false;
+	}
+	return true;
+}
+} // namespace
+
+int64_t JoypadFlightNow()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		       std::chrono::steady_clock::now().time_since_epoch())
+		.count();
+}
+
+void JoypadFlightRecordInput(const JoypadEvent &event)
+{
+	JoypadFlightEntry entry;
+	entry.time_ns = JoypadFlightNow();
+	entry.device = event.device_key.id;
+	if (event.is_axis) {
+		entry.kind = JoypadFlightKind::Axis;
+		entry.index = event.axis_index;
+		entry.value = event.axis_value;
+	} else {
+		entry.kind = JoypadFlightKind::Button;
+		entry.index = event.button;
+		entry.value = event.released ? 0.0 : 1.0;
+	}
+	record(entry);
+}
+
+void JoypadFlightRecordMatch(const JoypadEvent &event, size_t matches, int64_t start_ns, int64_t end_ns)
+{
+	JoypadFlightEntry entry;
+	entry.time_ns = end_ns;
+	entry.duration_ns = end_ns - start_ns;
+	entry.device = event.device_key.id;
+	entry.count = (uint32_t)matches;
+	entry.index = event.is_axis ? event.axis_index : event.button;
+	entry.kind = JoypadFlightKind::Match;
+	record(entry);
+}
+
+void JoypadFlightRecordAction(JoypadActionType action, int64_t start_ns, int64_t end_ns)
+{
+	const int64_t duration_ns = end_ns - start_ns;
+	JoypadFlightEntry entry;
+	entry.time_ns = end_ns;
+	entry.duration_ns = duration_ns;
+	entry.index = (int32_t)action;
+	entry.kind = JoypadFlightKind::Action;
+	record(entry);
+
+	if (duration_ns <= kJoypadFlightActionBudgetNs) {
+		return;
+	}
+	int64_t last = g_last_slow_dump_ns.load(std::memory_order_relaxed);
+	if ((last != 0 && entry.time_ns - last < kSlowDumpIntervalNs) ||
+	    !g_last_slow_dump_ns.compare_exchange_strong(last, entry.time_ns, std::memory_order_relaxed)) {
+		return;
+	}
+	g_slow_action.store((uint8_t)action, std::memory_order_relaxed);
+	g_slow_duration_ns.store(duration_ns, std::memory_order_relaxed);
+	g_slow_dump_pending.store(true, std::memory_order_release);
+}
+
+void JoypadFlightDumpPending()
+{
+	if (!g_slow_dump_pending.exchange(false, std::memory_order_acquire)) {
+		return;
+	}
+	const auto action = (JoypadActionType)g_slow_action.load(std::memory_order_relaxed);
+	const int64_t duration_ns = g_slow_duration_ns.load(std::memory_order_relaxed);
+	JoypadLog(kJoypadLogWarning, "joypad-to-obs action %s took %.1f ms", JoypadActionTypeName(action),
+		  (double)duration_ns / 1000000.0);
+	JoypadFlightDump("slow-action");
+}
+
+void JoypadFlightRecordDevice(const std::string &id, const std::string &name, bool connected)
+{
+	JoypadFlightEntry entry;
+	entry.time_ns = JoypadFlightNow();
+	entry.device = JoypadHashString(id);
+	entry.kind = connected ? JoypadFlightKind::DeviceConnected : JoypadFlightKind::DeviceDisconnected;
+	{
+		std::lock_guard<std::mutex> lock(g_names_mutex);
+		g_device_names[entry.device] = name + " (" + id + ")";
+	}
+	record(entry);
+}
+
+void JoypadFlightSnapshot(std::vector<JoypadFlightEntry> &out)
+{
+	out.clear();
+	const uint64_t head = g_head.load(std::memory_order_acquire);
+	const uint64_t first = head > kJoypadFlightEntries ? head - kJoypadFlightEntries : 0;
+	out.reserve((size_t)(head - first));
+	for (uint64_t position = first; position < head; ++position) {
+		const FlightSlot &slot = g_slots[position % kJoypadFlightEntries];
+		const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+		if (sequence != position + 1) {
+			// Still being written, or already overwritten by a newer entry.
+			continue;
+		}
+		JoypadFlightEntry entry;
+		entry.time_ns = slot.time_ns.load(std::memory_order_relaxed);
+		entry.duration_ns = slot.duration_ns.load(std::memory_order_relaxed);
+		entry.device = slot.device.load(std::memory_order_relaxed);
+		entry.value = slot.value.load(std::memory_order_relaxed);
+		entry.count = slot.count.load(std::memory_order_relaxed);
+		entry.index = slot.index.load(std::memory_order_relaxed);
+		entry.kind = (JoypadFlightKind)slot.kind.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.sequence.load(std::memory_order_relaxed) == sequence) {
+			out.push_back(entry);
+		}
+	}
+}
+
+void JoypadFlightSetDumpDirectory(const std::string &directory)
+{
+	std::lock_guard<std::mutex> lock(g_dump_mutex);
+	g_dump_directory = directory;
+	if (!g_dump_directory.empty() && g_dump_directory.back() != '/' && g_dump_directory.back() != '\\') {
+		g_dump_directory.push_back('/');
+	}
+}
+
+std::string JoypadFlightDump(const char *reason, bool overwrite)
+{
+	std::lock_guard<std::mutex> lock(g_dump_mutex);
+	if (g_dump_directory.empty()) {
+		return std::string();
+	}
+	std::string path = g_dump_directory + "joypad-flight-" + reason;
+	if (!overwrite) {
+		path += "-" + format_local_time("%Y%m%d-%H%M%S");
+	}
+	path += ".jsonl";
+	std::string error;
+	if (!write_locked(path, reason, &error)) {
+		JoypadLog(kJoypadLogWarning, "joypad-to-obs flight recorder not saved: %s", error.c_str());
+		return std::string();
+	}
+	JoypadLog(kJoypadLogInfo, "joypad-to-obs flight recorder saved to %s", path.c_str());
+	return path;
+}
+
+bool JoypadFlightWrite(const std::string &path, const char *reason, std::string *error)
+{
+	std::lock_guard<std::mutex> lock(g_dump_mutex);
+	return write_locked(path, reason, error);
+}
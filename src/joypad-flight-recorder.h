@@ -0,0 +1,83 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include "joypad-core.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Always-on record of the last kJoypadFlightEntries inputs, matches, actions and device
+// changes, for looking back at what happened during a show. Writers never lock: each claims
+// a slot with one atomic increment and publishes it with a per-slot sequence number, so the
+// poll thread pays a few relaxed stores per event. The oldest entries are overwritten.
+//
+// Dumps are JSON lines, newest last: a header with the reason and wall-clock time, then one
+// object per entry with ago_ms, the time before the dump.
+constexpr size_t kJoypadFlightEntries = 8192;
+// An action slower than this requests a "slow-action" dump, at most one every 30 seconds.
+constexpr int64_t kJoypadFlightActionBudgetNs = 50000000;
+
+enum class JoypadFlightKind : uint8_t {
+	Button = 1,
+	Axis = 2,
+	Match = 3,
+	Action = 4,
+	DeviceConnected = 5,
+	DeviceDisconnected = 6,
+};
+
+struct JoypadFlightEntry {
+	// Steady clock nanoseconds.
+	int64_t time_ns = 0;
+	// Match and Action: how long it took.
+	int64_t duration_ns = 0;
+	// JoypadDeviceKey::id of the device, for inputs, matches and device changes.
+	uint64_t device = 0;
+	// Axis value, or 1/0 for button presses and releases.
+	double value = 0.0;
+	// Match: bindings matched.
+	uint32_t count = 0;
+	// Button or axis index; Action: the JoypadActionType.
+	int32_t index = -1;
+	JoypadFlightKind kind = JoypadFlightKind::Button;
+};
+
+void JoypadFlightRecordInput(const JoypadEvent &event);
+// start_ns and end_ns come from JoypadFlightNow(); the caller's clock reads are reused.
+void JoypadFlightRecordMatch(const JoypadEvent &event, size_t matches, int64_t start_ns, int64_t end_ns);
+// Requests a dump when the action took longer than kJoypadFlightActionBudgetNs; only a flag
+// is set here, JoypadFlightDumpPending() does the writing.
+void JoypadFlightRecordAction(JoypadActionType action, int64_t start_ns, int64_t end_ns);
+void JoypadFlightRecordDevice(const std::string &id, const std::string &name, bool connected);
+
+int64_t JoypadFlightNow();
+// Copies the entries still in the ring, oldest first.
+void JoypadFlightSnapshot(std::vector<JoypadFlightEntry> &out);
+
+// Where JoypadFlightDump() writes; dumps are skipped until it is set.
+void JoypadFlightSetDumpDirectory(const std::string &directory);
+// Writes joypad-flight-<reason>-<time>.jsonl to the dump directory and returns its path, or
+// an empty string on failure. With overwrite set the name has no time and replaces the last one.
+std::string JoypadFlightDump(const char *reason, bool overwrite = false);
+bool JoypadFlightWrite(const std::string &path, const char *reason, std::string *error);
+// Writes the slow-action dump requested since the last call, if any. Meant for a thread that
+// may block, such as the watchdog's, so the poll thread never waits on the file.
+void JoypadFlightDumpPending();
@@ -18,21 +18,42 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 
 #pragma once
 
-#include "joypad-config.h"
+#include "joypad-backend.h"
+#include "joypad-core.h"
+#include "joypad-recording.h"
 
 #include <atomic>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
 #include <vector>
 
+constexpr int kJoypadMonitorAxes = 8;
+constexpr int kJoypadMonitorSlots = 32;
+
 struct JoypadDeviceInfo {
 	std::string id;
 	std::string stable_id;
 	std::string type_id;
 	std::string name;
+	// Index into ReadMonitorSamples() output slots, or -1 when every slot is taken.
+	int monitor_slot = -1;
+};
+
+struct JoypadMonitorSample {
+	int slot = -1;
+	bool connected = false;
+	uint32_t buttons = 0;
+	float axes[kJoypadMonitorAxes] = {};
+	// Monotonic count of button and axis changes seen on this device.
+	uint64_t event_count = 0;
+	// Axis readings that produced no event (unchanged or rate limited), and times the
+	// backend reported lost input.
+	uint64_t coalesced_count = 0;
+	uint64_t dropped_count = 0;
 };
 
 class JoypadInputManager {
@@ -42,10 +63,14 @@ public:
 
 	void Start();
 	void Stop();
+	// Reads devices through backend instead of the platform default (see
+	// JoypadCreateDefaultInputBackend); nullptr restores the default. Restarts input if it was running.
+	void SetBackend(std::unique_ptr<JoypadInputBackend> backend);
 
 	std::vector<JoypadDeviceInfo> GetDevices() const;
 	void RefreshDevices();
 
+	// Receives button presses and, with JoypadEvent::released set, releases.
 	void SetOnButtonPressed(std::function<void(const JoypadEvent &)> handler);
 	void SetOnAxisChanged(std::function<void(const JoypadEvent &)> handler);
 	int AddOnAxisChanged(std::function<void(const JoypadEvent &)> handler);
@@ -53,11 +78,35 @@ public:
 	bool GetAxisRawValue(const std::string &device_id, int axis_index, double &raw_out) const;
 	bool IsButtonPressed(const std::string &device_id, const std::string &device_stable_id,
 			     const std::string &device_type_id, int button) const;
+	bool IsButtonPressed(const JoypadDeviceKey &device, int button) const;
+	// Pressed buttons of the first device matching the key; false if none is tracked.
+	bool GetPressedButtons(const JoypadDeviceKey &device, uint32_t &buttons_out) const;
 	void SetNativeWindowHandle(void *hwnd);
 
+	// Lock-free view of every tracked device, meant to be polled at display rate. Re-read
+	// GetDevices() whenever GetDevicesVersion() changes to map slots back to device names.
+	void ReadMonitorSamples(std::vector<JoypadMonitorSample> &out) const;
+	uint64_t GetDevicesVersion() const;
+	// Steady clock nanoseconds at which the poll loop last started a cycle, 0 while stopped.
+	int64_t GetPollHeartbeat() const { return poll_heartbeat_ns_.load(std::memory_order_relaxed); }
+
 	bool BeginLearn(std::function<void(const JoypadEvent &)> handler);
 	void CancelLearn();
 
+	// Writes every dispatched event to path until StopRecording(); see joypad-recording.h.
+	bool StartRecording(const std::string &path);
+	void StopRecording();
+	bool IsRecording() const { return recording_.load(std::memory_order_acquire); }
+
+	// Feeds a recording through the same dispatch path as live input, at the recorded pace
+	// when realtime is set or as fast as possible otherwise. Replay() blocks and returns the
+	// number of events dispatched, or -1 if the file can't be read; StartReplay() runs it on
+	// a worker thread, replacing any replay in progress. Needs no devices or Start().
+	int64_t Replay(const std::string &path, bool realtime, std::string *error = nullptr);
+	bool StartReplay(const std::string &path, bool realtime, std::string *error = nullptr);
+	void StopReplay();
+	bool IsReplaying() const { return replaying_.load(std::memory_order_acquire); }
+
 private:
 	struct DeviceState {
 		std::string id;
@@ -68,30 +117,85 @@ private:
 		double last_axes[8] = {0};
 		bool axis_initialized[8] = {false};
 		bool connected = false;
-		bool resync_axes = false;
-#if defined(_WIN32)
-		void *di_device = nullptr;
-		bool is_xinput = false;
-		uint32_t xinput_slot = 0;
-#endif
-#if defined(__linux__)
-		int fd = -1;
-#elif defined(__APPLE__)
-		void *hid_device = nullptr;
-#endif
+		// Normalized axis values and change count, published for the input monitor.
+		double axis_values[8] = {0};
+		uint64_t event_count = 0;
+		uint64_t coalesced_count = 0;
+		uint64_t dropped_count = 0;
+		JoypadDeviceKey key;
+		bool xbox_like = false;
+		int slot = -1;
+		// Handle from backend_->Open(), -1 while closed.
+		int backend_handle = -1;
 	};
 
 	void PollLoop();
 	void DispatchEvent(const JoypadEvent &event);
 	void DispatchAxisAbsolute(const JoypadEvent &event);
+	void RecordEvent(JoypadRecordTag tag, const JoypadEvent &event);
+	int64_t ReplayEvents(const std::vector<JoypadRecordedEvent> &events, bool realtime);
 	void MarkDeviceDisconnected(DeviceState &state);
+	void CommitDevicesLocked(const std::unordered_map<std::string, std::string> &previous_devices,
+				 std::vector<DeviceState> &next_states, std::vector<JoypadDeviceInfo> &next_devices);
+	void RefreshBackendDevicesLocked(std::vector<DeviceState> &next_states,
+					 std::vector<JoypadDeviceInfo> &next_devices);
+	void CloseBackendDevicesLocked();
+	void PollBackendLocked(std::vector<JoypadEvent> &button_events, std::vector<JoypadEvent> &axis_events);
+	void QueueAxisLocked(DeviceState &state, int axis_index, double value, double raw,
+			     std::vector<JoypadEvent> &axis_events);
+
+	// Published copy of a DeviceState. Writers hold devices_mutex_ and bracket every update
+	// with an odd/even sequence number (a seqlock), so readers never take the lock, never
+	// block the poll loop and retry instead of seeing a half-written state.
+	struct DeviceSlot {
+		std::atomic<uint32_t> sequence{0};
+		std::atomic<bool> in_use{false};
+		std::atomic<bool> connected{false};
+		std::atomic<uint64_t> id_hash{0};
+		std::atomic<uint64_t> stable_hash{0};
+		std::atomic<uint64_t> type_hash{0};
+		std::atomic<uint32_t> buttons{0};
+		std::atomic<uint32_t> axes_valid{0};
+		std::atomic<double> raw_axes[kJoypadMonitorAxes] = {};
+		std::atomic<float> axes[kJoypadMonitorAxes] = {};
+		std::atomic<uint64_t> event_count{0};
+		std::atomic<uint64_t> coalesced_count{0};
+		std::atomic<uint64_t> dropped_count{0};
+	};
+	struct SlotView {
+		bool connected = false;
+		JoypadDeviceKey key;
+		uint32_t buttons = 0;
+		uint32_t axes_valid = 0;
+		double raw_axes[kJoypadMonitorAxes] = {};
+		float axes[kJoypadMonitorAxes] = {};
+		uint64_t event_count = 0;
+		uint64_t coalesced_count = 0;
+		uint64_t dropped_count = 0;
+	};
+	bool ReadSlot(int index, SlotView &out) const;
+	void WriteSlotLocked(int index, const DeviceState *state);
+	void SyncDeviceSlotsLocked();
+	static void FillEventDevice(JoypadEvent &event, const DeviceState &state);
+	void PublishDeviceStateLocked(const DeviceState &state);
+	void PublishDeviceStatesLocked();
+	void SetButtonStateLocked(DeviceState &state, int index, bool pressed);
 
 	std::atomic<bool> running_{false};
 	std::thread poll_thread_;
+	std::atomic<int64_t> poll_heartbeat_ns_{0};
 
 	mutable std::mutex devices_mutex_;
 	std::vector<JoypadDeviceInfo> devices_;
 	std::vector<DeviceState> device_states_;
+	DeviceSlot device_slots_[kJoypadMonitorSlots];
+	// Devices left without a slot; readers fall back to device_states_ under the lock for them.
+	std::atomic<int> unslotted_devices_{0};
+	std::atomic<uint64_t> devices_version_{0};
+	std::unique_ptr<JoypadInputBackend> backend_;
+	std::vector<JoypadBackendEvent> backend_events_;
+	// Host window handed to backend_->Start().
+	void *native_window_ = nullptr;
 
 	std::mutex handler_mutex_;
 	std::function<void(const JoypadEvent &)> on_button_pressed_;
@@ -103,19 +207,11 @@ private:
 	};
 	int next_axis_handler_id_ = 1;
 	std::vector<AxisHandlerEntry> axis_handlers_;
-	std::unordered_map<std::string, std::chrono::steady_clock::time_point> axis_last_trigger_;
-
-#if defined(_WIN32)
-	void *dinput_ = nullptr;
-	void *dinput_hwnd_ = nullptr;
-	void *dinput_notify_hwnd_ = nullptr;
-	void *dinput_devnotify_ = nullptr;
-	void *native_hwnd_ = nullptr;
-	std::atomic<bool> device_change_pending_{false};
-#endif
-
-#if defined(__APPLE__)
-	void *hid_manager_ = nullptr;
-	void *hid_run_loop_ = nullptr;
-#endif
+
+	std::atomic<bool> recording_{false};
+	std::mutex recorder_mutex_;
+	JoypadInputRecorder recorder_;
+	std::atomic<bool> replaying_{false};
+	std::atomic<bool> replay_cancel_{false};
+	std::thread replay_thread_;
 };
@@ -0,0 +1,879 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "joypad-matcher.h"
+#include "joypad-input.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+bool device_matches_key(const JoypadCompiledDevice &device, const JoypadDeviceKey &key, bool xbox_like)
+{
+	if (device.key.id == 0 || device.key.id == key.id) {
+		return true;
+	}
+	if (device.key.stable_id != 0 && device.key.stable_id == key.stable_id) {
+		return true;
+	}
+	if (device.key.type_id != 0 && device.key.type_id == key.type_id) {
+		return true;
+	}
+	return device.xbox_like && xbox_like;
+}
+
+bool device_matches_event(const JoypadCompiledProfile &profile, const JoypadCompiledDevice &device,
+			  const JoypadEvent &event)
+{
+	if (event.device_key.id != 0) {
+		// Events from the input manager carry the same hashes the profile was compiled with.
+		return device_matches_key(device, event.device_key, event.device_xbox_like);
+	}
+	const std::string &device_id = profile.String(device.id);
+	if (device_id.empty() || device_id == event.device_id) {
+		return true;
+	}
+	if (device.stable_id != 0 && profile.String(device.stable_id) == event.device_stable_id) {
+		return true;
+	}
+	if (device.type_id != 0 && profile.String(device.type_id) == event.device_type_id) {
+		return true;
+	}
+	return device.xbox_like && JoypadIsXboxLikeDevice(event.device_type_id, event.device_name);
+}
+
+bool condition_met(const JoypadCompiledCondition &condition, uint32_t flags, uint64_t scene)
+{
+	return (flags & condition.mask) == condition.value &&
+	       (condition.scene_hash == 0 || condition.scene_hash == scene);
+}
+
+uint32_t button_bit(int button)
+{
+	return button >= 1 && button <= 32 ? 1u << (button - 1) : 0;
+}
+
+// Whether the event's button belongs to the combo, and whether every mask was fully held
+// right before and right after the event.
+struct ComboEdge {
+	bool touched = false;
+	bool before = true;
+	bool after = true;
+};
+
+ComboEdge combo_edge(const JoypadCompiledProfile &profile, const JoypadCompiledBinding &binding,
+		     const JoypadEvent &event, const JoypadInputManager *input)
+{
+	ComboEdge edge;
+	const uint32_t bit = button_bit(event.button);
+	const uint32_t after = event.released ? (event.buttons & ~bit) : (event.buttons | bit);
+	const uint32_t before = event.released ? (after | bit) : (after & ~bit);
+	const JoypadCompiledComboMask *masks = profile.combo_masks.data() + binding.mask_first;
+	bool remote = false;
+	for (uint32_t i = 0; i < binding.mask_count; ++i) {
+		if (!device_matches_event(profile, profile.devices[masks[i].device], event)) {
+			remote = true;
+			continue;
+		}
+		const uint32_t mask = masks[i].mask;
+		edge.touched = edge.touched || (mask & bit) != 0;
+		edge.before = edge.before && (before & mask) == mask;
+		edge.after = edge.after && (after & mask) == mask;
+	}
+	if (!remote || !edge.touched || !input || (!edge.before && !edge.after)) {
+		return edge;
+	}
+	// Masks held on other devices do not change with this event; read their published state.
+	for (uint32_t i = 0; i < binding.mask_count; ++i) {
+		if (device_matches_event(profile, profile.devices[masks[i].device], event)) {
+			continue;
+		}
+		uint32_t held = 0;
+		input->GetPressedButtons(profile.devices[masks[i].device].key, held);
+		if ((held & masks[i].mask) != masks[i].mask) {
+			edge.before = false;
+			edge.after = false;
+			break;
+		}
+	}
+	return edge;
+}
+
+// Folds a binding's combo entries into one pressed-button mask per device and indexes the
+// binding under each of its buttons.
+void compile_combo_masks(JoypadCompiledProfile &profile, JoypadCompiledLayerTable &table,
+			 JoypadCompiledBinding &record, uint32_t slot)
+{
+	record.mask_first = (uint32_t)profile.combo_masks.size();
+	for (uint32_t i = 0; i < record.combo_count; ++i) {
+		const JoypadCompiledComboEntry entry = profile.combo_entries[record.combo_first + i];
+		auto mask = std::find_if(profile.combo_masks.begin() + record.mask_first, profile.combo_masks.end(),
+					 [&](const JoypadCompiledComboMask &m) { return m.device == entry.device; });
+		if (mask == profile.combo_masks.end()) {
+			profile.combo_masks.push_back({entry.device, 0});
+			mask = profile.combo_masks.end() - 1;
+		}
+		mask->mask |= button_bit(entry.button);
+		auto &slots = table.button_slots[entry.button];
+		if (slots.empty() || slots.back() != slot) {
+			slots.push_back(slot);
+		}
+	}
+	record.mask_count = (uint16_t)(profile.combo_masks.size() - record.mask_first);
+}
+
+// Aho-Corasick construction: a trie of the sequences, then a breadth-first pass that fills
+// every missing transition from the failure state and merges suffix outputs.
+void build_sequence_automaton(const JoypadCompiledProfile &profile, JoypadCompiledSequences &automaton,
+			      const std::vector<uint32_t> &slots)
+{
+	constexpr uint32_t kSymbols = JoypadCompiledSequences::kSymbols;
+	constexpr uint32_t kNoState = UINT32_MAX;
+	if (slots.empty()) {
+		return;
+	}
+	std::vector<std::vector<uint32_t>> outputs(1);
+	automaton.next.assign(kSymbols, kNoState);
+	for (uint32_t slot : slots) {
+		const JoypadCompiledBinding &binding = profile.bindings[slot];
+		uint32_t state = 0;
+		for (uint32_t i = 0; i < binding.combo_count; ++i) {
+			const uint32_t symbol = (uint32_t)profile.combo_entries[binding.combo_first + i].button - 1;
+			uint32_t &next = automaton.next[state * kSymbols + symbol];
+			if (next == kNoState) {
+				next = (uint32_t)outputs.size();
+				outputs.emplace_back();
+				automaton.next.resize(automaton.next.size() + kSymbols, kNoState);
+			}
+			state = automaton.next[state * kSymbols + symbol];
+		}
+		outputs[state].push_back(slot);
+		automaton.max_length = std::max<uint32_t>(automaton.max_length, binding.combo_count);
+	}
+
+	std::vector<uint32_t> fail(outputs.size(), 0);
+	std::vector<uint32_t> queue;
+	queue.reserve(outputs.size());
+	for (uint32_t symbol = 0; symbol < kSymbols; ++symbol) {
+		uint32_t &next = automaton.next[symbol];
+		if (next == kNoState) {
+			next = 0;
+		} else {
+			queue.push_back(next);
+		}
+	}
+	for (size_t head = 0; head < queue.size(); ++head) {
+		const uint32_t state = queue[head];
+		auto &own = outputs[state];
+		const auto &inherited = outputs[fail[state]];
+		own.insert(own.end(), inherited.begin(), inherited.end());
+		std::sort(own.begin(), own.end());
+		for (uint32_t symbol = 0; symbol < kSymbols; ++symbol) {
+			uint32_t &next = automaton.next[state * kSymbols + symbol];
+			const uint32_t fallback = automaton.next[fail[state] * kSymbols + symbol];
+			if (next == kNoState) {
+				next = fallback;
+			} else {
+				fail[next] = fallback;
+				queue.push_back(next);
+			}
+		}
+	}
+
+	automaton.output_first.reserve(outputs.size() + 1);
+	for (const auto &state_outputs : outputs) {
+		automaton.output_first.push_back((uint32_t)automaton.outputs.size());
+		automaton.outputs.insert(automaton.outputs.end(), state_outputs.begin(), state_outputs.end());
+	}
+	automaton.output_first.push_back((uint32_t)automaton.outputs.size());
+}
+
+JoypadPayloadKind payload_kind_for(JoypadActionType action)
+{
+	switch (action) {
+	case JoypadActionType::SwitchScene:
+	case JoypadActionType::ToggleSourceVisibility:
+	case JoypadActionType::SetSourceVisibility:
+	case JoypadActionType::ToggleSourceMute:
+	case JoypadActionType::SetSourceMute:
+	case JoypadActionType::SetSourceVolume:
+	case JoypadActionType::AdjustSourceVolume:
+	case JoypadActionType::SetSourceVolumePercent:
+	case JoypadActionType::MediaPlayPause:
+	case JoypadActionType::MediaRestart:
+	case JoypadActionType::MediaStop:
+	case JoypadActionType::SourceTransform:
+	case JoypadActionType::Screenshot:
+		return JoypadPayloadKind::Source;
+	case JoypadActionType::ToggleFilterEnabled:
+	case JoypadActionType::SetFilterEnabled:
+	case JoypadActionType::SetFilterProperty:
+	case JoypadActionType::AdjustFilterProperty:
+		return JoypadPayloadKind::Filter;
+	default:
+		return JoypadPayloadKind::None;
+	}
+}
+
+// Values an action is dispatched with before the matcher adjusts them for the event.
+void payload_values(const JoypadCompiledProfile &profile, const JoypadCompiledBinding &binding, double &volume_value,
+		    double &filter_property_value)
+{
+	if (binding.payload_kind == JoypadPayloadKind::Source) {
+		volume_value = profile.source_payloads[binding.payload].volume_value;
+	} else if (binding.payload_kind == JoypadPayloadKind::Filter) {
+		const JoypadCompiledFilterPayload &payload = profile.filter_payloads[binding.payload];
+		volume_value = payload.volume_value;
+		filter_property_value = payload.property_value;
+	}
+}
+
+// Builds one compiled profile: interns strings and deduplicates devices.
+class ProfileCompiler {
+public:
+	ProfileCompiler(JoypadCompiledProfile &profile, JoypadStringPool &pool) : profile_(profile), pool_(pool)
+	{
+		profile_.strings.push_back(pool_.Intern(std::string()));
+		string_ids_.emplace(profile_.strings.front(), 0);
+	}
+
+	uint32_t StringId(const std::string &value)
+	{
+		const std::string *interned = pool_.Intern(value);
+		auto it = string_ids_.find(interned);
+		if (it != string_ids_.end()) {
+			return it->second;
+		}
+		const uint32_t id = (uint32_t)profile_.strings.size();
+		profile_.strings.push_back(interned);
+		string_ids_.emplace(interned, id);
+		return id;
+	}
+
+	uint32_t DeviceIndex(const std::string &id, const std::string &stable_id, const std::string &type_id,
+			     const std::string &name)
+	{
+		JoypadCompiledDevice device;
+		device.id = StringId(id);
+		device.stable_id = StringId(stable_id);
+		device.type_id = StringId(type_id);
+		device.name = StringId(name);
+		for (size_t i = 0; i < profile_.devices.size(); ++i) {
+			const JoypadCompiledDevice &other = profile_.devices[i];
+			if (other.id == device.id && other.stable_id == device.stable_id &&
+			    other.type_id == device.type_id && other.name == device.name) {
+				return (uint32_t)i;
+			}
+		}
+		device.xbox_like = JoypadIsXboxLikeDevice(type_id, name);
+		device.key = JoypadMakeDeviceKey(id, stable_id, type_id);
+		profile_.devices.push_back(device);
+		return (uint32_t)profile_.devices.size() - 1;
+	}
+
+private:
+	JoypadCompiledProfile &profile_;
+	JoypadStringPool &pool_;
+	std::unordered_map<const std::string *, uint32_t> string_ids_;
+};
+} // namespace
+
+const std::string *JoypadStringPool::Intern(const std::string &value)
+{
+	return &*strings_.insert(value).first;
+}
+
+JoypadActionParams JoypadCompiledProfile::Params(uint32_t slot, double volume_value,
+						 double filter_property_value) const
+{
+	const JoypadCompiledBinding &binding = bindings[slot];
+	JoypadActionParams params;
+	params.action = binding.action;
+	params.use_current_scene = binding.Has(JoypadCompiledBinding::kUseCurrentScene);
+	params.bool_value = binding.Has(JoypadCompiledBinding::kBoolValue);
+	params.allow_above_unity = binding.Has(JoypadCompiledBinding::kAllowAboveUnity);
+	params.source_transform_op = (JoypadSourceTransformOp)binding.action_op;
+	params.screenshot_target = (JoypadScreenshotTarget)binding.action_op;
+	params.volume_value = volume_value;
+	params.filter_property_value = filter_property_value;
+	if (binding.payload_kind == JoypadPayloadKind::Source) {
+		const JoypadCompiledSourcePayload &payload = source_payloads[binding.payload];
+		params.scene_name = String(payload.scene_name).c_str();
+		params.source_name = String(payload.source_name).c_str();
+	} else if (binding.payload_kind == JoypadPayloadKind::Filter) {
+		const JoypadCompiledFilterPayload &payload = filter_payloads[binding.payload];
+		params.source_name = String(payload.source_name).c_str();
+		params.filter_name = String(payload.filter_name).c_str();
+		params.filter_property_name = String(payload.property_name).c_str();
+		params.filter_property_list_string = String(payload.list_string).c_str();
+		params.filter_property_list_int = payload.list_int;
+		params.filter_property_list_float = payload.list_float;
+	}
+	return params;
+}
+
+size_t JoypadCompiledProfile::MemoryUsage() const
+{
+	size_t bytes = sizeof(*this);
+	bytes += bindings.capacity() * sizeof(JoypadCompiledBinding);
+	bytes += devices.capacity() * sizeof(JoypadCompiledDevice);
+	bytes += combo_entries.capacity() * sizeof(JoypadCompiledComboEntry);
+	bytes += combo_masks.capacity() * sizeof(JoypadCompiledComboMask);
+	bytes += axes.capacity() * sizeof(JoypadCompiledAxis);
+	bytes += conditions.capacity() * sizeof(JoypadCompiledCondition);
+	bytes += source_payloads.capacity() * sizeof(JoypadCompiledSourcePayload);
+	bytes += filter_payloads.capacity() * sizeof(JoypadCompiledFilterPayload);
+	bytes += strings.capacity() * sizeof(const std::string *);
+	bytes += modifiers.capacity() * sizeof(JoypadCompiledModifier);
+	bytes += layers.capacity() * sizeof(JoypadCompiledLayerTable);
+	for (const auto &layer : layers) {
+		for (const auto *index : {&layer.button_slots, &layer.axis_slots}) {
+			for (const auto &entry : *index) {
+				bytes += sizeof(entry) + entry.second.capacity() * sizeof(uint32_t);
+			}
+		}
+		const JoypadCompiledSequences &sequences = layer.sequences;
+		bytes += (sequences.next.capacity() + sequences.output_first.capacity() +
+			  sequences.outputs.capacity()) *
+			 sizeof(uint32_t);
+	}
+	return bytes;
+}
+
+void JoypadSyncButtonCombo(JoypadBinding &binding)
+{
+	if (binding.input_type != JoypadInputType::Button) {
+		binding.button = -1;
+		binding.button_combo.clear();
+		return;
+	}
+
+	if (binding.button_combo.empty() && binding.button > 0) {
+		JoypadButtonComboEntry entry;
+		entry.device_id = binding.device_id;
+		entry.device_stable_id = binding.device_stable_id;
+		entry.device_type_id = binding.device_type_id;
+		entry.device_name = binding.device_name;
+		entry.button = binding.button;
+		binding.button_combo.push_back(std::move(entry));
+	}
+
+	if (!binding.button_combo.empty()) {
+		const auto &primary = binding.button_combo.front();
+		binding.button = primary.button;
+		binding.device_id = primary.device_id;
+		binding.device_stable_id = primary.device_stable_id;
+		binding.device_type_id = primary.device_type_id;
+		binding.device_name = primary.device_name;
+	}
+}
+
+std::shared_ptr<const JoypadCompiledProfile> JoypadCompileProfile(const std::vector<JoypadBinding> &bindings,
+								  const std::vector<JoypadLayer> &layers,
+								  uint64_t revision,
+								  const std::shared_ptr<JoypadStringPool> &pool,
+								  uint64_t layer_revision)
+{
+	auto compiled = std::make_shared<JoypadCompiledProfile>();
+	compiled->revision = revision;
+	compiled->layer_revision = layer_revision;
+	compiled->pool = pool;
+	compiled->bindings.reserve(bindings.size());
+	compiled->layers.resize(layers.size() + 1);
+	ProfileCompiler compiler(*compiled, *pool);
+	std::vector<std::vector<uint32_t>> sequence_slots(compiled->layers.size());
+
+	for (size_t i = 0; i < layers.size(); ++i) {
+		const JoypadButtonComboEntry &modifier = layers[i].modifier;
+		if (button_bit(modifier.button) == 0) {
+			continue;
+		}
+		JoypadCompiledModifier compiled_modifier;
+		compiled_modifier.device = compiler.DeviceIndex(modifier.device_id, modifier.device_stable_id,
+								modifier.device_type_id, modifier.device_name);
+		compiled_modifier.button = modifier.button;
+		compiled_modifier.layer = (uint32_t)i + 1;
+		compiled->modifiers.push_back(compiled_modifier);
+		compiled->modifier_buttons |= button_bit(modifier.button);
+	}
+
+	for (const auto &source : bindings) {
+		// Bindings of a layer that no longer exists stay in the profile but never match.
+		if (!source.enabled || source.layer < 0 || source.layer >= (int)compiled->layers.size()) {
+			continue;
+		}
+		JoypadCompiledLayerTable &table = compiled->layers[source.layer];
+		JoypadBinding binding = source;
+		JoypadSyncButtonCombo(binding);
+
+		const uint32_t slot = (uint32_t)compiled->bindings.size();
+		JoypadCompiledBinding record;
+		record.uid = binding.uid;
+		record.action = binding.action;
+		record.input_type = binding.input_type;
+		record.axis_direction = binding.axis_direction;
+		record.axis_index = binding.axis_index;
+		record.device = compiler.DeviceIndex(binding.device_id, binding.device_stable_id, binding.device_type_id,
+						     binding.device_name);
+		if (binding.axis_inverted)
+			record.flags |= JoypadCompiledBinding::kAxisInverted;
+		if (binding.use_current_scene)
+			record.flags |= JoypadCompiledBinding::kUseCurrentScene;
+		if (binding.bool_value)
+			record.flags |= JoypadCompiledBinding::kBoolValue;
+		if (binding.allow_above_unity)
+			record.flags |= JoypadCompiledBinding::kAllowAboveUnity;
+		record.action_op = binding.action == JoypadActionType::Screenshot ? (uint8_t)binding.screenshot_target
+										  : (uint8_t)binding.source_transform_op;
+
+		if (binding.input_type == JoypadInputType::Axis) {
+			if (binding.axis_index < 0) {
+				continue;
+			}
+			JoypadCompiledAxis axis;
+			axis.threshold = binding.axis_threshold;
+			axis.min_per_second = binding.axis_min_per_second;
+			axis.max_per_second = binding.axis_max_per_second;
+			axis.min_value = binding.axis_min_value;
+			axis.max_value = binding.axis_max_value;
+			axis.slider_gamma = binding.slider_gamma;
+			record.axis = (uint32_t)compiled->axes.size();
+			compiled->axes.push_back(axis);
+			table.axis_slots[binding.axis_index].push_back(slot);
+		} else {
+			if (binding.button_combo.empty()) {
+				continue;
+			}
+			// Buttons past 32 can never be reported as held, so such combos can never fire.
+			const auto &combo = binding.button_combo;
+			const auto in_range = [](const JoypadButtonComboEntry &e) { return button_bit(e.button) != 0; };
+			const bool reachable = std::all_of(combo.begin(), combo.end(), in_range);
+			if (!reachable) {
+				continue;
+			}
+			record.combo_first = (uint32_t)compiled->combo_entries.size();
+			record.combo_count = (uint16_t)std::min<size_t>(binding.button_combo.size(), UINT16_MAX);
+			for (uint32_t i = 0; i < record.combo_count; ++i) {
+				const auto &entry = binding.button_combo[i];
+				JoypadCompiledComboEntry compiled_entry;
+				compiled_entry.device = compiler.DeviceIndex(entry.device_id, entry.device_stable_id,
+									     entry.device_type_id, entry.device_name);
+				compiled_entry.button = entry.button;
+				compiled->combo_entries.push_back(compiled_entry);
+			}
+			record.combo_window_ms = (uint16_t)std::clamp(binding.combo_window_ms, 50, 5000);
+			if (binding.combo_mode == JoypadComboMode::Sequence) {
+				record.flags |= JoypadCompiledBinding::kSequence;
+				sequence_slots[source.layer].push_back(slot);
+			} else {
+				compile_combo_masks(*compiled, table, record, slot);
+				if (binding.combo_mode == JoypadComboMode::Ordered && record.combo_count > 1)
+					record.flags |= JoypadCompiledBinding::kComboOrdered;
+				if (binding.combo_trigger == JoypadComboTrigger::Release)
+					record.flags |= JoypadCompiledBinding::kComboOnRelease;
+			}
+		}
+
+		if (binding.require_state != 0 || binding.forbid_state != 0 || !binding.condition_scene.empty()) {
+			JoypadCompiledCondition condition;
+			condition.mask = binding.require_state | binding.forbid_state;
+			condition.value = binding.require_state;
+			condition.scene_hash = JoypadHashString(binding.condition_scene);
+			compiled->conditions.push_back(condition);
+			record.condition = (uint32_t)compiled->conditions.size();
+		}
+
+		record.payload_kind = payload_kind_for(binding.action);
+		if (record.payload_kind == JoypadPayloadKind::Source) {
+			JoypadCompiledSourcePayload payload;
+			payload.scene_name = compiler.StringId(binding.scene_name);
+			payload.source_name = compiler.StringId(binding.source_name);
+			payload.volume_value = binding.volume_value;
+			record.payload = (uint32_t)compiled->source_payloads.size();
+			compiled->source_payloads.push_back(payload);
+		} else if (record.payload_kind == JoypadPayloadKind::Filter) {
+			JoypadCompiledFilterPayload payload;
+			payload.source_name = compiler.StringId(binding.source_name);
+			payload.filter_name = compiler.StringId(binding.filter_name);
+			payload.property_name = compiler.StringId(binding.filter_property_name);
+			payload.list_string = compiler.StringId(binding.filter_property_list_string);
+			payload.property_type = binding.filter_property_type;
+			payload.volume_value = binding.volume_value;
+			payload.property_value = binding.filter_property_value;
+			payload.property_min = binding.filter_property_min;
+			payload.property_max = binding.filter_property_max;
+			payload.list_int = binding.filter_property_list_int;
+			payload.list_float = binding.filter_property_list_float;
+			record.payload = (uint32_t)compiled->filter_payloads.size();
+			compiled->filter_payloads.push_back(payload);
+		}
+		compiled->bindings.push_back(record);
+	}
+	compiled->bindings.shrink_to_fit();
+	for (size_t i = 0; i < compiled->layers.size(); ++i) {
+		build_sequence_automaton(*compiled, compiled->layers[i].sequences, sequence_slots[i]);
+	}
+	// Buttons and axes a layer leaves unbound keep their base-layer bindings while it is held.
+	const JoypadCompiledLayerTable &base = compiled->layers.front();
+	for (size_t i = 1; i < compiled->layers.size(); ++i) {
+		JoypadCompiledLayerTable &table = compiled->layers[i];
+		table.button_slots.insert(base.button_slots.begin(), base.button_slots.end());
+		table.axis_slots.insert(base.axis_slots.begin(), base.axis_slots.end());
+	}
+	return compiled;
+}
+
+void JoypadMatcher::Match(const JoypadCompiledProfile &profile, const JoypadEvent &event,
+			  const JoypadInputManager *input, const JoypadFrontendState *state,
+			  std::vector<JoypadMatch> &matches)
+{
+	if (layer_revision_.load(std::memory_order_relaxed) != profile.layer_revision) {
+		// A modifier held across a profile switch or layer edit may never be released here.
+		layer_revision_.store(profile.layer_revision, std::memory_order_relaxed);
+		active_layer_.store(0, std::memory_order_relaxed);
+	}
+	if (!event.is_axis && (profile.modifier_buttons & button_bit(event.button)) != 0 &&
+	    SwitchLayer(profile, event)) {
+		return;
+	}
+	const uint32_t layer = active_layer_.load(std::memory_order_relaxed);
+	const JoypadCompiledLayerTable &table = profile.Layer(layer);
+	const auto &index = event.is_axis ? table.axis_slots : table.button_slots;
+	const auto it = index.find(event.is_axis ? event.axis_index : event.button);
+	const bool sequence_step = !event.is_axis && !event.released && !table.sequences.empty();
+	if (it == index.end() && !sequence_step) {
+		return;
+	}
+
+	const auto now = Clock::now();
+	const size_t first_match = matches.size();
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (it != index.end()) {
+		for (uint32_t slot : it->second) {
+			if (event.is_axis) {
+				MatchAxis(profile, slot, event, now, matches);
+			} else {
+				MatchButton(profile, slot, event, input, now, matches);
+			}
+		}
+	}
+	if (sequence_step) {
+		MatchSequences(profile, layer, event, state, now, matches);
+	}
+	// Conditions are applied after matching, so combo and axis state keep tracking the input
+	// while a binding is held back by them. Sequences already skipped theirs, since a fired
+	// sequence resets the shared automaton.
+	if (state && !profile.conditions.empty() && matches.size() > first_match) {
+		const uint32_t flags = state->Flags();
+		const uint64_t scene = state->SceneHash();
+		const auto held_back = [&](const JoypadMatch &match) {
+			const uint32_t condition = profile.bindings[match.slot].condition;
+			return condition != 0 && !condition_met(profile.conditions[condition - 1], flags, scene);
+		};
+		matches.erase(std::remove_if(matches.begin() + (ptrdiff_t)first_match, matches.end(), held_back),
+			      matches.end());
+	}
+}
+
+bool JoypadMatcher::SwitchLayer(const JoypadCompiledProfile &profile, const JoypadEvent &event)
+{
+	for (const JoypadCompiledModifier &modifier : profile.modifiers) {
+		if (modifier.button != event.button ||
+		    !device_matches_event(profile, profile.devices[modifier.device], event)) {
+			continue;
+		}
+		if (!event.released) {
+			active_layer_.store(modifier.layer, std::memory_order_relaxed);
+		} else {
+			// Releasing a modifier that was already superseded leaves the newer layer active.
+			uint32_t expected = modifier.layer;
+			active_layer_.compare_exchange_strong(expected, 0, std::memory_order_relaxed);
+		}
+		return true;
+	}
+	return false;
+}
+
+void JoypadMatcher::Reset()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	axis_active_.clear();
+	combo_progress_.clear();
+	active_layer_.store(0, std::memory_order_relaxed);
+	sequence_revision_ = 0;
+	axis_last_dispatch_.clear();
+}
+
+void JoypadMatcher::Forget(const std::vector<int64_t> &uids)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	for (int64_t uid : uids) {
+		axis_active_.erase(uid);
+		combo_progress_.erase(uid);
+		axis_last_dispatch_.erase(uid);
+	}
+}
+
+bool JoypadMatcher::MatchAxis(const JoypadCompiledProfile &profile, uint32_t slot, const JoypadEvent &event,
+			      Clock::time_point now, std::vector<JoypadMatch> &matches)
+{
+	const JoypadCompiledBinding &binding = profile.bindings[slot];
+	if (!device_matches_event(profile, profile.devices[binding.device], event)) {
+		return false;
+	}
+	const JoypadCompiledAxis &axis = profile.axes[binding.axis];
+	const bool axis_inverted = binding.Has(JoypadCompiledBinding::kAxisInverted);
+	const JoypadCompiledFilterPayload *filter =
+		binding.payload_kind == JoypadPayloadKind::Filter ? &profile.filter_payloads[binding.payload] : nullptr;
+
+	const bool is_percent_axis = (binding.action == JoypadActionType::SetSourceVolumePercent);
+	const bool is_filter_numeric_axis =
+		filter && binding.action == JoypadActionType::SetFilterProperty &&
+		(filter->property_type == kJoypadPropertyInt || filter->property_type == kJoypadPropertyFloat);
+	double volume_value = 0.0;
+	double filter_property_value = 0.0;
+	payload_values(profile, binding, volume_value, filter_property_value);
+	if (is_percent_axis) {
+		// Map axis min..max to 0..100%
+		double minv = axis.min_value;
+		double maxv = axis.max_value;
+		if (maxv <= minv) {
+			minv = 0.0;
+			maxv = 1024.0;
+		}
+		const double raw = event.axis_raw_value;
+		double percent = ((raw - minv) / (maxv - minv)) * 100.0;
+		if (axis_inverted || binding.axis_direction == JoypadAxisDirection::Negative) {
+			percent = 100.0 - percent;
+		}
+		double base = std::clamp(percent / 100.0, 0.0, 1.0);
+		double gamma = axis.slider_gamma > 0.0 ? axis.slider_gamma : 0.6;
+		gamma = std::clamp(gamma, 0.1, 50.0);
+		double curved = std::pow(base, gamma);
+		volume_value = std::clamp(curved * 100.0, 0.0, 100.0);
+	} else if (is_filter_numeric_axis) {
+		double minv = axis.min_value;
+		double maxv = axis.max_value;
+		if (maxv <= minv) {
+			minv = 0.0;
+			maxv = 1024.0;
+		}
+		double normalized = (event.axis_raw_value - minv) / (maxv - minv);
+		normalized = std::clamp(normalized, 0.0, 1.0);
+		if (axis_inverted || binding.axis_direction == JoypadAxisDirection::Negative) {
+			normalized = 1.0 - normalized;
+		}
+		double target_min = filter->property_min;
+		double target_max = filter->property_max;
+		if (target_max <= target_min) {
+			target_min = 0.0;
+			target_max = 1.0;
+		}
+		filter_property_value = target_min + normalized * (target_max - target_min);
+	}
+	double value = event.axis_value;
+	if (axis_inverted) {
+		value = -value;
+	}
+	const double abs_value = std::fabs(value);
+	if (!is_percent_axis && !is_filter_numeric_axis && binding.axis_direction != JoypadAxisDirection::Both) {
+		int dir = value >= 0.0 ? 1 : -1;
+		if (dir != (int)binding.axis_direction) {
+			return false;
+		}
+	}
+
+	const double threshold_on = std::clamp(axis.threshold, 0.0, 0.95);
+	const double threshold_off = threshold_on * 0.4;
+	if (!is_percent_axis && !is_filter_numeric_axis) {
+		const uint64_t device =
+			event.device_key.id != 0 ? event.device_key.id : JoypadHashString(event.device_id);
+		bool &active = axis_active_[binding.uid][device];
+		if (!active) {
+			if (abs_value < threshold_on) {
+				return false;
+			}
+			active = true;
+		} else if (abs_value < threshold_off) {
+			active = false;
+			return false;
+		}
+	}
+	if (binding.action == JoypadActionType::AdjustSourceVolume ||
+	    binding.action == JoypadActionType::AdjustFilterProperty) {
+		double sign = value >= 0.0 ? 1.0 : -1.0;
+		volume_value = std::fabs(volume_value) * sign;
+	}
+	if (!is_percent_axis && !is_filter_numeric_axis) {
+		const double min_rate = std::clamp(axis.min_per_second, 1.0, 60.0);
+		const double max_rate = std::clamp(axis.max_per_second, min_rate, 60.0);
+		double intensity = std::clamp((abs_value - threshold_on) / (1.0 - threshold_on), 0.0, 1.0);
+		double rate = min_rate + (max_rate - min_rate) * intensity;
+		int dynamic_interval_ms = (int)std::round(1000.0 / std::max(rate, 0.001));
+		dynamic_interval_ms = std::max(dynamic_interval_ms, 1);
+		auto it_last = axis_last_dispatch_.find(binding.uid);
+		if (it_last != axis_last_dispatch_.end()) {
+			const auto elapsed =
+				std::chrono::duration_cast<std::chrono::milliseconds>(now - it_last->second).count();
+			if (elapsed < dynamic_interval_ms) {
+				return false;
+			}
+		}
+		axis_last_dispatch_[binding.uid] = now;
+	}
+
+	matches.push_back({slot, volume_value, filter_property_value});
+	return true;
+}
+
+bool JoypadMatcher::AdvanceOrderedCombo(const JoypadCompiledProfile &profile, const JoypadCompiledBinding &binding,
+					const JoypadEvent &event, bool held_after, Clock::time_point now)
+{
+	ComboProgress &progress = combo_progress_[binding.uid];
+	if (event.released) {
+		// Letting go of any combo button abandons a partial sequence.
+		progress.next = 0;
+		return false;
+	}
+	const JoypadCompiledComboEntry *entries = profile.combo_entries.data() + binding.combo_first;
+	const auto window = std::chrono::milliseconds(binding.combo_window_ms);
+	const auto is_entry = [&](uint32_t i) {
+		return entries[i].button == event.button &&
+		       device_matches_event(profile, profile.devices[entries[i].device], event);
+	};
+	if (progress.next > 0 && now - progress.started <= window && is_entry(progress.next)) {
+		++progress.next;
+	} else {
+		// Out of order or too slow: this press may still start a new attempt.
+		progress.next = is_entry(0) ? 1 : 0;
+		progress.started = now;
+		progress.armed = false;
+	}
+	if (progress.next < binding.combo_count) {
+		return false;
+	}
+	progress.next = 0;
+	return held_after;
+}
+
+bool JoypadMatcher::MatchButton(const JoypadCompiledProfile &profile, uint32_t slot, const JoypadEvent &event,
+				const JoypadInputManager *input, Clock::time_point now,
+				std::vector<JoypadMatch> &matches)
+{
+	const JoypadCompiledBinding &binding = profile.bindings[slot];
+	const ComboEdge edge = combo_edge(profile, binding, event, input);
+	if (!edge.touched) {
+		return false;
+	}
+	const bool on_release = binding.Has(JoypadCompiledBinding::kComboOnRelease);
+	bool fire = false;
+	if (!binding.Has(JoypadCompiledBinding::kComboOrdered)) {
+		// Edge triggered: fire once when the last button of the chord goes down, or when the
+		// first one comes up after the whole chord was held.
+		fire = on_release ? (edge.before && !edge.after) : (!edge.before && edge.after);
+	} else if (!event.released) {
+		const bool completed = AdvanceOrderedCombo(profile, binding, event, edge.after, now);
+		if (completed && on_release) {
+			combo_progress_[binding.uid].armed = true;
+		}
+		fire = completed && !on_release;
+	} else {
+		ComboProgress &progress = combo_progress_[binding.uid];
+		fire = progress.armed && edge.before && !edge.after;
+		if (!edge.after) {
+			progress.armed = false;
+		}
+		AdvanceOrderedCombo(profile, binding, event, false, now);
+	}
+	if (!fire) {
+		return false;
+	}
+	JoypadMatch match{slot, 0.0, 0.0};
+	payload_values(profile, binding, match.volume_value, match.filter_property_value);
+	matches.push_back(match);
+	return true;
+}
+
+void JoypadMatcher::MatchSequences(const JoypadCompiledProfile &profile, uint32_t layer, const JoypadEvent &event,
+				   const JoypadFrontendState *state, Clock::time_point now,
+				   std::vector<JoypadMatch> &matches)
+{
+	const JoypadCompiledSequences &automaton = profile.Layer(layer).sequences;
+	if (sequence_revision_ != profile.revision || sequence_layer_ != layer) {
+		// State numbers are only meaningful for the automaton they were computed with.
+		sequence_revision_ = profile.revision;
+		sequence_layer_ = layer;
+		sequence_state_ = 0;
+		sequence_history_.assign(automaton.max_length, SequenceStep{});
+		sequence_head_ = 0;
+	}
+	if (event.button < 1 || event.button > (int)JoypadCompiledSequences::kSymbols) {
+		sequence_state_ = 0;
+		return;
+	}
+
+	SequenceStep &step = sequence_history_[sequence_head_];
+	step.time = now;
+	if (event.device_key.id != 0) {
+		step.key = event.device_key;
+		step.xbox_like = event.device_xbox_like;
+	} else {
+		step.key = JoypadMakeDeviceKey(event.device_id, event.device_stable_id, event.device_type_id);
+		step.xbox_like = JoypadIsXboxLikeDevice(event.device_type_id, event.device_name);
+	}
+	sequence_head_ = (sequence_head_ + 1) % sequence_history_.size();
+	sequence_state_ = automaton.next[sequence_state_ * JoypadCompiledSequences::kSymbols + event.button - 1];
+
+	bool fired = false;
+	const uint32_t last = automaton.output_first[sequence_state_ + 1];
+	for (uint32_t i = automaton.output_first[sequence_state_]; i < last; ++i) {
+		const uint32_t slot = automaton.outputs[i];
+		const JoypadCompiledBinding &binding = profile.bindings[slot];
+		const size_t length = binding.combo_count;
+		const size_t history = sequence_history_.size();
+		// Entry k of the sequence is the (length - 1 - k)-th most recent press.
+		const auto press = [&](size_t k) -> const SequenceStep & {
+			return sequence_history_[(sequence_head_ + history - length + k) % history];
+		};
+		if (now - press(0).time > std::chrono::milliseconds(binding.combo_window_ms)) {
+			continue;
+		}
+		if (state && binding.condition != 0 &&
+		    !condition_met(profile.conditions[binding.condition - 1], state->Flags(), state->SceneHash())) {
+			continue;
+		}
+		bool devices_match = true;
+		for (size_t k = 0; k < length && devices_match; ++k) {
+			const JoypadCompiledComboEntry &entry = profile.combo_entries[binding.combo_first + k];
+			const SequenceStep &pressed = press(k);
+			const JoypadCompiledDevice &device = profile.devices[entry.device];
+			devices_match = device_matches_key(device, pressed.key, pressed.xbox_like);
+		}
+		if (!devices_match) {
+			continue;
+		}
+		JoypadMatch match{slot, 0.0, 0.0};
+		payload_values(profile, binding, match.volume_value, match.filter_property_value);
+		matches.push_back(match);
+		fired = true;
+	}
+	if (fired) {
+		// A completed sequence consumes its presses, so "A, A" fires once per two taps.
+		sequence_state_ = 0;
+	}
+}
@@ -0,0 +1,297 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include "joypad-core.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class JoypadInputManager;
+
+// Deduplicated strings shared by compiled profiles. Entries are never moved or removed,
+// so pointers handed out by Intern stay valid while the pool is alive. Not thread safe;
+// only the config store interns, under its own lock.
+class JoypadStringPool {
+public:
+	const std::string *Intern(const std::string &value);
+	size_t Size() const { return strings_.size(); }
+
+private:
+	std::unordered_set<std::string> strings_;
+};
+
+// Compiled bindings are split into a small fixed-size header plus side tables, so a
+// binding only pays for the fields its input and action kinds actually use. Strings
+// are uint32_t ids into JoypadCompiledProfile::strings; id 0 is the empty string.
+struct JoypadCompiledDevice {
+	uint32_t id = 0;
+	uint32_t stable_id = 0;
+	uint32_t type_id = 0;
+	uint32_t name = 0;
+	bool xbox_like = false;
+	JoypadDeviceKey key;
+};
+
+struct JoypadCompiledComboEntry {
+	uint32_t device = 0;
+	int32_t button = -1;
+};
+
+// One device's share of a combo: bit N set means button N + 1 must be held on it.
+struct JoypadCompiledComboMask {
+	uint32_t device = 0;
+	uint32_t mask = 0;
+};
+
+// All sequence bindings of a profile share one Aho-Corasick automaton over button numbers
+// 1..32, flattened into a dense goto table. A press costs one table lookup, however many
+// sequences the profile defines; timeouts and devices are only checked on a hit.
+struct JoypadCompiledSequences {
+	static constexpr uint32_t kSymbols = 32;
+	// state * kSymbols + (button - 1) -> next state; state 0 is the root.
+	std::vector<uint32_t> next;
+	// Bindings whose sequence ends in a state, suffix matches included, are
+	// outputs[output_first[state] .. output_first[state + 1]).
+	std::vector<uint32_t> output_first;
+	std::vector<uint32_t> outputs;
+	uint32_t max_length = 0;
+
+	bool empty() const { return next.empty(); }
+};
+
+// Lookup tables of one layer; slots index JoypadCompiledProfile::bindings.
+struct JoypadCompiledLayerTable {
+	// Button number / axis index -> slots in bindings, in profile order.
+	std::unordered_map<int, std::vector<uint32_t>> button_slots;
+	std::unordered_map<int, std::vector<uint32_t>> axis_slots;
+	JoypadCompiledSequences sequences;
+};
+
+// Holding button on device makes layer the active table.
+struct JoypadCompiledModifier {
+	uint32_t device = 0;
+	int32_t button = -1;
+	uint32_t layer = 0;
+};
+
+// Fires only while (flags & mask) == value and, if scene_hash is set, in that program scene.
+struct JoypadCompiledCondition {
+	uint32_t mask = 0;
+	uint32_t value = 0;
+	uint64_t scene_hash = 0;
+};
+
+struct JoypadCompiledAxis {
+	double threshold = 0.10;
+	double min_per_second = 2.5;
+	double max_per_second = 20.0;
+	double min_value = 0.0;
+	double max_value = 1024.0;
+	double slider_gamma = 0.6;
+};
+
+// Scene, source and media actions.
+struct JoypadCompiledSourcePayload {
+	uint32_t scene_name = 0;
+	uint32_t source_name = 0;
+	double volume_value = 1.0;
+};
+
+struct JoypadCompiledFilterPayload {
+	uint32_t source_name = 0;
+	uint32_t filter_name = 0;
+	uint32_t property_name = 0;
+	uint32_t list_string = 0;
+	int32_t property_type = 0;
+	double volume_value = 1.0;
+	double property_value = 0.0;
+	double property_min = 0.0;
+	double property_max = 1.0;
+	long long list_int = 0;
+	double list_float = 0.0;
+};
+
+enum class JoypadPayloadKind : uint8_t {
+	None = 0,
+	Source = 1,
+	Filter = 2,
+};
+
+struct JoypadCompiledBinding {
+	int64_t uid = 0;
+	uint32_t device = 0;
+	uint32_t combo_first = 0;
+	uint32_t mask_first = 0;
+	uint32_t payload = 0;
+	uint32_t axis = 0;
+	// 1 + index into JoypadCompiledProfile::conditions; 0 when unconditional.
+	uint32_t condition = 0;
+	int32_t axis_index = -1;
+	uint16_t combo_count = 0;
+	uint16_t mask_count = 0;
+	uint16_t combo_window_ms = 0;
+	JoypadActionType action = JoypadActionType::SwitchScene;
+	JoypadInputType input_type = JoypadInputType::Button;
+	JoypadAxisDirection axis_direction = JoypadAxisDirection::Both;
+	JoypadPayloadKind payload_kind = JoypadPayloadKind::None;
+	// Transform op or screenshot target, depending on the action.
+	uint8_t action_op = 0;
+	uint8_t flags = 0;
+
+	enum : uint8_t {
+		kAxisInverted = 1 << 0,
+		kUseCurrentScene = 1 << 1,
+		kBoolValue = 1 << 2,
+		kAllowAboveUnity = 1 << 3,
+		kComboOrdered = 1 << 4,
+		kComboOnRelease = 1 << 5,
+		kSequence = 1 << 6,
+	};
+	bool Has(uint8_t flag) const { return (flags & flag) != 0; }
+};
+
+// Immutable, matcher-ready view of one profile. A new one is published on every
+// committed edit; the input thread only ever holds a reference to it.
+struct JoypadCompiledProfile {
+	uint64_t revision = 0;
+	// Changes only when a different profile or layer set is published; the matcher drops
+	// the active layer then, since its number means nothing in the new profile.
+	uint64_t layer_revision = 0;
+	std::vector<JoypadCompiledBinding> bindings;
+	std::vector<JoypadCompiledDevice> devices;
+	std::vector<JoypadCompiledComboEntry> combo_entries;
+	std::vector<JoypadCompiledComboMask> combo_masks;
+	std::vector<JoypadCompiledAxis> axes;
+	std::vector<JoypadCompiledCondition> conditions;
+	std::vector<JoypadCompiledSourcePayload> source_payloads;
+	std::vector<JoypadCompiledFilterPayload> filter_payloads;
+	// String id -> interned string in pool.
+	std::vector<const std::string *> strings;
+	std::shared_ptr<const JoypadStringPool> pool;
+	// layers[0] is the base layer, layers[n] is JoypadProfile::layers[n - 1]. Each layer table
+	// also carries the base slots of buttons and axes it does not bind itself, so switching
+	// layers adds no work per event. Sequences stay with their own layer.
+	std::vector<JoypadCompiledLayerTable> layers;
+	std::vector<JoypadCompiledModifier> modifiers;
+	// Bit N set when button N + 1 is the modifier of some layer.
+	uint32_t modifier_buttons = 0;
+
+	const std::string &String(uint32_t id) const { return *strings[id]; }
+	const JoypadCompiledLayerTable &Layer(uint32_t layer) const
+	{
+		return layer < layers.size() ? layers[layer] : layers.front();
+	}
+	// Action parameters of a slot, with the per-event values computed by the matcher.
+	JoypadActionParams Params(uint32_t slot, double volume_value, double filter_property_value) const;
+	// Bytes held by this profile, excluding the shared string pool.
+	size_t MemoryUsage() const;
+};
+
+struct JoypadMatch {
+	uint32_t slot = 0;
+	double volume_value = 0.0;
+	double filter_property_value = 0.0;
+};
+
+// Bindings matched for one event. Keeps the compiled profile they point into alive.
+struct JoypadMatchList {
+	std::shared_ptr<const JoypadCompiledProfile> profile;
+	std::vector<JoypadMatch> matches;
+
+	bool empty() const { return matches.empty(); }
+	size_t size() const { return matches.size(); }
+	const JoypadCompiledBinding &Binding(size_t i) const { return profile->bindings[matches[i].slot]; }
+	JoypadActionParams Params(size_t i) const
+	{
+		const JoypadMatch &match = matches[i];
+		return profile->Params(match.slot, match.volume_value, match.filter_property_value);
+	}
+};
+
+// Keeps the legacy single-button fields and button_combo in sync.
+void JoypadSyncButtonCombo(JoypadBinding &binding);
+
+std::shared_ptr<const JoypadCompiledProfile> JoypadCompileProfile(const std::vector<JoypadBinding> &bindings,
+								  const std::vector<JoypadLayer> &layers,
+								  uint64_t revision,
+								  const std::shared_ptr<JoypadStringPool> &pool,
+								  uint64_t layer_revision = 0);
+
+class JoypadMatcher {
+public:
+	// Conditions on OBS state are checked only when state is given.
+	void Match(const JoypadCompiledProfile &profile, const JoypadEvent &event, const JoypadInputManager *input,
+		   const JoypadFrontendState *state, std::vector<JoypadMatch> &matches);
+	void Reset();
+	// Drops runtime state (hysteresis, rate limits) of the given bindings.
+	void Forget(const std::vector<int64_t> &uids);
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	bool MatchAxis(const JoypadCompiledProfile &profile, uint32_t slot, const JoypadEvent &event,
+		       Clock::time_point now, std::vector<JoypadMatch> &matches);
+	bool MatchButton(const JoypadCompiledProfile &profile, uint32_t slot, const JoypadEvent &event,
+			 const JoypadInputManager *input, Clock::time_point now, std::vector<JoypadMatch> &matches);
+
+	// Ordered combos: how far the press sequence got, and whether a release-triggered
+	// combo was completed and now waits for its release.
+	struct ComboProgress {
+		uint16_t next = 0;
+		bool armed = false;
+		Clock::time_point started = {};
+	};
+	bool AdvanceOrderedCombo(const JoypadCompiledProfile &profile, const JoypadCompiledBinding &binding,
+				 const JoypadEvent &event, bool held_after, Clock::time_point now);
+	// Checks conditions itself: a sequence held back by one must not consume the presses.
+	void MatchSequences(const JoypadCompiledProfile &profile, uint32_t layer, const JoypadEvent &event,
+			    const JoypadFrontendState *state, Clock::time_point now, std::vector<JoypadMatch> &matches);
+	// Updates the active layer if the event is a modifier press or release.
+	bool SwitchLayer(const JoypadCompiledProfile &profile, const JoypadEvent &event);
+
+	// Recent presses, newest at sequence_history_[sequence_head_ - 1], kept to check the
+	// devices and timeout of a sequence once the automaton reports it.
+	struct SequenceStep {
+		Clock::time_point time = {};
+		JoypadDeviceKey key;
+		bool xbox_like = false;
+	};
+
+	std::mutex mutex_;
+	// uid -> JoypadDeviceKey::id -> axis past its activation threshold.
+	std::unordered_map<int64_t, std::unordered_map<uint64_t, bool>> axis_active_;
+	std::unordered_map<int64_t, ComboProgress> combo_progress_;
+	// Index into JoypadCompiledProfile::layers; written by modifier events only.
+	std::atomic<uint32_t> active_layer_{0};
+	std::atomic<uint64_t> layer_revision_{0};
+	uint64_t sequence_revision_ = 0;
+	uint32_t sequence_layer_ = 0;
+	uint32_t sequence_state_ = 0;
+	std::vector<SequenceStep> sequence_history_;
+	size_t sequence_head_ = 0;
+	std::unordered_map<int64_t, Clock::time_point> axis_last_dispatch_;
+};
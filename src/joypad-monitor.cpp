@@ -0,0 +1,243 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "joypad-monitor.h"
+
+#include <obs-module.h>
+
+#include <QFontMetrics>
+#include <QPainter>
+#include <QPalette>
+#include <QScreen>
+#include <QTimer>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr int kRowPadding = 6;
+constexpr int kRowGap = 4;
+constexpr int kAxisBarHeight = 12;
+constexpr int kButtonCount = 32;
+constexpr int kButtonCellSize = 12;
+constexpr int kButtonCellGap = 2;
+constexpr auto kRateWindow = std::chrono::milliseconds(500);
+
+inline QString L(const char *key)
+{
+	return QString::fromUtf8(obs_module_text(key));
+}
+
+bool same_sample(const JoypadMonitorSample &a, const JoypadMonitorSample &b)
+{
+	if (a.slot != b.slot || a.connected != b.connected || a.buttons != b.buttons) {
+		return false;
+	}
+	return std::equal(std::begin(a.axes), std::end(a.axes), std::begin(b.axes));
+}
+} // namespace
+
+JoypadInputMonitorWidget::JoypadInputMonitorWidget(QWidget *parent, JoypadInputManager *input)
+	: QWidget(parent),
+	  input_(input)
+{
+	setAttribute(Qt::WA_OpaquePaintEvent);
+	samples_.reserve(kJoypadMonitorSlots);
+	next_samples_.reserve(kJoypadMonitorSlots);
+	setMinimumHeight(RowHeight());
+
+	timer_ = new QTimer(this);
+	timer_->setTimerType(Qt::PreciseTimer);
+	connect(timer_, &QTimer::timeout, this, [this]() { Tick(); });
+}
+
+QSize JoypadInputMonitorWidget::sizeHint() const
+{
+	const int rows = std::max<int>(1, (int)samples_.size());
+	const int width = 2 * kRowPadding + kButtonCount * (kButtonCellSize + kButtonCellGap);
+	return QSize(width, rows * RowHeight());
+}
+
+int JoypadInputMonitorWidget::RowHeight() const
+{
+	return 2 * kRowPadding + fontMetrics().height() + kRowGap + kAxisBarHeight + kRowGap + kButtonCellSize;
+}
+
+void JoypadInputMonitorWidget::showEvent(QShowEvent *event)
+{
+	QWidget::showEvent(event);
+	double refresh_rate = 60.0;
+	if (const QScreen *current_screen = screen()) {
+		refresh_rate = std::max(1.0, (double)current_screen->refreshRate());
+	}
+	names_known_ = false;
+	rate_window_start_ = std::chrono::steady_clock::now();
+	Tick();
+	timer_->start(std::clamp((int)std::lround(1000.0 / refresh_rate), 4, 50));
+}
+
+void JoypadInputMonitorWidget::hideEvent(QHideEvent *event)
+{
+	timer_->stop();
+	QWidget::hideEvent(event);
+}
+
+void JoypadInputMonitorWidget::RefreshDeviceNames()
+{
+	for (auto &name : names_) {
+		name.clear();
+	}
+	for (auto &rate : rates_) {
+		rate = SlotRate();
+	}
+	for (const auto &device : input_->GetDevices()) {
+		if (device.monitor_slot >= 0 && device.monitor_slot < kJoypadMonitorSlots) {
+			names_[device.monitor_slot] = QString::fromStdString(device.name);
+		}
+	}
+}
+
+void JoypadInputMonitorWidget::Tick()
+{
+	if (!input_) {
+		return;
+	}
+
+	bool changed = false;
+	const uint64_t version = input_->GetDevicesVersion();
+	if (!names_known_ || version != devices_version_) {
+		names_known_ = true;
+		devices_version_ = version;
+		RefreshDeviceNames();
+		changed = true;
+	}
+
+	input_->ReadMonitorSamples(next_samples_);
+	const bool rows_changed = next_samples_.size() != samples_.size();
+	if (!rows_changed) {
+		for (size_t i = 0; i < samples_.size() && !changed; ++i) {
+			changed = !same_sample(samples_[i], next_samples_[i]);
+		}
+	}
+	samples_.swap(next_samples_);
+
+	const auto now = std::chrono::steady_clock::now();
+	if (now - rate_window_start_ >= kRateWindow) {
+		UpdateRates(now);
+		changed = true;
+	}
+
+	if (rows_changed) {
+		setMinimumHeight(std::max<int>(1, (int)samples_.size()) * RowHeight());
+		updateGeometry();
+	}
+	if (changed || rows_changed) {
+		update();
+	}
+}
+
+void JoypadInputMonitorWidget::UpdateRates(std::chrono::steady_clock::time_point now)
+{
+	const double seconds = std::chrono::duration<double>(now - rate_window_start_).count();
+	rate_window_start_ = now;
+	bool seen[kJoypadMonitorSlots] = {false};
+	for (const auto &sample : samples_) {
+		seen[sample.slot] = true;
+		SlotRate &rate = rates_[sample.slot];
+		if (!rate.known || sample.event_count < rate.base_count || seconds <= 0.0) {
+			rate.known = true;
+			rate.events_per_second = 0.0;
+		} else {
+			rate.events_per_second = (double)(sample.event_count - rate.base_count) / seconds;
+		}
+		rate.base_count = sample.event_count;
+	}
+	for (int i = 0; i < kJoypadMonitorSlots; ++i) {
+		if (!seen[i]) {
+			rates_[i] = SlotRate();
+		}
+	}
+}
+
+void JoypadInputMonitorWidget::paintEvent(QPaintEvent *event)
+{
+	(void)event;
+	QPainter painter(this);
+	const QPalette &pal = palette();
+	painter.fillRect(rect(), pal.color(QPalette::Base));
+
+	if (samples_.empty()) {
+		painter.setPen(pal.color(QPalette::PlaceholderText));
+		painter.drawText(rect(), Qt::AlignCenter, L("JoypadToOBS.Monitor.NoDevices"));
+		return;
+	}
+
+	const QFontMetrics metrics = fontMetrics();
+	const int row_height = RowHeight();
+	const int content_width = std::max(1, width() - 2 * kRowPadding);
+	const int axis_width = std::max(1, (content_width - (kJoypadMonitorAxes - 1) * kRowGap) / kJoypadMonitorAxes);
+	const QColor active = pal.color(QPalette::Highlight);
+	const QColor idle = pal.color(QPalette::Button);
+	const QColor center = pal.color(QPalette::Mid);
+
+	int row_top = 0;
+	for (const auto &sample : samples_) {
+		int top = row_top + kRowPadding;
+		const QColor text = sample.connected ? pal.color(QPalette::Text)
+						     : pal.color(QPalette::PlaceholderText);
+
+		QString title = names_[sample.slot].isEmpty() ? L("JoypadToOBS.Common.Controller")
+							     : names_[sample.slot];
+		if (!sample.connected) {
+			title = L("JoypadToOBS.Monitor.Disconnected").arg(title);
+		}
+		const QString rate = L("JoypadToOBS.Monitor.EventRate")
+					     .arg(QString::number(rates_[sample.slot].events_per_second, 'f', 0));
+		const QRect title_rect(kRowPadding, top, content_width, metrics.height());
+		const int title_width = std::max(0, content_width - metrics.horizontalAdvance(rate) - kRowPadding);
+		painter.setPen(text);
+		painter.drawText(title_rect, Qt::AlignLeft | Qt::AlignVCenter,
+				 metrics.elidedText(title, Qt::ElideRight, title_width));
+		painter.drawText(title_rect, Qt::AlignRight | Qt::AlignVCenter, rate);
+		top += metrics.height() + kRowGap;
+
+		for (int axis = 0; axis < kJoypadMonitorAxes; ++axis) {
+			const QRect bar(kRowPadding + axis * (axis_width + kRowGap), top, axis_width, kAxisBarHeight);
+			painter.fillRect(bar, idle);
+			const double value = std::clamp((double)sample.axes[axis], -1.0, 1.0);
+			const int middle = bar.left() + bar.width() / 2;
+			const int extent = (int)std::lround(value * (bar.width() / 2));
+			if (extent > 0) {
+				painter.fillRect(QRect(middle, bar.top(), extent, bar.height()), active);
+			} else if (extent < 0) {
+				painter.fillRect(QRect(middle + extent, bar.top(), -extent, bar.height()), active);
+			}
+			painter.fillRect(QRect(middle, bar.top(), 1, bar.height()), center);
+		}
+		top += kAxisBarHeight + kRowGap;
+
+		for (int button = 0; button < kButtonCount; ++button) {
+			const int left = kRowPadding + button * (kButtonCellSize + kButtonCellGap);
+			const QRect cell(left, top, kButtonCellSize, kButtonCellSize);
+			const bool pressed = (sample.buttons & (1u << (uint32_t)button)) != 0;
+			painter.fillRect(cell, pressed ? active : idle);
+		}
+
+		row_top += row_height;
+		painter.fillRect(QRect(0, row_top - 1, width(), 1), center);
+	}
+}
@@ -0,0 +1,64 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include "joypad-input.h"
+
+#include <QWidget>
+#include <chrono>
+#include <vector>
+
+class QTimer;
+
+// Axes, buttons and event rate of every tracked device. A display-rate timer copies the
+// input manager's lock-free snapshot while the widget is visible and repaints only when
+// something moved, so leaving it open costs nothing per input event.
+class JoypadInputMonitorWidget : public QWidget {
+public:
+	JoypadInputMonitorWidget(QWidget *parent, JoypadInputManager *input);
+
+	QSize sizeHint() const override;
+
+protected:
+	void paintEvent(QPaintEvent *event) override;
+	void showEvent(QShowEvent *event) override;
+	void hideEvent(QHideEvent *event) override;
+
+private:
+	struct SlotRate {
+		bool known = false;
+		uint64_t base_count = 0;
+		double events_per_second = 0.0;
+	};
+
+	void Tick();
+	void RefreshDeviceNames();
+	void UpdateRates(std::chrono::steady_clock::time_point now);
+	int RowHeight() const;
+
+	JoypadInputManager *input_ = nullptr;
+	QTimer *timer_ = nullptr;
+	bool names_known_ = false;
+	uint64_t devices_version_ = 0;
+	QString names_[kJoypadMonitorSlots];
+	std::vector<JoypadMonitorSample> samples_;
+	std::vector<JoypadMonitorSample> next_samples_;
+	SlotRate rates_[kJoypadMonitorSlots];
+	std::chrono::steady_clock::time_point rate_window_start_;
+};
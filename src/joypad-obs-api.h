@@ -0,0 +1,125 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+// Everything JoypadActionEngine asks of OBS. JoypadLibObsApi() (joypad-obs-libobs.h) forwards
+// to libobs and the frontend API; JoypadFakeObsApi (joypad-obs-fake.h) keeps scenes, sources
+// and filters in memory so actions can be measured and checked without OBS.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Opaque references. Every non-null result of a Get* call must go back to Release().
+struct JoypadObsSource;
+struct JoypadObsItem;
+
+struct JoypadObsVec2 {
+	float x = 0.0f;
+	float y = 0.0f;
+};
+
+// obs_combo_format and obs_bounds_type values, checked against libobs in joypad-obs-libobs.cpp.
+constexpr int kJoypadComboFormatInt = 1;
+constexpr int kJoypadComboFormatFloat = 2;
+constexpr int kJoypadComboFormatString = 3;
+constexpr int kJoypadBoundsStretch = 1;
+constexpr int kJoypadBoundsScaleInner = 2;
+
+struct JoypadObsProperty {
+	// kJoypadProperty* type; list_format is a kJoypadComboFormat* for list properties.
+	int type = 0;
+	int list_format = 0;
+	// Limits of int and float properties.
+	double min = 0.0;
+	double max = 0.0;
+};
+
+enum class JoypadObsOutput : uint8_t {
+	Streaming = 0,
+	Recording = 1,
+	VirtualCam = 2,
+	ReplayBuffer = 3,
+};
+
+class JoypadObsApi {
+public:
+	virtual ~JoypadObsApi() = default;
+
+	// Sources and filters, by name.
+	virtual JoypadObsSource *GetSource(const char *name) = 0;
+	virtual JoypadObsSource *GetFilter(JoypadObsSource *source, const char *name) = 0;
+	virtual void Release(JoypadObsSource *source) = 0;
+	// Volume as a multiplier, 1.0 being 0 dB.
+	virtual float Volume(JoypadObsSource *source) = 0;
+	virtual void SetVolume(JoypadObsSource *source, float volume) = 0;
+	virtual bool Muted(JoypadObsSource *source) = 0;
+	virtual void SetMuted(JoypadObsSource *source, bool muted) = 0;
+	virtual bool Enabled(JoypadObsSource *source) = 0;
+	virtual void SetEnabled(JoypadObsSource *source, bool enabled) = 0;
+	virtual bool MediaPlaying(JoypadObsSource *source) = 0;
+	virtual void MediaPlayPause(JoypadObsSource *source, bool pause) = 0;
+	virtual void MediaRestart(JoypadObsSource *source) = 0;
+	virtual void MediaStop(JoypadObsSource *source) = 0;
+
+	// Properties and settings. Every Set*Setting call applies the change to the source.
+	virtual bool GetProperty(JoypadObsSource *source, const char *name, JoypadObsProperty &out) = 0;
+	virtual long long IntSetting(JoypadObsSource *source, const char *name) = 0;
+	virtual double DoubleSetting(JoypadObsSource *source, const char *name) = 0;
+	virtual void SetBoolSetting(JoypadObsSource *source, const char *name, bool value) = 0;
+	virtual void SetIntSetting(JoypadObsSource *source, const char *name, long long value) = 0;
+	virtual void SetDoubleSetting(JoypadObsSource *source, const char *name, double value) = 0;
+	virtual void SetStringSetting(JoypadObsSource *source, const char *name, const char *value) = 0;
+
+	// Scene items. A null scene means the current program scene.
+	virtual JoypadObsItem *GetSceneItem(const char *scene, const char *source) = 0;
+	virtual void Release(JoypadObsItem *item) = 0;
+	virtual bool ItemVisible(JoypadObsItem *item) = 0;
+	virtual void SetItemVisible(JoypadObsItem *item, bool visible) = 0;
+	virtual JoypadObsVec2 ItemPosition(JoypadObsItem *item) = 0;
+	virtual void SetItemPosition(JoypadObsItem *item, JoypadObsVec2 position) = 0;
+	virtual JoypadObsVec2 ItemScale(JoypadObsItem *item) = 0;
+	virtual void SetItemScale(JoypadObsItem *item, JoypadObsVec2 scale) = 0;
+	virtual float ItemRotation(JoypadObsItem *item) = 0;
+	virtual void SetItemRotation(JoypadObsItem *item, float degrees) = 0;
+	// Size of the item's box on the canvas, negative when flipped.
+	virtual JoypadObsVec2 ItemBoxSize(JoypadObsItem *item) = 0;
+	virtual void SetItemAlignment(JoypadObsItem *item, uint32_t alignment) = 0;
+	virtual void SetItemBounds(JoypadObsItem *item, int bounds_type, uint32_t alignment, JoypadObsVec2 size) = 0;
+	// Base canvas size; false while video isn't set up.
+	virtual bool CanvasSize(uint32_t &width, uint32_t &height) = 0;
+
+	// Scenes in frontend order, and the program and (studio mode) preview scenes by name.
+	virtual void GetSceneNames(std::vector<std::string> &names) = 0;
+	virtual std::string ProgramScene() = 0;
+	virtual std::string PreviewScene() = 0;
+	// False when no scene has that name.
+	virtual bool SetProgramScene(const char *name) = 0;
+	virtual bool SetPreviewScene(const char *name) = 0;
+
+	virtual bool OutputActive(JoypadObsOutput output) = 0;
+	virtual void SetOutputActive(JoypadObsOutput output, bool active) = 0;
+	virtual void SaveReplayBuffer() = 0;
+	virtual bool StudioModeActive() = 0;
+	// Both run later on the UI thread in OBS.
+	virtual void ToggleStudioMode() = 0;
+	virtual void TransitionToProgram() = 0;
+	// Screenshot of source, or of the program output when source is null.
+	virtual void TakeScreenshot(JoypadObsSource *source) = 0;
+};
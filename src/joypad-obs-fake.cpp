@@ -0,0 +1,433 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "joypad-obs-fake.h"
+
+namespace {
+using Source = JoypadFakeObsApi::Source;
+using Item = JoypadFakeObsApi::Item;
+
+Source *to_fake(JoypadObsSource *source)
+{
+	return reinterpret_cast<Source *>(source);
+}
+
+Item *to_fake(JoypadObsItem *item)
+{
+	return reinterpret_cast<Item *>(item);
+}
+} // namespace
+
+JoypadFakeObsApi::Scene &JoypadFakeObsApi::AddScene(const std::string &name)
+{
+	if (Scene *scene = FindScene(name)) {
+		return *scene;
+	}
+	AddSource(name);
+	scenes_.push_back(std::make_unique<Scene>());
+	scenes_.back()->name = name;
+	if (state.program_scene.empty()) {
+		state.program_scene = name;
+	}
+	return *scenes_.back();
+}
+
+JoypadFakeObsApi::Source &JoypadFakeObsApi::AddSource(const std::string &name)
+{
+	auto &source = sources_[name];
+	if (!source) {
+		source = std::make_unique<Source>();
+		source->name = name;
+	}
+	return *source;
+}
+
+JoypadFakeObsApi::Source &JoypadFakeObsApi::AddFilter(const std::string &source, const std::string &filter)
+{
+	auto &entry = AddSource(source).filters[filter];
+	if (!entry) {
+		entry = std::make_unique<Source>();
+		entry->name = filter;
+	}
+	return *entry;
+}
+
+JoypadFakeObsApi::Item &JoypadFakeObsApi::AddItem(const std::string &scene, const std::string &source)
+{
+	AddSource(source);
+	Scene &target = AddScene(scene);
+	target.items.emplace_back();
+	target.items.back().source = source;
+	return target.items.back();
+}
+
+JoypadFakeObsApi::Source *JoypadFakeObsApi::FindSource(const std::string &name)
+{
+	auto it = sources_.find(name);
+	return it != sources_.end() ? it->second.get() : nullptr;
+}
+
+JoypadFakeObsApi::Scene *JoypadFakeObsApi::FindScene(const std::string &name)
+{
+	for (auto &scene : scenes_) {
+		if (scene->name == name) {
+			return scene.get();
+		}
+	}
+	return nullptr;
+}
+
+JoypadObsSource *JoypadFakeObsApi::GetSource(const char *name)
+{
+	++calls_;
+	Source *source = FindSource(name);
+	if (source) {
+		++open_references_;
+	}
+	return reinterpret_cast<JoypadObsSource *>(source);
+}
+
+JoypadObsSource *JoypadFakeObsApi::GetFilter(JoypadObsSource *source, const char *name)
+{
+	++calls_;
+	auto &filters = to_fake(source)->filters;
+	auto it = filters.find(name);
+	if (it == filters.end()) {
+		return nullptr;
+	}
+	++open_references_;
+	return reinterpret_cast<JoypadObsSource *>(it->second.get());
+}
+
+void JoypadFakeObsApi::Release(JoypadObsSource *source)
+{
+	++calls_;
+	if (source) {
+		--open_references_;
+	}
+}
+
+float JoypadFakeObsApi::Volume(JoypadObsSource *source)
+{
+	++calls_;
+	return to_fake(source)->volume;
+}
+
+void JoypadFakeObsApi::SetVolume(JoypadObsSource *source, float volume)
+{
+	++calls_;
+	to_fake(source)->volume = volume;
+}
+
+bool JoypadFakeObsApi::Muted(JoypadObsSource *source)
+{
+	++calls_;
+	return to_fake(source)->muted;
+}
+
+void JoypadFakeObsApi::SetMuted(JoypadObsSource *source, bool muted)
+{
+	++calls_;
+	to_fake(source)->muted = muted;
+}
+
+bool JoypadFakeObsApi::Enabled(JoypadObsSource *source)
+{
+	++calls_;
+	return to_fake(source)->enabled;
+}
+
+void JoypadFakeObsApi::SetEnabled(JoypadObsSource *source, bool enabled)
+{
+	++calls_;
+	to_fake(source)->enabled = enabled;
+}
+
+bool JoypadFakeObsApi::MediaPlaying(JoypadObsSource *source)
+{
+	++calls_;
+	return to_fake(source)->media_playing;
+}
+
+void JoypadFakeObsApi::MediaPlayPause(JoypadObsSource *source, bool pause)
+{
+	++calls_;
+	to_fake(source)->media_playing = !pause;
+}
+
+void JoypadFakeObsApi::MediaRestart(JoypadObsSource *source)
+{
+	++calls_;
+	to_fake(source)->media_playing = true;
+	++to_fake(source)->media_restarts;
+}
+
+void JoypadFakeObsApi::MediaStop(JoypadObsSource *source)
+{
+	++calls_;
+	to_fake(source)->media_playing = false;
+	++to_fake(source)->media_stops;
+}
+
+bool JoypadFakeObsApi::GetProperty(JoypadObsSource *source, const char *name, JoypadObsProperty &out)
+{
+	++calls_;
+	const auto &properties = to_fake(source)->properties;
+	auto it = properties.find(name);
+	if (it == properties.end()) {
+		return false;
+	}
+	out = it->second;
+	return true;
+}
+
+long long JoypadFakeObsApi::IntSetting(JoypadObsSource *source, const char *name)
+{
+	++calls_;
+	return to_fake(source)->settings[name].int_value;
+}
+
+double JoypadFakeObsApi::DoubleSetting(JoypadObsSource *source, const char *name)
+{
+	++calls_;
+	return to_fake(source)->settings[name].double_value;
+}
+
+void JoypadFakeObsApi::SetBoolSetting(JoypadObsSource *source, const char *name, bool value)
+{
+	++calls_;
+	to_fake(source)->settings[name].bool_value = value;
+	++to_fake(source)->updates;
+}
+
+void JoypadFakeObsApi::SetIntSetting(JoypadObsSource *source, const char *name, long long value)
+{
+	++calls_;
+	to_fake(source)->settings[name].int_value = value;
+	++to_fake(source)->updates;
+}
+
+void JoypadFakeObsApi::SetDoubleSetting(JoypadObsSource *source, const char *name, double value)
+{
+	++calls_;
+	to_fake(source)->settings[name].double_value = value;
+	++to_fake(source)->updates;
+}
+
+void JoypadFakeObsApi::SetStringSetting(JoypadObsSource *source, const char *name, const char *value)
+{
+	++calls_;
+	to_fake(source)->settings[name].string_value = value ? value : "";
+	++to_fake(source)->updates;
+}
+
+JoypadObsItem *JoypadFakeObsApi::GetSceneItem(const char *scene, const char *source)
+{
+	++calls_;
+	Scene *target = FindScene(scene ? scene : state.program_scene);
+	if (!target) {
+		return nullptr;
+	}
+	for (auto &item : target->items) {
+		if (item.source == source) {
+			++open_references_;
+			return reinterpret_cast<JoypadObsItem *>(&item);
+		}
+	}
+	return nullptr;
+}
+
+void JoypadFakeObsApi::Release(JoypadObsItem *item)
+{
+	++calls_;
+	if (item) {
+		--open_references_;
+	}
+}
+
+bool JoypadFakeObsApi::ItemVisible(JoypadObsItem *item)
+{
+	++calls_;
+	return to_fake(item)->visible;
+}
+
+void JoypadFakeObsApi::SetItemVisible(JoypadObsItem *item, bool visible)
+{
+	++calls_;
+	to_fake(item)->visible = visible;
+}
+
+JoypadObsVec2 JoypadFakeObsApi::ItemPosition(JoypadObsItem *item)
+{
+	++calls_;
+	return to_fake(item)->position;
+}
+
+void JoypadFakeObsApi::SetItemPosition(JoypadObsItem *item, JoypadObsVec2 position)
+{
+	++calls_;
+	to_fake(item)->position = position;
+}
+
+JoypadObsVec2 JoypadFakeObsApi::ItemScale(JoypadObsItem *item)
+{
+	++calls_;
+	return to_fake(item)->scale;
+}
+
+void JoypadFakeObsApi::SetItemScale(JoypadObsItem *item, JoypadObsVec2 scale)
+{
+	++calls_;
+	to_fake(item)->scale = scale;
+}
+
+float JoypadFakeObsApi::ItemRotation(JoypadObsItem *item)
+{
+	++calls_;
+	return to_fake(item)->rotation;
+}
+
+void JoypadFakeObsApi::SetItemRotation(JoypadObsItem *item, float degrees)
+{
+	++calls_;
+	to_fake(item)->rotation = degrees;
+}
+
+JoypadObsVec2 JoypadFakeObsApi::ItemBoxSize(JoypadObsItem *item)
+{
+	++calls_;
+	const Item &fake = *to_fake(item);
+	return {fake.size.x * fake.scale.x, fake.size.y * fake.scale.y};
+}
+
+void JoypadFakeObsApi::SetItemAlignment(JoypadObsItem *item, uint32_t alignment)
+{
+	++calls_;
+	to_fake(item)->alignment = alignment;
+}
+
+void JoypadFakeObsApi::SetItemBounds(JoypadObsItem *item, int bounds_type, uint32_t alignment, JoypadObsVec2 size)
+{
+	++calls_;
+	Item &fake = *to_fake(item);
+	fake.bounds_type = bounds_type;
+	fake.bounds_alignment = alignment;
+	fake.bounds = size;
+}
+
+bool JoypadFakeObsApi::CanvasSize(uint32_t &width, uint32_t &height)
+{
+	++calls_;
+	width = state.canvas_width;
+	height = state.canvas_height;
+	return true;
+}
+
+void JoypadFakeObsApi::GetSceneNames(std::vector<std::string> &names)
+{
+	++calls_;
+	names.clear();
+	for (const auto &scene : scenes_) {
+		names.push_back(scene->name);
+	}
+}
+
+std::string JoypadFakeObsApi::ProgramScene()
+{
+	++calls_;
+	return state.program_scene;
+}
+
+std::string JoypadFakeObsApi::PreviewScene()
+{
+	++calls_;
+	return state.studio_mode ? state.preview_scene : std::string();
+}
+
+bool JoypadFakeObsApi::SetProgramScene(const char *name)
+{
+	++calls_;
+	if (!FindScene(name)) {
+		return false;
+	}
+	state.program_scene = name;
+	return true;
+}
+
+bool JoypadFakeObsApi::SetPreviewScene(const char *name)
+{
+	++calls_;
+	if (!FindScene(name)) {
+		return false;
+	}
+	if (state.studio_mode) {
+		state.preview_scene = name;
+	}
+	return true;
+}
+
+bool JoypadFakeObsApi::OutputActive(JoypadObsOutput output)
+{
+	++calls_;
+	return state.outputs[(size_t)output];
+}
+
+void JoypadFakeObsApi::SetOutputActive(JoypadObsOutput output, bool active)
+{
+	++calls_;
+	state.outputs[(size_t)output] = active;
+}
+
+void JoypadFakeObsApi::SaveReplayBuffer()
+{
+	++calls_;
+	++state.replay_saves;
+}
+
+bool JoypadFakeObsApi::StudioModeActive()
+{
+	++calls_;
+	return state.studio_mode;
+}
+
+void JoypadFakeObsApi::ToggleStudioMode()
+{
+	++calls_;
+	state.studio_mode = !state.studio_mode;
+	// Entering studio mode previews the program scene, as OBS does.
+	state.preview_scene = state.studio_mode ? state.program_scene : std::string();
+}
+
+void JoypadFakeObsApi::TransitionToProgram()
+{
+	++calls_;
+	if (state.studio_mode) {
+		state.program_scene = state.preview_scene;
+		++state.transitions;
+	}
+}
+
+void JoypadFakeObsApi::TakeScreenshot(JoypadObsSource *source)
+{
+	++calls_;
+	if (source) {
+		++to_fake(source)->screenshots;
+	} else {
+		++state.program_screenshots;
+	}
+}
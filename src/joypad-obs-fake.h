@@ -0,0 +1,158 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include "joypad-obs-api.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// OBS kept in memory for tools and benchmarks: scenes, sources, filters, volumes and
+// properties, all by name. Build the model with the Add* calls before running actions, then
+// inspect it through the returned references and state. Not thread-safe.
+class JoypadFakeObsApi final : public JoypadObsApi {
+public:
+	struct Setting {
+		bool bool_value = false;
+		long long int_value = 0;
+		double double_value = 0.0;
+		std::string string_value;
+	};
+	// A source or, inside Source::filters, a filter.
+	struct Source {
+		std::string name;
+		float volume = 1.0f;
+		bool muted = false;
+		bool enabled = true;
+		bool media_playing = false;
+		int media_restarts = 0;
+		int media_stops = 0;
+		int screenshots = 0;
+		// obs_source_update calls.
+		int updates = 0;
+		std::unordered_map<std::string, JoypadObsProperty> properties;
+		std::unordered_map<std::string, Setting> settings;
+		std::map<std::string, std::unique_ptr<Source>> filters;
+	};
+	struct Item {
+		std::string source;
+		bool visible = true;
+		JoypadObsVec2 position;
+		JoypadObsVec2 scale = {1.0f, 1.0f};
+		float rotation = 0.0f;
+		// Unscaled source size; ItemBoxSize() is this times scale.
+		JoypadObsVec2 size = {640.0f, 360.0f};
+		// OBS_ALIGN_TOP | OBS_ALIGN_LEFT, the libobs default.
+		uint32_t alignment = 5;
+		int bounds_type = 0;
+		uint32_t bounds_alignment = 0;
+		JoypadObsVec2 bounds;
+	};
+	struct Scene {
+		std::string name;
+		std::vector<Item> items;
+	};
+	struct State {
+		std::string program_scene;
+		std::string preview_scene;
+		bool studio_mode = false;
+		bool outputs[4] = {};
+		int replay_saves = 0;
+		int program_screenshots = 0;
+		int transitions = 0;
+		uint32_t canvas_width = 1920;
+		uint32_t canvas_height = 1080;
+	};
+
+	// The first scene added becomes the program scene. Scenes are sources too, as in OBS.
+	Scene &AddScene(const std::string &name);
+	Source &AddSource(const std::string &name);
+	Source &AddFilter(const std::string &source, const std::string &filter);
+	// Adds source to scene, creating the source if needed.
+	Item &AddItem(const std::string &scene, const std::string &source);
+	Source *FindSource(const std::string &name);
+	Scene *FindScene(const std::string &name);
+
+	State state;
+	// Facade calls made so far, to compare how many OBS calls actions cost.
+	uint64_t Calls() const { return calls_; }
+	// References handed out and not yet released; non-zero after an action is a leak.
+	int OpenReferences() const { return open_references_; }
+
+	JoypadObsSource *GetSource(const char *name) override;
+	JoypadObsSource *GetFilter(JoypadObsSource *source, const char *name) override;
+	void Release(JoypadObsSource *source) override;
+	float Volume(JoypadObsSource *source) override;
+	void SetVolume(JoypadObsSource *source, float volume) override;
+	bool Muted(JoypadObsSource *source) override;
+	void SetMuted(JoypadObsSource *source, bool muted) override;
+	bool Enabled(JoypadObsSource *source) override;
+	void SetEnabled(JoypadObsSource *source, bool enabled) override;
+	bool MediaPlaying(JoypadObsSource *source) override;
+	void MediaPlayPause(JoypadObsSource *source, bool pause) override;
+	void MediaRestart(JoypadObsSource *source) override;
+	void MediaStop(JoypadObsSource *source) override;
+
+	bool GetProperty(JoypadObsSource *source, const char *name, JoypadObsProperty &out) override;
+	long long IntSetting(JoypadObsSource *source, const char *name) override;
+	double DoubleSetting(JoypadObsSource *source, const char *name) override;
+	void SetBoolSetting(JoypadObsSource *source, const char *name, bool value) override;
+	void SetIntSetting(JoypadObsSource *source, const char *name, long long value) override;
+	void SetDoubleSetting(JoypadObsSource *source, const char *name, double value) override;
+	void SetStringSetting(JoypadObsSource *source, const char *name, const char *value) override;
+
+	JoypadObsItem *GetSceneItem(const char *scene, const char *source) override;
+	void Release(JoypadObsItem *item) override;
+	bool ItemVisible(JoypadObsItem *item) override;
+	void SetItemVisible(JoypadObsItem *item, bool visible) override;
+	JoypadObsVec2 ItemPosition(JoypadObsItem *item) override;
+	void SetItemPosition(JoypadObsItem *item, JoypadObsVec2 position) override;
+	JoypadObsVec2 ItemScale(JoypadObsItem *item) override;
+	void SetItemScale(JoypadObsItem *item, JoypadObsVec2 scale) override;
+	float ItemRotation(JoypadObsItem *item) override;
+	void SetItemRotation(JoypadObsItem *item, float degrees) override;
+	JoypadObsVec2 ItemBoxSize(JoypadObsItem *item) override;
+	void SetItemAlignment(JoypadObsItem *item, uint32_t alignment) override;
+	void SetItemBounds(JoypadObsItem *item, int bounds_type, uint32_t alignment, JoypadObsVec2 size) override;
+	bool CanvasSize(uint32_t &width, uint32_t &height) override;
+
+	void GetSceneNames(std::vector<std::string> &names) override;
+	std::string ProgramScene() override;
+	std::string PreviewScene() override;
+	bool SetProgramScene(const char *name) override;
+	bool SetPreviewScene(const char *name) override;
+
+	bool OutputActive(JoypadObsOutput output) override;
+	void SetOutputActive(JoypadObsOutput output, bool active) override;
+	void SaveReplayBuffer() override;
+	bool StudioModeActive() override;
+	void ToggleStudioMode() override;
+	void TransitionToProgram() override;
+	void TakeScreenshot(JoypadObsSource *source) override;
+
+private:
+	std::unordered_map<std::string, std::unique_ptr<Source>> sources_;
+	// Frontend order.
+	std::vector<std::unique_ptr<Scene>> scenes_;
+	uint64_t calls_ = 0;
+	int open_references_ = 0;
+};
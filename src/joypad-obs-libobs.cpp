@@ -0,0 +1,363 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "joypad-obs-libobs.h"
+#include "joypad-core.h"
+
+#include <obs-frontend-api.h>
+#include <obs-module.h>
+#include <obs-properties.h>
+#include <util/bmem.h>
+#include <QCoreApplication>
+#include <QMetaObject>
+
+namespace {
+static_assert(kJoypadPropertyBool == OBS_PROPERTY_BOOL && kJoypadPropertyInt == OBS_PROPERTY_INT &&
+		      kJoypadPropertyFloat == OBS_PROPERTY_FLOAT && kJoypadPropertyList == OBS_PROPERTY_LIST,
+	      "joypad-core property types must match libobs");
+static_assert(kJoypadComboFormatInt == OBS_COMBO_FORMAT_INT && kJoypadComboFormatFloat == OBS_COMBO_FORMAT_FLOAT &&
+		      kJoypadComboFormatString == OBS_COMBO_FORMAT_STRING,
+	      "combo formats must match libobs");
+static_assert(kJoypadBoundsStretch == OBS_BOUNDS_STRETCH && kJoypadBoundsScaleInner == OBS_BOUNDS_SCALE_INNER,
+	      "bounds types must match libobs");
+
+// Facade handles are the libobs objects themselves: a referenced obs_source_t, or an
+// obs_sceneitem_t holding its own reference.
+obs_source_t *to_obs(JoypadObsSource *source)
+{
+	return reinterpret_cast<obs_source_t *>(source);
+}
+
+JoypadObsSource *from_obs(obs_source_t *source)
+{
+	return reinterpret_cast<JoypadObsSource *>(source);
+}
+
+obs_sceneitem_t *to_obs(JoypadObsItem *item)
+{
+	return reinterpret_cast<obs_sceneitem_t *>(item);
+}
+
+std::string scene_name(obs_source_t *scene)
+{
+	std::string name;
+	if (scene) {
+		const char *scene_name = obs_source_get_name(scene);
+		name = scene_name ? scene_name : "";
+		obs_source_release(scene);
+	}
+	return name;
+}
+
+// Applies one settings change to source and pushes it with obs_source_update.
+template<typename Setter> void update_setting(obs_source_t *source, Setter &&set)
+{
+	obs_data_t *settings = obs_source_get_settings(source);
+	if (!settings) {
+		return;
+	}
+	set(settings);
+	obs_source_update(source, settings);
+	obs_data_release(settings);
+}
+
+class LibObsApi final : public JoypadObsApi {
+public:
+	JoypadObsSource *GetSource(const char *name) override { return from_obs(obs_get_source_by_name(name)); }
+	JoypadObsSource *GetFilter(JoypadObsSource *source, const char *name) override
+	{
+		return from_obs(obs_source_get_filter_by_name(to_obs(source), name));
+	}
+	void Release(JoypadObsSource *source) override { obs_source_release(to_obs(source)); }
+	float Volume(JoypadObsSource *source) override { return obs_source_get_volume(to_obs(source)); }
+	void SetVolume(JoypadObsSource *source, float volume) override
+	{
+		obs_source_set_volume(to_obs(source), volume);
+	}
+	bool Muted(JoypadObsSource *source) override { return obs_source_muted(to_obs(source)); }
+	void SetMuted(JoypadObsSource *source, bool muted) override { obs_source_set_muted(to_obs(source), muted); }
+	bool Enabled(JoypadObsSource *source) override { return obs_source_enabled(to_obs(source)); }
+	void SetEnabled(JoypadObsSource *source, bool enabled) override
+	{
+		obs_source_set_enabled(to_obs(source), enabled);
+	}
+	bool MediaPlaying(JoypadObsSource *source) override
+	{
+		return obs_source_media_get_state(to_obs(source)) == OBS_MEDIA_STATE_PLAYING;
+	}
+	void MediaPlayPause(JoypadObsSource *source, bool pause) override
+	{
+		obs_source_media_play_pause(to_obs(source), pause);
+	}
+	void MediaRestart(JoypadObsSource *source) override { obs_source_media_restart(to_obs(source)); }
+	void MediaStop(JoypadObsSource *source) override { obs_source_media_stop(to_obs(source)); }
+
+	bool GetProperty(JoypadObsSource *source, const char *name, JoypadObsProperty &out) override
+	{
+		obs_properties_t *props = obs_source_properties(to_obs(source));
+		if (!props) {
+			return false;
+		}
+		obs_property_t *prop = obs_properties_get(props, name);
+		if (prop) {
+			out = {};
+			out.type = (int)obs_property_get_type(prop);
+			if (out.type == OBS_PROPERTY_INT) {
+				out.min = obs_property_int_min(prop);
+				out.max = obs_property_int_max(prop);
+			} else if (out.type == OBS_PROPERTY_FLOAT) {
+				out.min = obs_property_float_min(prop);
+				out.max = obs_property_float_max(prop);
+			} else if (out.type == OBS_PROPERTY_LIST) {
+				out.list_format = (int)obs_property_list_format(prop);
+			}
+		}
+		obs_properties_destroy(props);
+		return prop != nullptr;
+	}
+	long long IntSetting(JoypadObsSource *source, const char *name) override
+	{
+		obs_data_t *settings = obs_source_get_settings(to_obs(source));
+		const long long value = settings ? obs_data_get_int(settings, name) : 0;
+		obs_data_release(settings);
+		return value;
+	}
+	double DoubleSetting(JoypadObsSource *source, const char *name) override
+	{
+		obs_data_t *settings = obs_source_get_settings(to_obs(source));
+		const double value = settings ? obs_data_get_double(settings, name) : 0.0;
+		obs_data_release(settings);
+		return value;
+	}
+	void SetBoolSetting(JoypadObsSource *source, const char *name, bool value) override
+	{
+		update_setting(to_obs(source), [&](obs_data_t *settings) { obs_data_set_bool(settings, name, value); });
+	}
+	void SetIntSetting(JoypadObsSource *source, const char *name, long long value) override
+	{
+		update_setting(to_obs(source), [&](obs_data_t *settings) { obs_data_set_int(settings, name, value); });
+	}
+	void SetDoubleSetting(JoypadObsSource *source, const char *name, double value) override
+	{
+		update_setting(to_obs(source),
+			       [&](obs_data_t *settings) { obs_data_set_double(settings, name, value); });
+	}
+	void SetStringSetting(JoypadObsSource *source, const char *name, const char *value) override
+	{
+		update_setting(to_obs(source),
+			       [&](obs_data_t *settings) { obs_data_set_string(settings, name, value); });
+	}
+
+	JoypadObsItem *GetSceneItem(const char *scene, const char *source) override
+	{
+		obs_source_t *scene_source = scene ? obs_get_source_by_name(scene) : obs_frontend_get_current_scene();
+		if (!scene_source) {
+			return nullptr;
+		}
+		obs_sceneitem_t *item = nullptr;
+		if (obs_scene_t *obs_scene = obs_scene_from_source(scene_source)) {
+			item = obs_scene_find_source(obs_scene, source);
+			if (item) {
+				obs_sceneitem_addref(item);
+			}
+		}
+		obs_source_release(scene_source);
+		return reinterpret_cast<JoypadObsItem *>(item);
+	}
+	void Release(JoypadObsItem *item) override { obs_sceneitem_release(to_obs(item)); }
+	bool ItemVisible(JoypadObsItem *item) override { return obs_sceneitem_visible(to_obs(item)); }
+	void SetItemVisible(JoypadObsItem *item, bool visible) override
+	{
+		obs_sceneitem_set_visible(to_obs(item), visible);
+	}
+	JoypadObsVec2 ItemPosition(JoypadObsItem *item) override
+	{
+		struct vec2 pos = {};
+		obs_sceneitem_get_pos(to_obs(item), &pos);
+		return {pos.x, pos.y};
+	}
+	void SetItemPosition(JoypadObsItem *item, JoypadObsVec2 position) override
+	{
+		struct vec2 pos = {};
+		pos.x = position.x;
+		pos.y = position.y;
+		obs_sceneitem_set_pos(to_obs(item), &pos);
+	}
+	JoypadObsVec2 ItemScale(JoypadObsItem *item) override
+	{
+		struct vec2 scale = {};
+		obs_sceneitem_get_scale(to_obs(item), &scale);
+		return {scale.x, scale.y};
+	}
+	void SetItemScale(JoypadObsItem *item, JoypadObsVec2 scale) override
+	{
+		struct vec2 value = {};
+		value.x = scale.x;
+		value.y = scale.y;
+		obs_sceneitem_set_scale(to_obs(item), &value);
+	}
+	float ItemRotation(JoypadObsItem *item) override { return obs_sceneitem_get_rot(to_obs(item)); }
+	void SetItemRotation(JoypadObsItem *item, float degrees) override
+	{
+		obs_sceneitem_set_rot(to_obs(item), degrees);
+	}
+	JoypadObsVec2 ItemBoxSize(JoypadObsItem *item) override
+	{
+		struct vec2 box = {};
+		obs_sceneitem_get_box_scale(to_obs(item), &box);
+		return {box.x, box.y};
+	}
+	void SetItemAlignment(JoypadObsItem *item, uint32_t alignment) override
+	{
+		obs_sceneitem_set_alignment(to_obs(item), alignment);
+	}
+	void SetItemBounds(JoypadObsItem *item, int bounds_type, uint32_t alignment, JoypadObsVec2 size) override
+	{
+		struct vec2 bounds = {};
+		bounds.x = size.x;
+		bounds.y = size.y;
+		obs_sceneitem_set_bounds_type(to_obs(item), (enum obs_bounds_type)bounds_type);
+		obs_sceneitem_set_bounds_alignment(to_obs(item), alignment);
+		obs_sceneitem_set_bounds(to_obs(item), &bounds);
+	}
+	bool CanvasSize(uint32_t &width, uint32_t &height) override
+	{
+		obs_video_info ovi = {};
+		if (!obs_get_video_info(&ovi)) {
+			return false;
+		}
+		width = ovi.base_width;
+		height = ovi.base_height;
+		return true;
+	}
+
+	void GetSceneNames(std::vector<std::string> &names) override
+	{
+		names.clear();
+		char **scene_names = obs_frontend_get_scene_names();
+		for (char **name = scene_names; name && *name; ++name) {
+			names.emplace_back(*name);
+		}
+		bfree(scene_names);
+	}
+	std::string ProgramScene() override { return scene_name(obs_frontend_get_current_scene()); }
+	std::string PreviewScene() override { return scene_name(obs_frontend_get_current_preview_scene()); }
+	bool SetProgramScene(const char *name) override
+	{
+		obs_source_t *scene = obs_get_source_by_name(name);
+		if (!scene) {
+			return false;
+		}
+		obs_frontend_set_current_scene(scene);
+		obs_source_release(scene);
+		return true;
+	}
+	bool SetPreviewScene(const char *name) override
+	{
+		obs_source_t *scene = obs_get_source_by_name(name);
+		if (!scene) {
+			return false;
+		}
+		obs_frontend_set_current_preview_scene(scene);
+		obs_source_release(scene);
+		return true;
+	}
+
+	bool OutputActive(JoypadObsOutput output) override
+	{
+		switch (output) {
+		case JoypadObsOutput::Streaming:
+			return obs_frontend_streaming_active();
+		case JoypadObsOutput::Recording:
+			return obs_frontend_recording_active();
+		case JoypadObsOutput::VirtualCam:
+			return obs_frontend_virtualcam_active();
+		case JoypadObsOutput::ReplayBuffer:
+			return obs_frontend_replay_buffer_active();
+		}
+		return false;
+	}
+	void SetOutputActive(JoypadObsOutput output, bool active) override
+	{
+		switch (output) {
+		case JoypadObsOutput::Streaming:
+			if (active) {
+				obs_frontend_streaming_start();
+			} else {
+				obs_frontend_streaming_stop();
+			}
+			break;
+		case JoypadObsOutput::Recording:
+			if (active) {
+				obs_frontend_recording_start();
+			} else {
+				obs_frontend_recording_stop();
+			}
+			break;
+		case JoypadObsOutput::VirtualCam:
+			if (active) {
+				obs_frontend_start_virtualcam();
+			} else {
+				obs_frontend_stop_virtualcam();
+			}
+			break;
+		case JoypadObsOutput::ReplayBuffer:
+			if (active) {
+				obs_frontend_replay_buffer_start();
+			} else {
+				obs_frontend_replay_buffer_stop();
+			}
+			break;
+		}
+	}
+	void SaveReplayBuffer() override { obs_frontend_replay_buffer_save(); }
+	bool StudioModeActive() override { return obs_frontend_preview_program_mode_active(); }
+	void ToggleStudioMode() override
+	{
+		if (QCoreApplication *app = QCoreApplication::instance()) {
+			QMetaObject::invokeMethod(app, []() {
+				obs_frontend_set_preview_program_mode(!obs_frontend_preview_program_mode_active());
+			});
+		}
+	}
+	void TransitionToProgram() override
+	{
+		if (QCoreApplication *app = QCoreApplication::instance()) {
+			QMetaObject::invokeMethod(app, []() {
+				if (obs_frontend_preview_program_mode_active()) {
+					obs_frontend_preview_program_trigger_transition();
+				}
+			});
+		}
+	}
+	void TakeScreenshot(JoypadObsSource *source) override
+	{
+		if (source) {
+			obs_frontend_take_source_screenshot(to_obs(source));
+		} else {
+			obs_frontend_take_screenshot();
+		}
+	}
+};
+} // namespace
+
+JoypadObsApi &JoypadLibObsApi()
+{
+	static LibObsApi api;
+	return api;
+}
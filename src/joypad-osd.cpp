@@ -0,0 +1,186 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "joypad-osd.h"
+
+#include <QColor>
+#include <QEasingCurve>
+#include <QPropertyAnimation>
+#include <QTimer>
+
+namespace {
+constexpr int kOsdMargin = 40;
+constexpr int kOsdFadeInMs = 180;
+constexpr int kOsdHoldMs = 1700;
+constexpr int kOsdFadeOutMs = 600;
+
+QString BuildOsdStyle(const QString &text_color, const QString &background_color, int font_size)
+{
+	return QString("QLabel { background-color: %1; color: %2; border-radius: 0px; padding: 8px; "
+		       "font-size: %3px; font-weight: bold; border: 2px solid %2; }")
+		.arg(background_color)
+		.arg(text_color)
+		.arg(font_size);
+}
+
+QString ToCssColor(const QString &input, const QString &fallback)
+{
+	QColor parsed(input);
+	if (!parsed.isValid()) {
+		parsed = QColor(fallback);
+	}
+	if (!parsed.isValid()) {
+		parsed = QColor("#000000");
+	}
+	return QString("rgba(%1, %2, %3, %4)")
+		.arg(parsed.red())
+		.arg(parsed.green())
+		.arg(parsed.blue())
+		.arg(parsed.alpha());
+}
+} // namespace
+
+JoypadOsdWidget::JoypadOsdWidget(QWidget *main_window, JoypadConfigStore *config)
+	: QLabel(main_window),
+	  main_window_(main_window),
+	  config_(config)
+{
+	setWindowFlags(Qt::ToolTip | Qt::FramelessWindowHint);
+	setAttribute(Qt::WA_ShowWithoutActivating);
+	setAttribute(Qt::WA_StyledBackground, true);
+	setAutoFillBackground(true);
+
+	hold_timer_ = new QTimer(this);
+	hold_timer_->setSingleShot(true);
+	connect(hold_timer_, &QTimer::timeout, this, [this]() { FadeTo(0.0, kOsdFadeOutMs, true); });
+
+	fade_ = new QPropertyAnimation(this, "windowOpacity", this);
+	connect(fade_, &QPropertyAnimation::finished, this, [this]() {
+		if (fading_out_) {
+			hide();
+		}
+	});
+}
+
+void JoypadOsdWidget::InvalidateSettings()
+{
+	settings_valid_ = false;
+}
+
+void JoypadOsdWidget::ApplySettings()
+{
+	settings_ = config_ ? config_->GetOsdSettings() : JoypadOsdSettings();
+	settings_valid_ = true;
+	const QString color = ToCssColor(QString::fromStdString(settings_.color), "#ffffff");
+	const QString background_color =
+		ToCssColor(QString::fromStdString(settings_.background_color), "rgba(0, 0, 0, 230)");
+	const QString style = BuildOsdStyle(color, background_color, settings_.font_size);
+	if (style != style_) {
+		style_ = style;
+		setStyleSheet(style_);
+	}
+}
+
+void JoypadOsdWidget::ShowMessage(const QString &text)
+{
+	if (!settings_valid_) {
+		ApplySettings();
+	}
+	if (!settings_.enabled) {
+		hold_timer_->stop();
+		fade_->stop();
+		hide();
+		return;
+	}
+
+	setText(text);
+	adjustSize();
+	Reposition();
+	if (!isVisible()) {
+		setWindowOpacity(0.0);
+		show();
+	}
+	if (fading_out_ || windowOpacity() < 1.0) {
+		FadeTo(1.0, kOsdFadeInMs, false);
+	}
+	hold_timer_->start(kOsdFadeInMs + kOsdHoldMs);
+}
+
+void JoypadOsdWidget::FadeTo(double opacity, int duration_ms, bool fading_out)
+{
+	fade_->stop();
+	fading_out_ = fading_out;
+	fade_->setDuration(duration_ms);
+	fade_->setStartValue(windowOpacity());
+	fade_->setEndValue(opacity);
+	fade_->setEasingCurve(fading_out ? QEasingCurve::OutCubic : QEasingCurve::InOutQuad);
+	fade_->start();
+}
+
+void JoypadOsdWidget::Reposition()
+{
+	if (!main_window_) {
+		return;
+	}
+	const QRect r = main_window_->geometry();
+	const int m = kOsdMargin;
+	const int w = width();
+	const int h = height();
+	int x = 0;
+	int y = 0;
+
+	switch (settings_.position) {
+	case JoypadOsdPosition::TopLeft:
+		x = r.x() + m;
+		y = r.y() + m;
+		break;
+	case JoypadOsdPosition::TopCenter:
+		x = r.x() + (r.width() - w) / 2;
+		y = r.y() + m;
+		break;
+	case JoypadOsdPosition::TopRight:
+		x = r.x() + r.width() - w - m;
+		y = r.y() + m;
+		break;
+	case JoypadOsdPosition::CenterLeft:
+		x = r.x() + m;
+		y = r.y() + (r.height() - h) / 2;
+		break;
+	case JoypadOsdPosition::Center:
+		x = r.x() + (r.width() - w) / 2;
+		y = r.y() + (r.height() - h) / 2;
+		break;
+	case JoypadOsdPosition::CenterRight:
+		x = r.x() + r.width() - w - m;
+		y = r.y() + (r.height() - h) / 2;
+		break;
+	case JoypadOsdPosition::BottomLeft:
+		x = r.x() + m;
+		y = r.y() + r.height() - h - m;
+		break;
+	case JoypadOsdPosition::BottomCenter:
+		x = r.x() + (r.width() - w) / 2;
+		y = r.y() + r.height() - h - m;
+		break;
+	case JoypadOsdPosition::BottomRight:
+		x = r.x() + r.width() - w - m;
+		y = r.y() + r.height() - h - m;
+		break;
+	}
+	move(x, y);
+}
@@ -0,0 +1,52 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include "joypad-config.h"
+
+#include <QLabel>
+
+class QPropertyAnimation;
+class QTimer;
+
+// On-screen notification drawn over the OBS main window. A single instance serves every
+// message: a new message replaces the one on screen and re-arms the hold timer, and the
+// stylesheet is only rebuilt after the OSD settings change.
+class JoypadOsdWidget : public QLabel {
+public:
+	JoypadOsdWidget(QWidget *main_window, JoypadConfigStore *config);
+
+	void ShowMessage(const QString &text);
+	// Called on the UI thread when kJoypadConfigOsdChanged arrives.
+	void InvalidateSettings();
+
+private:
+	void ApplySettings();
+	void Reposition();
+	void FadeTo(double opacity, int duration_ms, bool fading_out);
+
+	QWidget *main_window_ = nullptr;
+	JoypadConfigStore *config_ = nullptr;
+	JoypadOsdSettings settings_;
+	bool settings_valid_ = false;
+	QString style_;
+	QTimer *hold_timer_ = nullptr;
+	QPropertyAnimation *fade_ = nullptr;
+	bool fading_out_ = false;
+};
@@ -19,8 +19,16 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 #include "joypad-actions.h"
 #include "joypad-config.h"
 #include "joypad-dock.h"
+#include "joypad-flight-recorder.h"
 #include "joypad-input.h"
+#include "joypad-matcher.h"
+#include "joypad-obs-libobs.h"
+#include "joypad-osd.h"
+#include "joypad-source-catalog.h"
+#include "joypad-stats.h"
+#include "joypad-trace.h"
 #include "joypad-ui.h"
+#include "joypad-watchdog.h"
 
 #include <obs-frontend-api.h>
 #include <obs-module.h>
@@ -28,11 +36,9 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 
 #include <QAction>
 #include <QCoreApplication>
-#include <QLabel>
-#include <QColor>
+#include <QDateTime>
 #include <QMetaObject>
-#include <QPropertyAnimation>
-#include <QSequentialAnimationGroup>
+#include <QPointer>
 #include <QWidget>
 #include <algorithm>
 #include <atomic>
@@ -47,10 +53,15 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 OBS_DECLARE_MODULE()
 OBS_MODULE_USE_DEFAULT_LOCALE(PLUGIN_NAME, "en-US")
 
+void JoypadPluginToggleTrace();
+
 namespace {
 JoypadConfigStore g_config;
 JoypadInputManager g_input;
-JoypadActionEngine g_actions;
+JoypadActionEngine g_actions(JoypadLibObsApi());
+JoypadSourceCatalog g_catalog;
+JoypadWatchdog g_watchdog;
+JoypadFrontendState g_frontend_state;
 std::atomic<bool> g_unloading{false};
 
 QAction *g_tools_action = nullptr;
@@ -58,12 +69,20 @@ JoypadToolsDialog *g_dialog = nullptr;
 QAction *g_dock_action = nullptr;
 JoypadControlDock *g_dock_widget = nullptr;
 obs_hotkey_id g_toggle_input_listening_hotkey_id = OBS_INVALID_HOTKEY_ID;
+obs_hotkey_id g_toggle_trace_hotkey_id = OBS_INVALID_HOTKEY_ID;
+obs_hotkey_id g_save_flight_hotkey_id = OBS_INVALID_HOTKEY_ID;
+int g_config_subscription = 0;
+std::atomic<uint32_t> g_pending_config_changes{0};
 
 constexpr const char *kToggleInputListeningHotkeySaveKey = "toggle_input_listening_hotkey";
+constexpr const char *kToggleTraceHotkeySaveKey = "toggle_trace_hotkey";
+constexpr const char *kSaveFlightHotkeySaveKey = "save_flight_recorder_hotkey";
 constexpr const char *kDockId = "joypad_to_obs_dock";
 
-QString BuildOsdStyle(const QString &text_color, const QString &background_color, int font_size);
-QString ToCssColor(const QString &input, const QString &fallback);
+std::mutex g_osd_mutex;
+QString g_pending_osd_text;
+bool g_osd_post_pending = false;
+QPointer<JoypadOsdWidget> g_osd;
 
 std::mutex g_absolute_axis_mutex;
 struct AbsoluteAxisDispatchState {
@@ -71,44 +90,38 @@ struct AbsoluteAxisDispatchState {
 	double normalized = 0.0;
 	std::chrono::steady_clock::time_point when = {};
 };
-std::unordered_map<std::string, AbsoluteAxisDispatchState> g_absolute_axis_last_state;
+std::unordered_map<int64_t, AbsoluteAxisDispatchState> g_absolute_axis_last_state;
 
 constexpr double kAbsoluteAxisRawEpsilon = 2.0;
 constexpr double kAbsoluteAxisNormalizedEpsilon = 0.01;
 constexpr auto kAbsoluteAxisMinDispatchInterval = std::chrono::milliseconds(35);
 
-std::string BuildAbsoluteAxisKey(const JoypadBinding &binding, const JoypadEvent &event)
-{
-	if (binding.uid > 0) {
-		return std::to_string((long long)binding.uid);
-	}
-	return event.device_id + ":" + std::to_string(event.axis_index) + ":" + binding.source_name;
-}
-
-bool ShouldDispatchAbsoluteAxisValue(const JoypadBinding &binding, const JoypadEvent &event)
+bool ShouldDispatchAbsoluteAxisValue(const JoypadCompiledBinding &binding, const JoypadEvent &event)
 {
 	if (binding.action != JoypadActionType::SetSourceVolumePercent || binding.input_type != JoypadInputType::Axis) {
 		return true;
 	}
-	const std::string key = BuildAbsoluteAxisKey(binding, event);
 	const double raw = event.axis_raw_value;
 	const double normalized = event.axis_value;
 	const auto now = std::chrono::steady_clock::now();
 	std::lock_guard<std::mutex> lock(g_absolute_axis_mutex);
-	auto it = g_absolute_axis_last_state.find(key);
+	auto it = g_absolute_axis_last_state.find(binding.uid);
 	if (it != g_absolute_axis_last_state.end()) {
 		const auto &previous = it->second;
 		const bool raw_unchanged = std::fabs(previous.raw - raw) <= kAbsoluteAxisRawEpsilon;
 		const bool normalized_unchanged = std::fabs(previous.normalized - normalized) <=
 						  kAbsoluteAxisNormalizedEpsilon;
 		if (raw_unchanged && normalized_unchanged) {
+			JoypadStatsRecordCache(JoypadStatsCache::AxisDispatch, true);
 			return false;
 		}
 		if ((now - previous.when) < kAbsoluteAxisMinDispatchInterval) {
+			JoypadStatsRecordCache(JoypadStatsCache::AxisDispatch, true);
 			return false;
 		}
 	}
-	g_absolute_axis_last_state[key] = {raw, normalized, now};
+	g_absolute_axis_last_state[binding.uid] = {raw, normalized, now};
+	JoypadStatsRecordCache(JoypadStatsCache::AxisDispatch, false);
 	return true;
 }
 
@@ -118,6 +131,39 @@ void ClearAbsoluteAxisDispatchCache()
 	g_absolute_axis_last_state.clear();
 }
 
+// Runs on any thread. Changes arriving before the UI caught up are merged into one refresh.
+void QueueConfigChanges(uint32_t changes)
+{
+	if (g_unloading.load(std::memory_order_acquire)) {
+		return;
+	}
+	QCoreApplication *app = QCoreApplication::instance();
+	if (!app || QCoreApplication::closingDown()) {
+		return;
+	}
+	if (g_pending_config_changes.fetch_or(changes, std::memory_order_acq_rel) != 0) {
+		return;
+	}
+	QMetaObject::invokeMethod(
+		app,
+		[]() {
+			const uint32_t pending = g_pending_config_changes.exchange(0, std::memory_order_acq_rel);
+			if (g_unloading.load(std::memory_order_acquire) || QCoreApplication::closingDown()) {
+				return;
+			}
+			if (g_dialog) {
+				g_dialog->OnConfigChanged(pending);
+			}
+			if (g_dock_widget) {
+				g_dock_widget->OnConfigChanged(pending);
+			}
+			if (g_osd && (pending & kJoypadConfigOsdChanged)) {
+				g_osd->InvalidateSettings();
+			}
+		},
+		Qt::QueuedConnection);
+}
+
 void *AddObsDockCompat(const char *dock_id, const char *title, void *dock_content_widget, void *legacy_qdock_widget)
 {
 #if defined(_WIN32)
@@ -160,110 +206,50 @@ void *AddObsDockCompat(const char *dock_id, const char *title, void *dock_conten
 #endif
 }
 
+// Runs on any thread. Only the latest text is kept while a post is in flight, so a burst of
+// profile switches shows the final one instead of stacking notifications.
 void ShowOsdNotification(const QString &text)
 {
 	if (g_unloading.load(std::memory_order_acquire)) {
 		return;
 	}
-	if (!g_config.GetOsdEnabled()) {
-		return;
-	}
 
 	QCoreApplication *app = QCoreApplication::instance();
 	if (!app || QCoreApplication::closingDown()) {
 		return;
 	}
 
-	QMetaObject::invokeMethod(app, [text]() {
-		if (g_unloading.load(std::memory_order_acquire) || QCoreApplication::closingDown()) {
-			return;
-		}
-		QWidget *main_window = (QWidget *)obs_frontend_get_main_window();
-		if (!main_window) {
+	{
+		std::lock_guard<std::mutex> lock(g_osd_mutex);
+		g_pending_osd_text = text;
+		if (g_osd_post_pending) {
 			return;
 		}
+		g_osd_post_pending = true;
+	}
 
-		QLabel *label = new QLabel(main_window);
-		label->setWindowFlags(Qt::ToolTip | Qt::FramelessWindowHint);
-		label->setAttribute(Qt::WA_ShowWithoutActivating);
-		label->setAttribute(Qt::WA_StyledBackground, true);
-		label->setAutoFillBackground(true);
-		QString color = ToCssColor(QString::fromStdString(g_config.GetOsdColor()), "#ffffff");
-		QString background_color =
-			ToCssColor(QString::fromStdString(g_config.GetOsdBackgroundColor()), "rgba(0, 0, 0, 230)");
-		int size = g_config.GetOsdFontSize();
-		label->setStyleSheet(BuildOsdStyle(color, background_color, size));
-		label->setText(text);
-		label->adjustSize();
-
-		QRect r = main_window->geometry();
-		int m = 40; // Margin
-		int x = 0;
-		int y = 0;
-		int w = label->width();
-		int h = label->height();
-
-		switch (g_config.GetOsdPosition()) {
-		case JoypadOsdPosition::TopLeft:
-			x = r.x() + m;
-			y = r.y() + m;
-			break;
-		case JoypadOsdPosition::TopCenter:
-			x = r.x() + (r.width() - w) / 2;
-			y = r.y() + m;
-			break;
-		case JoypadOsdPosition::TopRight:
-			x = r.x() + r.width() - w - m;
-			y = r.y() + m;
-			break;
-		case JoypadOsdPosition::CenterLeft:
-			x = r.x() + m;
-			y = r.y() + (r.height() - h) / 2;
-			break;
-		case JoypadOsdPosition::Center:
-			x = r.x() + (r.width() - w) / 2;
-			y = r.y() + (r.height() - h) / 2;
-			break;
-		case JoypadOsdPosition::CenterRight:
-			x = r.x() + r.width() - w - m;
-			y = r.y() + (r.height() - h) / 2;
-			break;
-		case JoypadOsdPosition::BottomLeft:
-			x = r.x() + m;
-			y = r.y() + r.height() - h - m;
-			break;
-		case JoypadOsdPosition::BottomCenter:
-			x = r.x() + (r.width() - w) / 2;
-			y = r.y() + r.height() - h - m;
-			break;
-		case JoypadOsdPosition::BottomRight:
-			x = r.x() + r.width() - w - m;
-			y = r.y() + r.height() - h - m;
-			break;
-		}
-		label->move(x, y);
-		label->setWindowOpacity(0.0);
-		label->show();
-
-		auto *fade_in = new QPropertyAnimation(label, "windowOpacity");
-		fade_in->setDuration(180);
-		fade_in->setStartValue(0.0);
-		fade_in->setEndValue(1.0);
-		fade_in->setEasingCurve(QEasingCurve::InOutQuad);
-
-		auto *fade_out = new QPropertyAnimation(label, "windowOpacity");
-		fade_out->setDuration(600);
-		fade_out->setStartValue(1.0);
-		fade_out->setEndValue(0.0);
-		fade_out->setEasingCurve(QEasingCurve::OutCubic);
-
-		auto *anim_group = new QSequentialAnimationGroup(label);
-		anim_group->addAnimation(fade_in);
-		anim_group->addPause(1700);
-		anim_group->addAnimation(fade_out);
-		QObject::connect(anim_group, &QSequentialAnimationGroup::finished, label, &QLabel::deleteLater);
-		anim_group->start(QAbstractAnimation::DeleteWhenStopped);
-	});
+	QMetaObject::invokeMethod(
+		app,
+		[]() {
+			QString pending_text;
+			{
+				std::lock_guard<std::mutex> lock(g_osd_mutex);
+				pending_text.swap(g_pending_osd_text);
+				g_osd_post_pending = false;
+			}
+			if (g_unloading.load(std::memory_order_acquire) || QCoreApplication::closingDown()) {
+				return;
+			}
+			if (!g_osd) {
+				QWidget *main_window = (QWidget *)obs_frontend_get_main_window();
+				if (!main_window) {
+					return;
+				}
+				g_osd = new JoypadOsdWidget(main_window, &g_config);
+			}
+			g_osd->ShowMessage(pending_text);
+		},
+		Qt::QueuedConnection);
 }
 
 void toggle_input_listening_hotkey_callback(void *data, obs_hotkey_id id, obs_hotkey_t *hotkey, bool pressed)
@@ -284,31 +270,112 @@ void toggle_input_listening_hotkey_callback(void *data, obs_hotkey_id id, obs_ho
 				       : QString::fromUtf8(obs_module_text("JoypadToOBS.Common.Off"));
 	const QString message = QString::fromUtf8(obs_module_text("JoypadToOBS.OSD.InputListeningStatus")).arg(status);
 	ShowOsdNotification(message);
+
+	QCoreApplication *app = QCoreApplication::instance();
+	if (app && !QCoreApplication::closingDown()) {
+		QMetaObject::invokeMethod(
+			app,
+			[]() {
+				if (!g_unloading.load(std::memory_order_acquire) && g_dock_widget) {
+					g_dock_widget->RefreshState();
+				}
+			},
+			Qt::QueuedConnection);
+	}
+}
+
+void toggle_trace_hotkey_callback(void *data, obs_hotkey_id id, obs_hotkey_t *hotkey, bool pressed)
+{
+	(void)data;
+	(void)id;
+	(void)hotkey;
+	if (!pressed || g_unloading.load(std::memory_order_acquire)) {
+		return;
+	}
+	JoypadPluginToggleTrace();
+}
+
+void save_flight_hotkey_callback(void *data, obs_hotkey_id id, obs_hotkey_t *hotkey, bool pressed)
+{
+	(void)data;
+	(void)id;
+	(void)hotkey;
+	if (!pressed || g_unloading.load(std::memory_order_acquire)) {
+		return;
+	}
+	const std::string path = JoypadFlightDump("manual");
+	if (path.empty()) {
+		ShowOsdNotification(QString::fromUtf8(obs_module_text("JoypadToOBS.OSD.FlightRecorderFailed")));
+		return;
+	}
+	ShowOsdNotification(QString::fromUtf8(obs_module_text("JoypadToOBS.OSD.FlightRecorderSaved"))
+				    .arg(QString::fromStdString(path)));
 }
 
-QString BuildOsdStyle(const QString &text_color, const QString &background_color, int font_size)
+static_assert(kJoypadLogError == LOG_ERROR && kJoypadLogWarning == LOG_WARNING && kJoypadLogInfo == LOG_INFO &&
+		      kJoypadLogDebug == LOG_DEBUG,
+	      "joypad-core log levels must match libobs");
+
+void forward_core_log(int level, const char *message)
 {
-	return QString("QLabel { background-color: %1; color: %2; border-radius: 0px; padding: 8px; "
-		       "font-size: %3px; font-weight: bold; border: 2px solid %2; }")
-		.arg(background_color)
-		.arg(text_color)
-		.arg(font_size);
+	obs_log(level, "%s", message);
 }
 
-QString ToCssColor(const QString &input, const QString &fallback)
+void sync_frontend_scene()
 {
-	QColor parsed(input);
-	if (!parsed.isValid()) {
-		parsed = QColor(fallback);
-	}
-	if (!parsed.isValid()) {
-		parsed = QColor("#000000");
-	}
-	return QString("rgba(%1, %2, %3, %4)")
-		.arg(parsed.red())
-		.arg(parsed.green())
-		.arg(parsed.blue())
-		.arg(parsed.alpha());
+	obs_source_t *scene = obs_frontend_get_current_scene();
+	g_frontend_state.SetScene(scene ? std::string(obs_source_get_name(scene)) : std::string());
+	obs_source_release(scene);
+}
+
+void sync_frontend_state()
+{
+	uint32_t flags = 0;
+	flags |= obs_frontend_streaming_active() ? kJoypadStateStreaming : 0;
+	flags |= obs_frontend_recording_active() ? kJoypadStateRecording : 0;
+	flags |= obs_frontend_preview_program_mode_active() ? kJoypadStateStudioMode : 0;
+	flags |= obs_frontend_replay_buffer_active() ? kJoypadStateReplayBuffer : 0;
+	flags |= obs_frontend_virtualcam_active() ? kJoypadStateVirtualCam : 0;
+	g_frontend_state.SetFlags(flags);
+	sync_frontend_scene();
+}
+
+// Keeps g_frontend_state current for conditional bindings; runs on the UI thread.
+void frontend_event(enum obs_frontend_event event, void *private_data)
+{
+	(void)private_data;
+
+	switch (event) {
+	case OBS_FRONTEND_EVENT_FINISHED_LOADING:
+		sync_frontend_state();
+		break;
+	case OBS_FRONTEND_EVENT_STREAMING_STARTED:
+	case OBS_FRONTEND_EVENT_STREAMING_STOPPED:
+		g_frontend_state.SetFlag(kJoypadStateStreaming, event == OBS_FRONTEND_EVENT_STREAMING_STARTED);
+		break;
+	case OBS_FRONTEND_EVENT_RECORDING_STARTED:
+	case OBS_FRONTEND_EVENT_RECORDING_STOPPED:
+		g_frontend_state.SetFlag(kJoypadStateRecording, event == OBS_FRONTEND_EVENT_RECORDING_STARTED);
+		break;
+	case OBS_FRONTEND_EVENT_STUDIO_MODE_ENABLED:
+	case OBS_FRONTEND_EVENT_STUDIO_MODE_DISABLED:
+		g_frontend_state.SetFlag(kJoypadStateStudioMode, event == OBS_FRONTEND_EVENT_STUDIO_MODE_ENABLED);
+		break;
+	case OBS_FRONTEND_EVENT_REPLAY_BUFFER_STARTED:
+	case OBS_FRONTEND_EVENT_REPLAY_BUFFER_STOPPED:
+		g_frontend_state.SetFlag(kJoypadStateReplayBuffer, event == OBS_FRONTEND_EVENT_REPLAY_BUFFER_STARTED);
+		break;
+	case OBS_FRONTEND_EVENT_VIRTUALCAM_STARTED:
+	case OBS_FRONTEND_EVENT_VIRTUALCAM_STOPPED:
+		g_frontend_state.SetFlag(kJoypadStateVirtualCam, event == OBS_FRONTEND_EVENT_VIRTUALCAM_STARTED);
+		break;
+	case OBS_FRONTEND_EVENT_SCENE_CHANGED:
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED:
+		sync_frontend_scene();
+		break;
+	default:
+		break;
+	}
 }
 
 static void save_hotkeys(obs_data_t *save_data, bool saving, void *private_data)
@@ -327,6 +394,20 @@ static void save_hotkeys(obs_data_t *save_data, bool saving, void *private_data)
 				obs_data_array_release(hotkey_data);
 			}
 		}
+		if (g_toggle_trace_hotkey_id != OBS_INVALID_HOTKEY_ID) {
+			obs_data_array_t *hotkey_data = obs_hotkey_save(g_toggle_trace_hotkey_id);
+			if (hotkey_data) {
+				obs_data_set_array(save_data, kToggleTraceHotkeySaveKey, hotkey_data);
+				obs_data_array_release(hotkey_data);
+			}
+		}
+		if (g_save_flight_hotkey_id != OBS_INVALID_HOTKEY_ID) {
+			obs_data_array_t *hotkey_data = obs_hotkey_save(g_save_flight_hotkey_id);
+			if (hotkey_data) {
+				obs_data_set_array(save_data, kSaveFlightHotkeySaveKey, hotkey_data);
+				obs_data_array_release(hotkey_data);
+			}
+		}
 
 		g_config.Save();
 		if (!g_unloading.load(std::memory_order_acquire) && g_dialog) {
@@ -357,9 +438,82 @@ static void save_hotkeys(obs_data_t *save_data, bool saving, void *private_data)
 		}
 		obs_data_array_release(hotkey_data);
 	}
+	hotkey_data = obs_data_get_array(save_data, kToggleTraceHotkeySaveKey);
+	if (hotkey_data) {
+		if (g_toggle_trace_hotkey_id != OBS_INVALID_HOTKEY_ID) {
+			obs_hotkey_load(g_toggle_trace_hotkey_id, hotkey_data);
+		}
+		obs_data_array_release(hotkey_data);
+	}
+	hotkey_data = obs_data_get_array(save_data, kSaveFlightHotkeySaveKey);
+	if (hotkey_data) {
+		if (g_save_flight_hotkey_id != OBS_INVALID_HOTKEY_ID) {
+			obs_hotkey_load(g_save_flight_hotkey_id, hotkey_data);
+		}
+		obs_data_array_release(hotkey_data);
+	}
+}
+
+void log_stall_summary()
+{
+	const JoypadWatchdogSummary stalls = g_watchdog.Summary();
+	if (!stalls.loop_stalls && stalls.actions.empty()) {
+		return;
+	}
+	obs_log(LOG_INFO, "joypad-to-obs input stalls: %llu in the poll loop (longest %.1f ms)",
+		(unsigned long long)stalls.loop_stalls, (double)stalls.loop_stall_max_ns / 1000000.0);
+	for (const auto &stall : stalls.actions) {
+		obs_log(LOG_INFO, "joypad-to-obs   %s on '%s' (binding %lld): %llu times, longest %.1f ms",
+			JoypadActionTypeName(stall.action), stall.target.c_str(), (long long)stall.binding_uid,
+			(unsigned long long)stall.count, (double)stall.max_ns / 1000000.0);
+	}
 }
 } // namespace
 
+// Starts tracing, or stops it and writes the spans next to the plugin config. Runs on the UI
+// thread (dock) or the hotkey thread.
+void JoypadPluginToggleTrace()
+{
+	if (g_unloading.load(std::memory_order_acquire)) {
+		return;
+	}
+	if (!JoypadTraceEnabled()) {
+		JoypadTraceClear();
+		JoypadTraceSetEnabled(true);
+		obs_log(LOG_INFO, "joypad-to-obs input trace started");
+		ShowOsdNotification(QString::fromUtf8(obs_module_text("JoypadToOBS.OSD.TraceStarted")));
+	} else {
+		JoypadTraceSetEnabled(false);
+		const QString stamp = QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss");
+		const std::string name = "joypad-trace-" + stamp.toStdString() + ".json";
+		char *trace_path = obs_module_config_path(name.c_str());
+		const std::string path = trace_path ? trace_path : name;
+		bfree(trace_path);
+		std::string error;
+		if (JoypadTraceWriteJson(path, &error)) {
+			obs_log(LOG_INFO, "joypad-to-obs input trace written to %s", path.c_str());
+			ShowOsdNotification(QString::fromUtf8(obs_module_text("JoypadToOBS.OSD.TraceSaved"))
+						    .arg(QString::fromStdString(path)));
+		} else {
+			obs_log(LOG_WARNING, "joypad-to-obs input trace not written: %s", error.c_str());
+			ShowOsdNotification(QString::fromUtf8(obs_module_text("JoypadToOBS.OSD.TraceFailed"))
+						    .arg(QString::fromStdString(error)));
+		}
+	}
+
+	QCoreApplication *app = QCoreApplication::instance();
+	if (app && !QCoreApplication::closingDown()) {
+		QMetaObject::invokeMethod(
+			app,
+			[]() {
+				if (!g_unloading.load(std::memory_order_acquire) && g_dock_widget) {
+					g_dock_widget->RefreshState();
+				}
+			},
+			Qt::QueuedConnection);
+	}
+}
+
 void JoypadPluginOpenToolsDialog()
 {
 	if (g_unloading.load(std::memory_order_acquire)) {
@@ -367,7 +521,7 @@ void JoypadPluginOpenToolsDialog()
 	}
 	if (!g_dialog) {
 		auto *parent = reinterpret_cast<QWidget *>(obs_frontend_get_main_window());
-		g_dialog = new JoypadToolsDialog(parent, &g_config, &g_input);
+		g_dialog = new JoypadToolsDialog(parent, &g_config, &g_input, &g_catalog);
 	}
 	g_dialog->show();
 	g_dialog->raise();
@@ -378,8 +532,16 @@ bool obs_module_load(void)
 {
 	obs_log(LOG_INFO, "joypad-to-obs loaded (version %s)", PLUGIN_VERSION);
 	g_unloading.store(false, std::memory_order_release);
+	JoypadSetLogHandler(forward_core_log);
 
 	g_config.Load();
+	char *config_dir = obs_module_config_path("");
+	if (config_dir) {
+		JoypadFlightSetDumpDirectory(config_dir);
+		bfree(config_dir);
+	}
+	g_catalog.Start();
+	g_config_subscription = g_config.Subscribe(QueueConfigChanges);
 
 	g_config.SetProfileSwitchCallback([](const std::string &name) {
 		if (g_unloading.load(std::memory_order_acquire)) {
@@ -392,39 +554,36 @@ bool obs_module_load(void)
 		if (g_unloading.load(std::memory_order_acquire)) {
 			return;
 		}
+		// Matched even when nothing may run, so held layer modifiers, combo masks and ordered
+		// combo progress follow the pad while the binding dialog is open or listening is off.
+		const auto matches = g_config.FindMatchingBindings(event, &g_input, &g_frontend_state);
 		if (JoypadUiEmulateBindingDialogAction(event, &g_actions)) {
 			return;
 		}
 		if (JoypadUiIsBindingDialogOpen() || !JoypadUiIsInputListeningEnabled()) {
 			return;
 		}
-		auto matches = g_config.FindMatchingBindings(event, &g_input);
-		for (const auto &binding : matches) {
-			g_actions.Execute(binding);
+		for (size_t i = 0; i < matches.size(); ++i) {
+			g_actions.Execute(matches.Params(i), matches.Binding(i).uid);
 		}
 	});
 	g_input.SetOnAxisChanged([](const JoypadEvent &event) {
-		if (g_unloading.load(std::memory_order_acquire)) {
+		if (g_unloading.load(std::memory_order_acquire) || !event.is_axis) {
 			return;
 		}
+		// Matched before the checks below for the same reason as buttons.
+		const auto matches = g_config.FindMatchingBindings(event, &g_input, &g_frontend_state);
 		if (JoypadUiEmulateBindingDialogAction(event, &g_actions)) {
 			return;
 		}
 		if (JoypadUiIsBindingDialogOpen() || !JoypadUiIsInputListeningEnabled()) {
 			return;
 		}
-		if (!event.is_axis) {
-			return;
-		}
-		auto matches = g_config.FindMatchingBindings(event, &g_input);
-		if (matches.empty()) {
-			return;
-		}
-		for (const auto &binding : matches) {
-			if (!ShouldDispatchAbsoluteAxisValue(binding, event)) {
+		for (size_t i = 0; i < matches.size(); ++i) {
+			if (!ShouldDispatchAbsoluteAxisValue(matches.Binding(i), event)) {
 				continue;
 			}
-			g_actions.Execute(binding);
+			g_actions.Execute(matches.Params(i), matches.Binding(i).uid);
 		}
 	});
 #if defined(_WIN32)
@@ -437,11 +596,20 @@ bool obs_module_load(void)
 	}
 #endif
 	g_input.Start();
+	g_actions.SetWatchdog(&g_watchdog);
+	g_watchdog.Start(&g_input);
 
 	g_toggle_input_listening_hotkey_id = obs_hotkey_register_frontend(
 		"joypad_to_obs.toggle_input_listening", obs_module_text("JoypadToOBS.Hotkey.ToggleInputListening"),
 		toggle_input_listening_hotkey_callback, nullptr);
+	g_toggle_trace_hotkey_id = obs_hotkey_register_frontend("joypad_to_obs.toggle_trace",
+								obs_module_text("JoypadToOBS.Hotkey.ToggleTrace"),
+								toggle_trace_hotkey_callback, nullptr);
+	g_save_flight_hotkey_id = obs_hotkey_register_frontend("joypad_to_obs.save_flight_recorder",
+							       obs_module_text("JoypadToOBS.Hotkey.SaveFlightRecorder"),
+							       save_flight_hotkey_callback, nullptr);
 	obs_frontend_add_save_callback(save_hotkeys, nullptr);
+	obs_frontend_add_event_callback(frontend_event, nullptr);
 
 	g_tools_action = reinterpret_cast<QAction *>(
 		obs_frontend_add_tools_menu_qaction(obs_module_text("JoypadToOBS.MenuTitle")));
@@ -449,7 +617,7 @@ bool obs_module_load(void)
 
 	auto *main_window = reinterpret_cast<QWidget *>(obs_frontend_get_main_window());
 	if (main_window) {
-		g_dock_widget = new JoypadControlDock(main_window, &g_config);
+		g_dock_widget = new JoypadControlDock(main_window, &g_config, &g_input, &g_watchdog);
 		g_dock_widget->setObjectName(QString::fromUtf8(kDockId));
 		QWidget *dock_content = g_dock_widget->widget();
 		if (!dock_content) {
@@ -466,23 +634,42 @@ void obs_module_unload(void)
 {
 	g_unloading.store(true, std::memory_order_release);
 	obs_frontend_remove_save_callback(save_hotkeys, nullptr);
+	obs_frontend_remove_event_callback(frontend_event, nullptr);
 	if (g_toggle_input_listening_hotkey_id != OBS_INVALID_HOTKEY_ID) {
 		obs_hotkey_unregister(g_toggle_input_listening_hotkey_id);
 		g_toggle_input_listening_hotkey_id = OBS_INVALID_HOTKEY_ID;
 	}
+	if (g_toggle_trace_hotkey_id != OBS_INVALID_HOTKEY_ID) {
+		obs_hotkey_unregister(g_toggle_trace_hotkey_id);
+		g_toggle_trace_hotkey_id = OBS_INVALID_HOTKEY_ID;
+	}
+	if (g_save_flight_hotkey_id != OBS_INVALID_HOTKEY_ID) {
+		obs_hotkey_unregister(g_save_flight_hotkey_id);
+		g_save_flight_hotkey_id = OBS_INVALID_HOTKEY_ID;
+	}
+	JoypadTraceSetEnabled(false);
 	g_config.SetProfileSwitchCallback({});
+	g_config.Unsubscribe(g_config_subscription);
+	g_config_subscription = 0;
 	ClearAbsoluteAxisDispatchCache();
 	g_input.SetOnButtonPressed({});
 	g_input.SetOnAxisChanged({});
 	g_input.CancelLearn();
 	g_input.Stop();
+	g_watchdog.Stop();
+	g_catalog.Stop();
+	log_stall_summary();
+	// Kept under one name so every session doesn't leave a file behind.
+	JoypadFlightDump("unload", true);
 
 	// Avoid touching Qt objects during teardown; OBS/Qt owns their destruction order.
 	g_dialog = nullptr;
 	g_tools_action = nullptr;
 	g_dock_action = nullptr;
 	g_dock_widget = nullptr;
+	g_osd = nullptr;
 
 	g_config.Unload();
+	JoypadSetLogHandler(nullptr);
 	obs_log(LOG_INFO, "joypad-to-obs unloaded");
 }
@@ -0,0 +1,284 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "joypad-recording.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+constexpr char kMagic[5] = {'J', 'P', 'R', 'E', 'C'};
+constexpr uint8_t kVersion = 1;
+// Written once this much is buffered, so a crash loses at most a few hundred events.
+constexpr size_t kFlushBytes = 4096;
+
+void put_varint(std::vector<uint8_t> &out, uint64_t value)
+{
+	while (value >= 0x80) {
+		out.push_back((uint8_t)(value | 0x80));
+		value >>= 7;
+	}
+	out.push_back((uint8_t)value);
+}
+
+void put_double(std::vector<uint8_t> &out, double value)
+{
+	uint64_t bits = 0;
+	memcpy(&bits, &value, sizeof(bits));
+	for (int i = 0; i < 8; ++i) {
+		out.push_back((uint8_t)(bits >> (8 * i)));
+	}
+}
+
+void put_string(std::vector<uint8_t> &out, const std::string &value)
+{
+	put_varint(out, value.size());
+	out.insert(out.end(), value.begin(), value.end());
+}
+
+bool same_device(const JoypadDeviceKey &a, const JoypadDeviceKey &b)
+{
+	return a.id == b.id && a.stable_id == b.stable_id && a.type_id == b.type_id;
+}
+
+struct Reader {
+	const std::vector<uint8_t> &data;
+	size_t pos = 0;
+
+	bool Byte(uint8_t &out)
+	{
+		if (pos >= data.size()) {
+			return false;
+		}
+		out = data[pos++];
+		return true;
+	}
+	bool Varint(uint64_t &out)
+	{
+		out = 0;
+		for (int shift = 0; shift < 64; shift += 7) {
+			uint8_t byte = 0;
+			if (!Byte(byte)) {
+				return false;
+			}
+			out |= (uint64_t)(byte & 0x7f) << shift;
+			if ((byte & 0x80) == 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+	bool Double(double &out)
+	{
+		if (data.size() - pos < 8) {
+			return false;
+		}
+		uint64_t bits = 0;
+		for (int i = 0; i < 8; ++i) {
+			bits |= (uint64_t)data[pos++] << (8 * i);
+		}
+		memcpy(&out, &bits, sizeof(out));
+		return true;
+	}
+	bool String(std::string &out)
+	{
+		uint64_t length = 0;
+		if (!Varint(length) || length > data.size() - pos) {
+			return false;
+		}
+		out.assign((const char *)data.data() + pos, (size_t)length);
+		pos += (size_t)length;
+		return true;
+	}
+};
+
+bool read_failure(std::string *error, const std::string &reason)
+{
+	if (error) {
+		*error = reason;
+	}
+	return false;
+}
+} // namespace
+
+JoypadInputRecorder::~JoypadInputRecorder()
+{
+	Close();
+}
+
+bool JoypadInputRecorder::Open(const std::string &path)
+{
+	Close();
+	file_ = fopen(path.c_str(), "wb");
+	if (!file_) {
+		JoypadLog(kJoypadLogWarning, "joypad-to-obs cannot record input to %s", path.c_str());
+		return false;
+	}
+	buffer_.assign(kMagic, kMagic + sizeof(kMagic));
+	buffer_.push_back(kVersion);
+	devices_.clear();
+	last_event_ = {};
+	event_count_ = 0;
+	return true;
+}
+
+void JoypadInputRecorder::Close()
+{
+	if (!file_) {
+		return;
+	}
+	Flush();
+	fclose(file_);
+	file_ = nullptr;
+}
+
+void JoypadInputRecorder::Flush()
+{
+	if (!buffer_.empty()) {
+		fwrite(buffer_.data(), 1, buffer_.size(), file_);
+		buffer_.clear();
+	}
+	fflush(file_);
+}
+
+uint64_t JoypadInputRecorder::DeviceIndex(const JoypadEvent &event)
+{
+	for (size_t i = 0; i < devices_.size(); ++i) {
+		if (same_device(devices_[i], event.device_key)) {
+			return i;
+		}
+	}
+	devices_.push_back(event.device_key);
+	buffer_.push_back((uint8_t)JoypadRecordTag::Device);
+	put_varint(buffer_, devices_.size() - 1);
+	put_string(buffer_, event.device_id);
+	put_string(buffer_, event.device_stable_id);
+	put_string(buffer_, event.device_type_id);
+	put_string(buffer_, event.device_name);
+	return devices_.size() - 1;
+}
+
+void JoypadInputRecorder::Write(JoypadRecordTag tag, const JoypadEvent &event)
+{
+	if (!file_) {
+		return;
+	}
+	const auto now = Clock::now();
+	const uint64_t delta_us =
+		event_count_ == 0
+			? 0
+			: (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(now - last_event_).count();
+	last_event_ = now;
+	++event_count_;
+
+	const uint64_t device = DeviceIndex(event);
+	buffer_.push_back((uint8_t)tag);
+	put_varint(buffer_, delta_us);
+	put_varint(buffer_, device);
+	if (tag == JoypadRecordTag::Button) {
+		put_varint(buffer_, (uint64_t)std::max(event.button, 0));
+		buffer_.push_back(event.released ? 1 : 0);
+		put_varint(buffer_, event.buttons);
+	} else {
+		put_varint(buffer_, (uint64_t)std::max(event.axis_index, 0));
+		put_double(buffer_, event.axis_value);
+		put_double(buffer_, event.axis_raw_value);
+	}
+	if (buffer_.size() >= kFlushBytes) {
+		Flush();
+	}
+}
+
+bool JoypadReadRecording(const std::string &path, std::vector<JoypadRecordedEvent> &events, std::string *error)
+{
+	events.clear();
+	FILE *file = fopen(path.c_str(), "rb");
+	if (!file) {
+		return read_failure(error, "cannot open " + path);
+	}
+	std::vector<uint8_t> data;
+	uint8_t chunk[8192];
+	size_t read = 0;
+	while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+		data.insert(data.end(), chunk, chunk + read);
+	}
+	fclose(file);
+
+	if (data.size() < sizeof(kMagic) + 1 || memcmp(data.data(), kMagic, sizeof(kMagic)) != 0) {
+		return read_failure(error, "not an input recording");
+	}
+	if (data[sizeof(kMagic)] != kVersion) {
+		return read_failure(error, "unsupported recording version");
+	}
+
+	Reader reader{data, sizeof(kMagic) + 1};
+	std::vector<JoypadEvent> devices;
+	uint64_t time_us = 0;
+	uint8_t tag = 0;
+	while (reader.Byte(tag)) {
+		if (tag == (uint8_t)JoypadRecordTag::Device) {
+			uint64_t index = 0;
+			JoypadEvent device;
+			if (!reader.Varint(index) || index != devices.size() || !reader.String(device.device_id) ||
+			    !reader.String(device.device_stable_id) || !reader.String(device.device_type_id) ||
+			    !reader.String(device.device_name)) {
+				return read_failure(error, "corrupt device record");
+			}
+			device.device_key = JoypadMakeDeviceKey(device.device_id, device.device_stable_id,
+								device.device_type_id);
+			device.device_xbox_like = JoypadIsXboxLikeDevice(device.device_type_id, device.device_name);
+			devices.push_back(std::move(device));
+			continue;
+		}
+		if (tag < (uint8_t)JoypadRecordTag::Button || tag > (uint8_t)JoypadRecordTag::AxisAbsolute) {
+			return read_failure(error, "unknown record");
+		}
+
+		uint64_t delta_us = 0;
+		uint64_t device = 0;
+		if (!reader.Varint(delta_us) || !reader.Varint(device) || device >= devices.size()) {
+			return read_failure(error, "corrupt event record");
+		}
+		JoypadRecordedEvent recorded;
+		time_us += delta_us;
+		recorded.time_us = time_us;
+		recorded.tag = (JoypadRecordTag)tag;
+		recorded.event = devices[(size_t)device];
+		JoypadEvent &event = recorded.event;
+		uint64_t index = 0;
+		if (recorded.tag == JoypadRecordTag::Button) {
+			uint8_t released = 0;
+			uint64_t buttons = 0;
+			if (!reader.Varint(index) || !reader.Byte(released) || !reader.Varint(buttons)) {
+				return read_failure(error, "corrupt button record");
+			}
+			event.button = (int)index;
+			event.released = released != 0;
+			event.buttons = (uint32_t)buttons;
+		} else {
+			if (!reader.Varint(index) || !reader.Double(event.axis_value) ||
+			    !reader.Double(event.axis_raw_value)) {
+				return read_failure(error, "corrupt axis record");
+			}
+			event.is_axis = true;
+			event.axis_index = (int)index;
+		}
+		events.push_back(std::move(recorded));
+	}
+	return true;
+}
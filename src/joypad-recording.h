@@ -0,0 +1,79 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include "joypad-core.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Input recordings (.jprec) hold every event the input manager dispatched, with its time,
+// so a burst seen on one machine can be replayed on another without the hardware.
+//
+// Layout: the 6 bytes "JPREC" + version, then records starting with a JoypadRecordTag.
+// Integers are LEB128 varints, doubles are 8 little-endian bytes, strings are a varint
+// length plus bytes. A device record (index, id, stable id, type id, name) precedes the
+// first event of that device; event records carry the microseconds since the previous
+// event and the device index, then button, released flag and pressed mask for buttons,
+// or axis index, value and raw value for axes.
+enum class JoypadRecordTag : uint8_t {
+	Device = 1,
+	Button = 2,
+	Axis = 3,
+	AxisAbsolute = 4,
+};
+
+struct JoypadRecordedEvent {
+	// Microseconds since the first event of the recording.
+	uint64_t time_us = 0;
+	// Button, Axis or AxisAbsolute: which dispatch path the event took.
+	JoypadRecordTag tag = JoypadRecordTag::Button;
+	JoypadEvent event;
+};
+
+// Appends dispatched events to a recording. Not thread safe; the input manager serializes
+// calls under its own lock.
+class JoypadInputRecorder {
+public:
+	~JoypadInputRecorder();
+
+	bool Open(const std::string &path);
+	void Close();
+	bool IsOpen() const { return file_ != nullptr; }
+	void Write(JoypadRecordTag tag, const JoypadEvent &event);
+	uint64_t EventCount() const { return event_count_; }
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	uint64_t DeviceIndex(const JoypadEvent &event);
+	void Flush();
+
+	FILE *file_ = nullptr;
+	std::vector<uint8_t> buffer_;
+	std::vector<JoypadDeviceKey> devices_;
+	Clock::time_point last_event_ = {};
+	uint64_t event_count_ = 0;
+};
+
+// Reads a whole recording; on failure returns false and describes why in error.
+bool JoypadReadRecording(const std::string &path, std::vector<JoypadRecordedEvent> &events, std::string *error);
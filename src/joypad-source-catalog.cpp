@@ -0,0 +1,533 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "joypad-source-catalog.h"
+#include "joypad-stats.h"
+
+#include <algorithm>
+
+namespace {
+constexpr const char *kFilterListSignals[] = {"filter_add", "filter_remove", "reorder_filters"};
+
+JoypadCatalogSource describe_source(obs_source_t *source)
+{
+	JoypadCatalogSource info;
+	const char *name = obs_source_get_name(source);
+	const char *type_id = obs_source_get_id(source);
+	info.name = name ? name : "";
+	info.type_id = type_id ? type_id : "";
+	const uint32_t output_flags = obs_source_get_output_flags(source);
+	info.has_audio = (output_flags & OBS_SOURCE_AUDIO) != 0;
+	info.has_video = (output_flags & OBS_SOURCE_VIDEO) != 0;
+	info.is_media = obs_source_media_get_state(source) != OBS_MEDIA_STATE_NONE;
+	return info;
+}
+
+std::string source_name(obs_source_t *source)
+{
+	const char *name = source ? obs_source_get_name(source) : nullptr;
+	return name ? name : "";
+}
+
+std::vector<std::string> read_filter_names(const std::string &source_name)
+{
+	std::vector<std::string> names;
+	obs_source_t *source = obs_get_source_by_name(source_name.c_str());
+	if (!source) {
+		return names;
+	}
+	obs_source_enum_filters(
+		source,
+		[](obs_source_t *parent, obs_source_t *filter, void *data) {
+			(void)parent;
+			if (!filter) {
+				return;
+			}
+			auto *list = static_cast<std::vector<std::string> *>(data);
+			const char *name = obs_source_get_name(filter);
+			if (name && *name) {
+				list->emplace_back(name);
+			}
+		},
+		&names);
+	obs_source_release(source);
+	return names;
+}
+
+std::vector<JoypadFilterPropertyInfo> read_filter_properties(obs_source_t *filter)
+{
+	std::vector<JoypadFilterPropertyInfo> infos;
+	obs_properties_t *props = obs_source_properties(filter);
+	if (!props) {
+		return infos;
+	}
+
+	for (obs_property_t *prop = obs_properties_first(props); prop; obs_property_next(&prop)) {
+		const obs_property_type type = obs_property_get_type(prop);
+		if (type != OBS_PROPERTY_BOOL && type != OBS_PROPERTY_INT && type != OBS_PROPERTY_FLOAT &&
+		    type != OBS_PROPERTY_LIST) {
+			continue;
+		}
+
+		JoypadFilterPropertyInfo info;
+		const char *name = obs_property_name(prop);
+		const char *desc = obs_property_description(prop);
+		if (!name || !*name) {
+			continue;
+		}
+		info.name = name;
+		info.description = (desc && *desc) ? desc : name;
+		info.type = type;
+
+		if (type == OBS_PROPERTY_INT) {
+			info.min_value = (double)obs_property_int_min(prop);
+			info.max_value = (double)obs_property_int_max(prop);
+		} else if (type == OBS_PROPERTY_FLOAT) {
+			info.min_value = obs_property_float_min(prop);
+			info.max_value = obs_property_float_max(prop);
+		} else if (type == OBS_PROPERTY_LIST) {
+			info.list_format = obs_property_list_format(prop);
+			const size_t count = obs_property_list_item_count(prop);
+			for (size_t i = 0; i < count; ++i) {
+				JoypadFilterPropertyListItem item;
+				const char *item_name = obs_property_list_item_name(prop, i);
+				item.name = (item_name && *item_name) ? item_name : "";
+				if (info.list_format == OBS_COMBO_FORMAT_INT) {
+					item.int_value = obs_property_list_item_int(prop, i);
+				} else if (info.list_format == OBS_COMBO_FORMAT_FLOAT) {
+					item.float_value = obs_property_list_item_float(prop, i);
+				} else {
+					const char *item_value = obs_property_list_item_string(prop, i);
+					item.string_value = (item_value && *item_value) ? item_value : "";
+				}
+				info.list_items.push_back(item);
+			}
+		}
+
+		infos.push_back(std::move(info));
+	}
+
+	obs_properties_destroy(props);
+	return infos;
+}
+} // namespace
+
+JoypadSourceCatalog::~JoypadSourceCatalog()
+{
+	Stop();
+}
+
+void JoypadSourceCatalog::Start()
+{
+	if (running_.exchange(true)) {
+		return;
+	}
+	signal_handler_t *signals = obs_get_signal_handler();
+	signal_handler_connect(signals, "source_create", OnSourceCreate, this);
+	signal_handler_connect(signals, "source_remove", OnSourceRemove, this);
+	signal_handler_connect(signals, "source_destroy", OnSourceRemove, this);
+	signal_handler_connect(signals, "source_rename", OnSourceRename, this);
+	populate_thread_ = std::thread([this]() { Populate(); });
+}
+
+void JoypadSourceCatalog::Stop()
+{
+	if (!running_.exchange(false)) {
+		return;
+	}
+	// Signal callbacks take mutex_, so nothing below may hold it while disconnecting.
+	signal_handler_t *signals = obs_get_signal_handler();
+	signal_handler_disconnect(signals, "source_create", OnSourceCreate, this);
+	signal_handler_disconnect(signals, "source_remove", OnSourceRemove, this);
+	signal_handler_disconnect(signals, "source_destroy", OnSourceRemove, this);
+	signal_handler_disconnect(signals, "source_rename", OnSourceRename, this);
+	if (populate_thread_.joinable()) {
+		populate_thread_.join();
+	}
+
+	std::vector<obs_weak_source_t *> released;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (auto &item : sources_) {
+			released.push_back(item.second.weak);
+		}
+		for (auto &item : properties_) {
+			released.push_back(item.second.weak_filter);
+		}
+		sources_.clear();
+		properties_.clear();
+	}
+	Release(released);
+	ready_ = false;
+}
+
+bool JoypadSourceCatalog::IsReady() const
+{
+	return ready_;
+}
+
+uint64_t JoypadSourceCatalog::GetVersion() const
+{
+	return version_.load(std::memory_order_acquire);
+}
+
+std::vector<JoypadCatalogSource> JoypadSourceCatalog::GetSources() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	std::vector<JoypadCatalogSource> sources;
+	sources.reserve(sources_.size());
+	for (const auto &item : sources_) {
+		sources.push_back(item.second.info);
+	}
+	return sources;
+}
+
+std::vector<std::string> JoypadSourceCatalog::GetFilterNames(const std::string &source_name)
+{
+	if (source_name.empty()) {
+		return {};
+	}
+	uint64_t generation = 0;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = sources_.find(source_name);
+		if (it != sources_.end()) {
+			if (it->second.filters_known) {
+				return it->second.filters;
+			}
+			generation = it->second.filters_generation;
+		}
+	}
+
+	std::vector<std::string> names = read_filter_names(source_name);
+	std::lock_guard<std::mutex> lock(mutex_);
+	auto it = sources_.find(source_name);
+	if (it != sources_.end() && it->second.filters_generation == generation) {
+		it->second.filters = names;
+		it->second.filters_known = true;
+	}
+	return names;
+}
+
+std::vector<JoypadFilterPropertyInfo> JoypadSourceCatalog::GetFilterProperties(const std::string &source_name,
+									       const std::string &filter_name)
+{
+	if (source_name.empty() || filter_name.empty()) {
+		return {};
+	}
+	const PropertyKey key(source_name, filter_name);
+	uint64_t generation = 0;
+	bool cacheable = false;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto cached = properties_.find(key);
+		if (cached != properties_.end()) {
+			JoypadStatsRecordCache(JoypadStatsCache::FilterProperties, true);
+			return cached->second.properties;
+		}
+		JoypadStatsRecordCache(JoypadStatsCache::FilterProperties, false);
+		auto it = sources_.find(source_name);
+		if (it != sources_.end()) {
+			generation = it->second.filters_generation;
+			cacheable = true;
+		}
+	}
+
+	obs_source_t *source = obs_get_source_by_name(source_name.c_str());
+	if (!source) {
+		return {};
+	}
+	obs_source_t *filter = obs_source_get_filter_by_name(source, filter_name.c_str());
+	obs_source_release(source);
+	if (!filter) {
+		return {};
+	}
+	std::vector<JoypadFilterPropertyInfo> properties = read_filter_properties(filter);
+	if (!cacheable) {
+		obs_source_release(filter);
+		return properties;
+	}
+
+	// Some filters build their lists from current settings; any update drops the cached layout.
+	obs_weak_source_t *weak_filter = obs_source_get_weak_source(filter);
+	signal_handler_connect(obs_source_get_signal_handler(filter), "update", OnFilterUpdate, this);
+	obs_source_release(filter);
+
+	bool stored = false;
+	bool duplicate = false;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = sources_.find(source_name);
+		duplicate = properties_.count(key) != 0;
+		if (!duplicate && it != sources_.end() && it->second.filters_generation == generation) {
+			properties_[key] = PropertyEntry{weak_filter, properties};
+			stored = true;
+		}
+	}
+	if (duplicate) {
+		// The cached entry owns the (single) update connection.
+		obs_weak_source_release(weak_filter);
+	} else if (!stored) {
+		Release({weak_filter});
+	}
+	return properties;
+}
+
+int JoypadSourceCatalog::AddOnChanged(ChangeCallback callback)
+{
+	std::lock_guard<std::mutex> lock(handlers_mutex_);
+	const int id = next_handler_id_++;
+	handlers_.emplace_back(id, std::move(callback));
+	return id;
+}
+
+void JoypadSourceCatalog::RemoveOnChanged(int handler_id)
+{
+	std::lock_guard<std::mutex> lock(handlers_mutex_);
+	handlers_.erase(std::remove_if(handlers_.begin(), handlers_.end(),
+				       [handler_id](const auto &handler) { return handler.first == handler_id; }),
+			handlers_.end());
+}
+
+void JoypadSourceCatalog::OnSourceCreate(void *data, calldata_t *cd)
+{
+	auto *catalog = static_cast<JoypadSourceCatalog *>(data);
+	auto *source = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+	if (source && catalog->AddSource(source)) {
+		catalog->NotifyChanged();
+	}
+}
+
+void JoypadSourceCatalog::OnSourceRemove(void *data, calldata_t *cd)
+{
+	auto *catalog = static_cast<JoypadSourceCatalog *>(data);
+	auto *source = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+	if (!source) {
+		return;
+	}
+	if (obs_source_get_type(source) == OBS_SOURCE_TYPE_FILTER) {
+		obs_source_t *parent = obs_filter_get_parent(source);
+		if (parent) {
+			catalog->ForgetFilters(source_name(parent));
+		}
+		return;
+	}
+	catalog->RemoveSource(source);
+}
+
+void JoypadSourceCatalog::OnSourceRename(void *data, calldata_t *cd)
+{
+	auto *catalog = static_cast<JoypadSourceCatalog *>(data);
+	auto *source = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+	const char *new_name = calldata_string(cd, "new_name");
+	const char *prev_name = calldata_string(cd, "prev_name");
+	if (!source || !new_name || !prev_name) {
+		return;
+	}
+	if (obs_source_get_type(source) == OBS_SOURCE_TYPE_FILTER) {
+		obs_source_t *parent = obs_filter_get_parent(source);
+		if (parent) {
+			catalog->ForgetFilters(source_name(parent));
+		}
+		return;
+	}
+	catalog->RenameSource(source, new_name, prev_name);
+}
+
+void JoypadSourceCatalog::OnFiltersChanged(void *data, calldata_t *cd)
+{
+	auto *catalog = static_cast<JoypadSourceCatalog *>(data);
+	auto *source = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+	if (source) {
+		catalog->ForgetFilters(source_name(source));
+	}
+}
+
+void JoypadSourceCatalog::OnFilterUpdate(void *data, calldata_t *cd)
+{
+	auto *catalog = static_cast<JoypadSourceCatalog *>(data);
+	auto *filter = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+	obs_source_t *parent = filter ? obs_filter_get_parent(filter) : nullptr;
+	if (!parent) {
+		return;
+	}
+	obs_weak_source_t *released = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(catalog->mutex_);
+		auto it = catalog->properties_.find(PropertyKey(source_name(parent), source_name(filter)));
+		if (it == catalog->properties_.end()) {
+			return;
+		}
+		released = it->second.weak_filter;
+		catalog->properties_.erase(it);
+	}
+	catalog->Release({released});
+}
+
+bool JoypadSourceCatalog::AddSource(obs_source_t *source)
+{
+	if (obs_source_get_type(source) != OBS_SOURCE_TYPE_INPUT) {
+		return false;
+	}
+	JoypadCatalogSource info = describe_source(source);
+	if (info.name.empty()) {
+		return false;
+	}
+
+	// Connect before taking mutex_: connecting waits for running callbacks, which take mutex_.
+	obs_weak_source_t *weak = obs_source_get_weak_source(source);
+	signal_handler_t *signals = obs_source_get_signal_handler(source);
+	for (const char *signal : kFilterListSignals) {
+		signal_handler_connect(signals, signal, OnFiltersChanged, this);
+	}
+
+	bool added = false;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = sources_.find(info.name);
+		if (it == sources_.end()) {
+			const std::string name = info.name;
+			SourceEntry entry;
+			entry.info = std::move(info);
+			entry.weak = weak;
+			sources_.emplace(name, std::move(entry));
+			added = true;
+		}
+	}
+	if (!added) {
+		// Already known: seen by both the initial enumeration and source_create.
+		obs_weak_source_release(weak);
+	}
+	return added;
+}
+
+void JoypadSourceCatalog::RemoveSource(obs_source_t *source)
+{
+	std::vector<obs_weak_source_t *> released;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = sources_.find(source_name(source));
+		if (it == sources_.end() || !obs_weak_source_references_source(it->second.weak, source)) {
+			return;
+		}
+		ForgetFiltersLocked(it->first, released);
+		released.push_back(it->second.weak);
+		sources_.erase(it);
+	}
+	Release(released);
+	NotifyChanged();
+}
+
+void JoypadSourceCatalog::RenameSource(obs_source_t *source, const std::string &new_name,
+				       const std::string &prev_name)
+{
+	std::vector<obs_weak_source_t *> released;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = sources_.find(prev_name);
+		if (it == sources_.end() || !obs_weak_source_references_source(it->second.weak, source)) {
+			return;
+		}
+		ForgetFiltersLocked(prev_name, released);
+		auto node = sources_.extract(it);
+		node.key() = new_name;
+		node.mapped().info.name = new_name;
+		sources_.insert(std::move(node));
+	}
+	Release(released);
+	NotifyChanged();
+}
+
+void JoypadSourceCatalog::ForgetFilters(const std::string &source_name)
+{
+	std::vector<obs_weak_source_t *> released;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (!sources_.count(source_name)) {
+			return;
+		}
+		ForgetFiltersLocked(source_name, released);
+	}
+	Release(released);
+	NotifyChanged();
+}
+
+void JoypadSourceCatalog::ForgetFiltersLocked(const std::string &source_name,
+					      std::vector<obs_weak_source_t *> &released)
+{
+	auto it = sources_.find(source_name);
+	if (it != sources_.end()) {
+		it->second.filters_known = false;
+		it->second.filters.clear();
+		++it->second.filters_generation;
+	}
+	auto first = properties_.lower_bound(PropertyKey(source_name, std::string()));
+	auto last = first;
+	while (last != properties_.end() && last->first.first == source_name) {
+		released.push_back(last->second.weak_filter);
+		++last;
+	}
+	properties_.erase(first, last);
+}
+
+void JoypadSourceCatalog::Release(const std::vector<obs_weak_source_t *> &released)
+{
+	for (obs_weak_source_t *weak : released) {
+		if (!weak) {
+			continue;
+		}
+		// Gone sources take their signal handler with them; live ones must be disconnected.
+		obs_source_t *source = obs_weak_source_get_source(weak);
+		if (source) {
+			signal_handler_t *signals = obs_source_get_signal_handler(source);
+			for (const char *signal : kFilterListSignals) {
+				signal_handler_disconnect(signals, signal, OnFiltersChanged, this);
+			}
+			signal_handler_disconnect(signals, "update", OnFilterUpdate, this);
+			obs_source_release(source);
+		}
+		obs_weak_source_release(weak);
+	}
+}
+
+void JoypadSourceCatalog::Populate()
+{
+	obs_enum_sources(
+		[](void *data, obs_source_t *source) {
+			auto *catalog = static_cast<JoypadSourceCatalog *>(data);
+			if (!catalog->running_) {
+				return false;
+			}
+			if (source) {
+				catalog->AddSource(source);
+			}
+			return true;
+		},
+		this);
+	ready_ = true;
+	NotifyChanged();
+}
+
+void JoypadSourceCatalog::NotifyChanged()
+{
+	version_.fetch_add(1, std::memory_order_acq_rel);
+	std::lock_guard<std::mutex> lock(handlers_mutex_);
+	for (const auto &handler : handlers_) {
+		handler.second();
+	}
+}
@@ -0,0 +1,123 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <obs.h>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct JoypadCatalogSource {
+	std::string name;
+	std::string type_id;
+	bool has_audio = false;
+	bool has_video = false;
+	bool is_media = false;
+};
+
+struct JoypadFilterPropertyListItem {
+	std::string name;
+	std::string string_value;
+	long long int_value = 0;
+	double float_value = 0.0;
+};
+
+struct JoypadFilterPropertyInfo {
+	std::string name;
+	std::string description;
+	obs_property_type type = OBS_PROPERTY_INVALID;
+	double min_value = 0.0;
+	double max_value = 1.0;
+	obs_combo_format list_format = OBS_COMBO_FORMAT_INVALID;
+	std::vector<JoypadFilterPropertyListItem> list_items;
+};
+
+// Input sources, their filters and filter property layouts, shared by every binding editor.
+// Start() enumerates the sources on a worker thread; after that the catalog follows OBS
+// source and filter signals. Filter lists and property layouts are read on first use and
+// kept until the source or filter changes.
+class JoypadSourceCatalog {
+public:
+	using ChangeCallback = std::function<void()>;
+
+	~JoypadSourceCatalog();
+
+	void Start();
+	void Stop();
+	bool IsReady() const;
+	uint64_t GetVersion() const;
+
+	// Sorted by name.
+	std::vector<JoypadCatalogSource> GetSources() const;
+	std::vector<std::string> GetFilterNames(const std::string &source_name);
+	std::vector<JoypadFilterPropertyInfo> GetFilterProperties(const std::string &source_name,
+								  const std::string &filter_name);
+
+	// Called on the thread that saw the change; callers coalesce and hop to the UI thread.
+	int AddOnChanged(ChangeCallback callback);
+	void RemoveOnChanged(int handler_id);
+
+private:
+	struct SourceEntry {
+		JoypadCatalogSource info;
+		obs_weak_source_t *weak = nullptr;
+		bool filters_known = false;
+		// Bumped whenever the filter list goes stale, so reads that raced a change are dropped.
+		uint64_t filters_generation = 0;
+		std::vector<std::string> filters;
+	};
+	struct PropertyEntry {
+		obs_weak_source_t *weak_filter = nullptr;
+		std::vector<JoypadFilterPropertyInfo> properties;
+	};
+	using PropertyKey = std::pair<std::string, std::string>;
+
+	static void OnSourceCreate(void *data, calldata_t *cd);
+	static void OnSourceRemove(void *data, calldata_t *cd);
+	static void OnSourceRename(void *data, calldata_t *cd);
+	static void OnFiltersChanged(void *data, calldata_t *cd);
+	static void OnFilterUpdate(void *data, calldata_t *cd);
+
+	bool AddSource(obs_source_t *source);
+	void RemoveSource(obs_source_t *source);
+	void RenameSource(obs_source_t *source, const std::string &new_name, const std::string &prev_name);
+	void ForgetFilters(const std::string &source_name);
+	void ForgetFiltersLocked(const std::string &source_name, std::vector<obs_weak_source_t *> &released);
+	void Release(const std::vector<obs_weak_source_t *> &released);
+	void Populate();
+	void NotifyChanged();
+
+	mutable std::mutex mutex_;
+	std::map<std::string, SourceEntry> sources_;
+	std::map<PropertyKey, PropertyEntry> properties_;
+	std::atomic<bool> running_{false};
+	std::atomic<bool> ready_{false};
+	std::atomic<uint64_t> version_{0};
+	std::thread populate_thread_;
+
+	std::mutex handlers_mutex_;
+	std::vector<std::pair<int, ChangeCallback>> handlers_;
+	int next_handler_id_ = 1;
+};
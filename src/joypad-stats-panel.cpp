@@ -0,0 +1,192 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "joypad-stats-panel.h"
+#include "joypad-stats.h"
+#include "joypad-ui.h"
+#include "joypad-watchdog.h"
+
+#include <obs-module.h>
+
+#include <QLabel>
+#include <QTimer>
+#include <QVBoxLayout>
+#include <algorithm>
+
+namespace {
+constexpr int kRefreshIntervalMs = 1000;
+constexpr size_t kMaxStallRows = 5;
+
+inline QString L(const char *key)
+{
+	return QString::fromUtf8(obs_module_text(key));
+}
+
+QString format_duration(int64_t ns)
+{
+	if (ns < 1000) {
+		return QStringLiteral("%1 ns").arg(ns);
+	}
+	if (ns < 1000000) {
+		return QStringLiteral("%1 µs").arg((double)ns / 1000.0, 0, 'f', 1);
+	}
+	return QStringLiteral("%1 ms").arg((double)ns / 1000000.0, 0, 'f', 1);
+}
+
+QString heading(const QString &text)
+{
+	return QStringLiteral("<tr><td colspan=\"2\"><b>%1</b></td></tr>").arg(text.toHtmlEscaped());
+}
+
+QString row(const QString &name, const QString &value)
+{
+	return QStringLiteral("<tr><td>%1</td><td>%2</td></tr>").arg(name.toHtmlEscaped(), value.toHtmlEscaped());
+}
+} // namespace
+
+JoypadStatsPanel::JoypadStatsPanel(QWidget *parent, JoypadInputManager *input, JoypadWatchdog *watchdog)
+	: QWidget(parent),
+	  input_(input),
+	  watchdog_(watchdog)
+{
+	std::fill(std::begin(last_counts_), std::end(last_counts_), UINT64_MAX);
+	samples_.reserve(kJoypadMonitorSlots);
+
+	auto *layout = new QVBoxLayout(this);
+	layout->setContentsMargins(0, 0, 0, 0);
+	label_ = new QLabel(this);
+	label_->setTextFormat(Qt::RichText);
+	label_->setTextInteractionFlags(Qt::TextSelectableByMouse);
+	layout->addWidget(label_);
+
+	timer_ = new QTimer(this);
+	connect(timer_, &QTimer::timeout, this, [this]() { Refresh(); });
+}
+
+void JoypadStatsPanel::showEvent(QShowEvent *event)
+{
+	QWidget::showEvent(event);
+	names_known_ = false;
+	Refresh();
+	timer_->start(kRefreshIntervalMs);
+}
+
+void JoypadStatsPanel::hideEvent(QHideEvent *event)
+{
+	timer_->stop();
+	QWidget::hideEvent(event);
+}
+
+void JoypadStatsPanel::Refresh()
+{
+	QString html = QStringLiteral("<table cellspacing=\"0\" cellpadding=\"1\">");
+
+	html += heading(L("JoypadToOBS.Stats.Devices"));
+	if (input_) {
+		const uint64_t version = input_->GetDevicesVersion();
+		if (!names_known_ || version != devices_version_) {
+			names_known_ = true;
+			devices_version_ = version;
+			for (auto &name : names_) {
+				name.clear();
+			}
+			std::fill(std::begin(last_counts_), std::end(last_counts_), UINT64_MAX);
+			for (const auto &device : input_->GetDevices()) {
+				if (device.monitor_slot >= 0 && device.monitor_slot < kJoypadMonitorSlots) {
+					names_[device.monitor_slot] = QString::fromStdString(device.name);
+				}
+			}
+		}
+		input_->ReadMonitorSamples(samples_);
+	}
+	const auto now = std::chrono::steady_clock::now();
+	const double seconds = std::chrono::duration<double>(now - last_refresh_).count();
+	last_refresh_ = now;
+	for (const auto &sample : samples_) {
+		const uint64_t previous = last_counts_[sample.slot];
+		last_counts_[sample.slot] = sample.event_count;
+		const double rate = previous == UINT64_MAX || sample.event_count < previous || seconds <= 0.0
+					    ? 0.0
+					    : (double)(sample.event_count - previous) / seconds;
+		html += row(names_[sample.slot], L("JoypadToOBS.Stats.DeviceRow")
+							 .arg(rate, 0, 'f', 0)
+							 .arg(sample.coalesced_count)
+							 .arg(sample.dropped_count));
+	}
+	if (samples_.empty()) {
+		html += row(L("JoypadToOBS.Monitor.NoDevices"), QString());
+	}
+
+	JoypadStatsSnapshot stats;
+	JoypadStatsRead(stats);
+	html += heading(L("JoypadToOBS.Stats.Dispatch"));
+	html += row(L("JoypadToOBS.Stats.Matching"), L("JoypadToOBS.Stats.MatchingRow")
+							     .arg(format_duration(stats.match_p50_ns))
+							     .arg(format_duration(stats.match_p99_ns))
+							     .arg(stats.matches));
+	html += row(L("JoypadToOBS.Stats.InputBatch"),
+		    L("JoypadToOBS.Stats.InputBatchRow").arg(stats.input_batch).arg(stats.input_batch_max));
+
+	html += heading(L("JoypadToOBS.Stats.Actions"));
+	bool any_action = false;
+	for (size_t i = 0; i < kJoypadActionTypeCount; ++i) {
+		const auto &action = stats.actions[i];
+		if (action.count == 0) {
+			continue;
+		}
+		any_action = true;
+		html += row(JoypadUiActionText((JoypadActionType)i),
+			    L("JoypadToOBS.Stats.ActionRow")
+				    .arg(action.count)
+				    .arg(format_duration(action.total_ns / (int64_t)action.count))
+				    .arg(format_duration(action.max_ns)));
+	}
+	if (!any_action) {
+		html += row(L("JoypadToOBS.Stats.NoActions"), QString());
+	}
+
+	html += heading(L("JoypadToOBS.Stats.Caches"));
+	const char *cache_names[kJoypadStatsCacheCount] = {"JoypadToOBS.Stats.CacheAxisDispatch",
+							    "JoypadToOBS.Stats.CacheFilterProperties"};
+	for (size_t i = 0; i < kJoypadStatsCacheCount; ++i) {
+		const auto &cache = stats.caches[i];
+		const uint64_t total = cache.hits + cache.misses;
+		const double percent = total ? 100.0 * (double)cache.hits / (double)total : 0.0;
+		html += row(L(cache_names[i]),
+			    L("JoypadToOBS.Stats.CacheRow").arg(percent, 0, 'f', 0).arg(cache.hits).arg(total));
+	}
+
+	if (watchdog_) {
+		const JoypadWatchdogSummary stalls = watchdog_->Summary();
+		html += heading(L("JoypadToOBS.Stats.Stalls"));
+		html += row(L("JoypadToOBS.Stats.LoopStalls"), L("JoypadToOBS.Stats.StallRow")
+								      .arg(stalls.loop_stalls)
+								      .arg(format_duration(stalls.loop_stall_max_ns)));
+		for (size_t i = 0; i < stalls.actions.size() && i < kMaxStallRows; ++i) {
+			const auto &stall = stalls.actions[i];
+			html += row(QStringLiteral("%1: %2").arg(JoypadUiActionText(stall.action),
+								  QString::fromStdString(stall.target)),
+				    L("JoypadToOBS.Stats.StallRow")
+					    .arg(stall.count)
+					    .arg(format_duration(stall.max_ns)));
+		}
+	}
+
+	html += QStringLiteral("</table>");
+	label_->setText(html);
+}
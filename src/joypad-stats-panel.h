@@ -0,0 +1,57 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include "joypad-input.h"
+
+#include <QWidget>
+#include <chrono>
+#include <vector>
+
+class QLabel;
+class QTimer;
+class JoypadWatchdog;
+
+// Runtime statistics for the dock: per-device event rates and coalesced/dropped counts from
+// the input monitor slots, plus matcher, input batch size, action and cache counters from
+// joypad-stats.h, and the slowest stalls seen by the watchdog. Refreshes once a second, and
+// only while visible.
+class JoypadStatsPanel : public QWidget {
+public:
+	JoypadStatsPanel(QWidget *parent, JoypadInputManager *input, JoypadWatchdog *watchdog);
+
+protected:
+	void showEvent(QShowEvent *event) override;
+	void hideEvent(QHideEvent *event) override;
+
+private:
+	void Refresh();
+
+	JoypadInputManager *input_ = nullptr;
+	JoypadWatchdog *watchdog_ = nullptr;
+	QLabel *label_ = nullptr;
+	QTimer *timer_ = nullptr;
+	uint64_t devices_version_ = 0;
+	bool names_known_ = false;
+	QString names_[kJoypadMonitorSlots];
+	// Event count of each slot at the previous refresh, or UINT64_MAX when unknown.
+	uint64_t last_counts_[kJoypadMonitorSlots];
+	std::chrono::steady_clock::time_point last_refresh_;
+	std::vector<JoypadMonitorSample> samples_;
+};
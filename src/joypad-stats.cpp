@@ -0,0 +1,140 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "joypad-stats.h"
+
+#include <atomic>
+
+namespace {
+// Log-linear histogram: values below 4 ns get their own bucket, larger ones are split into
+// four buckets per power of two.
+constexpr size_t kHistogramBuckets = 252;
+
+struct ActionCounters {
+	std::atomic<uint64_t> count{0};
+	std::atomic<int64_t> total_ns{0};
+	std::atomic<int64_t> max_ns{0};
+};
+
+struct CacheCounters {
+	std::atomic<uint64_t> hits{0};
+	std::atomic<uint64_t> misses{0};
+};
+
+std::atomic<uint64_t> g_match_buckets[kHistogramBuckets] = {};
+std::atomic<uint32_t> g_input_batch{0};
+std::atomic<uint32_t> g_input_batch_max{0};
+ActionCounters g_actions[kJoypadActionTypeCount];
+CacheCounters g_caches[kJoypadStatsCacheCount];
+
+size_t bucket_of(uint64_t value)
+{
+	if (value < 4) {
+		return (size_t)value;
+	}
+	int exponent = 2;
+	while ((value >> (exponent + 1)) != 0) {
+		++exponent;
+	}
+	return (size_t)(exponent - 1) * 4 + (size_t)((value >> (exponent - 2)) & 3u);
+}
+
+// Largest value that falls in bucket.
+int64_t bucket_limit(size_t bucket)
+{
+	if (bucket < 4) {
+		return (int64_t)bucket;
+	}
+	const int exponent = (int)(bucket / 4) + 1;
+	const uint64_t limit = ((uint64_t)(5 + bucket % 4) << (exponent - 2)) - 1;
+	return limit > (uint64_t)INT64_MAX ? INT64_MAX : (int64_t)limit;
+}
+
+template<typename T> void store_max(std::atomic<T> &target, T value)
+{
+	T current = target.load(std::memory_order_relaxed);
+	while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+	}
+}
+} // namespace
+
+void JoypadStatsRecordMatch(int64_t duration_ns)
+{
+	g_match_buckets[bucket_of(duration_ns > 0 ? (uint64_t)duration_ns : 0)].fetch_add(
+		1, std::memory_order_relaxed);
+}
+
+void JoypadStatsRecordInputBatch(size_t size)
+{
+	const uint32_t value = size > UINT32_MAX ? UINT32_MAX : (uint32_t)size;
+	g_input_batch.store(value, std::memory_order_relaxed);
+	store_max(g_input_batch_max, value);
+}
+
+void JoypadStatsRecordAction(JoypadActionType action, int64_t duration_ns)
+{
+	const size_t index = (size_t)action;
+	if (index >= kJoypadActionTypeCount) {
+		return;
+	}
+	ActionCounters &counters = g_actions[index];
+	counters.count.fetch_add(1, std::memory_order_relaxed);
+	counters.total_ns.fetch_add(duration_ns, std::memory_order_relaxed);
+	store_max(counters.max_ns, duration_ns);
+}
+
+void JoypadStatsRecordCache(JoypadStatsCache cache, bool hit)
+{
+	CacheCounters &counters = g_caches[(size_t)cache];
+	(hit ? counters.hits : counters.misses).fetch_add(1, std::memory_order_relaxed);
+}
+
+void JoypadStatsRead(JoypadStatsSnapshot &out)
+{
+	out = JoypadStatsSnapshot();
+	uint64_t buckets[kHistogramBuckets];
+	for (size_t i = 0; i < kHistogramBuckets; ++i) {
+		buckets[i] = g_match_buckets[i].load(std::memory_order_relaxed);
+		out.matches += buckets[i];
+	}
+	const uint64_t p50_rank = (out.matches + 1) / 2;
+	const uint64_t p99_rank = out.matches - out.matches / 100;
+	uint64_t seen = 0;
+	for (size_t i = 0; i < kHistogramBuckets && out.matches != 0; ++i) {
+		seen += buckets[i];
+		if (out.match_p50_ns == 0 && seen >= p50_rank) {
+			out.match_p50_ns = bucket_limit(i);
+		}
+		if (seen >= p99_rank) {
+			out.match_p99_ns = bucket_limit(i);
+			break;
+		}
+	}
+
+	out.input_batch = g_input_batch.load(std::memory_order_relaxed);
+	out.input_batch_max = g_input_batch_max.load(std::memory_order_relaxed);
+	for (size_t i = 0; i < kJoypadActionTypeCount; ++i) {
+		out.actions[i].count = g_actions[i].count.load(std::memory_order_relaxed);
+		out.actions[i].total_ns = g_actions[i].total_ns.load(std::memory_order_relaxed);
+		out.actions[i].max_ns = g_actions[i].max_ns.load(std::memory_order_relaxed);
+	}
+	for (size_t i = 0; i < kJoypadStatsCacheCount; ++i) {
+		out.caches[i].hits = g_caches[i].hits.load(std::memory_order_relaxed);
+		out.caches[i].misses = g_caches[i].misses.load(std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,66 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include "joypad-core.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Runtime counters for the dock's statistics panel. Recording is a few relaxed atomic
+// operations and never locks, so the poll thread can call it for every event; readers get
+// a snapshot that may mix counts from neighbouring events, which is fine for display.
+// Per-device counts live in JoypadMonitorSample instead.
+
+enum class JoypadStatsCache : uint8_t {
+	// Absolute axis values held back because they repeat, or come too soon after, the last
+	// one dispatched for their binding.
+	AxisDispatch = 0,
+	// Filter property layouts served from JoypadSourceCatalog.
+	FilterProperties = 1,
+};
+constexpr size_t kJoypadStatsCacheCount = 2;
+
+struct JoypadStatsSnapshot {
+	uint64_t matches = 0;
+	// Within a quarter of a power of two.
+	int64_t match_p50_ns = 0;
+	int64_t match_p99_ns = 0;
+	// Input events the poll loop read in its last cycle, and the most read in one cycle.
+	uint32_t input_batch = 0;
+	uint32_t input_batch_max = 0;
+	struct Action {
+		uint64_t count = 0;
+		int64_t total_ns = 0;
+		int64_t max_ns = 0;
+	};
+	Action actions[kJoypadActionTypeCount];
+	struct Cache {
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+	};
+	Cache caches[kJoypadStatsCacheCount];
+};
+
+void JoypadStatsRecordMatch(int64_t duration_ns);
+void JoypadStatsRecordInputBatch(size_t size);
+void JoypadStatsRecordAction(JoypadActionType action, int64_t duration_ns);
+void JoypadStatsRecordCache(JoypadStatsCache cache, bool hit);
+
+void JoypadStatsRead(JoypadStatsSnapshot &out);
@@ -0,0 +1,231 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "joypad-trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace joypad_trace_detail {
+std::atomic<bool> enabled{false};
+}
+
+namespace {
+
+// About 2.5 MB; at 32 busy controllers that is the last few seconds of input.
+constexpr size_t kTraceCapacity = 1u << 16;
+
+struct TraceSpan {
+	const char *name = nullptr;
+	uint64_t event_id = 0;
+	int64_t start_ns = 0;
+	int64_t end_ns = 0;
+	uint32_t thread = 0;
+};
+
+struct TraceBuffer {
+	std::mutex mutex;
+	std::vector<TraceSpan> spans;
+	size_t next = 0;
+	bool wrapped = false;
+	std::vector<std::pair<uint32_t, std::string>> thread_names;
+};
+
+TraceBuffer &trace_buffer()
+{
+	static TraceBuffer buffer;
+	return buffer;
+}
+
+std::atomic<uint64_t> g_next_event_id{1};
+std::atomic<uint32_t> g_next_thread{1};
+thread_local uint32_t t_thread = 0;
+thread_local uint64_t t_current_event = 0;
+
+uint32_t current_thread()
+{
+	if (t_thread == 0) {
+		t_thread = g_next_thread.fetch_add(1, std::memory_order_relaxed);
+	}
+	return t_thread;
+}
+
+void write_json_string(FILE *file, const char *text)
+{
+	fputc('"', file);
+	for (const char *c = text; *c; ++c) {
+		if (*c == '"' || *c == '\\') {
+			fputc('\\', file);
+			fputc(*c, file);
+		} else if ((unsigned char)*c < 0x20) {
+			fprintf(file, "\\u%04x", (unsigned)(unsigned char)*c);
+		} else {
+			fputc(*c, file);
+		}
+	}
+	fputc('"', file);
+}
+
+} // namespace
+
+void JoypadTraceSetEnabled(bool enabled)
+{
+	if (enabled) {
+		TraceBuffer &buffer = trace_buffer();
+		std::lock_guard<std::mutex> lock(buffer.mutex);
+		if (buffer.spans.empty()) {
+			buffer.spans.resize(kTraceCapacity);
+		}
+	}
+	joypad_trace_detail::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void JoypadTraceClear()
+{
+	TraceBuffer &buffer = trace_buffer();
+	std::lock_guard<std::mutex> lock(buffer.mutex);
+	buffer.next = 0;
+	buffer.wrapped = false;
+}
+
+int64_t JoypadTraceNow()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		       std::chrono::steady_clock::now().time_since_epoch())
+		.count();
+}
+
+uint64_t JoypadTraceNextEventId()
+{
+	return g_next_event_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+void JoypadTraceRecord(const char *name, uint64_t event_id, int64_t start_ns, int64_t end_ns)
+{
+	const uint32_t thread = current_thread();
+	TraceBuffer &buffer = trace_buffer();
+	std::lock_guard<std::mutex> lock(buffer.mutex);
+	if (buffer.spans.empty()) {
+		return;
+	}
+	TraceSpan &span = buffer.spans[buffer.next];
+	span.name = name;
+	span.event_id = event_id;
+	span.start_ns = start_ns;
+	span.end_ns = end_ns;
+	span.thread = thread;
+	if (++buffer.next == buffer.spans.size()) {
+		buffer.next = 0;
+		buffer.wrapped = true;
+	}
+}
+
+void JoypadTraceSetThreadName(const char *name)
+{
+	const uint32_t thread = current_thread();
+	TraceBuffer &buffer = trace_buffer();
+	std::lock_guard<std::mutex> lock(buffer.mutex);
+	for (auto &entry : buffer.thread_names) {
+		if (entry.first == thread) {
+			entry.second = name;
+			return;
+		}
+	}
+	buffer.thread_names.emplace_back(thread, name);
+}
+
+bool JoypadTraceWriteJson(const std::string &path, std::string *error)
+{
+	std::vector<TraceSpan> spans;
+	std::vector<std::pair<uint32_t, std::string>> thread_names;
+	{
+		TraceBuffer &buffer = trace_buffer();
+		std::lock_guard<std::mutex> lock(buffer.mutex);
+		if (buffer.wrapped) {
+			spans.assign(buffer.spans.begin() + (std::ptrdiff_t)buffer.next, buffer.spans.end());
+		}
+		spans.insert(spans.end(), buffer.spans.begin(), buffer.spans.begin() + (std::ptrdiff_t)buffer.next);
+		thread_names = buffer.thread_names;
+	}
+	// Spans are recorded when they end, so nested ones come first; viewers want start order.
+	std::stable_sort(spans.begin(), spans.end(),
+			 [](const TraceSpan &a, const TraceSpan &b) { return a.start_ns < b.start_ns; });
+
+	FILE *file = fopen(path.c_str(), "wb");
+	if (!file) {
+		if (error) {
+			*error = "cannot create " + path;
+		}
+		return false;
+	}
+
+	const int64_t origin = spans.empty() ? 0 : spans.front().start_ns;
+	fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", file);
+	fputs("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"joypad-to-obs\"}}", file);
+	for (const auto &entry : thread_names) {
+		fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+			entry.first);
+		write_json_string(file, entry.second.c_str());
+		fputs("}}", file);
+	}
+	for (const auto &span : spans) {
+		fputs(",\n{\"name\":", file);
+		write_json_string(file, span.name);
+		fprintf(file, ",\"cat\":\"joypad\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u",
+			(double)(span.start_ns - origin) / 1000.0,
+			(double)std::max<int64_t>(span.end_ns - span.start_ns, 0) / 1000.0, span.thread);
+		if (span.event_id) {
+			fprintf(file, ",\"args\":{\"event\":%llu}", (unsigned long long)span.event_id);
+		}
+		fputc('}', file);
+	}
+	fputs("\n]}\n", file);
+
+	const bool ok = !ferror(file);
+	if (fclose(file) != 0 || !ok) {
+		if (error) {
+			*error = "cannot write " + path;
+		}
+		return false;
+	}
+	return true;
+}
+
+void JoypadTraceScope::Begin(const char *name, uint64_t event_id)
+{
+	name_ = name;
+	if (event_id) {
+		owns_event_ = true;
+		previous_event_ = t_current_event;
+		t_current_event = event_id;
+	}
+	event_id_ = t_current_event;
+	start_ns_ = JoypadTraceNow();
+}
+
+void JoypadTraceScope::End()
+{
+	JoypadTraceRecord(name_, event_id_, start_ns_, JoypadTraceNow());
+	if (owns_event_) {
+		t_current_event = previous_event_;
+	}
+}
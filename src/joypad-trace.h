@@ -0,0 +1,85 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Span tracing for the input path, exported as Chrome trace JSON (chrome://tracing or
+// ui.perfetto.dev). Each event read from a device gets an id; the read, queue, dispatch,
+// matching and action spans it goes through are tagged with that id so one press can be
+// followed from the device to OBS. Spans go to a fixed ring that keeps the most recent
+// ones. While tracing is off every call below is a relaxed atomic load and nothing else.
+
+namespace joypad_trace_detail {
+extern std::atomic<bool> enabled;
+}
+
+inline bool JoypadTraceEnabled()
+{
+	return joypad_trace_detail::enabled.load(std::memory_order_relaxed);
+}
+
+// Turning tracing on keeps the spans already recorded; call JoypadTraceClear() to drop them.
+void JoypadTraceSetEnabled(bool enabled);
+void JoypadTraceClear();
+
+// Steady clock nanoseconds, the time base of every span.
+int64_t JoypadTraceNow();
+uint64_t JoypadTraceNextEventId();
+// name must outlive the trace; string literals or static tables only.
+void JoypadTraceRecord(const char *name, uint64_t event_id, int64_t start_ns, int64_t end_ns);
+// Labels the calling thread in exported traces.
+void JoypadTraceSetThreadName(const char *name);
+
+// Writes the recorded spans, oldest first. On failure returns false and describes why in error.
+bool JoypadTraceWriteJson(const std::string &path, std::string *error);
+
+// Records a span from construction to destruction when tracing is on. A scope with an event
+// id makes that id current on this thread until it ends, and nested scopes without one
+// (matching and actions, which never see the event) are tagged with it.
+class JoypadTraceScope {
+public:
+	explicit JoypadTraceScope(const char *name, uint64_t event_id = 0)
+	{
+		if (JoypadTraceEnabled()) {
+			Begin(name, event_id);
+		}
+	}
+	~JoypadTraceScope()
+	{
+		if (name_) {
+			End();
+		}
+	}
+
+	JoypadTraceScope(const JoypadTraceScope &) = delete;
+	JoypadTraceScope &operator=(const JoypadTraceScope &) = delete;
+
+private:
+	void Begin(const char *name, uint64_t event_id);
+	void End();
+
+	const char *name_ = nullptr;
+	uint64_t event_id_ = 0;
+	uint64_t previous_event_ = 0;
+	int64_t start_ns_ = 0;
+	bool owns_event_ = false;
+};
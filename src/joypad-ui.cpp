@@ -18,6 +18,8 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 
 #include "joypad-ui.h"
 #include "joypad-actions.h"
+#include "joypad-monitor.h"
+#include "joypad-source-catalog.h"
 #include "plugin-support.h"
 
 #include <obs-frontend-api.h>
@@ -25,14 +27,18 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 #include <obs-properties.h>
 
 #include <QAbstractItemView>
+#include <QAbstractTableModel>
+#include <QApplication>
 #include <QCheckBox>
 #include <QComboBox>
+#include <QCompleter>
 #include <QDialogButtonBox>
 #include <QDoubleSpinBox>
 #include <QFrame>
 #include <QGroupBox>
 #include <QHeaderView>
 #include <QLabel>
+#include <QLineEdit>
 #include <QLayout>
 #include <QGridLayout>
 #include <QHBoxLayout>
@@ -44,11 +50,17 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 #include <QMetaObject>
 #include <QInputDialog>
 #include <QMessageBox>
+#include <QMenu>
 #include <QFileDialog>
 #include <QPushButton>
-#include <QTableWidget>
-#include <QTableWidgetItem>
+#include <QProgressDialog>
+#include <QTableView>
+#include <QStyledItemDelegate>
+#include <QStyleOptionButton>
+#include <QPainter>
+#include <QMouseEvent>
 #include <QSlider>
+#include <QSpinBox>
 #include <QSizePolicy>
 #include <QSignalBlocker>
 #include <QTimer>
@@ -56,6 +68,7 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 #include <QFileInfo>
 #include <QDir>
 #include <QSplitter>
+#include <QScrollArea>
 #include <QCloseEvent>
 #include <QColorDialog>
 #include <QSpinBox>
@@ -64,14 +77,22 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 #include <atomic>
 #include <chrono>
 #include <cmath>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace {
 constexpr int kDeviceIdRole = Qt::UserRole;
 constexpr int kDeviceStableIdRole = Qt::UserRole + 1;
 constexpr int kDeviceTypeIdRole = Qt::UserRole + 2;
+constexpr int kBindingUidRole = Qt::UserRole + 3;
+constexpr const char *kBundleSuffix = ".joypadbundle";
+constexpr const char *kBundleDefaultName = "joypad-profiles.joypadbundle";
+constexpr const char *kBundleFileFilter = "Joypad to OBS Bundles (*.joypadbundle)";
+constexpr const char *kRecordingFileFilter = "Joypad Input Recordings (*.jprec)";
 
 std::atomic<int> g_binding_dialog_open_count{0};
 std::atomic<bool> g_input_listening_enabled{true};
@@ -84,6 +105,23 @@ DialogTestState g_dialog_test_state;
 std::unordered_map<std::string, std::chrono::steady_clock::time_point> g_dialog_axis_last_dispatch;
 constexpr double kLearnAxisDeadzone = 0.65;
 
+struct ConditionFlagEntry {
+	uint32_t flag;
+	const char *label_key;
+};
+constexpr ConditionFlagEntry kConditionFlags[] = {
+	{kJoypadStateStreaming, "JoypadToOBS.Condition.Streaming"},
+	{kJoypadStateRecording, "JoypadToOBS.Condition.Recording"},
+	{kJoypadStateStudioMode, "JoypadToOBS.Condition.StudioMode"},
+	{kJoypadStateReplayBuffer, "JoypadToOBS.Condition.ReplayBuffer"},
+	{kJoypadStateVirtualCam, "JoypadToOBS.Condition.VirtualCam"},
+};
+constexpr int kConditionFlagCount = (int)(sizeof(kConditionFlags) / sizeof(kConditionFlags[0]));
+// Item data of the per-flag condition combos.
+constexpr int kConditionAny = 0;
+constexpr int kConditionRequired = 1;
+constexpr int kConditionForbidden = 2;
+
 inline QString L(const char *key)
 {
 	return QString::fromUtf8(obs_module_text(key));
@@ -163,6 +201,17 @@ QString combo_entry_to_text(const JoypadButtonComboEntry &entry)
 	return QStringLiteral("%1: %2").arg(device, L("JoypadToOBS.Common.ButtonNumber").arg(entry.button));
 }
 
+QString layer_to_text(const std::vector<JoypadLayer> &layers, int layer)
+{
+	if (layer <= 0) {
+		return L("JoypadToOBS.Layer.Base");
+	}
+	if (layer <= (int)layers.size() && !layers[layer - 1].name.empty()) {
+		return QString::fromStdString(layers[layer - 1].name);
+	}
+	return L("JoypadToOBS.Layer.Number").arg(layer);
+}
+
 QString add_listen_button_text()
 {
 	return QStringLiteral("+ %1").arg(L("JoypadToOBS.Common.Listen"));
@@ -362,62 +411,9 @@ std::vector<std::string> get_scene_names()
 	return names;
 }
 
-std::vector<std::string> get_source_names()
+std::vector<JoypadCatalogSource> get_sources_for_action(const JoypadSourceCatalog *catalog, JoypadActionType action)
 {
-	std::vector<std::string> names;
-	obs_enum_sources(
-		[](void *data, obs_source_t *source) {
-			if (!source) {
-				return true;
-			}
-			auto *list = static_cast<std::vector<std::string> *>(data);
-			const char *name = obs_source_get_name(source);
-			if (name && *name) {
-				list->emplace_back(name);
-			}
-			return true;
-		},
-		&names);
-
-	std::sort(names.begin(), names.end());
-	names.erase(std::unique(names.begin(), names.end()), names.end());
-	return names;
-}
-
-struct SourceItem {
-	std::string name;
-	std::string type_id;
-	bool has_audio = false;
-	bool has_video = false;
-	bool is_media = false;
-};
-
-std::vector<SourceItem> get_sources_for_action(JoypadActionType action)
-{
-	std::vector<SourceItem> items;
-	obs_enum_sources(
-		[](void *data, obs_source_t *source) {
-			if (!source) {
-				return true;
-			}
-			auto *list = static_cast<std::vector<SourceItem> *>(data);
-			const char *name = obs_source_get_name(source);
-			const char *type_id = obs_source_get_id(source);
-			if (!name || !*name) {
-				return true;
-			}
-
-			SourceItem item;
-			item.name = name;
-			item.type_id = type_id ? type_id : "";
-			const uint32_t output_flags = obs_source_get_output_flags(source);
-			item.has_audio = (output_flags & OBS_SOURCE_AUDIO) != 0;
-			item.has_video = (output_flags & OBS_SOURCE_VIDEO) != 0;
-			item.is_media = obs_source_media_get_state(source) != OBS_MEDIA_STATE_NONE;
-			list->push_back(item);
-			return true;
-		},
-		&items);
+	std::vector<JoypadCatalogSource> items = catalog->GetSources();
 
 	auto is_audio_action =
 		(action == JoypadActionType::ToggleSourceMute) || (action == JoypadActionType::SetSourceMute) ||
@@ -427,146 +423,55 @@ std::vector<SourceItem> get_sources_for_action(JoypadActionType action)
 			       (action == JoypadActionType::MediaRestart) || (action == JoypadActionType::MediaStop);
 	auto is_screenshot_source_action = (action == JoypadActionType::Screenshot);
 
-	items.erase(
-		std::remove_if(items.begin(), items.end(),
-			       [is_audio_action, is_media_action, is_screenshot_source_action](const SourceItem &item) {
-				       if (is_media_action) {
-					       return !item.is_media;
-				       }
-				       if (is_audio_action) {
-					       return !item.has_audio;
-				       }
-				       if (is_screenshot_source_action) {
-					       return !item.has_video;
-				       }
-				       return false;
-			       }),
-		items.end());
-
-	std::sort(items.begin(), items.end(), [](const SourceItem &a, const SourceItem &b) { return a.name < b.name; });
-	items.erase(std::unique(items.begin(), items.end(),
-				[](const SourceItem &a, const SourceItem &b) { return a.name == b.name; }),
+	items.erase(std::remove_if(items.begin(), items.end(),
+				   [is_audio_action, is_media_action,
+				    is_screenshot_source_action](const JoypadCatalogSource &item) {
+					   if (is_media_action) {
+						   return !item.is_media;
+					   }
+					   if (is_audio_action) {
+						   return !item.has_audio;
+					   }
+					   if (is_screenshot_source_action) {
+						   return !item.has_video;
+					   }
+					   return false;
+				   }),
 		    items.end());
 
 	return items;
 }
 
-std::vector<std::string> get_filter_names_for_source(const std::string &source_name)
+// Brings combo in line with names (sorted, item data == text) by inserting and removing only the
+// items that differ, so the current item, an open popup and the completer stay put.
+void sync_sorted_combo(QComboBox *combo, const std::vector<std::string> &names)
 {
-	std::vector<std::string> names;
-	if (source_name.empty()) {
-		return names;
-	}
-	obs_source_t *source = obs_get_source_by_name(source_name.c_str());
-	if (!source) {
-		return names;
-	}
-	obs_source_enum_filters(
-		source,
-		[](obs_source_t *parent, obs_source_t *filter, void *data) {
-			(void)parent;
-			if (!filter) {
-				return;
-			}
-			auto *list = static_cast<std::vector<std::string> *>(data);
-			const char *name = obs_source_get_name(filter);
-			if (name && *name) {
-				list->emplace_back(name);
-			}
-		},
-		&names);
-	obs_source_release(source);
-	return names;
-}
-
-struct FilterPropertyListItem {
-	std::string name;
-	std::string string_value;
-	long long int_value = 0;
-	double float_value = 0.0;
-};
-
-struct FilterPropertyInfo {
-	std::string name;
-	std::string description;
-	obs_property_type type = OBS_PROPERTY_INVALID;
-	double min_value = 0.0;
-	double max_value = 1.0;
-	obs_combo_format list_format = OBS_COMBO_FORMAT_INVALID;
-	std::vector<FilterPropertyListItem> list_items;
-};
-
-std::vector<FilterPropertyInfo> get_filter_properties_for_source_filter(const std::string &source_name,
-									const std::string &filter_name)
-{
-	std::vector<FilterPropertyInfo> infos;
-	if (source_name.empty() || filter_name.empty()) {
-		return infos;
-	}
-
-	obs_source_t *source = obs_get_source_by_name(source_name.c_str());
-	if (!source) {
-		return infos;
-	}
-	obs_source_t *filter = obs_source_get_filter_by_name(source, filter_name.c_str());
-	obs_source_release(source);
-	if (!filter) {
-		return infos;
-	}
-
-	obs_properties_t *props = obs_source_properties(filter);
-	obs_source_release(filter);
-	if (!props) {
-		return infos;
-	}
-
-	for (obs_property_t *prop = obs_properties_first(props); prop; obs_property_next(&prop)) {
-		const obs_property_type type = obs_property_get_type(prop);
-		if (type != OBS_PROPERTY_BOOL && type != OBS_PROPERTY_INT && type != OBS_PROPERTY_FLOAT &&
-		    type != OBS_PROPERTY_LIST) {
+	int row = 0;
+	size_t next = 0;
+	while (row < combo->count() || next < names.size()) {
+		if (next == names.size()) {
+			combo->removeItem(row);
 			continue;
 		}
-
-		FilterPropertyInfo info;
-		const char *name = obs_property_name(prop);
-		const char *desc = obs_property_description(prop);
-		if (!name || !*name) {
+		const QString name = QString::fromStdString(names[next]);
+		if (row == combo->count()) {
+			combo->addItem(name, name);
+			++row;
+			++next;
 			continue;
 		}
-		info.name = name;
-		info.description = (desc && *desc) ? desc : name;
-		info.type = type;
-
-		if (type == OBS_PROPERTY_INT) {
-			info.min_value = (double)obs_property_int_min(prop);
-			info.max_value = (double)obs_property_int_max(prop);
-		} else if (type == OBS_PROPERTY_FLOAT) {
-			info.min_value = obs_property_float_min(prop);
-			info.max_value = obs_property_float_max(prop);
-		} else if (type == OBS_PROPERTY_LIST) {
-			info.list_format = obs_property_list_format(prop);
-			const size_t count = obs_property_list_item_count(prop);
-			for (size_t i = 0; i < count; ++i) {
-				FilterPropertyListItem item;
-				const char *item_name = obs_property_list_item_name(prop, i);
-				item.name = (item_name && *item_name) ? item_name : "";
-				if (info.list_format == OBS_COMBO_FORMAT_INT) {
-					item.int_value = obs_property_list_item_int(prop, i);
-				} else if (info.list_format == OBS_COMBO_FORMAT_FLOAT) {
-					item.float_value = obs_property_list_item_float(prop, i);
-				} else {
-					const char *item_value = obs_property_list_item_string(prop, i);
-					item.string_value = (item_value && *item_value) ? item_value : "";
-				}
-				info.list_items.push_back(item);
-			}
+		const std::string current = combo->itemData(row).toString().toStdString();
+		if (current == names[next]) {
+			++row;
+			++next;
+		} else if (current < names[next]) {
+			combo->removeItem(row);
+		} else {
+			combo->insertItem(row, name, name);
+			++row;
+			++next;
 		}
-
-		infos.push_back(std::move(info));
 	}
-
-	obs_properties_destroy(props);
-	return infos;
 }
 
 QString input_label_from_event(const JoypadEvent &event)
@@ -594,7 +499,8 @@ QString input_label_from_binding(const JoypadBinding &binding)
 		for (const auto &entry : binding.button_combo) {
 			parts.push_back(combo_entry_to_text(entry));
 		}
-		return parts.join(QStringLiteral(" + "));
+		return parts.join(binding.combo_mode == JoypadComboMode::Sequence ? QStringLiteral(", ")
+										  : QStringLiteral(" + "));
 	}
 	return L("JoypadToOBS.Common.ButtonNumber").arg(binding.button);
 }
@@ -638,10 +544,11 @@ double map_axis_raw_to_range_for_test(const JoypadBinding &binding, double raw,
 class JoypadBindingDialog : public QDialog {
 public:
 	JoypadBindingDialog(QWidget *parent, JoypadConfigStore *config, JoypadInputManager *input,
-			    const JoypadBinding *existing = nullptr)
+			    JoypadSourceCatalog *catalog, const JoypadBinding *existing = nullptr)
 		: QDialog(parent),
 		  config_(config),
 		  input_(input),
+		  catalog_(catalog),
 		  existing_(existing)
 	{
 		g_binding_dialog_open_count.fetch_add(1, std::memory_order_relaxed);
@@ -751,8 +658,73 @@ public:
 		device_layout->addWidget(axis_max_label_, 10, 0);
 		device_layout->addWidget(axis_set_max_button_, 10, 1);
 
+		combo_mode_label_ = new QLabel(L("JoypadToOBS.Field.ComboMode"), device_group);
+		combo_mode_combo_ = new QComboBox(device_group);
+		combo_mode_combo_->addItem(L("JoypadToOBS.ComboMode.Chord"), (int)JoypadComboMode::Chord);
+		combo_mode_combo_->addItem(L("JoypadToOBS.ComboMode.Ordered"), (int)JoypadComboMode::Ordered);
+		combo_mode_combo_->addItem(L("JoypadToOBS.ComboMode.Sequence"), (int)JoypadComboMode::Sequence);
+		combo_trigger_label_ = new QLabel(L("JoypadToOBS.Field.ComboTrigger"), device_group);
+		combo_trigger_combo_ = new QComboBox(device_group);
+		combo_trigger_combo_->addItem(L("JoypadToOBS.ComboTrigger.Press"), (int)JoypadComboTrigger::Press);
+		combo_trigger_combo_->addItem(L("JoypadToOBS.ComboTrigger.Release"), (int)JoypadComboTrigger::Release);
+		combo_window_label_ = new QLabel(L("JoypadToOBS.Field.ComboWindow"), device_group);
+		combo_window_spin_ = new QSpinBox(device_group);
+		combo_window_spin_->setRange(50, 5000);
+		combo_window_spin_->setSingleStep(50);
+		combo_window_spin_->setValue(500);
+		combo_window_spin_->setSuffix(" ms");
+		combo_window_spin_->setEnabled(false);
+		connect(combo_mode_combo_, &QComboBox::currentIndexChanged, this, [this]() {
+			combo_window_spin_->setEnabled(CurrentComboMode() != JoypadComboMode::Chord);
+			combo_trigger_combo_->setEnabled(CurrentComboMode() != JoypadComboMode::Sequence);
+		});
+		device_layout->addWidget(combo_mode_label_, 11, 0);
+		device_layout->addWidget(combo_mode_combo_, 11, 1, 1, 2);
+		device_layout->addWidget(combo_trigger_label_, 12, 0);
+		device_layout->addWidget(combo_trigger_combo_, 12, 1, 1, 2);
+		device_layout->addWidget(combo_window_label_, 13, 0);
+		device_layout->addWidget(combo_window_spin_, 13, 1, 1, 2);
+
+		layer_combo_ = new QComboBox(device_group);
+		const auto layers = config_->GetProfileLayers(config_->GetCurrentProfileIndex());
+		for (int i = 0; i <= (int)layers.size(); ++i) {
+			layer_combo_->addItem(layer_to_text(layers, i), i);
+		}
+		device_layout->addWidget(new QLabel(L("JoypadToOBS.Field.Layer"), device_group), 14, 0);
+		device_layout->addWidget(layer_combo_, 14, 1, 1, 2);
+
 		layout->addWidget(device_group);
 
+		auto *condition_group = new QGroupBox(L("JoypadToOBS.Group.Conditions"));
+		condition_group->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Maximum);
+		auto *condition_layout = new QGridLayout(condition_group);
+		condition_layout->setContentsMargins(8, 8, 8, 8);
+		condition_layout->setHorizontalSpacing(6);
+		condition_layout->setVerticalSpacing(4);
+		for (int i = 0; i < kConditionFlagCount; ++i) {
+			auto *combo = new QComboBox(condition_group);
+			combo->addItem(L("JoypadToOBS.Condition.Any"), kConditionAny);
+			combo->addItem(L("JoypadToOBS.Condition.Yes"), kConditionRequired);
+			combo->addItem(L("JoypadToOBS.Condition.No"), kConditionForbidden);
+			condition_combos_[i] = combo;
+			// Two columns of label + combo.
+			const int row = i / 2;
+			const int column = (i % 2) * 2;
+			condition_layout->addWidget(new QLabel(L(kConditionFlags[i].label_key), condition_group), row,
+						    column);
+			condition_layout->addWidget(combo, row, column + 1);
+		}
+		condition_scene_combo_ = new QComboBox(condition_group);
+		condition_scene_combo_->addItem(L("JoypadToOBS.Condition.AnyScene"), QString());
+		for (const auto &name : get_scene_names()) {
+			condition_scene_combo_->addItem(QString::fromStdString(name), QString::fromStdString(name));
+		}
+		const int scene_row = (kConditionFlagCount + 1) / 2;
+		condition_layout->addWidget(new QLabel(L("JoypadToOBS.Condition.Scene"), condition_group), scene_row,
+					    0);
+		condition_layout->addWidget(condition_scene_combo_, scene_row, 1, 1, 3);
+		layout->addWidget(condition_group);
+
 		auto *target_group = new QGroupBox(L("JoypadToOBS.Group.Target"));
 		target_group->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Maximum);
 		auto *target_layout = new QGridLayout(target_group);
@@ -763,6 +735,18 @@ public:
 		use_current_scene_ = new QCheckBox(L("JoypadToOBS.Field.UseCurrentScene"), target_group);
 		scene_combo_ = new QComboBox(target_group);
 		source_combo_ = new QComboBox(target_group);
+		// Type-ahead: typing narrows the list to sources containing the text.
+		source_combo_->setEditable(true);
+		source_combo_->setInsertPolicy(QComboBox::NoInsert);
+		source_combo_->completer()->setCompletionMode(QCompleter::PopupCompletion);
+		source_combo_->completer()->setFilterMode(Qt::MatchContains);
+		source_combo_->completer()->setCaseSensitivity(Qt::CaseInsensitive);
+		connect(source_combo_->lineEdit(), &QLineEdit::editingFinished, this, [this]() {
+			// Text that names no source falls back to the selected one.
+			if (source_combo_->findText(source_combo_->currentText()) < 0) {
+				source_combo_->setEditText(source_combo_->itemText(source_combo_->currentIndex()));
+			}
+		});
 		filter_combo_ = new QComboBox(target_group);
 		filter_property_combo_ = new QComboBox(target_group);
 
@@ -1046,7 +1030,8 @@ public:
 								" " +
 								L("JoypadToOBS.Common.DbValue").arg(db, 0, 'f', 1));
 						} else if (CurrentAction() == JoypadActionType::SetFilterProperty) {
-							const FilterPropertyInfo *info = CurrentFilterPropertyInfo();
+							const JoypadFilterPropertyInfo *info =
+								CurrentFilterPropertyInfo();
 							if (info && (info->type == OBS_PROPERTY_INT ||
 								     info->type == OBS_PROPERTY_FLOAT)) {
 								double mapped = map_axis_raw_to_range_for_test(
@@ -1084,6 +1069,19 @@ public:
 
 		ReloadTargets();
 		ReloadFilters();
+		catalog_handler_id_ = catalog_->AddOnChanged([this]() {
+			if (catalog_refresh_pending_.exchange(true)) {
+				return;
+			}
+			QMetaObject::invokeMethod(
+				this,
+				[this]() {
+					catalog_refresh_pending_ = false;
+					ReloadSourcesForAction(CurrentAction());
+					ReloadFiltersIfChanged();
+				},
+				Qt::QueuedConnection);
+		});
 		if (existing) {
 			ApplyBinding(*existing);
 		} else {
@@ -1108,6 +1106,7 @@ public:
 				axis_handler_id_ = 0;
 			}
 		}
+		catalog_->RemoveOnChanged(catalog_handler_id_);
 		g_binding_dialog_open_count.fetch_sub(1, std::memory_order_relaxed);
 	}
 
@@ -1230,7 +1229,7 @@ private:
 	{
 		bool hide_axis_options = (CurrentAction() == JoypadActionType::SetSourceVolumePercent);
 		if (CurrentAction() == JoypadActionType::SetFilterProperty) {
-			const FilterPropertyInfo *info = CurrentFilterPropertyInfo();
+			const JoypadFilterPropertyInfo *info = CurrentFilterPropertyInfo();
 			if (info && (info->type == OBS_PROPERTY_INT || info->type == OBS_PROPERTY_FLOAT)) {
 				hide_axis_options = true;
 			}
@@ -1266,6 +1265,12 @@ private:
 		button_combo_frame_->setVisible(!visible);
 		button_combo_list_->setVisible(!visible);
 		clear_combo_button_->setVisible(!visible);
+		combo_mode_label_->setVisible(!visible);
+		combo_mode_combo_->setVisible(!visible);
+		combo_trigger_label_->setVisible(!visible);
+		combo_trigger_combo_->setVisible(!visible);
+		combo_window_label_->setVisible(!visible);
+		combo_window_spin_->setVisible(!visible);
 		if (QLayout *lyt = layout()) {
 			lyt->activate();
 		}
@@ -1346,6 +1351,28 @@ private:
 			entry.button = binding_.button;
 			binding_.button_combo.push_back(std::move(entry));
 		}
+		combo_mode_combo_->setCurrentIndex(std::max(0, combo_mode_combo_->findData((int)binding.combo_mode)));
+		combo_trigger_combo_->setCurrentIndex(
+			std::max(0, combo_trigger_combo_->findData((int)binding.combo_trigger)));
+		combo_window_spin_->setValue(binding.combo_window_ms);
+		if (layer_combo_->findData(binding.layer) < 0) {
+			// The layer was removed from the profile; keep the binding where it is.
+			layer_combo_->addItem(L("JoypadToOBS.Layer.Number").arg(binding.layer), binding.layer);
+		}
+		layer_combo_->setCurrentIndex(layer_combo_->findData(binding.layer));
+		for (int i = 0; i < kConditionFlagCount; ++i) {
+			const uint32_t flag = kConditionFlags[i].flag;
+			const int value = (binding.require_state & flag)  ? kConditionRequired
+					  : (binding.forbid_state & flag) ? kConditionForbidden
+									  : kConditionAny;
+			condition_combos_[i]->setCurrentIndex(condition_combos_[i]->findData(value));
+		}
+		const QString condition_scene = QString::fromStdString(binding.condition_scene);
+		if (condition_scene_combo_->findData(condition_scene) < 0) {
+			// The scene may belong to another scene collection.
+			condition_scene_combo_->addItem(condition_scene, condition_scene);
+		}
+		condition_scene_combo_->setCurrentIndex(condition_scene_combo_->findData(condition_scene));
 		learned_event_.button = binding.button;
 		learned_event_.is_axis = (binding.input_type == JoypadInputType::Axis);
 		learned_event_.axis_index = binding.axis_index;
@@ -1467,16 +1494,20 @@ private:
 	void ReloadSourcesForAction(JoypadActionType action)
 	{
 		auto previous = source_combo_->currentData().toString();
+		if (previous.isEmpty()) {
+			// The catalog may still be filling in; keep the edited binding's source selectable.
+			previous = QString::fromStdString(binding_.source_name);
+		}
 		QSignalBlocker blocker(*source_combo_);
-		source_combo_->clear();
 
-		auto sources = get_sources_for_action(action);
-		for (const auto &item : sources) {
-			source_combo_->addItem(QString::fromStdString(item.name), QString::fromStdString(item.name));
+		std::vector<std::string> names;
+		for (const auto &item : get_sources_for_action(catalog_, action)) {
+			names.push_back(item.name);
 		}
+		sync_sorted_combo(source_combo_, names);
 
 		int idx = source_combo_->findData(previous);
-		if (idx >= 0) {
+		if (idx >= 0 && idx != source_combo_->currentIndex()) {
 			source_combo_->setCurrentIndex(idx);
 		}
 	}
@@ -1486,7 +1517,7 @@ private:
 		auto previous = filter_combo_->currentText();
 		QSignalBlocker blocker(*filter_combo_);
 		filter_combo_->clear();
-		auto names = get_filter_names_for_source(source_combo_->currentData().toString().toStdString());
+		auto names = catalog_->GetFilterNames(source_combo_->currentData().toString().toStdString());
 		for (const auto &name : names) {
 			filter_combo_->addItem(QString::fromStdString(name));
 		}
@@ -1497,7 +1528,20 @@ private:
 		ReloadFilterProperties();
 	}
 
-	const FilterPropertyInfo *CurrentFilterPropertyInfo() const
+	// Reloads the filter list only when the catalog reports a different one for the source.
+	void ReloadFiltersIfChanged()
+	{
+		const auto names = catalog_->GetFilterNames(source_combo_->currentData().toString().toStdString());
+		bool changed = filter_combo_->count() != (int)names.size();
+		for (int i = 0; !changed && i < filter_combo_->count(); ++i) {
+			changed = filter_combo_->itemText(i) != QString::fromStdString(names[(size_t)i]);
+		}
+		if (changed) {
+			ReloadFilters();
+		}
+	}
+
+	const JoypadFilterPropertyInfo *CurrentFilterPropertyInfo() const
 	{
 		const QString selected = filter_property_combo_->currentData().toString();
 		if (selected.isEmpty()) {
@@ -1511,7 +1555,7 @@ private:
 		return nullptr;
 	}
 
-	bool ReadCurrentFilterPropertyValue(const FilterPropertyInfo &info, bool &bool_value_out,
+	bool ReadCurrentFilterPropertyValue(const JoypadFilterPropertyInfo &info, bool &bool_value_out,
 					    double &number_value_out, int &list_index_out) const
 	{
 		bool_value_out = false;
@@ -1592,9 +1636,8 @@ private:
 			return;
 		}
 
-		filter_properties_ =
-			get_filter_properties_for_source_filter(source_combo_->currentData().toString().toStdString(),
-								filter_combo_->currentText().toStdString());
+		filter_properties_ = catalog_->GetFilterProperties(source_combo_->currentData().toString().toStdString(),
+								   filter_combo_->currentText().toStdString());
 		for (const auto &info : filter_properties_) {
 			if (CurrentAction() == JoypadActionType::AdjustFilterProperty &&
 			    !(info.type == OBS_PROPERTY_INT || info.type == OBS_PROPERTY_FLOAT)) {
@@ -1685,7 +1728,7 @@ private:
 					(action == JoypadActionType::AdjustSourceVolume);
 
 		if (action == JoypadActionType::SetFilterProperty || action == JoypadActionType::AdjustFilterProperty) {
-			const FilterPropertyInfo *info = CurrentFilterPropertyInfo();
+			const JoypadFilterPropertyInfo *info = CurrentFilterPropertyInfo();
 			if (info) {
 				bool current_bool = false;
 				double current_number = 0.0;
@@ -1783,7 +1826,7 @@ private:
 				volume_spin_->setValue(1.0);
 			}
 		} else if (action == JoypadActionType::SetFilterProperty) {
-			const FilterPropertyInfo *info = CurrentFilterPropertyInfo();
+			const JoypadFilterPropertyInfo *info = CurrentFilterPropertyInfo();
 			if (info && (info->type == OBS_PROPERTY_INT || info->type == OBS_PROPERTY_FLOAT)) {
 				bool current_bool = false;
 				double current_number = 0.0;
@@ -1810,7 +1853,7 @@ private:
 				}
 			}
 		} else if (action == JoypadActionType::AdjustFilterProperty) {
-			const FilterPropertyInfo *info = CurrentFilterPropertyInfo();
+			const JoypadFilterPropertyInfo *info = CurrentFilterPropertyInfo();
 			if (info && (info->type == OBS_PROPERTY_INT || info->type == OBS_PROPERTY_FLOAT)) {
 				volume_spin_->setRange(-1000000.0, 1000000.0);
 				if (info->type == OBS_PROPERTY_INT) {
@@ -1951,7 +1994,8 @@ private:
 								" " +
 								L("JoypadToOBS.Common.DbValue").arg(db, 0, 'f', 1));
 						} else if (CurrentAction() == JoypadActionType::SetFilterProperty) {
-							const FilterPropertyInfo *info = CurrentFilterPropertyInfo();
+							const JoypadFilterPropertyInfo *info =
+								CurrentFilterPropertyInfo();
 							if (info && (info->type == OBS_PROPERTY_INT ||
 								     info->type == OBS_PROPERTY_FLOAT)) {
 								double mapped = map_axis_raw_to_range_for_test(
@@ -1989,7 +2033,8 @@ private:
 								break;
 							}
 						}
-						if (!exists) {
+						// Sequences may repeat a button, e.g. Up, Up, A.
+						if (!exists || CurrentComboMode() == JoypadComboMode::Sequence) {
 							JoypadButtonComboEntry entry;
 							entry.device_id = event.device_id;
 							entry.device_stable_id = event.device_stable_id;
@@ -2102,6 +2147,13 @@ private:
 				binding_.device_name = device_combo_->currentText().toStdString();
 			}
 			binding_.input_type = JoypadInputType::Button;
+			binding_.combo_mode = CurrentComboMode();
+			binding_.combo_trigger = (JoypadComboTrigger)combo_trigger_combo_->currentData().toInt();
+			if (binding_.combo_mode == JoypadComboMode::Sequence) {
+				// Sequences fire on the press of their last button.
+				binding_.combo_trigger = JoypadComboTrigger::Press;
+			}
+			binding_.combo_window_ms = combo_window_spin_->value();
 			binding_.axis_index = -1;
 			binding_.axis_inverted = false;
 			binding_.axis_threshold = 0.10;
@@ -2109,6 +2161,18 @@ private:
 			binding_.axis_max_per_second = 20.0;
 		}
 
+		binding_.layer = layer_combo_->currentData().toInt();
+		binding_.require_state = 0;
+		binding_.forbid_state = 0;
+		for (int i = 0; i < kConditionFlagCount; ++i) {
+			const int value = condition_combos_[i]->currentData().toInt();
+			if (value == kConditionRequired) {
+				binding_.require_state |= kConditionFlags[i].flag;
+			} else if (value == kConditionForbidden) {
+				binding_.forbid_state |= kConditionFlags[i].flag;
+			}
+		}
+		binding_.condition_scene = condition_scene_combo_->currentData().toString().toStdString();
 		binding_.action = CurrentAction();
 		binding_.use_current_scene = use_current_scene_->isChecked();
 		binding_.scene_name = scene_combo_->currentText().toStdString();
@@ -2134,7 +2198,7 @@ private:
 		}
 		if (binding_.action == JoypadActionType::SetFilterProperty ||
 		    binding_.action == JoypadActionType::AdjustFilterProperty) {
-			const FilterPropertyInfo *info = CurrentFilterPropertyInfo();
+			const JoypadFilterPropertyInfo *info = CurrentFilterPropertyInfo();
 			if (!info) {
 				button_label_->setText(L("JoypadToOBS.Common.NoFilterPropertySelected"));
 				return false;
@@ -2271,6 +2335,7 @@ private:
 	}
 
 	JoypadActionType CurrentAction() const { return (JoypadActionType)action_combo_->currentData().toInt(); }
+	JoypadComboMode CurrentComboMode() const { return (JoypadComboMode)combo_mode_combo_->currentData().toInt(); }
 	JoypadScreenshotTarget CurrentScreenshotTarget() const
 	{
 		return (JoypadScreenshotTarget)screenshot_target_combo_->currentData().toInt();
@@ -2278,6 +2343,9 @@ private:
 
 	JoypadConfigStore *config_ = nullptr;
 	JoypadInputManager *input_ = nullptr;
+	JoypadSourceCatalog *catalog_ = nullptr;
+	int catalog_handler_id_ = 0;
+	std::atomic<bool> catalog_refresh_pending_{false};
 	const JoypadBinding *existing_ = nullptr;
 	JoypadBinding binding_;
 	JoypadEvent learned_event_;
@@ -2288,6 +2356,15 @@ private:
 	QPushButton *listen_button_ = nullptr;
 	QFrame *button_combo_frame_ = nullptr;
 	QListWidget *button_combo_list_ = nullptr;
+	QLabel *combo_mode_label_ = nullptr;
+	QComboBox *combo_mode_combo_ = nullptr;
+	QLabel *combo_trigger_label_ = nullptr;
+	QComboBox *combo_trigger_combo_ = nullptr;
+	QLabel *combo_window_label_ = nullptr;
+	QSpinBox *combo_window_spin_ = nullptr;
+	QComboBox *layer_combo_ = nullptr;
+	QComboBox *condition_combos_[kConditionFlagCount] = {};
+	QComboBox *condition_scene_combo_ = nullptr;
 	QPushButton *clear_combo_button_ = nullptr;
 	QLabel *device_hint_label_ = nullptr;
 	QLabel *axis_value_label_ = nullptr;
@@ -2329,11 +2406,196 @@ private:
 	int axis_handler_id_ = 0;
 	bool is_listening_ = false;
 	bool updating_action_ui_ = false;
-	std::vector<FilterPropertyInfo> filter_properties_;
+	std::vector<JoypadFilterPropertyInfo> filter_properties_;
+};
+
+// Edits the layers of one profile. Removing a layer renumbers the bindings of the layers
+// after it and deletes its own bindings, all applied on accept.
+class JoypadLayersDialog : public QDialog {
+public:
+	JoypadLayersDialog(QWidget *parent, JoypadConfigStore *config, JoypadInputManager *input)
+		: QDialog(parent),
+		  config_(config),
+		  input_(input),
+		  profile_index_(config->GetCurrentProfileIndex()),
+		  layers_(config->GetProfileLayers(profile_index_))
+	{
+		for (size_t i = 0; i < layers_.size(); ++i) {
+			origins_.push_back((int)i + 1);
+		}
+		setWindowTitle(L("JoypadToOBS.Dialog.Layers"));
+		auto *layout = new QVBoxLayout(this);
+		auto *description = new QLabel(L("JoypadToOBS.Layer.Description"), this);
+		description->setWordWrap(true);
+		layout->addWidget(description);
+		list_ = new QListWidget(this);
+		layout->addWidget(list_);
+		status_label_ = new QLabel(this);
+		layout->addWidget(status_label_);
+
+		auto *row = new QHBoxLayout();
+		auto *add_button = new QPushButton(L("JoypadToOBS.Layer.Add"), this);
+		auto *modifier_button = new QPushButton(L("JoypadToOBS.Layer.SetModifier"), this);
+		auto *rename_button = new QPushButton(L("JoypadToOBS.Layer.Rename"), this);
+		auto *remove_button = new QPushButton(L("JoypadToOBS.Layer.Remove"), this);
+		row->addWidget(add_button);
+		row->addWidget(modifier_button);
+		row->addWidget(rename_button);
+		row->addWidget(remove_button);
+		row->addStretch();
+		layout->addLayout(row);
+
+		auto *buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, this);
+		layout->addWidget(buttons);
+		connect(buttons, &QDialogButtonBox::accepted, this, &JoypadLayersDialog::Apply);
+		connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+
+		connect(add_button, &QPushButton::clicked, this, [this]() {
+			bool ok = false;
+			const QString suggested = L("JoypadToOBS.Layer.Number").arg(layers_.size() + 1);
+			const QString name = QInputDialog::getText(this, L("JoypadToOBS.Dialog.Layers"),
+								   L("JoypadToOBS.Layer.NewName"), QLineEdit::Normal,
+								   suggested, &ok);
+			if (!ok) {
+				return;
+			}
+			JoypadLayer layer;
+			layer.name = name.trimmed().toStdString();
+			layers_.push_back(std::move(layer));
+			origins_.push_back(0);
+			RefreshList((int)layers_.size() - 1);
+			ListenForModifier();
+		});
+		connect(modifier_button, &QPushButton::clicked, this, [this]() { ListenForModifier(); });
+		connect(rename_button, &QPushButton::clicked, this, [this]() {
+			const int row = list_->currentRow();
+			if (row < 0 || row >= (int)layers_.size()) {
+				return;
+			}
+			bool ok = false;
+			const QString name = QInputDialog::getText(this, L("JoypadToOBS.Dialog.Layers"),
+								   L("JoypadToOBS.Layer.NewName"), QLineEdit::Normal,
+								   QString::fromStdString(layers_[row].name), &ok);
+			if (ok) {
+				layers_[row].name = name.trimmed().toStdString();
+				RefreshList(row);
+			}
+		});
+		connect(remove_button, &QPushButton::clicked, this, [this]() {
+			const int row = list_->currentRow();
+			if (row < 0 || row >= (int)layers_.size()) {
+				return;
+			}
+			const int bound = CountBindings(origins_[row]);
+			if (bound > 0 && QMessageBox::question(this, L("JoypadToOBS.Dialog.Layers"),
+							       L("JoypadToOBS.Layer.ConfirmRemove").arg(bound)) !=
+						 QMessageBox::Yes) {
+				return;
+			}
+			layers_.erase(layers_.begin() + row);
+			origins_.erase(origins_.begin() + row);
+			RefreshList(std::min(row, (int)layers_.size() - 1));
+		});
+
+		RefreshList(0);
+		resize(460, 320);
+	}
+
+	~JoypadLayersDialog() override
+	{
+		if (input_ && listening_) {
+			input_->CancelLearn();
+		}
+	}
+
+private:
+	void RefreshList(int select)
+	{
+		list_->clear();
+		for (const auto &layer : layers_) {
+			const QString modifier = layer.modifier.button > 0 ? combo_entry_to_text(layer.modifier)
+									   : L("JoypadToOBS.Common.NoButtonSelected");
+			list_->addItem(QStringLiteral("%1 \u2014 %2")
+					       .arg(layer.name.empty() ? L("JoypadToOBS.Layer.Unnamed")
+								       : QString::fromStdString(layer.name),
+						    modifier));
+		}
+		if (select >= 0 && select < list_->count()) {
+			list_->setCurrentRow(select);
+		}
+	}
+
+	int CountBindings(int layer) const
+	{
+		if (layer <= 0) {
+			return 0;
+		}
+		int count = 0;
+		for (const auto &binding : config_->GetBindingsSnapshot()) {
+			count += binding.layer == layer ? 1 : 0;
+		}
+		return count;
+	}
+
+	void ListenForModifier()
+	{
+		const int row = list_->currentRow();
+		if (!input_ || row < 0 || row >= (int)layers_.size()) {
+			return;
+		}
+		status_label_->setText(L("JoypadToOBS.Layer.PressModifier"));
+		listening_ = input_->BeginLearn([this, row](const JoypadEvent &event) {
+			QMetaObject::invokeMethod(
+				this,
+				[this, row, event]() {
+					listening_ = false;
+					if (event.is_axis) {
+						ListenForModifier();
+						return;
+					}
+					if (row >= (int)layers_.size()) {
+						return;
+					}
+					JoypadButtonComboEntry &modifier = layers_[row].modifier;
+					modifier.device_id = event.device_id;
+					modifier.device_stable_id = event.device_stable_id;
+					modifier.device_type_id = event.device_type_id;
+					modifier.device_name = event.device_name;
+					modifier.button = event.button;
+					status_label_->clear();
+					RefreshList(row);
+				},
+				Qt::QueuedConnection);
+		});
+		if (!listening_) {
+			status_label_->clear();
+		}
+	}
+
+	void Apply()
+	{
+		// origins_[i] is the layer number layer i had when the dialog opened, 0 if new.
+		config_->SetProfileLayers(profile_index_, layers_, origins_);
+		accept();
+	}
+
+	JoypadConfigStore *config_ = nullptr;
+	JoypadInputManager *input_ = nullptr;
+	int profile_index_ = -1;
+	std::vector<JoypadLayer> layers_;
+	std::vector<int> origins_;
+	QListWidget *list_ = nullptr;
+	QLabel *status_label_ = nullptr;
+	bool listening_ = false;
 };
 
 } // namespace
 
+QString JoypadUiActionText(JoypadActionType action)
+{
+	return action_to_text(action);
+}
+
 bool JoypadUiIsBindingDialogOpen()
 {
 	return g_binding_dialog_open_count.load(std::memory_order_relaxed) > 0;
@@ -2377,7 +2639,7 @@ bool JoypadUiEmulateBindingDialogAction(const JoypadEvent &event, JoypadActionEn
 	JoypadBinding adjusted = binding;
 
 	if (binding.input_type == JoypadInputType::Button) {
-		if (event.is_axis) {
+		if (event.is_axis || event.released != (binding.combo_trigger == JoypadComboTrigger::Release)) {
 			return true;
 		}
 		if (!binding.button_combo.empty()) {
@@ -2471,10 +2733,381 @@ bool JoypadUiEmulateBindingDialogAction(const JoypadEvent &event, JoypadActionEn
 	return true;
 }
 
-JoypadToolsDialog::JoypadToolsDialog(QWidget *parent, JoypadConfigStore *config, JoypadInputManager *input)
+// Backs the bindings table. Rows keep a copy of their binding so Sync() can tell which rows
+// actually changed and only those are repainted; display strings are built once per change.
+class JoypadBindingTableModel : public QAbstractTableModel {
+public:
+	enum Column {
+		kColumnEnabled = 0,
+		kColumnDevice,
+		kColumnInput,
+		kColumnAction,
+		kColumnScene,
+		kColumnSourceFilter,
+		kColumnDetails,
+		kColumnEdit,
+		kColumnDelete,
+		kColumnCount
+	};
+
+	JoypadBindingTableModel(QObject *parent, JoypadConfigStore *config)
+		: QAbstractTableModel(parent),
+		  config_(config),
+		  headers_({L("JoypadToOBS.Table.Enabled"), L("JoypadToOBS.Table.Device"),
+			    L("JoypadToOBS.Table.Input"), L("JoypadToOBS.Table.Action"), L("JoypadToOBS.Table.Scene"),
+			    L("JoypadToOBS.Table.SourceFilter"), L("JoypadToOBS.Table.Details"),
+			    L("JoypadToOBS.Table.Edit"), L("JoypadToOBS.Table.Delete")})
+	{
+	}
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override
+	{
+		return parent.isValid() ? 0 : (int)rows_.size();
+	}
+
+	int columnCount(const QModelIndex &parent = QModelIndex()) const override
+	{
+		return parent.isValid() ? 0 : kColumnCount;
+	}
+
+	QVariant data(const QModelIndex &index, int role) const override
+	{
+		if (!index.isValid() || index.row() >= (int)rows_.size()) {
+			return QVariant();
+		}
+		const Row &row = rows_[(size_t)index.row()];
+		if (role == kBindingUidRole) {
+			return (qlonglong)row.binding.uid;
+		}
+		if (role == Qt::CheckStateRole && index.column() == kColumnEnabled) {
+			return row.binding.enabled ? Qt::Checked : Qt::Unchecked;
+		}
+		if (role != Qt::DisplayRole) {
+			return QVariant();
+		}
+		switch (index.column()) {
+		case kColumnDevice:
+			return row.device;
+		case kColumnInput:
+			return row.input;
+		case kColumnAction:
+			return row.action;
+		case kColumnScene:
+			return row.scene;
+		case kColumnSourceFilter:
+			return row.source_filter;
+		case kColumnDetails:
+			return row.details;
+		case kColumnEdit:
+			return L("JoypadToOBS.Button.Edit");
+		case kColumnDelete:
+			return L("JoypadToOBS.Button.Delete");
+		default:
+			return QVariant();
+		}
+	}
+
+	QVariant headerData(int section, Qt::Orientation orientation, int role) const override
+	{
+		if (orientation == Qt::Horizontal && role == Qt::DisplayRole && section >= 0 &&
+		    section < headers_.size()) {
+			return headers_[section];
+		}
+		return QAbstractTableModel::headerData(section, orientation, role);
+	}
+
+	Qt::ItemFlags flags(const QModelIndex &index) const override
+	{
+		Qt::ItemFlags result = QAbstractTableModel::flags(index);
+		if (index.isValid() && index.column() == kColumnEnabled) {
+			result |= Qt::ItemIsUserCheckable;
+		}
+		return result;
+	}
+
+	bool setData(const QModelIndex &index, const QVariant &value, int role) override
+	{
+		if (!index.isValid() || index.row() >= (int)rows_.size() || index.column() != kColumnEnabled ||
+		    role != Qt::CheckStateRole) {
+			return false;
+		}
+		Row &row = rows_[(size_t)index.row()];
+		const bool enabled = value.toInt() == Qt::Checked;
+		if (!config_->SetBindingEnabledByUid(row.binding.uid, enabled)) {
+			return false;
+		}
+		row.binding.enabled = enabled;
+		emit dataChanged(index, index, {Qt::CheckStateRole});
+		return true;
+	}
+
+	// Brings the rows in line with bindings. Unchanged rows are left alone, edited rows are
+	// refreshed in place and removals/insertions are reported as such. Returns true when the
+	// model had to be reset instead (first fill, or bindings were reordered).
+	bool Sync(const std::vector<JoypadBinding> &bindings)
+	{
+		if (rows_.empty() || bindings.empty()) {
+			Reset(bindings);
+			return true;
+		}
+
+		std::unordered_set<int64_t> incoming;
+		incoming.reserve(bindings.size());
+		for (const auto &binding : bindings) {
+			incoming.insert(binding.uid);
+		}
+		for (int last = (int)rows_.size() - 1; last >= 0;) {
+			if (incoming.count(rows_[(size_t)last].binding.uid)) {
+				--last;
+				continue;
+			}
+			int first = last;
+			while (first > 0 && !incoming.count(rows_[(size_t)first - 1].binding.uid)) {
+				--first;
+			}
+			beginRemoveRows(QModelIndex(), first, last);
+			rows_.erase(rows_.begin() + first, rows_.begin() + last + 1);
+			endRemoveRows();
+			last = first - 1;
+		}
+
+		std::unordered_set<int64_t> present;
+		present.reserve(rows_.size());
+		for (const auto &row : rows_) {
+			present.insert(row.binding.uid);
+		}
+		for (size_t i = 0; i < bindings.size();) {
+			if (i < rows_.size() && rows_[i].binding.uid == bindings[i].uid) {
+				if (!JoypadBindingsEqual(rows_[i].binding, bindings[i])) {
+					rows_[i] = MakeRow(bindings[i]);
+					emit dataChanged(index((int)i, 0), index((int)i, kColumnCount - 1));
+				}
+				++i;
+				continue;
+			}
+			if (present.count(bindings[i].uid)) {
+				Reset(bindings);
+				return true;
+			}
+			size_t end = i + 1;
+			while (end < bindings.size() && !present.count(bindings[end].uid)) {
+				++end;
+			}
+			beginInsertRows(QModelIndex(), (int)i, (int)end - 1);
+			std::vector<Row> added;
+			added.reserve(end - i);
+			for (size_t j = i; j < end; ++j) {
+				added.push_back(MakeRow(bindings[j]));
+			}
+			rows_.insert(rows_.begin() + (std::ptrdiff_t)i, std::make_move_iterator(added.begin()),
+				     std::make_move_iterator(added.end()));
+			endInsertRows();
+			i = end;
+		}
+		return false;
+	}
+
+private:
+	struct Row {
+		JoypadBinding binding;
+		QString device;
+		QString input;
+		QString action;
+		QString scene;
+		QString source_filter;
+		QString details;
+	};
+
+	void Reset(const std::vector<JoypadBinding> &bindings)
+	{
+		beginResetModel();
+		rows_.clear();
+		rows_.reserve(bindings.size());
+		for (const auto &binding : bindings) {
+			rows_.push_back(MakeRow(binding));
+		}
+		endResetModel();
+	}
+
+	static Row MakeRow(const JoypadBinding &binding)
+	{
+		Row row;
+		row.binding = binding;
+		row.device = device_label_from_binding(binding);
+		row.input = input_label_from_binding(binding);
+		row.action = action_to_text(binding.action);
+		row.details = binding_details(binding);
+
+		switch (binding.action) {
+		case JoypadActionType::SwitchScene:
+			row.scene = QString::fromStdString(binding.scene_name);
+			break;
+		case JoypadActionType::ToggleSourceVisibility:
+		case JoypadActionType::SetSourceVisibility:
+		case JoypadActionType::SourceTransform:
+			row.scene = binding.use_current_scene ? L("JoypadToOBS.Common.Current")
+							      : QString::fromStdString(binding.scene_name);
+			row.source_filter = QString::fromStdString(binding.source_name);
+			break;
+		case JoypadActionType::ToggleSourceMute:
+		case JoypadActionType::SetSourceMute:
+		case JoypadActionType::SetSourceVolume:
+		case JoypadActionType::AdjustSourceVolume:
+		case JoypadActionType::SetSourceVolumePercent:
+		case JoypadActionType::MediaPlayPause:
+		case JoypadActionType::MediaRestart:
+		case JoypadActionType::MediaStop:
+			row.source_filter = QString::fromStdString(binding.source_name);
+			break;
+		case JoypadActionType::ToggleFilterEnabled:
+		case JoypadActionType::SetFilterEnabled:
+			row.source_filter = QString::fromStdString(binding.filter_name);
+			break;
+		case JoypadActionType::SetFilterProperty:
+		case JoypadActionType::AdjustFilterProperty:
+			row.source_filter = QString::fromStdString(binding.filter_name);
+			if (!binding.filter_property_name.empty()) {
+				row.source_filter += " :: " + QString::fromStdString(binding.filter_property_name);
+			}
+			break;
+		case JoypadActionType::Screenshot:
+			if (binding.screenshot_target == JoypadScreenshotTarget::Source) {
+				row.source_filter = QString::fromStdString(binding.source_name);
+			}
+			break;
+		default:
+			break;
+		}
+		return row;
+	}
+
+	JoypadConfigStore *config_ = nullptr;
+	QStringList headers_;
+	std::vector<Row> rows_;
+};
+
+// Paints the enabled checkbox and the Edit/Delete buttons straight into the cells instead of
+// creating a widget per row, and turns clicks on them into model edits or ButtonClicked calls.
+class JoypadBindingTableDelegate : public QStyledItemDelegate {
+public:
+	using ButtonCallback = std::function<void(int64_t uid, int column)>;
+
+	JoypadBindingTableDelegate(QObject *parent, ButtonCallback on_button)
+		: QStyledItemDelegate(parent),
+		  on_button_(std::move(on_button))
+	{
+	}
+
+	void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override
+	{
+		const int column = index.column();
+		if (column != JoypadBindingTableModel::kColumnEnabled && !IsButtonColumn(column)) {
+			QStyledItemDelegate::paint(painter, option, index);
+			return;
+		}
+
+		QStyleOptionViewItem cell = option;
+		initStyleOption(&cell, index);
+		const QString text = cell.text;
+		cell.text.clear();
+		cell.features &= ~QStyleOptionViewItem::HasCheckIndicator;
+		const QWidget *widget = option.widget;
+		QStyle *style = widget ? widget->style() : QApplication::style();
+		style->drawControl(QStyle::CE_ItemViewItem, &cell, painter, widget);
+
+		QStyleOptionButton button;
+		button.state = option.state & QStyle::State_Enabled;
+		if (column == JoypadBindingTableModel::kColumnEnabled) {
+			button.rect = CheckRect(option, style, widget);
+			button.state |= index.data(Qt::CheckStateRole).toInt() == Qt::Checked ? QStyle::State_On
+											       : QStyle::State_Off;
+			style->drawPrimitive(QStyle::PE_IndicatorCheckBox, &button, painter, widget);
+			return;
+		}
+		button.rect = option.rect.adjusted(1, 1, -1, -1);
+		button.text = text;
+		button.state |= pressed_ == index ? QStyle::State_Sunken : QStyle::State_Raised;
+		style->drawControl(QStyle::CE_PushButton, &button, painter, widget);
+	}
+
+	QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override
+	{
+		if (!IsButtonColumn(index.column())) {
+			return QStyledItemDelegate::sizeHint(option, index);
+		}
+		const QWidget *widget = option.widget;
+		QStyle *style = widget ? widget->style() : QApplication::style();
+		QStyleOptionButton button;
+		button.text = index.data(Qt::DisplayRole).toString();
+		const QSize text_size = option.fontMetrics.size(Qt::TextShowMnemonic, button.text);
+		return style->sizeFromContents(QStyle::CT_PushButton, &button, text_size, widget);
+	}
+
+	bool editorEvent(QEvent *event, QAbstractItemModel *model, const QStyleOptionViewItem &option,
+			 const QModelIndex &index) override
+	{
+		const int column = index.column();
+		if (column != JoypadBindingTableModel::kColumnEnabled && !IsButtonColumn(column)) {
+			return QStyledItemDelegate::editorEvent(event, model, option, index);
+		}
+		if (event->type() != QEvent::MouseButtonPress && event->type() != QEvent::MouseButtonRelease &&
+		    event->type() != QEvent::MouseButtonDblClick) {
+			return false;
+		}
+		auto *mouse = static_cast<QMouseEvent *>(event);
+		if (mouse->button() != Qt::LeftButton) {
+			return false;
+		}
+
+		if (column == JoypadBindingTableModel::kColumnEnabled) {
+			const QWidget *widget = option.widget;
+			QStyle *style = widget ? widget->style() : QApplication::style();
+			if (!CheckRect(option, style, widget).contains(mouse->position().toPoint())) {
+				return false;
+			}
+			if (event->type() == QEvent::MouseButtonRelease) {
+				const bool checked = index.data(Qt::CheckStateRole).toInt() == Qt::Checked;
+				model->setData(index, checked ? Qt::Unchecked : Qt::Checked, Qt::CheckStateRole);
+			}
+			return true;
+		}
+
+		if (event->type() != QEvent::MouseButtonRelease) {
+			pressed_ = index;
+			return true;
+		}
+		const bool clicked = pressed_ == index && option.rect.contains(mouse->position().toPoint());
+		pressed_ = QPersistentModelIndex();
+		if (clicked && on_button_) {
+			on_button_(index.data(kBindingUidRole).toLongLong(), column);
+		}
+		return true;
+	}
+
+private:
+	static bool IsButtonColumn(int column)
+	{
+		return column == JoypadBindingTableModel::kColumnEdit ||
+		       column == JoypadBindingTableModel::kColumnDelete;
+	}
+
+	static QRect CheckRect(const QStyleOptionViewItem &option, const QStyle *style, const QWidget *widget)
+	{
+		const int width = style->pixelMetric(QStyle::PM_IndicatorWidth, &option, widget);
+		const int height = style->pixelMetric(QStyle::PM_IndicatorHeight, &option, widget);
+		return QStyle::alignedRect(option.direction, Qt::AlignCenter, QSize(width, height), option.rect);
+	}
+
+	ButtonCallback on_button_;
+	QPersistentModelIndex pressed_;
+};
+
+JoypadToolsDialog::JoypadToolsDialog(QWidget *parent, JoypadConfigStore *config, JoypadInputManager *input,
+				     JoypadSourceCatalog *catalog)
 	: QDialog(parent),
 	  config_(config),
-	  input_(input)
+	  input_(input),
+	  catalog_(catalog)
 {
 	setWindowTitle(obs_module_text("JoypadToOBS.DialogTitle"));
 	setModal(false);
@@ -2505,6 +3138,7 @@ JoypadToolsDialog::JoypadToolsDialog(QWidget *parent, JoypadConfigStore *config,
 	remove_profile_btn->setToolTip(L("JoypadToOBS.Profile.Remove"));
 	auto *import_profile_btn = new QPushButton(L("JoypadToOBS.Profile.Import"));
 	auto *export_profile_btn = new QPushButton(L("JoypadToOBS.Profile.Export"));
+	auto *export_all_btn = new QPushButton(L("JoypadToOBS.Profile.ExportAll"));
 
 	profile_comment_ = new QPlainTextEdit();
 	profile_comment_->setPlaceholderText(L("JoypadToOBS.Profile.CommentPlaceholder"));
@@ -2523,10 +3157,17 @@ JoypadToolsDialog::JoypadToolsDialog(QWidget *parent, JoypadConfigStore *config,
 	btn_layout->addStretch();
 	btn_layout->addWidget(import_profile_btn);
 	btn_layout->addWidget(export_profile_btn);
+	btn_layout->addWidget(export_all_btn);
 	profile_layout->addLayout(btn_layout, 0, 2);
 
 	profile_layout->addWidget(new QLabel(L("JoypadToOBS.Profile.Comment")), 1, 0);
 	profile_layout->addWidget(profile_comment_, 1, 1, 1, 2);
+
+	auto *watch_config_chk = new QCheckBox(L("JoypadToOBS.Profile.WatchConfigFile"));
+	watch_config_chk->setChecked(config_->GetWatchConfigFile());
+	connect(watch_config_chk, &QCheckBox::toggled, this,
+		[this](bool checked) { config_->SetWatchConfigFile(checked); });
+	profile_layout->addWidget(watch_config_chk, 2, 1, 1, 2);
 	profile_layout->setColumnStretch(1, 1);
 	profile_layout->setRowStretch(1, 1);
 
@@ -2550,7 +3191,6 @@ JoypadToolsDialog::JoypadToolsDialog(QWidget *parent, JoypadConfigStore *config,
 			profile_comment_->blockSignals(true);
 			profile_comment_->setPlainText(QString::fromStdString(config_->GetProfileComment(index)));
 			profile_comment_->blockSignals(false);
-			RefreshBindings();
 		}
 	});
 
@@ -2684,29 +3324,108 @@ JoypadToolsDialog::JoypadToolsDialog(QWidget *parent, JoypadConfigStore *config,
 		}
 	});
 
+	connect(export_all_btn, &QPushButton::clicked, this, [this]() {
+		if (bundle_progress_) {
+			return;
+		}
+		QString lastPath = QString::fromStdString(config_->GetLastFilePath());
+		QString initialPath = QString(kBundleDefaultName);
+		if (!lastPath.isEmpty()) {
+			initialPath = QDir(lastPath).filePath(initialPath);
+		}
+		QString path = QFileDialog::getSaveFileName(this, L("JoypadToOBS.Profile.ExportAll"), initialPath,
+							    kBundleFileFilter);
+		if (!path.isEmpty()) {
+			config_->SetLastFilePath(QFileInfo(path).absolutePath().toStdString());
+			RunBundleJob(path, false);
+		}
+	});
+
 	connect(import_profile_btn, &QPushButton::clicked, this, [this]() {
+		if (bundle_progress_) {
+			return;
+		}
 		QString lastPath = QString::fromStdString(config_->GetLastFilePath());
 		QString path = QFileDialog::getOpenFileName(this, L("JoypadToOBS.Profile.Import"), lastPath,
-							    "JSON Files (*.json)");
+							    QString("JSON Files (*.json);;%1").arg(kBundleFileFilter));
 		if (!path.isEmpty()) {
-			config_->ImportProfile(path.toStdString());
 			config_->SetLastFilePath(QFileInfo(path).absolutePath().toStdString());
+			if (path.endsWith(kBundleSuffix, Qt::CaseInsensitive)) {
+				RunBundleJob(path, true);
+				return;
+			}
+			config_->ImportProfile(path.toStdString());
 			RefreshProfiles();
 		}
 	});
 
-	table_ = new QTableWidget(this);
-	table_->setColumnCount(9);
-	table_->setHorizontalHeaderLabels(
-		{L("JoypadToOBS.Table.Enabled"), L("JoypadToOBS.Table.Device"), L("JoypadToOBS.Table.Input"),
-		 L("JoypadToOBS.Table.Action"), L("JoypadToOBS.Table.Scene"), L("JoypadToOBS.Table.SourceFilter"),
-		 L("JoypadToOBS.Table.Details"), L("JoypadToOBS.Table.Edit"), L("JoypadToOBS.Table.Delete")});
+	binding_model_ = new JoypadBindingTableModel(this, config_);
+	table_ = new QTableView(this);
+	table_->setModel(binding_model_);
+	table_->setItemDelegate(new JoypadBindingTableDelegate(table_, [this](int64_t uid, int column) {
+		// Leave the delegate's event handler before opening dialogs or changing rows.
+		QMetaObject::invokeMethod(
+			this,
+			[this, uid, column]() {
+				if (column == JoypadBindingTableModel::kColumnDelete) {
+					config_->RemoveBindingByUid(uid);
+					return;
+				}
+				JoypadBinding existing;
+				if (!config_->GetBindingByUid(uid, existing)) {
+					return;
+				}
+				JoypadBindingDialog dialog(this, config_, input_, catalog_, &existing);
+				if (dialog.exec() == QDialog::Accepted) {
+					config_->UpdateBindingByUid(uid, dialog.Binding());
+				}
+			},
+			Qt::QueuedConnection);
+	}));
+	table_->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
 	table_->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
 	auto *header = table_->horizontalHeader();
 	header->setSectionResizeMode(QHeaderView::Interactive);
 	table_->setSelectionBehavior(QAbstractItemView::SelectRows);
-	table_->setSelectionMode(QAbstractItemView::SingleSelection);
+	table_->setSelectionMode(QAbstractItemView::ExtendedSelection);
 	table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+	table_->setContextMenuPolicy(Qt::CustomContextMenu);
+
+	connect(table_, &QWidget::customContextMenuRequested, this, [this](const QPoint &pos) {
+		std::vector<int64_t> uids;
+		for (const QModelIndex &index : table_->selectionModel()->selectedRows(1)) {
+			uids.push_back(index.data(kBindingUidRole).toLongLong());
+		}
+		if (uids.empty()) {
+			return;
+		}
+
+		QMenu menu(this);
+		QAction *enable_action = menu.addAction(L("JoypadToOBS.Menu.EnableSelected"));
+		QAction *disable_action = menu.addAction(L("JoypadToOBS.Menu.DisableSelected"));
+		menu.addSeparator();
+		QAction *delete_action = menu.addAction(L("JoypadToOBS.Menu.DeleteSelected"));
+		QAction *chosen = menu.exec(table_->viewport()->mapToGlobal(pos));
+		if (!chosen) {
+			return;
+		}
+		if (chosen == delete_action &&
+		    QMessageBox::question(this, L("JoypadToOBS.Dialog.DeleteSelectedTitle"),
+					  L("JoypadToOBS.Dialog.DeleteSelectedConfirm").arg((int)uids.size())) !=
+			    QMessageBox::Yes) {
+			return;
+		}
+
+		JoypadBindingTransaction transaction = config_->BeginBindingTransaction();
+		for (int64_t uid : uids) {
+			if (chosen == delete_action) {
+				transaction.Remove(uid);
+			} else {
+				transaction.SetEnabled(uid, chosen == enable_action);
+			}
+		}
+		config_->CommitBindingTransaction(transaction);
+	});
 
 	auto *splitter = new QSplitter(Qt::Vertical);
 	splitter->addWidget(profile_group);
@@ -2721,6 +3440,8 @@ JoypadToolsDialog::JoypadToolsDialog(QWidget *parent, JoypadConfigStore *config,
 	add_button_ = new QPushButton(L("JoypadToOBS.Button.AddCommand"), this);
 	clear_button_ = new QPushButton(L("JoypadToOBS.Button.ClearAll"), this);
 	auto *osd_button = new QPushButton(L("JoypadToOBS.Button.OSDSettings"), this);
+	auto *monitor_button = new QPushButton(L("JoypadToOBS.Button.InputMonitor"), this);
+	auto *layers_button = new QPushButton(L("JoypadToOBS.Button.Layers"), this);
 	save_button_ = new QPushButton(L("JoypadToOBS.Button.Save"), this);
 	save_button_->setEnabled(config_->HasUnsavedChanges());
 	auto *close_button = new QPushButton(L("JoypadToOBS.Button.Close"), this);
@@ -2736,6 +3457,8 @@ JoypadToolsDialog::JoypadToolsDialog(QWidget *parent, JoypadConfigStore *config,
 	button_row->addWidget(add_button_);
 	button_row->addWidget(clear_button_);
 	button_row->addWidget(osd_button);
+	button_row->addWidget(monitor_button);
+	button_row->addWidget(layers_button);
 	button_row->addStretch();
 	button_row->addWidget(developerLabel);
 	button_row->addWidget(save_button_);
@@ -2744,10 +3467,9 @@ JoypadToolsDialog::JoypadToolsDialog(QWidget *parent, JoypadConfigStore *config,
 	layout->addLayout(button_row);
 
 	connect(add_button_, &QPushButton::clicked, this, [this]() {
-		JoypadBindingDialog dialog(this, config_, input_);
+		JoypadBindingDialog dialog(this, config_, input_, catalog_);
 		if (dialog.exec() == QDialog::Accepted) {
 			config_->AddBinding(dialog.Binding());
-			RefreshBindings();
 		}
 	});
 
@@ -2755,10 +3477,84 @@ JoypadToolsDialog::JoypadToolsDialog(QWidget *parent, JoypadConfigStore *config,
 		if (QMessageBox::question(this, L("JoypadToOBS.Dialog.ClearAllTitle"),
 					  L("JoypadToOBS.Dialog.ClearAllConfirm")) == QMessageBox::Yes) {
 			config_->ClearCurrentProfileBindings();
-			RefreshBindings();
 		}
 	});
 
+	connect(monitor_button, &QPushButton::clicked, this, [this]() {
+		if (!monitor_dialog_) {
+			auto *dialog = new QDialog(this);
+			dialog->setAttribute(Qt::WA_DeleteOnClose);
+			dialog->setWindowTitle(L("JoypadToOBS.Dialog.InputMonitor"));
+			auto *monitor_layout = new QVBoxLayout(dialog);
+			auto *scroll = new QScrollArea(dialog);
+			scroll->setWidgetResizable(true);
+			scroll->setWidget(new JoypadInputMonitorWidget(scroll, input_));
+			monitor_layout->addWidget(scroll);
+
+			auto *recording_row = new QHBoxLayout();
+			auto *record_button = new QPushButton(dialog);
+			record_button->setCheckable(true);
+			record_button->setChecked(input_->IsRecording());
+			const auto update_record_text = [record_button]() {
+				record_button->setText(record_button->isChecked()
+							       ? L("JoypadToOBS.Monitor.StopRecording")
+							       : L("JoypadToOBS.Monitor.Record"));
+			};
+			update_record_text();
+			auto *replay_button = new QPushButton(L("JoypadToOBS.Monitor.Replay"), dialog);
+			recording_row->addWidget(record_button);
+			recording_row->addWidget(replay_button);
+			recording_row->addStretch();
+			monitor_layout->addLayout(recording_row);
+
+			connect(record_button, &QPushButton::toggled, dialog,
+				[this, dialog, record_button, update_record_text](bool checked) {
+					if (!checked) {
+						input_->StopRecording();
+						update_record_text();
+						return;
+					}
+					const QDir last_dir(QString::fromStdString(config_->GetLastFilePath()));
+					const QString path =
+						QFileDialog::getSaveFileName(dialog, L("JoypadToOBS.Monitor.Record"),
+									     last_dir.filePath("input.jprec"),
+									     kRecordingFileFilter);
+					if (path.isEmpty() || !input_->StartRecording(path.toStdString())) {
+						QSignalBlocker blocker(record_button);
+						record_button->setChecked(false);
+					} else {
+						config_->SetLastFilePath(QFileInfo(path).absolutePath().toStdString());
+					}
+					update_record_text();
+				});
+			connect(replay_button, &QPushButton::clicked, dialog, [this, dialog]() {
+				const QString path = QFileDialog::getOpenFileName(
+					dialog, L("JoypadToOBS.Monitor.Replay"),
+					QString::fromStdString(config_->GetLastFilePath()), kRecordingFileFilter);
+				if (path.isEmpty()) {
+					return;
+				}
+				std::string error;
+				if (!input_->StartReplay(path.toStdString(), true, &error)) {
+					QMessageBox::warning(dialog, L("JoypadToOBS.Monitor.Replay"),
+							     L("JoypadToOBS.Monitor.ReplayFailed")
+								     .arg(QFileInfo(path).fileName(),
+									  QString::fromStdString(error)));
+				}
+			});
+			dialog->resize(560, 360);
+			monitor_dialog_ = dialog;
+		}
+		monitor_dialog_->show();
+		monitor_dialog_->raise();
+		monitor_dialog_->activateWindow();
+	});
+
+	connect(layers_button, &QPushButton::clicked, this, [this]() {
+		JoypadLayersDialog dialog(this, config_, input_);
+		dialog.exec();
+	});
+
 	connect(osd_button, &QPushButton::clicked, this, [this]() {
 		QDialog osd_dlg(this);
 
@@ -2895,40 +3691,93 @@ JoypadToolsDialog::JoypadToolsDialog(QWidget *parent, JoypadConfigStore *config,
 
 	connect(close_button, &QPushButton::clicked, this, &QDialog::close);
 
-	update_timer_ = new QTimer(this);
-	connect(update_timer_, &QTimer::timeout, this, [this]() {
-		int actual = config_->GetCurrentProfileIndex();
-
-		if (profile_combo_->currentIndex() != actual) {
-			profile_combo_->blockSignals(true);
-
-			if (actual >= 0 && actual < profile_combo_->count()) {
-				profile_combo_->setCurrentIndex(actual);
-				profile_comment_->blockSignals(true);
-				profile_comment_->setPlainText(
-					QString::fromStdString(config_->GetProfileComment(actual)));
-				profile_comment_->blockSignals(false);
-				RefreshBindings();
-			}
-
-			profile_combo_->blockSignals(false);
-		}
-		save_button_->setEnabled(config_->HasUnsavedChanges());
-	});
-	update_timer_->start(200);
-
 	RefreshProfiles();
 	table_->resizeColumnsToContents();
 }
 
 JoypadToolsDialog::~JoypadToolsDialog()
 {
+	bundle_cancel_ = true;
+	if (bundle_thread_.joinable()) {
+		bundle_thread_.join();
+	}
 	if (comment_debounce_timer_ && comment_debounce_timer_->isActive()) {
 		int idx = config_->GetCurrentProfileIndex();
 		config_->SetProfileComment(idx, profile_comment_->toPlainText().toStdString());
 	}
 }
 
+void JoypadToolsDialog::RunBundleJob(const QString &path, bool import)
+{
+	if (bundle_thread_.joinable()) {
+		bundle_thread_.join();
+	}
+	bundle_cancel_ = false;
+
+	auto *progress = new QProgressDialog(this);
+	progress->setWindowTitle(import ? L("JoypadToOBS.Profile.Import") : L("JoypadToOBS.Profile.ExportAll"));
+	progress->setLabelText(import ? L("JoypadToOBS.Profile.ImportingBundle")
+				      : L("JoypadToOBS.Profile.ExportingBundle"));
+	progress->setRange(0, 0);
+	progress->setWindowModality(Qt::WindowModal);
+	progress->setAutoClose(false);
+	progress->setAutoReset(false);
+	progress->setMinimumDuration(300);
+	progress->setAttribute(Qt::WA_DeleteOnClose);
+	connect(progress, &QProgressDialog::canceled, this, [this]() { bundle_cancel_ = true; });
+	bundle_progress_ = progress;
+
+	// Progress and results are posted back to this dialog, which joins the worker before
+	// it is destroyed; Qt drops posted calls for a deleted receiver.
+	const std::string file = path.toStdString();
+	bundle_thread_ = std::thread([this, import, file]() {
+		auto report = [this](size_t done, size_t total) {
+			QMetaObject::invokeMethod(
+				this,
+				[this, done, total]() {
+					if (bundle_progress_) {
+						bundle_progress_->setRange(0, (int)total);
+						bundle_progress_->setValue((int)done);
+					}
+				},
+				Qt::QueuedConnection);
+		};
+
+		std::string error;
+		auto bundle = std::make_shared<JoypadProfileBundle>();
+		const bool ok = import ? JoypadConfigStore::ReadBundle(file, *bundle, report, &bundle_cancel_, &error)
+				       : config_->ExportBundle(file, report, &bundle_cancel_, &error);
+
+		QMetaObject::invokeMethod(
+			this,
+			[this, import, ok, error, bundle]() {
+				// Closing the progress dialog emits canceled(), so read the flag first.
+				const bool cancelled = bundle_cancel_;
+				if (bundle_progress_) {
+					bundle_progress_->close();
+				}
+				if (cancelled) {
+					return;
+				}
+				if (!ok) {
+					QMessageBox::warning(this,
+							     import ? L("JoypadToOBS.Profile.Import")
+								    : L("JoypadToOBS.Profile.ExportAll"),
+							     L("JoypadToOBS.Profile.BundleFailed")
+								     .arg(QString::fromStdString(error)));
+					return;
+				}
+				if (import) {
+					const size_t added = config_->CommitBundle(*bundle);
+					RefreshProfiles();
+					QMessageBox::information(this, L("JoypadToOBS.Profile.Import"),
+								 L("JoypadToOBS.Profile.BundleImported").arg((int)added));
+				}
+			},
+			Qt::QueuedConnection);
+	});
+}
+
 void JoypadToolsDialog::closeEvent(QCloseEvent *event)
 {
 	if (config_->HasUnsavedChanges()) {
@@ -2951,6 +3800,29 @@ void JoypadToolsDialog::closeEvent(QCloseEvent *event)
 	}
 }
 
+void JoypadToolsDialog::OnConfigChanged(uint32_t changes)
+{
+	if (changes & kJoypadConfigProfilesChanged) {
+		RefreshProfiles();
+	} else if (changes & kJoypadConfigCurrentProfileChanged) {
+		const int actual = config_->GetCurrentProfileIndex();
+		if (actual >= 0 && actual < profile_combo_->count() && profile_combo_->currentIndex() != actual) {
+			profile_combo_->blockSignals(true);
+			profile_combo_->setCurrentIndex(actual);
+			profile_comment_->blockSignals(true);
+			profile_comment_->setPlainText(QString::fromStdString(config_->GetProfileComment(actual)));
+			profile_comment_->blockSignals(false);
+			profile_combo_->blockSignals(false);
+		}
+		RefreshBindings();
+	} else if (changes & kJoypadConfigBindingsChanged) {
+		RefreshBindings();
+	}
+	if (changes & kJoypadConfigDirtyChanged) {
+		save_button_->setEnabled(config_->HasUnsavedChanges());
+	}
+}
+
 void JoypadToolsDialog::RefreshProfiles()
 {
 	profile_combo_->blockSignals(true);
@@ -2978,138 +3850,7 @@ void JoypadToolsDialog::RefreshProfiles()
 
 void JoypadToolsDialog::RefreshBindings()
 {
-	auto bindings = config_->GetBindingsSnapshot();
-	table_->setRowCount((int)bindings.size());
-
-	for (int row = 0; row < (int)bindings.size(); ++row) {
-		const auto &binding = bindings[(size_t)row];
-		const QString device = device_label_from_binding(binding);
-
-		QWidget *chk_widget = new QWidget();
-		QHBoxLayout *chk_layout = new QHBoxLayout(chk_widget);
-		chk_layout->setContentsMargins(0, 0, 0, 0);
-		chk_layout->setAlignment(Qt::AlignCenter);
-		QCheckBox *chk = new QCheckBox();
-		chk->setChecked(binding.enabled);
-		chk_layout->addWidget(chk);
-		table_->setCellWidget(row, 0, chk_widget);
-
-		int64_t uid = binding.uid;
-
-		connect(chk, &QCheckBox::toggled, this, [this, uid](bool checked) {
-			auto current = config_->GetBindingsSnapshot();
-			for (size_t i = 0; i < current.size(); ++i) {
-				if (current[i].uid == uid) {
-					JoypadBinding updated = current[i];
-					updated.enabled = checked;
-					config_->UpdateBinding(i, updated);
-					break;
-				}
-			}
-		});
-
-		table_->setItem(row, 1, new QTableWidgetItem(device));
-		table_->setItem(row, 2, new QTableWidgetItem(input_label_from_binding(binding)));
-		table_->setItem(row, 3, new QTableWidgetItem(action_to_text(binding.action)));
-
-		QString scene_text;
-		QString source_filter_text;
-
-		switch (binding.action) {
-		case JoypadActionType::SwitchScene:
-			scene_text = QString::fromStdString(binding.scene_name);
-			break;
-		case JoypadActionType::ToggleSourceVisibility:
-		case JoypadActionType::SetSourceVisibility:
-			scene_text = binding.use_current_scene ? L("JoypadToOBS.Common.Current")
-							       : QString::fromStdString(binding.scene_name);
-			source_filter_text = QString::fromStdString(binding.source_name);
-			break;
-		case JoypadActionType::ToggleSourceMute:
-		case JoypadActionType::SetSourceMute:
-		case JoypadActionType::SetSourceVolume:
-		case JoypadActionType::AdjustSourceVolume:
-		case JoypadActionType::SetSourceVolumePercent:
-		case JoypadActionType::MediaPlayPause:
-		case JoypadActionType::MediaRestart:
-		case JoypadActionType::MediaStop:
-			source_filter_text = QString::fromStdString(binding.source_name);
-			break;
-		case JoypadActionType::ToggleFilterEnabled:
-		case JoypadActionType::SetFilterEnabled:
-			source_filter_text = QString::fromStdString(binding.filter_name);
-			break;
-		case JoypadActionType::SetFilterProperty:
-			source_filter_text = QString::fromStdString(binding.filter_name);
-			if (!binding.filter_property_name.empty()) {
-				source_filter_text += " :: " + QString::fromStdString(binding.filter_property_name);
-			}
-			break;
-		case JoypadActionType::AdjustFilterProperty:
-			source_filter_text = QString::fromStdString(binding.filter_name);
-			if (!binding.filter_property_name.empty()) {
-				source_filter_text += " :: " + QString::fromStdString(binding.filter_property_name);
-			}
-			break;
-		case JoypadActionType::SourceTransform:
-			scene_text = binding.use_current_scene ? L("JoypadToOBS.Common.Current")
-							       : QString::fromStdString(binding.scene_name);
-			source_filter_text = QString::fromStdString(binding.source_name);
-			break;
-		case JoypadActionType::Screenshot:
-			if (binding.screenshot_target == JoypadScreenshotTarget::Source) {
-				source_filter_text = QString::fromStdString(binding.source_name);
-			}
-			break;
-		default:
-			break;
-		}
-
-		table_->setItem(row, 4, new QTableWidgetItem(scene_text));
-		table_->setItem(row, 5, new QTableWidgetItem(source_filter_text));
-		table_->setItem(row, 6, new QTableWidgetItem(binding_details(binding)));
-
-		auto *edit_button = new QToolButton(table_);
-		edit_button->setText(L("JoypadToOBS.Button.Edit"));
-		const QVariant binding_index_value(row);
-		edit_button->setProperty("binding_index", binding_index_value);
-		table_->setCellWidget(row, 7, edit_button);
-
-		auto *delete_button = new QToolButton(table_);
-		delete_button->setText(L("JoypadToOBS.Button.Delete"));
-		const QVariant binding_index_value_delete(row);
-		delete_button->setProperty("binding_index", binding_index_value_delete);
-		table_->setCellWidget(row, 8, delete_button);
-
-		connect(edit_button, &QToolButton::clicked, this, [this, uid]() {
-			auto current = config_->GetBindingsSnapshot();
-			size_t target_index = (size_t)-1;
-			for (size_t i = 0; i < current.size(); ++i) {
-				if (current[i].uid == uid) {
-					target_index = i;
-					break;
-				}
-			}
-			if (target_index == (size_t)-1) {
-				return;
-			}
-			JoypadBindingDialog dialog(this, config_, input_, &current[target_index]);
-			if (dialog.exec() == QDialog::Accepted) {
-				config_->UpdateBinding(target_index, dialog.Binding());
-				RefreshBindings();
-			}
-		});
-
-		connect(delete_button, &QToolButton::clicked, this, [this, uid]() {
-			auto current = config_->GetBindingsSnapshot();
-			for (size_t i = 0; i < current.size(); ++i) {
-				if (current[i].uid == uid) {
-					config_->RemoveBinding(i);
-					RefreshBindings();
-					break;
-				}
-			}
-		});
+	if (binding_model_->Sync(config_->GetBindingsSnapshot())) {
+		table_->resizeColumnsToContents();
 	}
-	table_->resizeColumnsToContents();
 }
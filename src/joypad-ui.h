@@ -22,40 +22,57 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 #include "joypad-input.h"
 
 #include <QDialog>
+#include <QPointer>
+#include <atomic>
+#include <thread>
 
 class QCloseEvent;
-class QTableWidget;
+class QTableView;
 class QPushButton;
 class QLabel;
 class QComboBox;
 class QTimer;
 class QPlainTextEdit;
+class QProgressDialog;
 class JoypadActionEngine;
+class JoypadBindingTableModel;
+class JoypadSourceCatalog;
 
 class JoypadToolsDialog : public QDialog {
 public:
-	JoypadToolsDialog(QWidget *parent, JoypadConfigStore *config, JoypadInputManager *input);
+	JoypadToolsDialog(QWidget *parent, JoypadConfigStore *config, JoypadInputManager *input,
+			  JoypadSourceCatalog *catalog);
 	~JoypadToolsDialog();
 
 	void RefreshBindings();
 	void RefreshProfiles();
+	// Called on the UI thread with kJoypadConfig*Changed bits from the config store.
+	void OnConfigChanged(uint32_t changes);
 
 protected:
 	void closeEvent(QCloseEvent *event) override;
 
 private:
+	void RunBundleJob(const QString &path, bool import);
+
 	JoypadConfigStore *config_ = nullptr;
 	JoypadInputManager *input_ = nullptr;
+	JoypadSourceCatalog *catalog_ = nullptr;
 
-	QTableWidget *table_ = nullptr;
+	QTableView *table_ = nullptr;
+	JoypadBindingTableModel *binding_model_ = nullptr;
 	QPushButton *add_button_ = nullptr;
 	QPushButton *clear_button_ = nullptr;
 	QPushButton *save_button_ = nullptr;
 	QLabel *axis_live_label_ = nullptr;
 	QComboBox *profile_combo_ = nullptr;
 	QPlainTextEdit *profile_comment_ = nullptr;
-	QTimer *update_timer_ = nullptr;
 	QTimer *comment_debounce_timer_ = nullptr;
+
+	std::thread bundle_thread_;
+	std::atomic<bool> bundle_cancel_{false};
+	QPointer<QProgressDialog> bundle_progress_;
+	QPointer<QDialog> monitor_dialog_;
 };
 
 bool JoypadUiIsBindingDialogOpen();
@@ -63,3 +80,5 @@ bool JoypadUiIsInputListeningEnabled();
 bool JoypadUiToggleInputListeningEnabled();
 void JoypadUiSetInputListeningEnabled(bool enabled);
 bool JoypadUiEmulateBindingDialogAction(const JoypadEvent &event, JoypadActionEngine *actions);
+// Localized action name, as shown in the bindings table.
+QString JoypadUiActionText(JoypadActionType action);
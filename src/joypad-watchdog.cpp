@@ -0,0 +1,199 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+#include "joypad-watchdog.h"
+#include "joypad-flight-recorder.h"
+#include "joypad-input.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+constexpr auto kCheckInterval = std::chrono::milliseconds(50);
+
+double to_ms(int64_t ns)
+{
+	return (double)ns / 1000000.0;
+}
+
+std::string action_target(const JoypadActionParams &params)
+{
+	if (*params.filter_name) {
+		return std::string(params.source_name) + " / " + params.filter_name;
+	}
+	if (*params.source_name) {
+		return params.source_name;
+	}
+	if (params.use_current_scene) {
+		return "current scene";
+	}
+	return params.scene_name;
+}
+} // namespace
+
+JoypadWatchdog::JoypadWatchdog(int64_t loop_budget_ns, int64_t action_budget_ns)
+	: loop_budget_ns_(loop_budget_ns),
+	  action_budget_ns_(action_budget_ns)
+{
+}
+
+JoypadWatchdog::~JoypadWatchdog()
+{
+	Stop();
+}
+
+void JoypadWatchdog::Start(const JoypadInputManager *input)
+{
+	std::lock_guard<std::mutex> lock(thread_mutex_);
+	if (thread_.joinable()) {
+		return;
+	}
+	input_ = input;
+	stopping_ = false;
+	warned_action_start_ns_ = 0;
+	stalled_heartbeat_ns_ = 0;
+	thread_ = std::thread([this]() { Run(); });
+}
+
+void JoypadWatchdog::Stop()
+{
+	std::thread thread;
+	{
+		std::lock_guard<std::mutex> lock(thread_mutex_);
+		stopping_ = true;
+		thread = std::move(thread_);
+	}
+	wake_.notify_all();
+	if (thread.joinable()) {
+		thread.join();
+	}
+}
+
+void JoypadWatchdog::Run()
+{
+	std::unique_lock<std::mutex> lock(thread_mutex_);
+	while (!stopping_) {
+		wake_.wait_for(lock, kCheckInterval);
+		if (stopping_) {
+			break;
+		}
+		lock.unlock();
+		Check(JoypadFlightNow());
+		JoypadFlightDumpPending();
+		lock.lock();
+	}
+}
+
+void JoypadWatchdog::BeginAction(const JoypadActionParams &params, int64_t binding_uid, int64_t start_ns)
+{
+	action_type_.store((uint8_t)params.action, std::memory_order_relaxed);
+	action_binding_uid_.store(binding_uid, std::memory_order_relaxed);
+	action_start_ns_.store(start_ns, std::memory_order_release);
+}
+
+void JoypadWatchdog::EndAction(const JoypadActionParams &params, int64_t binding_uid, int64_t start_ns,
+			       int64_t end_ns)
+{
+	action_start_ns_.store(0, std::memory_order_relaxed);
+	last_action_end_ns_.store(end_ns, std::memory_order_relaxed);
+
+	const int64_t duration_ns = end_ns - start_ns;
+	if (duration_ns <= action_budget_ns_) {
+		return;
+	}
+	const std::string target = action_target(params);
+	JoypadLog(kJoypadLogWarning, "joypad-to-obs action %s on '%s' (binding %lld) blocked input for %.1f ms",
+		  JoypadActionTypeName(params.action), target.c_str(), (long long)binding_uid, to_ms(duration_ns));
+
+	std::lock_guard<std::mutex> lock(summary_mutex_);
+	auto it = std::find_if(summary_.actions.begin(), summary_.actions.end(), [&](const JoypadStallRecord &r) {
+		return r.binding_uid == binding_uid && r.action == params.action && r.target == target;
+	});
+	if (it == summary_.actions.end()) {
+		JoypadStallRecord record;
+		record.binding_uid = binding_uid;
+		record.action = params.action;
+		record.target = target;
+		it = summary_.actions.insert(summary_.actions.end(), std::move(record));
+	}
+	it->count++;
+	it->total_ns += duration_ns;
+	it->max_ns = std::max(it->max_ns, duration_ns);
+}
+
+void JoypadWatchdog::Check(int64_t now_ns)
+{
+	const int64_t action_start = action_start_ns_.load(std::memory_order_acquire);
+	if (action_start != 0) {
+		const auto action = (JoypadActionType)action_type_.load(std::memory_order_relaxed);
+		const int64_t binding_uid = action_binding_uid_.load(std::memory_order_relaxed);
+		// The fields above may belong to a newer action if this one just ended.
+		if (action_start_ns_.load(std::memory_order_acquire) != action_start) {
+			return;
+		}
+		if (now_ns - action_start > action_budget_ns_ && warned_action_start_ns_ != action_start) {
+			warned_action_start_ns_ = action_start;
+			JoypadLog(kJoypadLogWarning,
+				  "joypad-to-obs input thread blocked for %.1f ms so far in %s (binding %lld)",
+				  to_ms(now_ns - action_start), JoypadActionTypeName(action), (long long)binding_uid);
+		}
+		return;
+	}
+
+	const int64_t heartbeat = input_ ? input_->GetPollHeartbeat() : 0;
+	if (heartbeat == 0) {
+		stalled_heartbeat_ns_ = 0;
+		return;
+	}
+	if (stalled_heartbeat_ns_ != 0) {
+		if (heartbeat == stalled_heartbeat_ns_) {
+			return;
+		}
+		const int64_t stall_ns = heartbeat - stalled_since_ns_;
+		stalled_heartbeat_ns_ = 0;
+		JoypadLog(kJoypadLogInfo, "joypad-to-obs input poll loop resumed after %.1f ms", to_ms(stall_ns));
+		std::lock_guard<std::mutex> lock(summary_mutex_);
+		summary_.loop_stalls++;
+		summary_.loop_stall_max_ns = std::max(summary_.loop_stall_max_ns, stall_ns);
+		return;
+	}
+	const int64_t last_activity = std::max(heartbeat, last_action_end_ns_.load(std::memory_order_relaxed));
+	if (now_ns - last_activity > loop_budget_ns_) {
+		stalled_heartbeat_ns_ = heartbeat;
+		stalled_since_ns_ = last_activity;
+		JoypadLog(kJoypadLogWarning, "joypad-to-obs input poll loop has not run for %.1f ms",
+			  to_ms(now_ns - last_activity));
+	}
+}
+
+JoypadWatchdogSummary JoypadWatchdog::Summary() const
+{
+	JoypadWatchdogSummary summary;
+	{
+		std::lock_guard<std::mutex> lock(summary_mutex_);
+		summary = summary_;
+	}
+	std::sort(summary.actions.begin(), summary.actions.end(),
+		  [](const JoypadStallRecord &a, const JoypadStallRecord &b) { return a.max_ns > b.max_ns; });
+	return summary;
+}
+
+void JoypadWatchdog::Reset()
+{
+	std::lock_guard<std::mutex> lock(summary_mutex_);
+	summary_ = JoypadWatchdogSummary();
+}
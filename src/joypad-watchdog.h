@@ -0,0 +1,103 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+#pragma once
+
+#include "joypad-core.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class JoypadInputManager;
+
+constexpr int64_t kJoypadWatchdogLoopBudgetNs = 250000000;
+constexpr int64_t kJoypadWatchdogActionBudgetNs = 50000000;
+
+// Actions that went over budget, grouped by binding, action type and target.
+struct JoypadStallRecord {
+	int64_t binding_uid = 0;
+	JoypadActionType action = JoypadActionType::SwitchScene;
+	std::string target;
+	uint64_t count = 0;
+	int64_t total_ns = 0;
+	int64_t max_ns = 0;
+};
+
+struct JoypadWatchdogSummary {
+	// Times the poll loop went longer than the loop budget without starting a cycle while
+	// no action was running, and the longest such gap.
+	uint64_t loop_stalls = 0;
+	int64_t loop_stall_max_ns = 0;
+	// Slowest first.
+	std::vector<JoypadStallRecord> actions;
+};
+
+// Watches the input poll thread. Actions run on that thread, so one blocking OBS call
+// freezes every controller; the watchdog thread warns while an action or the loop itself
+// is stuck, and EndAction() attributes each over-budget action to its binding once it
+// returns. BeginAction()/EndAction() only touch atomics unless the budget was exceeded. The
+// watchdog thread also writes flight recorder dumps requested by slow actions.
+class JoypadWatchdog {
+public:
+	explicit JoypadWatchdog(int64_t loop_budget_ns = kJoypadWatchdogLoopBudgetNs,
+				int64_t action_budget_ns = kJoypadWatchdogActionBudgetNs);
+	~JoypadWatchdog();
+
+	// input may be nullptr to watch actions only.
+	void Start(const JoypadInputManager *input);
+	void Stop();
+
+	void BeginAction(const JoypadActionParams &params, int64_t binding_uid, int64_t start_ns);
+	void EndAction(const JoypadActionParams &params, int64_t binding_uid, int64_t start_ns, int64_t end_ns);
+
+	JoypadWatchdogSummary Summary() const;
+	void Reset();
+
+private:
+	void Run();
+	void Check(int64_t now_ns);
+
+	const int64_t loop_budget_ns_;
+	const int64_t action_budget_ns_;
+	const JoypadInputManager *input_ = nullptr;
+
+	std::thread thread_;
+	std::mutex thread_mutex_;
+	std::condition_variable wake_;
+	bool stopping_ = false;
+
+	// Action in progress on the poll thread; action_start_ns_ is 0 between actions.
+	std::atomic<int64_t> action_start_ns_{0};
+	std::atomic<int64_t> action_binding_uid_{0};
+	std::atomic<uint8_t> action_type_{0};
+	// The heartbeat doesn't move while an action runs, so loop gaps are measured from
+	// whichever came last.
+	std::atomic<int64_t> last_action_end_ns_{0};
+
+	// Watchdog thread only.
+	int64_t warned_action_start_ns_ = 0;
+	int64_t stalled_heartbeat_ns_ = 0;
+	int64_t stalled_since_ns_ = 0;
+
+	mutable std::mutex summary_mutex_;
+	JoypadWatchdogSummary summary_;
+};
@@ -0,0 +1,741 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+// Replays synthetic event streams through the binding matcher and prints one JSON object
+// per profile size: ns/event, allocations/event and latency percentiles.
+//
+//   joypad-bench [--sizes 10,100,1000,10000] [--events 200000] [--seed 1]
+//                [--record out.jprec] [--replay in.jprec]
+//                [--synthetic 32 --rate 1000 --seconds 5] [--actions] [--check]
+//                [--trace out.json] [--flight out.jsonl]
+//
+// --record saves the synthetic stream as an input recording; --replay measures a recording
+// instead, and also times it through JoypadInputManager::Replay, the live dispatch path.
+// --synthetic runs a live JoypadInputManager on the synthetic backend with that many devices,
+// each sending --rate events per second, and reports how many events the poll loop delivered.
+// --actions times JoypadActionEngine::Execute for every action type against JoypadFakeObsApi,
+// with the OBS calls each one makes; --check runs each once and exits with 1 unless the calls
+// and the fake's state match what the action should do (ctest runs it). --trace records
+// spans while the benchmark runs and writes them as Chrome trace JSON; see joypad-trace.h.
+// --flight saves the flight recorder (joypad-flight-recorder.h) when the run ends.
+
+#include "joypad-actions.h"
+#include "joypad-backend.h"
+#include "joypad-core.h"
+#include "joypad-flight-recorder.h"
+#include "joypad-input.h"
+#include "joypad-matcher.h"
+#include "joypad-obs-fake.h"
+#include "joypad-recording.h"
+#include "joypad-trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+std::atomic<uint64_t> g_allocations{0};
+
+struct DeviceKind {
+	const char *id;
+	const char *stable_id;
+	const char *type_id;
+	const char *name;
+};
+
+// Two Xbox pads, a DualShock and a generic DirectInput pad.
+constexpr DeviceKind kDevices[] = {
+	{"xinput:0", "", "VID_045E&PID_02FF", "Xbox Controller"},
+	{"xinput:1", "", "VID_045E&PID_0B12", "Xbox Wireless Controller"},
+	{"hid:054c:09cc:0", "usb-0000:00:14.0-3", "VID_054C&PID_09CC", "Wireless Controller"},
+	{"hid:0079:0006:0", "usb-0000:00:14.0-4", "VID_0079&PID_0006", "Generic USB Joystick"},
+};
+constexpr int kDeviceCount = (int)(sizeof(kDevices) / sizeof(kDevices[0]));
+constexpr int kButtons = 16;
+constexpr int kAxes = 6;
+
+struct Options {
+	std::vector<size_t> sizes = {10, 100, 1000, 10000};
+	size_t events = 200000;
+	uint32_t seed = 1;
+	std::string record_path;
+	std::string replay_path;
+	int synthetic_devices = 0;
+	double synthetic_rate = 1000.0;
+	double synthetic_seconds = 5.0;
+	bool actions = false;
+	bool check = false;
+	std::string trace_path;
+	std::string flight_path;
+};
+
+void assign_device(JoypadButtonComboEntry &entry, const DeviceKind &device)
+{
+	entry.device_id = device.id;
+	entry.device_stable_id = device.stable_id;
+	entry.device_type_id = device.type_id;
+	entry.device_name = device.name;
+}
+
+// Roughly what real profiles hold: mostly single buttons, some chords, ordered combos and
+// tap sequences, and axis bindings. A quarter of the bindings accept any device.
+std::vector<JoypadBinding> make_bindings(size_t count, std::mt19937 &rng)
+{
+	std::uniform_int_distribution<int> percent(0, 99);
+	std::uniform_int_distribution<int> button(1, kButtons);
+	std::uniform_int_distribution<int> axis(0, kAxes - 1);
+	std::uniform_int_distribution<int> device(0, kDeviceCount - 1);
+
+	std::vector<JoypadBinding> bindings;
+	bindings.reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		JoypadBinding binding;
+		binding.uid = (int64_t)i + 1;
+		binding.action = JoypadActionType::SwitchScene;
+		binding.scene_name = "Scene " + std::to_string(i % 64);
+		const bool any_device = percent(rng) < 25;
+		const DeviceKind &kind = kDevices[device(rng)];
+		const int roll = percent(rng);
+		if (roll < 15) {
+			binding.input_type = JoypadInputType::Axis;
+			binding.action = (i & 1) ? JoypadActionType::SetSourceVolumePercent
+						 : JoypadActionType::AdjustSourceVolume;
+			binding.source_name = "Mic " + std::to_string(i % 8);
+			binding.axis_index = axis(rng);
+			binding.axis_direction = (JoypadAxisDirection)(percent(rng) % 3 - 1);
+			if (!any_device) {
+				binding.device_id = kind.id;
+				binding.device_stable_id = kind.stable_id;
+				binding.device_type_id = kind.type_id;
+				binding.device_name = kind.name;
+			}
+			bindings.push_back(std::move(binding));
+			continue;
+		}
+
+		int buttons = 1;
+		if (roll >= 95) {
+			binding.combo_mode = JoypadComboMode::Sequence;
+			buttons = 3;
+		} else if (roll >= 88) {
+			binding.combo_mode = JoypadComboMode::Ordered;
+			buttons = 2;
+		} else if (roll >= 70) {
+			buttons = 2 + percent(rng) % 2;
+		}
+		binding.combo_trigger = percent(rng) < 10 ? JoypadComboTrigger::Release : JoypadComboTrigger::Press;
+		for (int b = 0; b < buttons; ++b) {
+			JoypadButtonComboEntry entry;
+			if (!any_device) {
+				assign_device(entry, kind);
+			}
+			entry.button = button(rng);
+			const bool repeated = std::any_of(binding.button_combo.begin(), binding.button_combo.end(),
+							  [&](const JoypadButtonComboEntry &e) {
+								  return e.button == entry.button;
+							  });
+			if (repeated && binding.combo_mode != JoypadComboMode::Sequence) {
+				continue;
+			}
+			binding.button_combo.push_back(std::move(entry));
+		}
+		JoypadSyncButtonCombo(binding);
+		bindings.push_back(std::move(binding));
+	}
+	return bindings;
+}
+
+// Presses and releases keep each device's pressed mask consistent, as the input manager
+// would report them; about one event in five is an axis move.
+std::vector<JoypadEvent> make_events(size_t count, std::mt19937 &rng)
+{
+	std::uniform_int_distribution<int> percent(0, 99);
+	std::uniform_int_distribution<int> button(1, kButtons);
+	std::uniform_int_distribution<int> axis(0, kAxes - 1);
+	std::uniform_int_distribution<int> device(0, kDeviceCount - 1);
+	std::uniform_real_distribution<double> axis_value(-1.0, 1.0);
+
+	uint32_t pressed[kDeviceCount] = {};
+	std::vector<JoypadEvent> events;
+	events.reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		const int d = device(rng);
+		const DeviceKind &kind = kDevices[d];
+		JoypadEvent event;
+		event.device_id = kind.id;
+		event.device_stable_id = kind.stable_id;
+		event.device_type_id = kind.type_id;
+		event.device_name = kind.name;
+		event.device_key = JoypadMakeDeviceKey(kind.id, kind.stable_id, kind.type_id);
+		event.device_xbox_like = JoypadIsXboxLikeDevice(kind.type_id, kind.name);
+		if (percent(rng) < 20) {
+			event.is_axis = true;
+			event.axis_index = axis(rng);
+			event.axis_value = axis_value(rng);
+			event.axis_raw_value = (event.axis_value + 1.0) * 512.0;
+		} else {
+			event.button = button(rng);
+			const uint32_t bit = 1u << (event.button - 1);
+			event.released = (pressed[d] & bit) != 0;
+			pressed[d] ^= bit;
+			event.buttons = pressed[d];
+		}
+		events.push_back(std::move(event));
+	}
+	return events;
+}
+
+uint64_t percentile(const std::vector<uint64_t> &sorted, double p)
+{
+	if (sorted.empty()) {
+		return 0;
+	}
+	const size_t index = std::min(sorted.size() - 1, (size_t)(p * (double)(sorted.size() - 1) + 0.5));
+	return sorted[index];
+}
+
+bool write_recording(const std::string &path, const std::vector<JoypadEvent> &events)
+{
+	JoypadInputRecorder recorder;
+	if (!recorder.Open(path)) {
+		return false;
+	}
+	for (const auto &event : events) {
+		recorder.Write(event.is_axis ? JoypadRecordTag::Axis : JoypadRecordTag::Button, event);
+	}
+	recorder.Close();
+	return true;
+}
+
+void run(size_t size, const Options &options, const std::vector<JoypadEvent> *recorded)
+{
+	std::mt19937 rng(options.seed + (uint32_t)size);
+	const auto bindings = make_bindings(size, rng);
+	const auto events = recorded ? *recorded : make_events(options.events, rng);
+	auto pool = std::make_shared<JoypadStringPool>();
+	std::shared_ptr<const JoypadCompiledProfile> compiled = JoypadCompileProfile(bindings, {}, 1, pool);
+
+	// Same steps as JoypadConfigStore::FindMatchingBindings: take the published profile
+	// under the store lock, then match into a fresh list.
+	std::mutex store_mutex;
+	JoypadMatcher matcher;
+	const auto find_matching = [&](const JoypadEvent &event) {
+		JoypadMatchList result;
+		{
+			std::lock_guard<std::mutex> lock(store_mutex);
+			result.profile = compiled;
+		}
+		matcher.Match(*result.profile, event, nullptr, nullptr, result.matches);
+		return result.matches.size();
+	};
+
+	size_t matches = 0;
+	for (size_t i = 0; i < std::min<size_t>(events.size(), 10000); ++i) {
+		matches += find_matching(events[i]);
+	}
+	matcher.Reset();
+
+	using Clock = std::chrono::steady_clock;
+	std::vector<uint64_t> samples;
+	samples.reserve(events.size());
+	matches = 0;
+	const uint64_t allocations_before = g_allocations.load(std::memory_order_relaxed);
+	const auto started = Clock::now();
+	for (const auto &event : events) {
+		const auto t0 = Clock::now();
+		matches += find_matching(event);
+		const auto t1 = Clock::now();
+		samples.push_back((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+	}
+	const auto elapsed = Clock::now() - started;
+	const uint64_t allocations = g_allocations.load(std::memory_order_relaxed) - allocations_before;
+
+	uint64_t total_ns = 0;
+	for (uint64_t sample : samples) {
+		total_ns += sample;
+	}
+	std::sort(samples.begin(), samples.end());
+	const double count = (double)std::max<size_t>(events.size(), 1);
+	printf("{\"bench\":\"matcher\",\"bindings\":%zu,\"events\":%zu,\"seed\":%u,\"ns_per_event\":%.1f,"
+	       "\"allocs_per_event\":%.3f,\"p50_ns\":%llu,\"p99_ns\":%llu,\"p999_ns\":%llu,\"max_ns\":%llu,"
+	       "\"matches_per_event\":%.3f,\"wall_ms\":%.1f,\"profile_bytes\":%zu}\n",
+	       size, events.size(), options.seed, (double)total_ns / count, (double)allocations / count,
+	       (unsigned long long)percentile(samples, 0.50), (unsigned long long)percentile(samples, 0.99),
+	       (unsigned long long)percentile(samples, 0.999),
+	       (unsigned long long)(samples.empty() ? 0 : samples.back()), (double)matches / count,
+	       std::chrono::duration<double, std::milli>(elapsed).count(), compiled->MemoryUsage());
+	fflush(stdout);
+
+	if (!recorded) {
+		return;
+	}
+	JoypadInputManager input;
+	matcher.Reset();
+	matches = 0;
+	input.SetOnButtonPressed([&](const JoypadEvent &event) { matches += find_matching(event); });
+	input.SetOnAxisChanged([&](const JoypadEvent &event) { matches += find_matching(event); });
+	const auto replay_started = Clock::now();
+	const int64_t dispatched = input.Replay(options.replay_path, false);
+	const auto replay_elapsed = Clock::now() - replay_started;
+	const double replay_ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(replay_elapsed).count();
+	printf("{\"bench\":\"replay\",\"bindings\":%zu,\"events\":%lld,\"ns_per_event\":%.1f,"
+	       "\"events_per_second\":%.0f,\"matches_per_event\":%.3f}\n",
+	       size, (long long)dispatched, replay_ns / (double)std::max<int64_t>(dispatched, 1),
+	       replay_ns > 0 ? (double)dispatched * 1e9 / replay_ns : 0.0,
+	       (double)matches / (double)std::max<int64_t>(dispatched, 1));
+	fflush(stdout);
+}
+
+void run_synthetic(size_t size, const Options &options)
+{
+	std::mt19937 rng(options.seed + (uint32_t)size);
+	const auto bindings = make_bindings(size, rng);
+	auto pool = std::make_shared<JoypadStringPool>();
+	std::shared_ptr<const JoypadCompiledProfile> compiled = JoypadCompileProfile(bindings, {}, 1, pool);
+	JoypadMatcher matcher;
+	std::atomic<uint64_t> events{0};
+	std::atomic<uint64_t> matches{0};
+	const auto on_event = [&](const JoypadEvent &event) {
+		JoypadMatchList result;
+		result.profile = compiled;
+		matcher.Match(*result.profile, event, nullptr, nullptr, result.matches);
+		events.fetch_add(1, std::memory_order_relaxed);
+		matches.fetch_add(result.matches.size(), std::memory_order_relaxed);
+	};
+
+	JoypadInputManager input;
+	input.SetBackend(JoypadCreateSyntheticBackend(options.synthetic_devices, options.synthetic_rate, options.seed));
+	input.SetOnButtonPressed(on_event);
+	input.SetOnAxisChanged(on_event);
+	using Clock = std::chrono::steady_clock;
+	const auto started = Clock::now();
+	input.Start();
+	std::this_thread::sleep_for(std::chrono::duration<double>(options.synthetic_seconds));
+	input.Stop();
+	const double seconds = std::chrono::duration<double>(Clock::now() - started).count();
+
+	const uint64_t delivered = events.load();
+	const double expected = options.synthetic_devices * options.synthetic_rate;
+	printf("{\"bench\":\"synthetic\",\"bindings\":%zu,\"devices\":%d,\"rate_hz\":%.0f,\"seconds\":%.2f,"
+	       "\"events\":%llu,\"events_per_second\":%.0f,\"expected_per_second\":%.0f,"
+	       "\"matches_per_event\":%.3f}\n",
+	       size, options.synthetic_devices, options.synthetic_rate, seconds, (unsigned long long)delivered,
+	       seconds > 0 ? (double)delivered / seconds : 0.0, expected,
+	       (double)matches.load() / (double)std::max<uint64_t>(delivered, 1));
+	fflush(stdout);
+}
+
+struct ActionCase {
+	const char *name;
+	JoypadActionParams params;
+	// Puts the fake into the state the action acts on, after populate_fake_obs().
+	std::function<void(JoypadFakeObsApi &)> setup;
+	// --check: OBS calls one run makes, and the state it must leave behind.
+	uint64_t calls = 0;
+	std::function<bool(JoypadFakeObsApi &)> expect;
+};
+
+bool near(double a, double b)
+{
+	return std::fabs(a - b) < 1e-4;
+}
+
+// "Camera" in "Scene 1", the item the visibility and transform cases act on.
+JoypadFakeObsApi::Item &camera_item(JoypadFakeObsApi &obs)
+{
+	return obs.FindScene("Scene 1")->items.front();
+}
+
+std::vector<ActionCase> make_action_cases()
+{
+	using Fake = JoypadFakeObsApi;
+	std::vector<ActionCase> cases;
+	const auto add = [&](const char *name, JoypadActionType action, uint64_t calls) -> ActionCase & {
+		cases.push_back({name, {}, nullptr, calls, nullptr});
+		cases.back().params.action = action;
+		return cases.back();
+	};
+	auto &scene = add("SwitchScene", JoypadActionType::SwitchScene, 1);
+	scene.params.scene_name = "Scene 2";
+	scene.expect = [](Fake &obs) { return obs.state.program_scene == "Scene 2"; };
+	for (auto action : {JoypadActionType::ToggleSourceVisibility, JoypadActionType::SetSourceVisibility}) {
+		auto &visibility = add(action == JoypadActionType::ToggleSourceVisibility ? "ToggleSourceVisibility"
+											  : "SetSourceVisibility",
+				       action, 4);
+		visibility.params.scene_name = "Scene 1";
+		visibility.params.source_name = "Camera";
+		visibility.params.bool_value = false;
+		visibility.expect = [](Fake &obs) { return !camera_item(obs).visible; };
+	}
+	for (auto action : {JoypadActionType::ToggleSourceMute, JoypadActionType::SetSourceMute}) {
+		auto &mute = add(action == JoypadActionType::ToggleSourceMute ? "ToggleSourceMute" : "SetSourceMute",
+				 action, 4);
+		mute.params.source_name = "Mic";
+		mute.params.bool_value = true;
+		mute.expect = [](Fake &obs) { return obs.FindSource("Mic")->muted; };
+	}
+	auto &volume = add("SetSourceVolume", JoypadActionType::SetSourceVolume, 4);
+	volume.params.source_name = "Mic";
+	volume.params.volume_value = -6.0;
+	volume.expect = [](Fake &obs) { return near(obs.FindSource("Mic")->volume, 0.501187); };
+	auto &percent = add("SetSourceVolumePercent", JoypadActionType::SetSourceVolumePercent, 4);
+	percent.params.source_name = "Mic";
+	percent.params.volume_value = 50.0;
+	// Half of the -60..0 dB range.
+	percent.expect = [](Fake &obs) { return near(obs.FindSource("Mic")->volume, 0.0316228); };
+	auto &adjust = add("AdjustSourceVolume", JoypadActionType::AdjustSourceVolume, 4);
+	adjust.params.source_name = "Mic";
+	adjust.params.volume_value = -0.5;
+	adjust.expect = [](Fake &obs) { return near(obs.FindSource("Mic")->volume, 0.944061); };
+	auto &play = add("MediaPlayPause", JoypadActionType::MediaPlayPause, 4);
+	play.params.source_name = "Clip";
+	play.expect = [](Fake &obs) { return obs.FindSource("Clip")->media_playing; };
+	auto &restart = add("MediaRestart", JoypadActionType::MediaRestart, 3);
+	restart.params.source_name = "Clip";
+	restart.expect = [](Fake &obs) {
+		const Fake::Source &clip = *obs.FindSource("Clip");
+		return clip.media_playing && clip.media_restarts == 1;
+	};
+	auto &stop = add("MediaStop", JoypadActionType::MediaStop, 3);
+	stop.params.source_name = "Clip";
+	stop.setup = [](Fake &obs) { obs.FindSource("Clip")->media_playing = true; };
+	stop.expect = [](Fake &obs) {
+		const Fake::Source &clip = *obs.FindSource("Clip");
+		return !clip.media_playing && clip.media_stops == 1;
+	};
+	for (auto action : {JoypadActionType::ToggleFilterEnabled, JoypadActionType::SetFilterEnabled}) {
+		auto &filter = add(action == JoypadActionType::ToggleFilterEnabled ? "ToggleFilterEnabled"
+										   : "SetFilterEnabled",
+				   action, 6);
+		filter.params.source_name = "Mic";
+		filter.params.filter_name = "Gain";
+		filter.params.bool_value = false;
+		filter.expect = [](Fake &obs) { return !obs.FindSource("Mic")->filters["Gain"]->enabled; };
+	}
+	auto &set_property = add("SetFilterProperty", JoypadActionType::SetFilterProperty, 6);
+	set_property.params.source_name = "Mic";
+	set_property.params.filter_name = "Gain";
+	set_property.params.filter_property_name = "db";
+	set_property.params.filter_property_value = 3.0;
+	set_property.expect = [](Fake &obs) {
+		const Fake::Source &gain = *obs.FindSource("Mic")->filters["Gain"];
+		return gain.updates == 1 && near(gain.settings.at("db").double_value, 3.0);
+	};
+	auto &adjust_property = add("AdjustFilterProperty", JoypadActionType::AdjustFilterProperty, 7);
+	adjust_property.params.source_name = "Mic";
+	adjust_property.params.filter_name = "Gain";
+	adjust_property.params.filter_property_name = "db";
+	adjust_property.params.volume_value = 0.5;
+	adjust_property.expect = [](Fake &obs) {
+		const Fake::Source &gain = *obs.FindSource("Mic")->filters["Gain"];
+		return gain.updates == 1 && near(gain.settings.at("db").double_value, 0.5);
+	};
+	struct Transform {
+		const char *name;
+		JoypadSourceTransformOp op;
+		uint64_t calls;
+		bool (*expect)(const Fake::Item &item);
+	};
+	const Transform transforms[] = {
+		{"SourceTransform:FlipHorizontal", JoypadSourceTransformOp::FlipHorizontal, 4,
+		 [](const Fake::Item &item) { return near(item.scale.x, -1.0) && near(item.scale.y, 1.0); }},
+		{"SourceTransform:Rotate90CW", JoypadSourceTransformOp::Rotate90CW, 4,
+		 [](const Fake::Item &item) { return near(item.rotation, 90.0); }},
+		{"SourceTransform:AlignTopLeft", JoypadSourceTransformOp::AlignTopLeft, 7,
+		 [](const Fake::Item &item) {
+			 return item.alignment == 0 && near(item.position.x, 320.0) && near(item.position.y, 180.0);
+		 }},
+		{"SourceTransform:FitToScreen", JoypadSourceTransformOp::FitToScreen, 6,
+		 [](const Fake::Item &item) {
+			 return item.bounds_type == kJoypadBoundsScaleInner && near(item.bounds.x, 1920.0) &&
+				near(item.bounds.y, 1080.0) && near(item.position.x, 960.0) &&
+				near(item.position.y, 540.0);
+		 }},
+	};
+	for (const auto &transform : transforms) {
+		auto &params = add(transform.name, JoypadActionType::SourceTransform, transform.calls);
+		params.params.use_current_scene = true;
+		params.params.source_name = "Camera";
+		params.params.source_transform_op = transform.op;
+		params.expect = [check = transform.expect](Fake &obs) { return check(camera_item(obs)); };
+	}
+	add("NextScene", JoypadActionType::NextScene, 4).expect = [](Fake &obs) {
+		return obs.state.program_scene == "Scene 2";
+	};
+	add("PreviousScene", JoypadActionType::PreviousScene, 4).expect = [](Fake &obs) {
+		return obs.state.program_scene == "Scene 8";
+	};
+	add("ToggleStreaming", JoypadActionType::ToggleStreaming, 2).expect = [](Fake &obs) {
+		return obs.state.outputs[(size_t)JoypadObsOutput::Streaming];
+	};
+	add("ToggleRecording", JoypadActionType::ToggleRecording, 2).expect = [](Fake &obs) {
+		return obs.state.outputs[(size_t)JoypadObsOutput::Recording];
+	};
+	add("ToggleVirtualCam", JoypadActionType::ToggleVirtualCam, 2).expect = [](Fake &obs) {
+		return obs.state.outputs[(size_t)JoypadObsOutput::VirtualCam];
+	};
+	add("ToggleStudioMode", JoypadActionType::ToggleStudioMode, 1).expect = [](Fake &obs) {
+		return obs.state.studio_mode && obs.state.preview_scene == "Scene 1";
+	};
+	auto &transition = add("TransitionToProgram", JoypadActionType::TransitionToProgram, 1);
+	transition.setup = [](Fake &obs) {
+		obs.state.studio_mode = true;
+		obs.state.preview_scene = "Scene 3";
+	};
+	transition.expect = [](Fake &obs) {
+		return obs.state.program_scene == "Scene 3" && obs.state.transitions == 1;
+	};
+	const auto replay_active = [](Fake &obs) { obs.state.outputs[(size_t)JoypadObsOutput::ReplayBuffer] = true; };
+	add("StartReplayBuffer", JoypadActionType::StartReplayBuffer, 2).expect = [](Fake &obs) {
+		return obs.state.outputs[(size_t)JoypadObsOutput::ReplayBuffer];
+	};
+	auto &stop_replay = add("StopReplayBuffer", JoypadActionType::StopReplayBuffer, 2);
+	stop_replay.setup = replay_active;
+	stop_replay.expect = [](Fake &obs) { return !obs.state.outputs[(size_t)JoypadObsOutput::ReplayBuffer]; };
+	add("ToggleReplayBuffer", JoypadActionType::ToggleReplayBuffer, 2).expect = [](Fake &obs) {
+		return obs.state.outputs[(size_t)JoypadObsOutput::ReplayBuffer];
+	};
+	auto &save_replay = add("SaveReplayBuffer", JoypadActionType::SaveReplayBuffer, 2);
+	save_replay.setup = replay_active;
+	save_replay.expect = [](Fake &obs) { return obs.state.replay_saves == 1; };
+	add("Screenshot", JoypadActionType::Screenshot, 1).expect = [](Fake &obs) {
+		return obs.state.program_screenshots == 1;
+	};
+	return cases;
+}
+
+// Eight scenes sharing a camera, a mic with a gain filter and a media clip.
+void populate_fake_obs(JoypadFakeObsApi &obs)
+{
+	for (int i = 1; i <= 8; ++i) {
+		const std::string scene = "Scene " + std::to_string(i);
+		obs.AddItem(scene, "Camera");
+		obs.AddItem(scene, "Overlay " + std::to_string(i));
+	}
+	obs.AddItem("Scene 1", "Clip");
+	obs.AddSource("Mic");
+	JoypadFakeObsApi::Source &gain = obs.AddFilter("Mic", "Gain");
+	JoypadObsProperty db;
+	db.type = kJoypadPropertyFloat;
+	db.min = -30.0;
+	db.max = 30.0;
+	gain.properties["db"] = db;
+}
+
+void run_actions(const Options &options)
+{
+	for (const ActionCase &action : make_action_cases()) {
+		JoypadFakeObsApi obs;
+		populate_fake_obs(obs);
+		if (action.setup) {
+			action.setup(obs);
+		}
+		JoypadActionEngine engine(obs);
+		engine.Execute(action.params);
+
+		const uint64_t calls_before = obs.Calls();
+		const uint64_t allocs_before = g_allocations.load(std::memory_order_relaxed);
+		const auto started = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < options.events; ++i) {
+			engine.Execute(action.params);
+		}
+		const auto elapsed = std::chrono::steady_clock::now() - started;
+		const uint64_t allocs = g_allocations.load(std::memory_order_relaxed) - allocs_before;
+		const double count = (double)std::max<size_t>(options.events, 1);
+		printf("{\"bench\":\"action\",\"action\":\"%s\",\"runs\":%zu,\"ns_per_action\":%.1f,"
+		       "\"allocs_per_action\":%.3f,\"obs_calls_per_action\":%.2f,\"leaked_refs\":%d}\n",
+		       action.name, options.events,
+		       (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / count,
+		       (double)allocs / count, (double)(obs.Calls() - calls_before) / count, obs.OpenReferences());
+		fflush(stdout);
+	}
+}
+
+// Runs every case once on a fresh fake and compares the calls it made and the state it left
+// with the case's expectation. Also fails when an action type has no case.
+bool check_actions()
+{
+	bool ok = true;
+	bool covered[kJoypadActionTypeCount] = {};
+	for (const ActionCase &action : make_action_cases()) {
+		JoypadFakeObsApi obs;
+		populate_fake_obs(obs);
+		if (action.setup) {
+			action.setup(obs);
+		}
+		JoypadActionEngine engine(obs);
+		engine.Execute(action.params);
+		const bool state_ok = action.expect && action.expect(obs);
+		const bool passed = state_ok && obs.Calls() == action.calls && obs.OpenReferences() == 0;
+		covered[(size_t)action.params.action] = true;
+		printf("{\"check\":\"action\",\"action\":\"%s\",\"passed\":%s,\"state\":%s,\"obs_calls\":%llu,"
+		       "\"expected_calls\":%llu,\"leaked_refs\":%d}\n",
+		       action.name, passed ? "true" : "false", state_ok ? "true" : "false",
+		       (unsigned long long)obs.Calls(), (unsigned long long)action.calls, obs.OpenReferences());
+		ok = ok && passed;
+	}
+	for (size_t i = 0; i < kJoypadActionTypeCount; ++i) {
+		if (!covered[i]) {
+			fprintf(stderr, "joypad-bench: no check for %s\n", JoypadActionTypeName((JoypadActionType)i));
+			ok = false;
+		}
+	}
+	fflush(stdout);
+	return ok;
+}
+
+bool write_diagnostics(const Options &options)
+{
+	std::string error;
+	if (!options.flight_path.empty() && !JoypadFlightWrite(options.flight_path, "bench", &error)) {
+		fprintf(stderr, "%s\n", error.c_str());
+		return false;
+	}
+	if (options.trace_path.empty()) {
+		return true;
+	}
+	JoypadTraceSetEnabled(false);
+	if (!JoypadTraceWriteJson(options.trace_path, &error)) {
+		fprintf(stderr, "%s\n", error.c_str());
+		return false;
+	}
+	return true;
+}
+
+bool parse_options(int argc, char **argv, Options &options)
+{
+	for (int i = 1; i < argc; ++i) {
+		const bool has_value = i + 1 < argc;
+		if (strcmp(argv[i], "--sizes") == 0 && has_value) {
+			options.sizes.clear();
+			for (char *item = strtok(argv[++i], ","); item; item = strtok(nullptr, ",")) {
+				options.sizes.push_back((size_t)strtoull(item, nullptr, 10));
+			}
+		} else if (strcmp(argv[i], "--events") == 0 && has_value) {
+			options.events = (size_t)strtoull(argv[++i], nullptr, 10);
+		} else if (strcmp(argv[i], "--seed") == 0 && has_value) {
+			options.seed = (uint32_t)strtoul(argv[++i], nullptr, 10);
+		} else if (strcmp(argv[i], "--record") == 0 && has_value) {
+			options.record_path = argv[++i];
+		} else if (strcmp(argv[i], "--replay") == 0 && has_value) {
+			options.replay_path = argv[++i];
+		} else if (strcmp(argv[i], "--synthetic") == 0 && has_value) {
+			options.synthetic_devices = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--rate") == 0 && has_value) {
+			options.synthetic_rate = strtod(argv[++i], nullptr);
+		} else if (strcmp(argv[i], "--seconds") == 0 && has_value) {
+			options.synthetic_seconds = strtod(argv[++i], nullptr);
+		} else if (strcmp(argv[i], "--actions") == 0) {
+			options.actions = true;
+		} else if (strcmp(argv[i], "--check") == 0) {
+			options.check = true;
+		} else if (strcmp(argv[i], "--trace") == 0 && has_value) {
+			options.trace_path = argv[++i];
+		} else if (strcmp(argv[i], "--flight") == 0 && has_value) {
+			options.flight_path = argv[++i];
+		} else {
+			fprintf(stderr,
+				"usage: %s [--sizes 10,100,1000,10000] [--events N] [--seed N] [--record FILE] "
+				"[--replay FILE] [--synthetic DEVICES] [--rate HZ] [--seconds N] [--actions] "
+				"[--check] [--trace FILE] [--flight FILE]\n",
+				argv[0]);
+			return false;
+		}
+	}
+	return true;
+}
+} // namespace
+
+// Counts every heap allocation made while the benchmark runs.
+void *operator new(size_t size)
+{
+	g_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void *p = malloc(size ? size : 1)) {
+		return p;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+	free(p);
+}
+
+int main(int argc, char **argv)
+{
+	Options options;
+	if (!parse_options(argc, argv, options)) {
+		return 2;
+	}
+	if (!options.trace_path.empty()) {
+		JoypadTraceSetEnabled(true);
+	}
+	if (options.check) {
+		const bool passed = check_actions();
+		return write_diagnostics(options) && passed ? 0 : 1;
+	}
+	if (options.actions) {
+		run_actions(options);
+		return write_diagnostics(options) ? 0 : 1;
+	}
+	if (!options.record_path.empty()) {
+		std::mt19937 rng(options.seed);
+		if (!write_recording(options.record_path, make_events(options.events, rng))) {
+			return 1;
+		}
+	}
+
+	std::vector<JoypadEvent> recorded;
+	if (!options.replay_path.empty()) {
+		std::vector<JoypadRecordedEvent> file_events;
+		std::string error;
+		if (!JoypadReadRecording(options.replay_path, file_events, &error)) {
+			fprintf(stderr, "%s: %s\n", options.replay_path.c_str(), error.c_str());
+			return 1;
+		}
+		for (auto &file_event : file_events) {
+			recorded.push_back(std::move(file_event.event));
+		}
+	}
+
+	for (size_t size : options.sizes) {
+		if (options.synthetic_devices > 0) {
+			run_synthetic(size, options);
+		} else {
+			run(size, options, options.replay_path.empty() ? nullptr : &recorded);
+		}
+	}
+	return write_diagnostics(options) ? 0 : 1;
+}
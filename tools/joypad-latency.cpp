@@ -0,0 +1,413 @@
+/*
+Joypad to OBS
+Copyright (C) 2026 FabioZumbi12 <admin@areaz12server.net.br>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+// End-to-end latency check for the Linux input path. Creates a virtual gamepad through
+// /dev/uinput, waits for JoypadInputManager to discover it, then injects button presses and
+// axis sweeps and times each one from the write() into the kernel to a mock action engine
+// receiving the matched binding. Prints one JSON object per phase.
+//
+//   joypad-latency [--backend joydev|evdev] [--presses 2000] [--sweeps 20] [--steps 500]
+//                  [--interval-us 1000] [--bindings 1000] [--max-p99-us N]
+//
+// Needs write access to /dev/uinput and exits with 77 (skipped) without it. With --max-p99-us
+// it exits with 1 when the button press p99 is above that bound, so CI can use it as a gate.
+
+#include "joypad-backend.h"
+#include "joypad-core.h"
+#include "joypad-input.h"
+#include "joypad-matcher.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/uinput.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr const char *kPadName = "joypad-to-obs latency pad";
+// BTN_SOUTH (A) through BTN_TR, reported as buttons 1..8 by both Linux backends.
+constexpr int kPadButtons = 8;
+constexpr int kAxisMin = -32767;
+constexpr int kAxisMax = 32767;
+constexpr int kExitSkipped = 77;
+
+struct Options {
+	std::string backend = "joydev";
+	int presses = 2000;
+	int sweeps = 20;
+	int steps = 500;
+	int interval_us = 1000;
+	size_t bindings = 1000;
+	double max_p99_us = 0.0;
+};
+
+// Stands in for JoypadActionEngine, which needs libobs: the same Execute() entry point, but
+// it only records which action arrived and when.
+class MockActionEngine {
+public:
+	struct Execution {
+		Clock::time_point at;
+		JoypadActionType action = JoypadActionType::SwitchScene;
+		std::string scene_name;
+	};
+
+	void Execute(const JoypadActionParams &params)
+	{
+		Execution execution{Clock::now(), params.action, params.scene_name};
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			executions_.push_back(std::move(execution));
+		}
+		arrived_.notify_all();
+	}
+
+	size_t Count() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return executions_.size();
+	}
+
+	// Waits until count actions arrived; false on timeout.
+	bool WaitFor(size_t count, std::chrono::milliseconds timeout)
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		return arrived_.wait_for(lock, timeout, [&]() { return executions_.size() >= count; });
+	}
+
+	std::vector<Execution> Snapshot() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return executions_;
+	}
+
+private:
+	mutable std::mutex mutex_;
+	std::condition_variable arrived_;
+	std::vector<Execution> executions_;
+};
+
+class VirtualPad {
+public:
+	~VirtualPad()
+	{
+		if (fd_ >= 0) {
+			ioctl(fd_, UI_DEV_DESTROY);
+			close(fd_);
+		}
+	}
+
+	bool Create(std::string &error)
+	{
+		fd_ = open("/dev/uinput", O_WRONLY | O_NONBLOCK);
+		if (fd_ < 0) {
+			error = std::string("/dev/uinput: ") + strerror(errno);
+			return false;
+		}
+		bool ok = ioctl(fd_, UI_SET_EVBIT, EV_KEY) >= 0 && ioctl(fd_, UI_SET_EVBIT, EV_ABS) >= 0;
+		for (int i = 0; ok && i < kPadButtons; ++i) {
+			ok = ioctl(fd_, UI_SET_KEYBIT, BTN_SOUTH + i) >= 0;
+		}
+		for (int axis : {ABS_X, ABS_Y}) {
+			uinput_abs_setup abs = {};
+			abs.code = (uint16_t)axis;
+			abs.absinfo.minimum = kAxisMin;
+			abs.absinfo.maximum = kAxisMax;
+			ok = ok && ioctl(fd_, UI_SET_ABSBIT, axis) >= 0 && ioctl(fd_, UI_ABS_SETUP, &abs) >= 0;
+		}
+		uinput_setup setup = {};
+		setup.id.bustype = BUS_USB;
+		// pid.codes test vendor/product.
+		setup.id.vendor = 0x1209;
+		setup.id.product = 0x0001;
+		snprintf(setup.name, sizeof(setup.name), "%s", kPadName);
+		ok = ok && ioctl(fd_, UI_DEV_SETUP, &setup) >= 0 && ioctl(fd_, UI_DEV_CREATE) >= 0;
+		if (!ok) {
+			error = std::string("uinput setup failed: ") + strerror(errno);
+		}
+		return ok;
+	}
+
+	// Writes one input event and its SYN_REPORT in a single call.
+	bool Send(int type, int code, int value)
+	{
+		input_event events[2] = {};
+		events[0].type = (uint16_t)type;
+		events[0].code = (uint16_t)code;
+		events[0].value = value;
+		events[1].type = EV_SYN;
+		events[1].code = SYN_REPORT;
+		return write(fd_, events, sizeof(events)) == (ssize_t)sizeof(events);
+	}
+
+private:
+	int fd_ = -1;
+};
+
+double percentile_us(std::vector<double> &samples, double fraction)
+{
+	if (samples.empty()) {
+		return -1.0;
+	}
+	const size_t index = std::min(samples.size() - 1, (size_t)(fraction * (double)samples.size()));
+	std::nth_element(samples.begin(), samples.begin() + (ptrdiff_t)index, samples.end());
+	return samples[index];
+}
+
+// One binding per pad button, a percent-volume binding on the X axis, which fires on every
+// axis change, and filler bindings for other devices so the matcher has lists to filter.
+std::vector<JoypadBinding> make_bindings(const JoypadDeviceInfo &pad, size_t filler)
+{
+	std::vector<JoypadBinding> bindings;
+	const auto assign_pad = [&](JoypadBinding &binding) {
+		binding.device_id = pad.id;
+		binding.device_stable_id = pad.stable_id;
+		binding.device_type_id = pad.type_id;
+		binding.device_name = pad.name;
+	};
+	for (int button = 1; button <= kPadButtons; ++button) {
+		JoypadBinding binding;
+		assign_pad(binding);
+		binding.button = button;
+		binding.action = JoypadActionType::SwitchScene;
+		binding.scene_name = "Button " + std::to_string(button);
+		bindings.push_back(std::move(binding));
+	}
+	JoypadBinding axis;
+	assign_pad(axis);
+	axis.input_type = JoypadInputType::Axis;
+	axis.axis_index = 0;
+	axis.axis_direction = JoypadAxisDirection::Both;
+	axis.axis_min_value = kAxisMin;
+	axis.axis_max_value = kAxisMax;
+	axis.action = JoypadActionType::SetSourceVolumePercent;
+	axis.source_name = "Mic";
+	bindings.push_back(std::move(axis));
+	for (size_t i = 0; i < filler; ++i) {
+		JoypadBinding binding;
+		binding.device_id = "filler:" + std::to_string(i % 16);
+		binding.button = (int)(i % 16) + 1;
+		binding.action = JoypadActionType::SwitchScene;
+		binding.scene_name = "Filler " + std::to_string(i);
+		bindings.push_back(std::move(binding));
+	}
+	for (size_t i = 0; i < bindings.size(); ++i) {
+		bindings[i].uid = (int64_t)i + 1;
+	}
+	return bindings;
+}
+
+bool find_pad(JoypadInputManager &input, JoypadDeviceInfo &pad)
+{
+	const auto deadline = Clock::now() + std::chrono::seconds(5);
+	while (Clock::now() < deadline) {
+		for (const auto &device : input.GetDevices()) {
+			if (device.name == kPadName) {
+				pad = device;
+				return true;
+			}
+		}
+		// udev may still be creating the node or fixing its permissions.
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		input.RefreshDevices();
+	}
+	return false;
+}
+
+// Presses and releases one button at a time and times each press to its action.
+bool run_presses(const Options &options, VirtualPad &pad, MockActionEngine &engine)
+{
+	std::vector<double> latencies;
+	latencies.reserve((size_t)options.presses);
+	int lost = 0;
+	int wrong = 0;
+	for (int i = 0; i < options.presses; ++i) {
+		const int button = i % kPadButtons;
+		const size_t expected = engine.Count() + 1;
+		const auto sent = Clock::now();
+		if (!pad.Send(EV_KEY, BTN_SOUTH + button, 1)) {
+			fprintf(stderr, "uinput write failed: %s\n", strerror(errno));
+			return false;
+		}
+		if (engine.WaitFor(expected, std::chrono::milliseconds(1000))) {
+			const auto execution = engine.Snapshot()[expected - 1];
+			if (execution.scene_name != "Button " + std::to_string(button + 1)) {
+				++wrong;
+			}
+			latencies.push_back(std::chrono::duration<double, std::micro>(execution.at - sent).count());
+		} else {
+			++lost;
+		}
+		pad.Send(EV_KEY, BTN_SOUTH + button, 0);
+		std::this_thread::sleep_for(std::chrono::microseconds(options.interval_us));
+	}
+
+	const double p99 = percentile_us(latencies, 0.99);
+	printf("{\"bench\":\"uinput_press\",\"backend\":\"%s\",\"presses\":%d,\"lost\":%d,\"wrong\":%d,"
+	       "\"p50_us\":%.1f,\"p99_us\":%.1f,\"max_us\":%.1f}\n",
+	       options.backend.c_str(), options.presses, lost, wrong, percentile_us(latencies, 0.5), p99,
+	       percentile_us(latencies, 1.0));
+	fflush(stdout);
+	if (lost > 0 || wrong > 0) {
+		return false;
+	}
+	return options.max_p99_us <= 0.0 || p99 <= options.max_p99_us;
+}
+
+// Sweeps the X axis end to end at a fixed step interval, without waiting between steps, and
+// reports throughput plus per-step latency when every step arrived.
+bool run_sweeps(const Options &options, VirtualPad &pad, MockActionEngine &engine)
+{
+	// The first reading of an axis only initializes it and dispatches nothing.
+	pad.Send(EV_ABS, ABS_X, kAxisMin);
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	const size_t base = engine.Count();
+
+	const int delta = std::max((kAxisMax - kAxisMin) / std::max(options.steps, 1), 1);
+	std::vector<Clock::time_point> sent;
+	sent.reserve((size_t)options.sweeps * (size_t)options.steps);
+	auto next = Clock::now();
+	for (int sweep = 0; sweep < options.sweeps; ++sweep) {
+		for (int step = 1; step <= options.steps; ++step) {
+			// Up on even sweeps, down on odd ones, so every step changes the reading.
+			const int value = kAxisMin + (sweep % 2 == 0 ? step : options.steps - step) * delta;
+			std::this_thread::sleep_until(next);
+			sent.push_back(Clock::now());
+			if (!pad.Send(EV_ABS, ABS_X, value)) {
+				fprintf(stderr, "uinput write failed: %s\n", strerror(errno));
+				return false;
+			}
+			next += std::chrono::microseconds(options.interval_us);
+		}
+	}
+	engine.WaitFor(base + sent.size(), std::chrono::milliseconds(1000));
+
+	const auto executions = engine.Snapshot();
+	const size_t delivered = executions.size() - base;
+	std::vector<double> latencies;
+	if (delivered == sent.size()) {
+		latencies.reserve(sent.size());
+		for (size_t i = 0; i < sent.size(); ++i) {
+			latencies.push_back(
+				std::chrono::duration<double, std::micro>(executions[base + i].at - sent[i]).count());
+		}
+	}
+	const double seconds =
+		delivered > 0 ? std::chrono::duration<double>(executions.back().at - sent.front()).count() : 0.0;
+	printf("{\"bench\":\"uinput_sweep\",\"backend\":\"%s\",\"sent\":%zu,\"delivered\":%zu,"
+	       "\"events_per_second\":%.0f,\"p50_us\":%.1f,\"p99_us\":%.1f,\"max_us\":%.1f}\n",
+	       options.backend.c_str(), sent.size(), delivered, seconds > 0 ? (double)delivered / seconds : 0.0,
+	       percentile_us(latencies, 0.5), percentile_us(latencies, 0.99), percentile_us(latencies, 1.0));
+	fflush(stdout);
+	return delivered == sent.size();
+}
+
+bool parse_options(int argc, char **argv, Options &options)
+{
+	for (int i = 1; i < argc; ++i) {
+		const bool has_value = i + 1 < argc;
+		if (strcmp(argv[i], "--backend") == 0 && has_value) {
+			options.backend = argv[++i];
+		} else if (strcmp(argv[i], "--presses") == 0 && has_value) {
+			options.presses = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--sweeps") == 0 && has_value) {
+			options.sweeps = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--steps") == 0 && has_value) {
+			options.steps = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--interval-us") == 0 && has_value) {
+			options.interval_us = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--bindings") == 0 && has_value) {
+			options.bindings = (size_t)strtoull(argv[++i], nullptr, 10);
+		} else if (strcmp(argv[i], "--max-p99-us") == 0 && has_value) {
+			options.max_p99_us = strtod(argv[++i], nullptr);
+		} else {
+			fprintf(stderr,
+				"usage: %s [--backend joydev|evdev] [--presses N] [--sweeps N] [--steps N] "
+				"[--interval-us N] [--bindings N] [--max-p99-us N]\n",
+				argv[0]);
+			return false;
+		}
+	}
+	return true;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+	Options options;
+	if (!parse_options(argc, argv, options)) {
+		return 2;
+	}
+	auto backend = JoypadCreateInputBackend(options.backend);
+	if (!backend) {
+		fprintf(stderr, "unknown backend: %s\n", options.backend.c_str());
+		return 2;
+	}
+
+	VirtualPad pad;
+	std::string error;
+	if (!pad.Create(error)) {
+		fprintf(stderr, "%s, skipping\n", error.c_str());
+		return kExitSkipped;
+	}
+
+	JoypadInputManager input;
+	input.SetBackend(std::move(backend));
+	input.Start();
+	JoypadDeviceInfo pad_info;
+	if (!find_pad(input, pad_info)) {
+		fprintf(stderr, "%s was not discovered by the %s backend\n", kPadName, options.backend.c_str());
+		return 1;
+	}
+
+	// Same steps as the plugin's handlers: match against the published profile, then hand
+	// every matched binding to the action engine.
+	auto pool = std::make_shared<JoypadStringPool>();
+	std::shared_ptr<const JoypadCompiledProfile> compiled =
+		JoypadCompileProfile(make_bindings(pad_info, options.bindings), {}, 1, pool);
+	JoypadMatcher matcher;
+	MockActionEngine engine;
+	const auto dispatch = [&](const JoypadEvent &event) {
+		JoypadMatchList result;
+		result.profile = compiled;
+		matcher.Match(*result.profile, event, &input, nullptr, result.matches);
+		for (size_t i = 0; i < result.size(); ++i) {
+			engine.Execute(result.Params(i));
+		}
+	};
+	input.SetOnButtonPressed(dispatch);
+	input.SetOnAxisChanged(dispatch);
+
+	const bool presses_ok = run_presses(options, pad, engine);
+	const bool sweeps_ok = run_sweeps(options, pad, engine);
+	input.Stop();
+	return presses_ok && sweeps_ok ? 0 : 1;
+}